@@ -0,0 +1,643 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "Allocator.h"
+#include "ScratchArena.h"
+#include "../Atomic/AtomicLock.h"
+#include "../Containers/DArray.h"
+#include "../Containers/HMap.h"
+#include "../Containers/HashPolicies.h"
+#include "../String/StringBuilder.h"
+#include "../Defer/Defer.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CALLER_ADDRESS() _ReturnAddress()
+#else
+#define CALLER_ADDRESS() __builtin_return_address( 0 )
+#endif
+
+/// <summary>
+/// <para>Where an allocation came from</para>
+/// <para>Debug builds get the file and line from the ALLOC macros , release builds only have the return address of the allocation call</para>
+/// </summary>
+struct AllocationSite
+{
+    const char* filepath;
+    size_t line_number;
+    void* address;
+};
+
+struct AllocationSiteHasher
+{
+    inline size_t Hash( const AllocationSite& key )
+    {
+        size_t hash = key.filepath != nullptr ? HashUtils::HashBytes( key.filepath, strlen( key.filepath ) ) : 0;
+
+        return hash ^ (key.line_number * 0x9E3779B97F4A7C15ull) ^ (size_t) key.address;
+    }
+};
+
+struct AllocationSiteComparer
+{
+    // NOTE : compares the paths by content , the same __FILE__ can end up at different addresses in different translation units
+    inline bool Equals( const AllocationSite& a, const AllocationSite& b )
+    {
+        if ( a.line_number != b.line_number || a.address != b.address )
+        {
+            return false;
+        }
+
+        if ( a.filepath == b.filepath )
+        {
+            return true;
+        }
+
+        return a.filepath != nullptr && b.filepath != nullptr && strcmp( a.filepath, b.filepath ) == 0;
+    }
+};
+
+struct AllocationSiteStats
+{
+    AllocationSite site;
+
+    size_t allocation_count;
+    size_t allocated_bytes;
+
+    size_t live_count;
+    size_t live_bytes;
+    size_t peak_live_bytes;
+
+    size_t frame_allocation_count;
+    size_t max_frame_allocation_count;
+};
+
+struct AllocationFrameStats
+{
+    static const size_t HISTOGRAM_BUCKETS = 16;
+    static const size_t MIN_BUCKET_SHIFT = 4;
+
+    uint64_t frame_index;
+
+    size_t allocation_count;
+    size_t allocated_bytes;
+    size_t free_count;
+
+    /// <summary>
+    /// Live bytes when the frame ended
+    /// </summary>
+    size_t live_bytes;
+
+    /// <summary>
+    /// Allocation count per size , bucket i holds the sizes up to 16 << i , the last one holds everything bigger
+    /// </summary>
+    size_t histogram[HISTOGRAM_BUCKETS];
+};
+
+/// <summary>
+/// <para>Counts allocations per call site : count , bytes , live and peak live bytes , the allocations per frame and a size histogram for the last frames</para>
+/// <para>It is fed by a ProfiledAllocator , either from the allocator callbacks (debug) or from the wrapper itself (release)</para>
+/// <para>With a "sample_interval" only about one allocation every "sample_interval" bytes is recorded and stands for all the bytes in between ,
+/// so the counts and bytes become estimates but the cost of the unsampled allocations is a thread local subtraction</para>
+/// <para>Frees look at "live_filter" first , a counter per hash of the pointer , and only lock when a live allocation may have that pointer ,
+/// so freeing an unsampled allocation is one atomic read</para>
+/// <para>NOTE : the profiler's own allocator must not be a profiled one</para>
+/// </summary>
+struct AllocationProfiler
+{
+    static const size_t FRAME_HISTORY = 128;
+    static const size_t DEFAULT_SAMPLE_INTERVAL = 32 * 1'024;
+    static const size_t LIVE_FILTER_LOG2 = 12;
+    static const size_t LIVE_FILTER_SIZE = (size_t) 1 << LIVE_FILTER_LOG2;
+
+    struct LiveAllocation
+    {
+        size_t bytes;
+        size_t count;
+        uint32_t site_index;
+    };
+
+    Allocator alloc;
+    AtomicLock lock;
+
+    /// <summary>
+    /// 0 records every allocation
+    /// </summary>
+    size_t sample_interval;
+
+    HMap<AllocationSite, AllocationSiteStats, AllocationSiteHasher, AllocationSiteComparer> sites;
+    HMap<void*, LiveAllocation> live;
+
+    /// <summary>
+    /// Number of "live" entries per FilterIndex , written under the lock and read without it
+    /// </summary>
+    volatile int32_t* live_filter;
+
+    size_t allocation_count;
+    size_t allocated_bytes;
+    size_t free_count;
+    size_t live_bytes;
+    size_t peak_live_bytes;
+
+    AllocationFrameStats current_frame;
+
+    /// <summary>
+    /// Ring of the last FRAME_HISTORY frames , "frame_count" is the number of frames ended so far
+    /// </summary>
+    AllocationFrameStats* frame_history;
+    uint64_t frame_count;
+
+    static void Create( AllocationProfiler* out_profiler, Allocator alloc, size_t sample_interval = 0 )
+    {
+        *out_profiler = {};
+        out_profiler->alloc = alloc;
+        out_profiler->sample_interval = sample_interval;
+
+        HMap<AllocationSite, AllocationSiteStats, AllocationSiteHasher, AllocationSiteComparer>::Create( &out_profiler->sites, alloc, 64 );
+        HMap<void*, LiveAllocation>::Create( &out_profiler->live, alloc, 1'024 );
+
+        out_profiler->live_filter = (volatile int32_t*) ALLOC( alloc, sizeof( int32_t ) * LIVE_FILTER_SIZE );
+        CoreContext::mem_init( (void*) out_profiler->live_filter, sizeof( int32_t ) * LIVE_FILTER_SIZE );
+
+        const size_t history_size = sizeof( AllocationFrameStats ) * FRAME_HISTORY;
+        out_profiler->frame_history = (AllocationFrameStats*) ALLOC( alloc, history_size );
+        CoreContext::mem_init( out_profiler->frame_history, history_size );
+    }
+
+    static void Destroy( AllocationProfiler* in_profiler )
+    {
+        HMap<AllocationSite, AllocationSiteStats, AllocationSiteHasher, AllocationSiteComparer>::Destroy( &in_profiler->sites );
+        HMap<void*, LiveAllocation>::Destroy( &in_profiler->live );
+        FREE( in_profiler->alloc, (void*) in_profiler->live_filter );
+        FREE( in_profiler->alloc, in_profiler->frame_history );
+
+        *in_profiler = {};
+    }
+
+    /// <summary>
+    /// (track_lifetime) false for memory that is never freed one by one (arenas) , it's counted but never considered live
+    /// </summary>
+    static void RecordAlloc( AllocationProfiler* in_profiler, void* ptr, size_t size, AllocationSite site, bool track_lifetime )
+    {
+        if ( ptr == nullptr )
+        {
+            return;
+        }
+
+        size_t bytes = size;
+        size_t count = 1;
+
+        if ( in_profiler->sample_interval != 0 && size < in_profiler->sample_interval )
+        {
+            bytes_until_sample -= (int64_t) size;
+
+            if ( bytes_until_sample > 0 )
+            {
+                return;
+            }
+
+            bytes_until_sample += (int64_t) in_profiler->sample_interval;
+
+            // this one stands for all the small allocations since the last sample
+            bytes = in_profiler->sample_interval;
+            count = size != 0 ? bytes / size : 1;
+        }
+
+        in_profiler->lock.Lock();
+        {
+            size_t site_index = 0;
+            AllocationSiteStats* stats = nullptr;
+
+            if ( !HMap<AllocationSite, AllocationSiteStats, AllocationSiteHasher, AllocationSiteComparer>::TryGet( &in_profiler->sites, site, &stats ) )
+            {
+                AllocationSiteStats new_stats = {};
+                new_stats.site = site;
+
+                HMap<AllocationSite, AllocationSiteStats, AllocationSiteHasher, AllocationSiteComparer>::TryAdd( &in_profiler->sites, site, new_stats, &site_index );
+                stats = &in_profiler->sites.all_values.data[site_index];
+            }
+            else
+            {
+                site_index = (size_t) (stats - in_profiler->sites.all_values.data);
+            }
+
+            stats->allocation_count += count;
+            stats->allocated_bytes += bytes;
+            stats->frame_allocation_count += count;
+
+            in_profiler->allocation_count += count;
+            in_profiler->allocated_bytes += bytes;
+
+            in_profiler->current_frame.allocation_count += count;
+            in_profiler->current_frame.allocated_bytes += bytes;
+            in_profiler->current_frame.histogram[BucketIndex( size )] += count;
+
+            if ( track_lifetime )
+            {
+                LiveAllocation allocation = {};
+                allocation.bytes = bytes;
+                allocation.count = count;
+                allocation.site_index = (uint32_t) site_index;
+
+                // a pointer that was freed without us seeing it (direct call to "free") , keep the newest one
+                LiveAllocation stale = {};
+                if ( HMap<void*, LiveAllocation>::TryRemove( &in_profiler->live, ptr, &stale ) )
+                {
+                    ForgetLive( in_profiler, ptr, stale );
+                }
+
+                HMap<void*, LiveAllocation>::TryAdd( &in_profiler->live, ptr, allocation, nullptr );
+                Atomic::Increment( &in_profiler->live_filter[FilterIndex( ptr )] );
+
+                stats->live_count += count;
+                stats->live_bytes += bytes;
+                in_profiler->live_bytes += bytes;
+
+                if ( stats->live_bytes > stats->peak_live_bytes )
+                {
+                    stats->peak_live_bytes = stats->live_bytes;
+                }
+
+                if ( in_profiler->live_bytes > in_profiler->peak_live_bytes )
+                {
+                    in_profiler->peak_live_bytes = in_profiler->live_bytes;
+                }
+            }
+        }
+        in_profiler->lock.Unlock();
+    }
+
+    static void RecordFree( AllocationProfiler* in_profiler, void* ptr )
+    {
+        // unsampled or untracked , nothing to remove
+        if ( ptr == nullptr || !MayBeLive( in_profiler, ptr ) )
+        {
+            return;
+        }
+
+        in_profiler->lock.Lock();
+        {
+            LiveAllocation allocation = {};
+
+            if ( HMap<void*, LiveAllocation>::TryRemove( &in_profiler->live, ptr, &allocation ) )
+            {
+                ForgetLive( in_profiler, ptr, allocation );
+
+                in_profiler->free_count += allocation.count;
+                in_profiler->current_frame.free_count += allocation.count;
+            }
+        }
+        in_profiler->lock.Unlock();
+    }
+
+    /// <summary>
+    /// False when "ptr" is surely not a live allocation , true when it may be one (another live pointer can share its counter)
+    /// </summary>
+    static inline bool MayBeLive( AllocationProfiler* in_profiler, void* ptr )
+    {
+        return Atomic::Load( &in_profiler->live_filter[FilterIndex( ptr )] ) != 0;
+    }
+
+    static void RecordRealloc( AllocationProfiler* in_profiler, void* old_ptr, void* new_ptr, size_t size, AllocationSite site, bool track_lifetime )
+    {
+        RecordFree( in_profiler, old_ptr );
+        RecordAlloc( in_profiler, new_ptr, size, site, track_lifetime );
+    }
+
+    /// <summary>
+    /// Closes the current frame , its stats go to the history and the per-frame counters start over
+    /// </summary>
+    static void EndFrame( AllocationProfiler* in_profiler )
+    {
+        in_profiler->lock.Lock();
+        {
+            AllocationFrameStats* frame = &in_profiler->current_frame;
+            frame->frame_index = in_profiler->frame_count;
+            frame->live_bytes = in_profiler->live_bytes;
+
+            in_profiler->frame_history[in_profiler->frame_count % FRAME_HISTORY] = *frame;
+            in_profiler->frame_count++;
+
+            *frame = {};
+
+            for ( size_t i = 0; i < in_profiler->sites.count; ++i )
+            {
+                AllocationSiteStats* stats = &in_profiler->sites.all_values.data[i];
+
+                if ( stats->frame_allocation_count > stats->max_frame_allocation_count )
+                {
+                    stats->max_frame_allocation_count = stats->frame_allocation_count;
+                }
+
+                stats->frame_allocation_count = 0;
+            }
+        }
+        in_profiler->lock.Unlock();
+    }
+
+    /// <summary>
+    /// Stats of a past frame , 0 being the last one that ended
+    /// </summary>
+    static bool TryGetFrame( AllocationProfiler* in_profiler, size_t frames_ago, AllocationFrameStats* out_frame )
+    {
+        if ( frames_ago >= in_profiler->frame_count || frames_ago >= FRAME_HISTORY )
+        {
+            return false;
+        }
+
+        *out_frame = in_profiler->frame_history[(in_profiler->frame_count - 1 - frames_ago) % FRAME_HISTORY];
+        return true;
+    }
+
+    static size_t BucketIndex( size_t size )
+    {
+        size_t bucket = 0;
+
+        while ( bucket < AllocationFrameStats::HISTOGRAM_BUCKETS - 1 && size > ((size_t) 1 << (AllocationFrameStats::MIN_BUCKET_SHIFT + bucket)) )
+        {
+            ++bucket;
+        }
+
+        return bucket;
+    }
+
+    /// <summary>
+    /// <para>Totals , the (max_sites) call sites that allocated the most bytes and the size histogram of the last frame</para>
+    /// <para>NOTE : the stats are copied before writing to (out_builder) , so its allocator can be one that reports to this profiler</para>
+    /// </summary>
+    static void Report( AllocationProfiler* in_profiler, StringBuilder* out_builder, size_t max_sites = 20 )
+    {
+        ScratchArena scratch = ScratchArena::Get( out_builder->alloc );
+        DEFER( [&](){ ScratchArena::Release( &scratch ); } );
+
+        AllocationProfiler totals = {};
+        AllocationFrameStats frame = {};
+        bool has_frame = false;
+
+        DArray<AllocationSiteStats> sites = {};
+
+        in_profiler->lock.Lock();
+        {
+            totals = *in_profiler;
+            has_frame = TryGetFrame( in_profiler, 0, &frame );
+            DArray<AllocationSiteStats>::Create( in_profiler->sites.all_values.data, &sites, in_profiler->sites.count, scratch.alloc );
+        }
+        in_profiler->lock.Unlock();
+
+        SortSites( &sites, false );
+
+        char line[512];
+
+        snprintf( line, sizeof( line ), "-- Allocations : %zu (%zu bytes) , frees : %zu , live : %zu bytes , peak : %zu bytes\n",
+            totals.allocation_count, totals.allocated_bytes, totals.free_count, totals.live_bytes, totals.peak_live_bytes );
+        StringBuilder::Append( out_builder, line );
+
+        if ( totals.sample_interval != 0 )
+        {
+            snprintf( line, sizeof( line ), "-- Sampling one allocation every %zu bytes , counts and bytes are estimates\n", totals.sample_interval );
+            StringBuilder::Append( out_builder, line );
+        }
+
+        snprintf( line, sizeof( line ), "%16s | %10s | %16s | %10s | %s\n", "bytes", "count", "live bytes", "max/frame", "site" );
+        StringBuilder::Append( out_builder, line );
+
+        for ( size_t i = 0; i < sites.size && i < max_sites; ++i )
+        {
+            AllocationSiteStats* stats = &sites.data[i];
+
+            char site[256];
+            FormatSite( stats->site, site, sizeof( site ) );
+
+            snprintf( line, sizeof( line ), "%16zu | %10zu | %16zu | %10zu | %s\n",
+                stats->allocated_bytes, stats->allocation_count, stats->live_bytes, stats->max_frame_allocation_count, site );
+            StringBuilder::Append( out_builder, line );
+        }
+
+        if ( !has_frame )
+        {
+            return;
+        }
+
+        snprintf( line, sizeof( line ), "-- Frame %llu : %zu allocations (%zu bytes) , %zu frees\n",
+            (unsigned long long) frame.frame_index, frame.allocation_count, frame.allocated_bytes, frame.free_count );
+        StringBuilder::Append( out_builder, line );
+
+        for ( size_t i = 0; i < AllocationFrameStats::HISTOGRAM_BUCKETS; ++i )
+        {
+            if ( frame.histogram[i] == 0 )
+            {
+                continue;
+            }
+
+            size_t bucket_size = (size_t) 1 << (AllocationFrameStats::MIN_BUCKET_SHIFT + i);
+            bool is_last = i == AllocationFrameStats::HISTOGRAM_BUCKETS - 1;
+
+            snprintf( line, sizeof( line ), "%s %10zu bytes : %zu\n", is_last ? " >" : "<=", is_last ? bucket_size / 2 : bucket_size, frame.histogram[i] );
+            StringBuilder::Append( out_builder, line );
+        }
+    }
+
+    /// <summary>
+    /// Lists the call sites that still have live allocations , returns how many allocations are still alive
+    /// </summary>
+    static size_t ReportLeaks( AllocationProfiler* in_profiler, StringBuilder* out_builder )
+    {
+        ScratchArena scratch = ScratchArena::Get( out_builder->alloc );
+        DEFER( [&](){ ScratchArena::Release( &scratch ); } );
+
+        DArray<AllocationSiteStats> sites = {};
+
+        in_profiler->lock.Lock();
+        {
+            DArray<AllocationSiteStats>::Create( in_profiler->sites.all_values.data, &sites, in_profiler->sites.count, scratch.alloc );
+        }
+        in_profiler->lock.Unlock();
+
+        SortSites( &sites, true );
+
+        char line[512];
+        size_t leak_count = 0;
+
+        for ( size_t i = 0; i < sites.size && sites.data[i].live_count != 0; ++i )
+        {
+            AllocationSiteStats* stats = &sites.data[i];
+
+            char site[256];
+            FormatSite( stats->site, site, sizeof( site ) );
+
+            snprintf( line, sizeof( line ), "-- Leak : %zu allocations (%zu bytes) from %s\n", stats->live_count, stats->live_bytes, site );
+            StringBuilder::Append( out_builder, line );
+
+            leak_count += stats->live_count;
+        }
+
+        return leak_count;
+    }
+
+private:
+
+    static inline thread_local int64_t bytes_until_sample = 0;
+
+    static inline size_t FilterIndex( void* ptr )
+    {
+        // the low bits are the same for every block , fibonacci hashing spreads the rest
+        return (size_t) ((((uint64_t) (uintptr_t) ptr >> 4) * 0x9E3779B97F4A7C15ull) >> (64 - LIVE_FILTER_LOG2));
+    }
+
+    static void ForgetLive( AllocationProfiler* in_profiler, void* ptr, LiveAllocation allocation )
+    {
+        Atomic::Decrement( &in_profiler->live_filter[FilterIndex( ptr )] );
+
+        AllocationSiteStats* stats = &in_profiler->sites.all_values.data[allocation.site_index];
+
+        stats->live_count -= allocation.count;
+        stats->live_bytes -= allocation.bytes;
+        in_profiler->live_bytes -= allocation.bytes;
+    }
+
+    static void FormatSite( AllocationSite site, char* out_buffer, size_t size )
+    {
+        if ( site.filepath != nullptr )
+        {
+            snprintf( out_buffer, size, "%s:%zu", site.filepath, site.line_number );
+        }
+        else
+        {
+            snprintf( out_buffer, size, "%p", site.address );
+        }
+    }
+
+    /// <summary>
+    /// Sorts by allocated bytes , or by live bytes for (by_live_bytes) , biggest first
+    /// </summary>
+    static void SortSites( DArray<AllocationSiteStats>* inout_sites, bool by_live_bytes )
+    {
+        AllocationSiteStats* sites = inout_sites->data;
+
+        // insertion sort , there are a few hundred sites at most
+        for ( size_t i = 1; i < inout_sites->size; ++i )
+        {
+            AllocationSiteStats curr = sites[i];
+            size_t key = by_live_bytes ? curr.live_bytes : curr.allocated_bytes;
+            size_t j = i;
+
+            while ( j > 0 && (by_live_bytes ? sites[j - 1].live_bytes : sites[j - 1].allocated_bytes) < key )
+            {
+                sites[j] = sites[j - 1];
+                --j;
+            }
+
+            sites[j] = curr;
+        }
+    }
+};
+
+/// <summary>
+/// <para>Wraps an allocator and reports everything going through it to an AllocationProfiler</para>
+/// <para>Debug builds record from the allocator callbacks to get the file and line , release builds record in the wrapper with the caller's address</para>
+/// <para>NOTE : the returned Allocator points to (out_allocator) , it has to outlive it</para>
+/// </summary>
+struct ProfiledAllocator
+{
+    Allocator inner;
+    AllocationProfiler* profiler;
+    bool track_lifetime;
+
+    static Allocator Create( ProfiledAllocator* out_allocator, Allocator inner, AllocationProfiler* profiler, bool track_lifetime = true )
+    {
+        out_allocator->inner = inner;
+        out_allocator->profiler = profiler;
+        out_allocator->track_lifetime = track_lifetime;
+
+        Allocator alloc = {};
+        alloc.user_data = out_allocator;
+        alloc.alloc = Allocate;
+        alloc.realloc = inner.realloc != nullptr ? Reallocate : nullptr;
+        alloc.free = inner.free != nullptr ? Free : nullptr;
+
+#if _DEBUG
+        alloc.callbacks.alloc_callback = OnAlloc;
+        alloc.callbacks.realloc_callback = OnRealloc;
+        alloc.callbacks.free_callback = OnFree;
+#endif
+
+        return alloc;
+    }
+
+private:
+
+    static void* Allocate( Allocator* alloc, size_t size )
+    {
+        ProfiledAllocator* profiled = (ProfiledAllocator*) alloc->user_data;
+        void* ptr = profiled->inner.alloc( &profiled->inner, size );
+
+#if !_DEBUG
+        AllocationSite site = {};
+        site.address = CALLER_ADDRESS();
+        AllocationProfiler::RecordAlloc( profiled->profiler, ptr, size, site, profiled->track_lifetime );
+#endif
+
+        return ptr;
+    }
+
+    static void* Reallocate( Allocator* alloc, void* ptr, size_t size )
+    {
+        ProfiledAllocator* profiled = (ProfiledAllocator*) alloc->user_data;
+        void* res = profiled->inner.realloc( &profiled->inner, ptr, size );
+
+#if !_DEBUG
+        AllocationSite site = {};
+        site.address = CALLER_ADDRESS();
+        AllocationProfiler::RecordRealloc( profiled->profiler, ptr, res, size, site, profiled->track_lifetime );
+#endif
+
+        return res;
+    }
+
+    static void Free( Allocator* alloc, void* ptr )
+    {
+        ProfiledAllocator* profiled = (ProfiledAllocator*) alloc->user_data;
+        profiled->inner.free( &profiled->inner, ptr );
+
+#if !_DEBUG
+        if ( profiled->track_lifetime )
+        {
+            AllocationProfiler::RecordFree( profiled->profiler, ptr );
+        }
+#endif
+    }
+
+#if _DEBUG
+    static AllocationSite SiteOf( AllocationData data )
+    {
+        AllocationSite site = {};
+        site.filepath = data.filepath.buffer;
+        site.line_number = data.line_number;
+
+        return site;
+    }
+
+    static void OnAlloc( Allocator* alloc, void* ptr, size_t size, AllocationData data )
+    {
+        ProfiledAllocator* profiled = (ProfiledAllocator*) alloc->user_data;
+        AllocationProfiler::RecordAlloc( profiled->profiler, ptr, size, SiteOf( data ), profiled->track_lifetime );
+    }
+
+    static void OnRealloc( Allocator* alloc, void* old_ptr, void* new_ptr, size_t size, AllocationData data )
+    {
+        ProfiledAllocator* profiled = (ProfiledAllocator*) alloc->user_data;
+        AllocationProfiler::RecordRealloc( profiled->profiler, old_ptr, new_ptr, size, SiteOf( data ), profiled->track_lifetime );
+    }
+
+    static void OnFree( Allocator* alloc, void* ptr, AllocationData )
+    {
+        ProfiledAllocator* profiled = (ProfiledAllocator*) alloc->user_data;
+
+        if ( profiled->track_lifetime )
+        {
+            AllocationProfiler::RecordFree( profiled->profiler, ptr );
+        }
+    }
+#endif
+};
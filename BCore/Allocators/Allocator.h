@@ -1,8 +1,13 @@
 #pragma once
 #include <malloc.h>
 #include <cstdint>
-#include <crtdbg.h>
 #include <assert.h>
+#ifdef _WIN32
+#include <crtdbg.h>
+#else
+#include <alloca.h>
+#define _alloca alloca
+#endif
 #include "../Context/CoreContext.h"
 #include "../String/StringView.h"
 struct Allocator;
@@ -18,8 +23,12 @@ typedef void* (*Alloc)(Allocator*, size_t);
 typedef void* (*Realloc)(Allocator*, void*, size_t);
 typedef void (*Free)(Allocator*, void*);
 
-typedef void* (*AllocCallback)(Allocator*, size_t , AllocationData);
-typedef void* (*ReallocCallback)(Allocator*, void*, size_t, AllocationData);
+/// <summary>
+/// <para>Called after the allocation with the pointer that was returned</para>
+/// <para>NOTE : only called by the ALLOC/REALLOC/FREE macros in debug builds</para>
+/// </summary>
+typedef void (*AllocCallback)(Allocator*, void* , size_t , AllocationData);
+typedef void (*ReallocCallback)(Allocator*, void* old_ptr, void* new_ptr, size_t, AllocationData);
 typedef void (*FreeCallback)(Allocator*, void*, AllocationData);
 
 struct AllocatorCallback
@@ -41,17 +50,118 @@ struct Allocator
     Free free;
 };
 
+#if _DEBUG
+
+/// <summary>
+/// What the ALLOC/REALLOC/FREE macros expand to in debug builds , calls the allocator then its callbacks with the call site
+/// </summary>
+struct AllocationTracking
+{
+    static inline void* Alloc( Allocator& allocator, size_t size, const char* filepath, size_t line_number, void* user_data )
+    {
+        void* ptr = allocator.alloc( &allocator, size );
+
+        if ( allocator.callbacks.alloc_callback )
+        {
+            allocator.callbacks.alloc_callback( &allocator, ptr, size, MakeData( filepath, line_number, user_data ) );
+        }
+
+        return ptr;
+    }
+
+    static inline void* Realloc( Allocator& allocator, void* ptr, size_t size, const char* filepath, size_t line_number )
+    {
+        void* res = allocator.realloc( &allocator, ptr, size );
+
+        if ( allocator.callbacks.realloc_callback )
+        {
+            allocator.callbacks.realloc_callback( &allocator, ptr, res, size, MakeData( filepath, line_number, nullptr ) );
+        }
+
+        return res;
+    }
+
+    static inline void Free( Allocator& allocator, void* ptr, const char* filepath, size_t line_number )
+    {
+        if ( allocator.free == nullptr )
+        {
+            return;
+        }
+
+        allocator.free( &allocator, ptr );
+
+        if ( allocator.callbacks.free_callback )
+        {
+            allocator.callbacks.free_callback( &allocator, ptr, MakeData( filepath, line_number, nullptr ) );
+        }
+    }
+
+private:
+    static inline AllocationData MakeData( const char* filepath, size_t line_number, void* user_data )
+    {
+        AllocationData data = {};
+        data.filepath = filepath;
+        data.line_number = line_number;
+        data.user_data = user_data;
+
+        return data;
+    }
+};
+
+#endif
+
+/// <summary>
+/// <para>Header placed at the start of every block an arena chains once its current block is full</para>
+/// <para>It keeps the block the arena was on before , so that rewinding can walk back to it</para>
+/// </summary>
+struct ArenaBlock
+{
+    ArenaBlock* prev;
+    void* prev_data;
+    size_t prev_capacity;
+    size_t prev_offset;
+    size_t size;
+};
+
+/// <summary>
+/// <para>Linear allocator , "data/capacity/offset" always describe the block currently allocated from</para>
+/// <para>An arena with a "block_size" (the ones made with "Create") chains a new heap block when it runs out instead of asserting</para>
+/// <para>Arenas filled by hand (over a stack buffer for example) keep "block_size" at 0 and stay fixed size</para>
+/// </summary>
 struct Arena
 {
+    static constexpr size_t DEFAULT_ALIGNMENT = 16;
+
     void* data;
     size_t capacity;
     size_t offset;
 
+    /// <summary>
+    /// Minimum size of the chained blocks , 0 means the arena can't grow
+    /// </summary>
+    size_t block_size;
+
+    /// <summary>
+    /// Last chained block , nullptr while still on the first block
+    /// </summary>
+    ArenaBlock* chain;
+
+    /// <summary>
+    /// Block released by the last rewind , kept around so that a spike every frame doesn't hit the heap every frame
+    /// </summary>
+    ArenaBlock* spare;
+
+    /// <summary>
+    /// Start of the last allocation , the only one that can be grown in place or given back
+    /// </summary>
+    void* last_allocation;
+
     static Arena Create( size_t capacity, bool init = true )
     {
         Arena res = {};
         res.data = CoreContext::malloc( capacity );
         res.capacity = capacity;
+        res.block_size = capacity;
 
         if ( init )
         {
@@ -61,6 +171,23 @@ struct Arena
         return res;
     }
 
+    /// <summary>
+    /// Frees the chained blocks and the first block , only for arenas made with "Create"
+    /// </summary>
+    static void Destroy( Arena* arena )
+    {
+        Reset( arena );
+
+        if ( arena->spare )
+        {
+            CoreContext::free( arena->spare );
+        }
+
+        CoreContext::free( arena->data );
+
+        *arena = {};
+    }
+
     static Arena CreateSubArena( Arena* source )
     {
         Arena sub = {};
@@ -73,16 +200,210 @@ struct Arena
 
     static void Reset( Arena* arena )
     {
+        while ( arena->chain )
+        {
+            PopBlock( arena );
+        }
+
         arena->offset = 0;
+        arena->last_allocation = nullptr;
     }
+
+    /// <summary>
+    /// Returns (size) bytes aligned on (alignment) , which has to be a power of two
+    /// </summary>
+    static void* Push( Arena* arena, size_t size, size_t alignment = DEFAULT_ALIGNMENT )
+    {
+        assert( (alignment & (alignment - 1)) == 0 );
+
+        size_t start = AlignedOffset( arena, alignment );
+
+        if ( start + size > arena->capacity )
+        {
+            assert( arena->block_size != 0 && "Arena is out of memory and can't grow" );
+
+            PushBlock( arena, size + alignment );
+            start = AlignedOffset( arena, alignment );
+        }
+
+        void* ptr = (void*) ((char*) arena->data + start);
+
+        arena->offset = start + size;
+        arena->last_allocation = ptr;
+
+        return ptr;
+    }
+
+    /// <summary>
+    /// <para>Grows or shrinks in place when (ptr) is the last allocation and the block has room , otherwise moves it</para>
+    /// <para>NOTE : the arena doesn't know the size of older allocations , a move copies up to the end of what was used in their block</para>
+    /// </summary>
+    static void* Resize( Arena* arena, void* ptr, size_t size, size_t alignment = DEFAULT_ALIGNMENT )
+    {
+        if ( ptr == nullptr )
+        {
+            return Push( arena, size, alignment );
+        }
+
+        size_t ptr_offset = (size_t) ((char*) ptr - (char*) arena->data);
+
+        if ( ptr == arena->last_allocation && ptr_offset + size <= arena->capacity )
+        {
+            arena->offset = ptr_offset + size;
+            return ptr;
+        }
+
+        size_t used = UsedAfter( arena, ptr );
+        void* res = Push( arena, size, alignment );
+
+        CoreContext::mem_copy( ptr, res, used < size ? used : size );
+
+        return res;
+    }
+
+    /// <summary>
+    /// Gives the memory back when (ptr) is the last allocation , does nothing otherwise
+    /// </summary>
+    static void Pop( Arena* arena, void* ptr )
+    {
+        if ( ptr != nullptr && ptr == arena->last_allocation )
+        {
+            arena->offset = (size_t) ((char*) ptr - (char*) arena->data);
+            arena->last_allocation = nullptr;
+        }
+    }
+
+private:
+
+    static size_t AlignedOffset( Arena* arena, size_t alignment )
+    {
+        uintptr_t address = (uintptr_t) arena->data + arena->offset;
+        uintptr_t aligned = (address + (alignment - 1)) & ~((uintptr_t) alignment - 1);
+
+        return arena->offset + (size_t) (aligned - address);
+    }
+
+    static void PushBlock( Arena* arena, size_t min_capacity )
+    {
+        ArenaBlock* block = nullptr;
+
+        if ( arena->spare && arena->spare->size - sizeof( ArenaBlock ) >= min_capacity )
+        {
+            block = arena->spare;
+            arena->spare = nullptr;
+        }
+        else
+        {
+            size_t capacity = arena->block_size > min_capacity ? arena->block_size : min_capacity;
+
+            block = (ArenaBlock*) CoreContext::malloc( sizeof( ArenaBlock ) + capacity );
+            block->size = sizeof( ArenaBlock ) + capacity;
+        }
+
+        block->prev = arena->chain;
+        block->prev_data = arena->data;
+        block->prev_capacity = arena->capacity;
+        block->prev_offset = arena->offset;
+
+        arena->chain = block;
+        arena->data = (void*) (block + 1);
+        arena->capacity = block->size - sizeof( ArenaBlock );
+        arena->offset = 0;
+    }
+
+    static void PopBlock( Arena* arena )
+    {
+        ArenaBlock* block = arena->chain;
+
+        arena->chain = block->prev;
+        arena->data = block->prev_data;
+        arena->capacity = block->prev_capacity;
+        arena->offset = block->prev_offset;
+
+        // keep the biggest block as the spare
+        if ( arena->spare == nullptr || arena->spare->size < block->size )
+        {
+            if ( arena->spare )
+            {
+                CoreContext::free( arena->spare );
+            }
+
+            arena->spare = block;
+        }
+        else
+        {
+            CoreContext::free( block );
+        }
+    }
+
+    /// <summary>
+    /// Bytes between (ptr) and the end of the used part of the block it lives in
+    /// </summary>
+    static size_t UsedAfter( Arena* arena, void* ptr )
+    {
+        char* data = (char*) arena->data;
+        size_t offset = arena->offset;
+        ArenaBlock* block = arena->chain;
+
+        while ( (char*) ptr < data || (char*) ptr >= data + offset )
+        {
+            // not in any block , nothing we can safely copy
+            if ( block == nullptr )
+            {
+                return 0;
+            }
+
+            data = (char*) block->prev_data;
+            offset = block->prev_offset;
+            block = block->prev;
+        }
+
+        return (size_t) (data + offset - (char*) ptr);
+    }
+
+    friend struct ArenaCheckpoint;
 };
 
+/// <summary>
+/// <para>Position in an arena to come back to , checkpoints nest like scopes as long as they are rewound in reverse order</para>
+/// <para>Rewinding releases the blocks chained after the checkpoint was taken</para>
+/// </summary>
 struct ArenaCheckpoint
 {
     Arena *arena;
+    void* block_data;
     size_t start_offset;
+
+    static ArenaCheckpoint Create( Arena* arena )
+    {
+        ArenaCheckpoint res = {};
+        res.arena = arena;
+        res.block_data = arena->data;
+        res.start_offset = arena->offset;
+
+        return res;
+    }
+
+    static void Rewind( ArenaCheckpoint* checkpoint )
+    {
+        Arena* arena = checkpoint->arena;
+
+        while ( arena->data != checkpoint->block_data && arena->chain )
+        {
+            Arena::PopBlock( arena );
+        }
+
+        assert( arena->data == checkpoint->block_data );
+
+        arena->offset = checkpoint->start_offset;
+        arena->last_allocation = nullptr;
+    }
 };
 
+/// <summary>
+/// <para>Allocator over an arena , allocations are aligned on Arena::DEFAULT_ALIGNMENT</para>
+/// <para>Realloc extends the last allocation in place when it can and free only gives back the last allocation , the rest is released by rewinding</para>
+/// </summary>
 struct ArenaAllocator
 {
 public:
@@ -91,8 +412,8 @@ public:
         Allocator alloc = {};
         alloc.user_data = arena;
         alloc.alloc = Allocate;
-        alloc.realloc = nullptr;
-        alloc.free = nullptr;
+        alloc.realloc = Reallocate;
+        alloc.free = Free;
 
         return alloc;
     }
@@ -100,34 +421,19 @@ public:
 
 private:
 
-    static void* NextPowerOfTwo( void* ptr, size_t size )
+    static void* Allocate( Allocator* alloc, size_t size )
     {
-        int64_t ptr_num = (int64_t) ptr;
-
-        ptr_num += size;
-
-        const size_t mask = 0b11;
-        const size_t stride = 4;
-
-        size_t res = ptr_num & mask;
-
-        ptr_num += ((size_t) (res != 0)) * stride;
-
-        return (void*) ptr_num;
+        return Arena::Push( (Arena*) alloc->user_data, size );
     }
 
-
-    static void* Allocate( Allocator* alloc, size_t size )
+    static void* Reallocate( Allocator* alloc, void* ptr, size_t size )
     {
-        Arena* arena = (Arena*) alloc->user_data;
-
-        assert( (arena->offset + size) < arena->capacity );
-
-        void* ptr = (void*) ((char*) arena->data + arena->offset);
-
-        arena->offset += size;
+        return Arena::Resize( (Arena*) alloc->user_data, ptr, size );
+    }
 
-        return ptr;
+    static void Free( Allocator* alloc, void* ptr )
+    {
+        Arena::Pop( (Arena*) alloc->user_data, ptr );
     }
 
 };
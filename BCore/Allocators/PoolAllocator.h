@@ -0,0 +1,605 @@
+#pragma once
+#include <stdint.h>
+#include <assert.h>
+#include "Allocator.h"
+#include "../Context/CoreContext.h"
+#include "../Atomic/Atomic.h"
+#include "../Atomic/AtomicLock.h"
+#include "../Containers/HMap.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <sys/mman.h>
+#endif
+
+/// <summary>
+/// Snapshot of a Pool's counters , see Pool::GetStats
+/// </summary>
+struct PoolStats
+{
+    static const size_t CLASS_COUNT = 8;
+
+    size_t reserved_bytes;
+    size_t committed_bytes;
+
+    /// <summary>
+    /// Bytes handed out from the size classes (rounded up to the class size)
+    /// </summary>
+    size_t live_bytes;
+    size_t peak_live_bytes;
+
+    size_t allocation_count;
+    size_t free_count;
+
+    /// <summary>
+    /// Allocations bigger than the biggest size class that went straight to CoreContext::malloc and are still alive
+    /// </summary>
+    size_t large_allocation_count;
+
+    size_t live_blocks[CLASS_COUNT];
+};
+
+/// <summary>
+/// <para>Memory behind a PoolAllocator , a segregated-fit allocator for small objects</para>
+/// <para>Sizes are rounded up to power of two classes (16 to 2048 bytes) , each class is carved out of 64KB slabs committed from one big range of reserved OS pages</para>
+/// <para>Every thread keeps a small cache of free blocks per class , the shared depot (behind a lock) is only touched once every BATCH_SIZE allocations or frees</para>
+/// <para>Anything bigger than MAX_CLASS_SIZE , or anything once the reserved range is full , goes to CoreContext::malloc</para>
+/// <para>Each live pool owns one of the MAX_POOLS thread cache slots , a pool created while they are all taken reserves nothing and sends everything to CoreContext::malloc</para>
+/// <para>NOTE : the blocks cached by a thread that exits are only given back when the pool is destroyed , call FlushThreadCache before exiting long-lived worker threads</para>
+/// </summary>
+struct Pool
+{
+    static const size_t CLASS_COUNT = PoolStats::CLASS_COUNT;
+    static const size_t MIN_CLASS_SHIFT = 4;
+    static const size_t MAX_CLASS_SIZE = (size_t) 1 << (MIN_CLASS_SHIFT + CLASS_COUNT - 1);
+    static const size_t SLAB_SIZE = 64 * 1'024;
+    static const size_t BATCH_SIZE = 32;
+    static const size_t MAX_POOLS = 16;
+    static const size_t DEFAULT_RESERVE_SIZE = 256 * 1'024 * 1'024;
+
+    char* base;
+    size_t reserve_size;
+
+    /// <summary>
+    /// Size class of each slab in the reserved range
+    /// </summary>
+    uint8_t* slab_classes;
+    size_t slab_capacity;
+    size_t committed_slabs;
+
+    /// <summary>
+    /// Free blocks shared between the threads , one intrusive list per class
+    /// </summary>
+    void* depot[CLASS_COUNT];
+    AtomicLock depot_lock;
+
+    /// <summary>
+    /// Index of the thread cache used for this pool and its generation , the generation changes every time a pool is created so stale caches get dropped
+    /// </summary>
+    size_t cache_index;
+    int64_t generation;
+
+    /// <summary>
+    /// Blocks handed out by AllocateLarge to their size , so that heap pointers freed through the pool aren't counted as large blocks
+    /// </summary>
+    HMap<void*, size_t> large_blocks;
+    AtomicLock large_lock;
+
+    volatile int64_t live_bytes;
+    volatile int64_t peak_live_bytes;
+    volatile int64_t allocation_count;
+    volatile int64_t free_count;
+    volatile int64_t large_allocation_count;
+    volatile int64_t live_blocks[CLASS_COUNT];
+
+    static void Create( Pool* out_pool, size_t reserve_size = DEFAULT_RESERVE_SIZE )
+    {
+        *out_pool = {};
+
+        int64_t generation = Atomic::Add( &next_generation, 1 ) + 1;
+        out_pool->generation = generation;
+        out_pool->cache_index = NO_CACHE;
+
+        HMap<void*, size_t>::Create( &out_pool->large_blocks, HeapAllocator::Create(), 16 );
+
+        // two live pools never share a slot , a thread switching between them would have to drop one's cached blocks
+        for ( size_t i = 0; i < MAX_POOLS; ++i )
+        {
+            if ( Atomic::CompareExchange( &cache_owners[i], generation, 0 ) == 0 )
+            {
+                out_pool->cache_index = i;
+                break;
+            }
+        }
+
+        // too many live pools , this one goes straight to the heap
+        if ( out_pool->cache_index == NO_CACHE )
+        {
+            reserve_size = 0;
+        }
+
+        out_pool->reserve_size = ((reserve_size + SLAB_SIZE - 1) / SLAB_SIZE) * SLAB_SIZE;
+        out_pool->slab_capacity = out_pool->reserve_size / SLAB_SIZE;
+        out_pool->base = out_pool->reserve_size != 0 ? (char*) Reserve( out_pool->reserve_size ) : nullptr;
+
+        // no address space left , every allocation will go to CoreContext::malloc
+        if ( out_pool->base == nullptr )
+        {
+            out_pool->reserve_size = 0;
+            out_pool->slab_capacity = 0;
+        }
+
+        out_pool->slab_classes = (uint8_t*) CoreContext::malloc( out_pool->slab_capacity + 1 );
+    }
+
+    /// <summary>
+    /// Releases all the pages at once , the blocks don't need to be freed one by one
+    /// </summary>
+    static void Destroy( Pool* inout_pool )
+    {
+        if ( inout_pool->base != nullptr )
+        {
+            Release( inout_pool->base, inout_pool->reserve_size );
+        }
+
+        CoreContext::free( inout_pool->slab_classes );
+        HMap<void*, size_t>::Destroy( &inout_pool->large_blocks );
+
+        if ( inout_pool->cache_index != NO_CACHE )
+        {
+            Atomic::Store( &cache_owners[inout_pool->cache_index], 0 );
+        }
+
+        *inout_pool = {};
+    }
+
+    /// <summary>
+    /// <para>Gives the calling thread's cached blocks back to the depot and publishes its pending stats</para>
+    /// <para>The stats are otherwise only published when a thread goes to the depot , so they can lag behind by a few blocks per thread</para>
+    /// </summary>
+    static void FlushThreadCache( Pool* in_pool )
+    {
+        // nothing reserved , nothing cached
+        if ( in_pool->base == nullptr )
+        {
+            return;
+        }
+
+        ThreadCache* cache = GetCache( in_pool );
+
+        in_pool->depot_lock.Lock();
+
+        for ( size_t i = 0; i < CLASS_COUNT; ++i )
+        {
+            while ( cache->heads[i] != nullptr )
+            {
+                void* block = cache->heads[i];
+                cache->heads[i] = *(void**) block;
+
+                *(void**) block = in_pool->depot[i];
+                in_pool->depot[i] = block;
+            }
+
+            cache->counts[i] = 0;
+        }
+
+        in_pool->depot_lock.Unlock();
+
+        FlushStats( in_pool, cache );
+    }
+
+    static PoolStats GetStats( Pool* in_pool )
+    {
+        PoolStats stats = {};
+        stats.reserved_bytes = in_pool->reserve_size;
+
+        in_pool->depot_lock.Lock();
+        stats.committed_bytes = in_pool->committed_slabs * SLAB_SIZE;
+        in_pool->depot_lock.Unlock();
+
+        stats.live_bytes = (size_t) Atomic::Load( &in_pool->live_bytes );
+        stats.peak_live_bytes = (size_t) Atomic::Load( &in_pool->peak_live_bytes );
+        stats.allocation_count = (size_t) Atomic::Load( &in_pool->allocation_count );
+        stats.free_count = (size_t) Atomic::Load( &in_pool->free_count );
+        stats.large_allocation_count = (size_t) Atomic::Load( &in_pool->large_allocation_count );
+
+        for ( size_t i = 0; i < CLASS_COUNT; ++i )
+        {
+            stats.live_blocks[i] = (size_t) Atomic::Load( &in_pool->live_blocks[i] );
+        }
+
+        return stats;
+    }
+
+    static inline size_t ClassSize( size_t class_index )
+    {
+        return (size_t) 1 << (MIN_CLASS_SHIFT + class_index);
+    }
+
+    static inline size_t ClassIndex( size_t size )
+    {
+        if ( size <= ClassSize( 0 ) )
+        {
+            return 0;
+        }
+
+        // index of the highest bit of (size - 1) gives the next power of two
+#ifdef _MSC_VER
+        unsigned long high_bit = 0;
+        _BitScanReverse64( &high_bit, (unsigned long long) (size - 1) );
+        return (size_t) high_bit + 1 - MIN_CLASS_SHIFT;
+#else
+        return (size_t) (64 - __builtin_clzll( (unsigned long long) (size - 1) )) - MIN_CLASS_SHIFT;
+#endif
+    }
+
+    static inline bool Owns( Pool* in_pool, void* ptr )
+    {
+        // NOTE : only committed slabs are ever handed out , so checking against the whole reserved range is enough
+        return (char*) ptr >= in_pool->base && (size_t) ((char*) ptr - in_pool->base) < in_pool->reserve_size;
+    }
+
+    static inline size_t ClassOf( Pool* in_pool, void* ptr )
+    {
+        return in_pool->slab_classes[(size_t) ((char*) ptr - in_pool->base) / SLAB_SIZE];
+    }
+
+private:
+
+    friend struct PoolAllocator;
+
+    struct ThreadCache
+    {
+        Pool* owner;
+        int64_t generation;
+
+        void* heads[CLASS_COUNT];
+        size_t counts[CLASS_COUNT];
+
+        // stats not published yet
+        int64_t pending_blocks[CLASS_COUNT];
+        int64_t pending_allocations;
+        int64_t pending_frees;
+    };
+
+    static const size_t NO_CACHE = (size_t) -1;
+
+    static inline volatile int64_t next_generation = 0;
+
+    /// <summary>
+    /// Generation of the live pool using each slot , 0 when free
+    /// </summary>
+    static inline volatile int64_t cache_owners[MAX_POOLS] = {};
+    static inline thread_local ThreadCache thread_caches[MAX_POOLS] = {};
+
+    static inline ThreadCache* GetCache( Pool* in_pool )
+    {
+        ThreadCache* cache = &thread_caches[in_pool->cache_index];
+
+        // the slot belonged to a destroyed pool , its blocks went away with that pool's pages
+        if ( cache->owner != in_pool || cache->generation != in_pool->generation )
+        {
+            *cache = {};
+            cache->owner = in_pool;
+            cache->generation = in_pool->generation;
+        }
+
+        return cache;
+    }
+
+    static void FlushStats( Pool* in_pool, ThreadCache* cache )
+    {
+        int64_t bytes = 0;
+
+        for ( size_t i = 0; i < CLASS_COUNT; ++i )
+        {
+            if ( cache->pending_blocks[i] != 0 )
+            {
+                Atomic::Add( &in_pool->live_blocks[i], cache->pending_blocks[i] );
+                bytes += cache->pending_blocks[i] * (int64_t) ClassSize( i );
+                cache->pending_blocks[i] = 0;
+            }
+        }
+
+        Atomic::Add( &in_pool->allocation_count, cache->pending_allocations );
+        Atomic::Add( &in_pool->free_count, cache->pending_frees );
+        cache->pending_allocations = 0;
+        cache->pending_frees = 0;
+
+        int64_t live = Atomic::Add( &in_pool->live_bytes, bytes ) + bytes;
+        int64_t peak = Atomic::Load( &in_pool->peak_live_bytes );
+
+        while ( live > peak )
+        {
+            int64_t prev = Atomic::CompareExchange( &in_pool->peak_live_bytes, live, peak );
+
+            if ( prev == peak )
+            {
+                break;
+            }
+
+            peak = prev;
+        }
+    }
+
+    /// <summary>
+    /// Moves up to BATCH_SIZE blocks from the depot to the thread cache , carving a new slab if the depot is empty
+    /// </summary>
+    static void Refill( Pool* in_pool, ThreadCache* cache, size_t class_index )
+    {
+        in_pool->depot_lock.Lock();
+
+        if ( in_pool->depot[class_index] == nullptr && in_pool->committed_slabs < in_pool->slab_capacity )
+        {
+            char* slab = in_pool->base + (in_pool->committed_slabs * SLAB_SIZE);
+
+            if ( Commit( slab, SLAB_SIZE ) )
+            {
+                in_pool->slab_classes[in_pool->committed_slabs] = (uint8_t) class_index;
+                in_pool->committed_slabs++;
+
+                // chain the blocks in address order so that the first allocations are contiguous
+                const size_t block_size = ClassSize( class_index );
+                const size_t block_count = SLAB_SIZE / block_size;
+
+                for ( size_t i = block_count; i > 0; --i )
+                {
+                    void* block = slab + ((i - 1) * block_size);
+                    *(void**) block = in_pool->depot[class_index];
+                    in_pool->depot[class_index] = block;
+                }
+            }
+        }
+
+        // move the first blocks of the depot as a whole chain to keep their order
+        void* first = in_pool->depot[class_index];
+
+        if ( first != nullptr )
+        {
+            void* last = first;
+            size_t moved = 1;
+
+            while ( moved < BATCH_SIZE && *(void**) last != nullptr )
+            {
+                last = *(void**) last;
+                moved++;
+            }
+
+            in_pool->depot[class_index] = *(void**) last;
+
+            *(void**) last = cache->heads[class_index];
+            cache->heads[class_index] = first;
+            cache->counts[class_index] += moved;
+        }
+
+        in_pool->depot_lock.Unlock();
+
+        FlushStats( in_pool, cache );
+    }
+
+    /// <summary>
+    /// Gives BATCH_SIZE blocks back to the depot when a thread frees much more than it allocates
+    /// </summary>
+    static void Drain( Pool* in_pool, ThreadCache* cache, size_t class_index )
+    {
+        in_pool->depot_lock.Lock();
+
+        for ( size_t i = 0; i < BATCH_SIZE; ++i )
+        {
+            void* block = cache->heads[class_index];
+            cache->heads[class_index] = *(void**) block;
+            cache->counts[class_index]--;
+
+            *(void**) block = in_pool->depot[class_index];
+            in_pool->depot[class_index] = block;
+        }
+
+        in_pool->depot_lock.Unlock();
+
+        FlushStats( in_pool, cache );
+    }
+
+    static void* Reserve( size_t size )
+    {
+#ifdef _WIN32
+        return VirtualAlloc( nullptr, size, MEM_RESERVE, PAGE_NOACCESS );
+#else
+        void* ptr = mmap( nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+
+        if ( ptr == MAP_FAILED )
+        {
+            return nullptr;
+        }
+
+#ifdef MADV_HUGEPAGE
+        // hint that the range can be backed by huge pages , fewer TLB misses when walking the slabs
+        madvise( ptr, size, MADV_HUGEPAGE );
+#endif
+        return ptr;
+#endif
+    }
+
+    static bool Commit( void* ptr, size_t size )
+    {
+#ifdef _WIN32
+        return VirtualAlloc( ptr, size, MEM_COMMIT, PAGE_READWRITE ) != nullptr;
+#else
+        return mprotect( ptr, size, PROT_READ | PROT_WRITE ) == 0;
+#endif
+    }
+
+    static void Release( void* ptr, size_t size )
+    {
+#ifdef _WIN32
+        VirtualFree( ptr, 0, MEM_RELEASE );
+#else
+        munmap( ptr, size );
+#endif
+    }
+};
+
+/// <summary>
+/// <para>Allocator using a Pool , meant as a drop-in replacement for HeapAllocator for small objects</para>
+/// <para>Pointers that don't belong to the pool are forwarded to CoreContext::free / CoreContext::realloc , so memory coming from the heap can be freed through it</para>
+/// </summary>
+struct PoolAllocator
+{
+public:
+    static Allocator Create( Pool* pool )
+    {
+        Allocator alloc = {};
+        alloc.user_data = pool;
+        alloc.alloc = Allocate;
+        alloc.realloc = Reallocate;
+        alloc.free = Free;
+
+        return alloc;
+    }
+
+private:
+
+    static void* AllocateLarge( Pool* pool, size_t size )
+    {
+        void* ptr = CoreContext::malloc( size );
+        TrackLarge( pool, ptr, size );
+
+        return ptr;
+    }
+
+    static void TrackLarge( Pool* pool, void* ptr, size_t size )
+    {
+        if ( ptr == nullptr )
+        {
+            return;
+        }
+
+        pool->large_lock.Lock();
+        HMap<void*, size_t>::TryAdd( &pool->large_blocks, ptr, size, nullptr );
+        pool->large_lock.Unlock();
+
+        Atomic::Add( &pool->large_allocation_count, 1 );
+    }
+
+    /// <summary>
+    /// False for heap memory that didn't come from AllocateLarge
+    /// </summary>
+    static bool ForgetLarge( Pool* pool, void* ptr )
+    {
+        size_t size = 0;
+
+        pool->large_lock.Lock();
+        bool is_large = HMap<void*, size_t>::TryRemove( &pool->large_blocks, ptr, &size );
+        pool->large_lock.Unlock();
+
+        if ( is_large )
+        {
+            Atomic::Add( &pool->large_allocation_count, -1 );
+        }
+
+        return is_large;
+    }
+
+    static void* Allocate( Allocator* alloc, size_t size )
+    {
+        Pool* pool = (Pool*) alloc->user_data;
+
+        if ( size > Pool::MAX_CLASS_SIZE || pool->base == nullptr )
+        {
+            return AllocateLarge( pool, size );
+        }
+
+        size_t class_index = Pool::ClassIndex( size );
+        Pool::ThreadCache* cache = Pool::GetCache( pool );
+
+        if ( cache->heads[class_index] == nullptr )
+        {
+            Pool::Refill( pool, cache, class_index );
+
+            // the reserved range is full
+            if ( cache->heads[class_index] == nullptr )
+            {
+                return AllocateLarge( pool, size );
+            }
+        }
+
+        void* block = cache->heads[class_index];
+        cache->heads[class_index] = *(void**) block;
+        cache->counts[class_index]--;
+
+        cache->pending_blocks[class_index]++;
+        cache->pending_allocations++;
+
+        return block;
+    }
+
+    static void Free( Allocator* alloc, void* ptr )
+    {
+        Pool* pool = (Pool*) alloc->user_data;
+
+        if ( ptr == nullptr )
+        {
+            return;
+        }
+
+        if ( !Pool::Owns( pool, ptr ) )
+        {
+            ForgetLarge( pool, ptr );
+            CoreContext::free( ptr );
+            return;
+        }
+
+        size_t class_index = Pool::ClassOf( pool, ptr );
+        Pool::ThreadCache* cache = Pool::GetCache( pool );
+
+        *(void**) ptr = cache->heads[class_index];
+        cache->heads[class_index] = ptr;
+        cache->counts[class_index]++;
+
+        cache->pending_blocks[class_index]--;
+        cache->pending_frees++;
+
+        if ( cache->counts[class_index] >= Pool::BATCH_SIZE * 2 )
+        {
+            Pool::Drain( pool, cache, class_index );
+        }
+    }
+
+    static void* Reallocate( Allocator* alloc, void* ptr, size_t size )
+    {
+        Pool* pool = (Pool*) alloc->user_data;
+
+        if ( ptr == nullptr )
+        {
+            return Allocate( alloc, size );
+        }
+
+        // the size of heap blocks isn't known , they stay on the heap
+        if ( !Pool::Owns( pool, ptr ) )
+        {
+            void* new_ptr = CoreContext::realloc( ptr, size );
+
+            if ( new_ptr != nullptr && ForgetLarge( pool, ptr ) )
+            {
+                TrackLarge( pool, new_ptr, size );
+            }
+
+            return new_ptr;
+        }
+
+        size_t block_size = Pool::ClassSize( Pool::ClassOf( pool, ptr ) );
+
+        // still fits in the same block
+        if ( size <= block_size )
+        {
+            return ptr;
+        }
+
+        void* new_ptr = Allocate( alloc, size );
+        CoreContext::mem_copy( ptr, new_ptr, block_size );
+        Free( alloc, ptr );
+
+        return new_ptr;
+    }
+};
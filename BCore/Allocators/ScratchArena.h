@@ -0,0 +1,73 @@
+#pragma once
+#include "Allocator.h"
+
+/// <summary>
+/// <para>Per-thread arenas for short lived temporary memory (formatting , logging , building small lists ...)</para>
+/// <para>"Get" hands out one of the calling thread's arenas with a checkpoint , "Release" rewinds to it , pair them with DEFER</para>
+/// <para>A function that returns memory from an allocator it was given while also using scratch memory passes that allocator as the conflict ,
+/// so it gets the other arena and doesn't rewind the memory it's returning</para>
+/// <para>NOTE : threads that used scratch memory should call "ReleaseThread" before exiting , the arenas are only freed then</para>
+/// </summary>
+struct ScratchArena
+{
+    static constexpr size_t ARENA_COUNT = 2;
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    Arena* arena;
+    ArenaCheckpoint checkpoint;
+    Allocator alloc;
+
+    static ScratchArena Get( Arena* conflict = nullptr )
+    {
+        Arena* picked = nullptr;
+
+        for ( size_t i = 0; i < ARENA_COUNT; ++i )
+        {
+            if ( &thread_arenas[i] != conflict )
+            {
+                picked = &thread_arenas[i];
+                break;
+            }
+        }
+
+        // first use on this thread
+        if ( picked->data == nullptr )
+        {
+            *picked = Arena::Create( BLOCK_SIZE, false );
+        }
+
+        ScratchArena res = {};
+        res.arena = picked;
+        res.checkpoint = ArenaCheckpoint::Create( picked );
+        res.alloc = ArenaAllocator::Create( picked );
+
+        return res;
+    }
+
+    /// <summary>
+    /// Same as above with the allocator the caller's result goes to , it only conflicts if it's an arena allocator over a scratch arena
+    /// </summary>
+    static ScratchArena Get( Allocator conflict )
+    {
+        return Get( (Arena*) conflict.user_data );
+    }
+
+    static void Release( ScratchArena* scratch )
+    {
+        ArenaCheckpoint::Rewind( &scratch->checkpoint );
+    }
+
+    static void ReleaseThread()
+    {
+        for ( size_t i = 0; i < ARENA_COUNT; ++i )
+        {
+            if ( thread_arenas[i].data != nullptr )
+            {
+                Arena::Destroy( &thread_arenas[i] );
+            }
+        }
+    }
+
+private:
+    static inline thread_local Arena thread_arenas[ARENA_COUNT];
+};
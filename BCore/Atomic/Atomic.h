@@ -0,0 +1,198 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <intrin.h>
+#else
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#endif
+
+/// <summary>
+/// <para>Thin layer over the platform's atomic operations , picked at compile time</para>
+/// <para>Win32 uses the Interlocked intrinsics , everything else uses the GCC/Clang __atomic builtins (the same codegen std::atomic produces)</para>
+/// <para>Works on plain (volatile) integers so the structs using it can still be zero-initialized and copied with "= {}"</para>
+/// <para>NOTE : Exchange , CompareExchange , Increment and Decrement are full barriers , Load is an acquire and Store a release</para>
+/// </summary>
+struct Atomic
+{
+#ifdef _WIN32
+
+    static inline int32_t Load(volatile int32_t* ptr)
+    {
+        int32_t val = *ptr;
+        _ReadWriteBarrier();
+        return val;
+    }
+
+    static inline int64_t Load(volatile int64_t* ptr)
+    {
+        int64_t val = *ptr;
+        _ReadWriteBarrier();
+        return val;
+    }
+
+    static inline void Store(volatile int32_t* ptr, int32_t value)
+    {
+        _ReadWriteBarrier();
+        *ptr = value;
+    }
+
+    static inline void Store(volatile int64_t* ptr, int64_t value)
+    {
+        _ReadWriteBarrier();
+        *ptr = value;
+    }
+
+    static inline int32_t Exchange(volatile int32_t* ptr, int32_t value)
+    {
+        return (int32_t) _InterlockedExchange((volatile long*) ptr, (long) value);
+    }
+
+    static inline int64_t Exchange(volatile int64_t* ptr, int64_t value)
+    {
+        return _InterlockedExchange64((volatile __int64*) ptr, value);
+    }
+
+    /// <summary>
+    /// Sets "ptr" to "desired" if it's equal to "expected" , returns the value that was there before
+    /// </summary>
+    static inline int32_t CompareExchange(volatile int32_t* ptr, int32_t desired, int32_t expected)
+    {
+        return (int32_t) _InterlockedCompareExchange((volatile long*) ptr, (long) desired, (long) expected);
+    }
+
+    static inline int64_t CompareExchange(volatile int64_t* ptr, int64_t desired, int64_t expected)
+    {
+        return _InterlockedCompareExchange64((volatile __int64*) ptr, desired, expected);
+    }
+
+    /// <summary>
+    /// Returns the incremented value
+    /// </summary>
+    static inline int32_t Increment(volatile int32_t* ptr)
+    {
+        return (int32_t) _InterlockedIncrement((volatile long*) ptr);
+    }
+
+    /// <summary>
+    /// Returns the decremented value
+    /// </summary>
+    static inline int32_t Decrement(volatile int32_t* ptr)
+    {
+        return (int32_t) _InterlockedDecrement((volatile long*) ptr);
+    }
+
+    /// <summary>
+    /// Returns the value before the addition
+    /// </summary>
+    static inline int64_t Add(volatile int64_t* ptr, int64_t value)
+    {
+        return _InterlockedExchangeAdd64((volatile __int64*) ptr, value);
+    }
+
+    static inline void CompilerBarrier()
+    {
+        _ReadWriteBarrier();
+    }
+
+    /// <summary>
+    /// Hints the CPU that we're in a spin-wait loop
+    /// </summary>
+    static inline void Pause()
+    {
+        YieldProcessor();
+    }
+
+#else
+
+    static inline int32_t Load(volatile int32_t* ptr)
+    {
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+    }
+
+    static inline int64_t Load(volatile int64_t* ptr)
+    {
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+    }
+
+    static inline void Store(volatile int32_t* ptr, int32_t value)
+    {
+        __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+    }
+
+    static inline void Store(volatile int64_t* ptr, int64_t value)
+    {
+        __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+    }
+
+    static inline int32_t Exchange(volatile int32_t* ptr, int32_t value)
+    {
+        return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+    }
+
+    static inline int64_t Exchange(volatile int64_t* ptr, int64_t value)
+    {
+        return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+    }
+
+    /// <summary>
+    /// Sets "ptr" to "desired" if it's equal to "expected" , returns the value that was there before
+    /// </summary>
+    static inline int32_t CompareExchange(volatile int32_t* ptr, int32_t desired, int32_t expected)
+    {
+        __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        return expected;
+    }
+
+    static inline int64_t CompareExchange(volatile int64_t* ptr, int64_t desired, int64_t expected)
+    {
+        __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        return expected;
+    }
+
+    /// <summary>
+    /// Returns the incremented value
+    /// </summary>
+    static inline int32_t Increment(volatile int32_t* ptr)
+    {
+        return __atomic_add_fetch(ptr, 1, __ATOMIC_SEQ_CST);
+    }
+
+    /// <summary>
+    /// Returns the decremented value
+    /// </summary>
+    static inline int32_t Decrement(volatile int32_t* ptr)
+    {
+        return __atomic_sub_fetch(ptr, 1, __ATOMIC_SEQ_CST);
+    }
+
+    /// <summary>
+    /// Returns the value before the addition
+    /// </summary>
+    static inline int64_t Add(volatile int64_t* ptr, int64_t value)
+    {
+        return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+    }
+
+    static inline void CompilerBarrier()
+    {
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    }
+
+    /// <summary>
+    /// Hints the CPU that we're in a spin-wait loop
+    /// </summary>
+    static inline void Pause()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+#endif
+};
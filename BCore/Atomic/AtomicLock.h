@@ -0,0 +1,53 @@
+#pragma once
+#include <stdint.h>
+#include "Atomic.h"
+
+/// <summary>
+/// <para>Spin lock using test-and-test-and-set with exponential backoff</para>
+/// <para>Waiting threads only read the lock (which stays in their cache) and only try the atomic exchange once it looks free</para>
+/// <para>Between two attempts they back off for an exponentially growing number of pause instructions , which keeps the cache line from bouncing between cores</para>
+/// </summary>
+struct AtomicLock
+{
+    static const uint32_t MAX_BACKOFF = 1024;
+
+    volatile int32_t is_locked;
+
+    bool TryLock()
+    {
+        return Atomic::Load(&is_locked) == 0 && Atomic::Exchange(&is_locked, 1) == 0;
+    }
+
+    void Lock()
+    {
+        uint32_t backoff = 1;
+
+        while (true)
+        {
+            if (Atomic::Exchange(&is_locked, 1) == 0)
+            {
+                return;
+            }
+
+            // spin on a plain read until the lock looks free
+            do
+            {
+                for (uint32_t i = 0; i < backoff; ++i)
+                {
+                    Atomic::Pause();
+                }
+
+                if (backoff < MAX_BACKOFF)
+                {
+                    backoff <<= 1;
+                }
+            }
+            while (Atomic::Load(&is_locked) != 0);
+        }
+    }
+
+    void Unlock()
+    {
+        Atomic::Store(&is_locked, 0);
+    }
+};
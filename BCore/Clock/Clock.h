@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/// <summary>
+/// <para>Monotonic clock shared by BTest , BBench , FrameProfiler and the loggers</para>
+/// <para>QueryPerformanceCounter on Windows , CLOCK_MONOTONIC elsewhere</para>
+/// </summary>
+struct Clock
+{
+    static uint64_t NowNs()
+    {
+#ifdef _WIN32
+        static LARGE_INTEGER frequency = {};
+
+        if ( frequency.QuadPart == 0 )
+        {
+            QueryPerformanceFrequency( &frequency );
+        }
+
+        LARGE_INTEGER counter = {};
+        QueryPerformanceCounter( &counter );
+
+        return (uint64_t) ((double) counter.QuadPart * 1'000'000'000.0 / (double) frequency.QuadPart);
+#else
+        timespec ts = {};
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+
+        return (uint64_t) ts.tv_sec * 1'000'000'000ull + (uint64_t) ts.tv_nsec;
+#endif
+    }
+
+    static uint64_t NowMs()
+    {
+        return NowNs() / 1'000'000ull;
+    }
+};
@@ -33,7 +33,7 @@ public:
         if ( !in_arr->alloc.free )
             return;
 
-        in_arr->alloc.free( in_arr->alloc, in_arr->data );
+        FREE( in_arr->alloc, in_arr->data );
         in_arr->data = nullptr;
     }
 };
\ No newline at end of file
@@ -0,0 +1,291 @@
+#pragma once
+#include <assert.h>
+#include <stdint.h>
+#include "../Allocators/Allocator.h"
+#include "../Context/CoreContext.h"
+#include "../Typedefs/Typedefs.h"
+#include "DArray.h"
+#include "../String/StringView.h"
+#include "../String/StringBuffer.h"
+
+struct BufferChunk
+{
+    BufferChunk* next;
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+
+/// <summary>
+/// <para>Append only byte buffer made of fixed size chunks , growing never moves or copies what has been written</para>
+/// <para>Reset keeps the chunks in a free list , a buffer reused for many documents stops allocating once it has seen the biggest one</para>
+/// <para>The chunks can be handed out as they are (WriteTo , Gather) , flattened in place (Flatten) or copied out (CopyTo , ToString)</para>
+/// </summary>
+struct ChunkedBuffer
+{
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 16 * 1'024;
+
+    // Reserve needs room for any formatted number
+    static constexpr size_t MIN_CHUNK_SIZE = 64;
+
+    Allocator alloc;
+    size_t chunk_size;
+
+    BufferChunk* first;
+    BufferChunk* last;
+
+    // chunks given back by Reset , reused before allocating new ones
+    BufferChunk* free_chunks;
+
+    // bytes in all the chunks before "last"
+    size_t flushed_size;
+
+    static void Create( ChunkedBuffer* out_buffer, Allocator alloc, size_t chunk_size = DEFAULT_CHUNK_SIZE )
+    {
+        *out_buffer = {};
+        out_buffer->alloc = alloc;
+        out_buffer->chunk_size = chunk_size < MIN_CHUNK_SIZE ? MIN_CHUNK_SIZE : chunk_size;
+    }
+
+    static void Destroy( ChunkedBuffer* buffer )
+    {
+        Reset( buffer );
+
+        BufferChunk* chunk = buffer->free_chunks;
+
+        while ( chunk != nullptr )
+        {
+            BufferChunk* next = chunk->next;
+
+            if ( buffer->alloc.free )
+            {
+                FREE( buffer->alloc, chunk );
+            }
+
+            chunk = next;
+        }
+
+        *buffer = {};
+    }
+
+    /// <summary>
+    /// Empties the buffer , the chunks are kept for the next writes
+    /// </summary>
+    static void Reset( ChunkedBuffer* buffer )
+    {
+        if ( buffer->last != nullptr )
+        {
+            buffer->last->next = buffer->free_chunks;
+            buffer->free_chunks = buffer->first;
+        }
+
+        buffer->first = nullptr;
+        buffer->last = nullptr;
+        buffer->flushed_size = 0;
+    }
+
+    static inline size_t Size( const ChunkedBuffer* buffer )
+    {
+        return buffer->flushed_size + (buffer->last != nullptr ? buffer->last->size : 0);
+    }
+
+    static inline void Write( ChunkedBuffer* buffer, char c )
+    {
+        BufferChunk* chunk = buffer->last;
+
+        if ( chunk == nullptr || chunk->size == chunk->capacity )
+        {
+            chunk = AddChunk( buffer );
+        }
+
+        chunk->data[chunk->size++] = c;
+    }
+
+    static inline void Write( ChunkedBuffer* buffer, StringView str )
+    {
+        Write( buffer, str.buffer, str.length );
+    }
+
+    static void Write( ChunkedBuffer* buffer, const char* data, size_t size )
+    {
+        while ( size != 0 )
+        {
+            BufferChunk* chunk = buffer->last;
+
+            if ( chunk == nullptr || chunk->size == chunk->capacity )
+            {
+                chunk = AddChunk( buffer );
+            }
+
+            size_t available = chunk->capacity - chunk->size;
+            size_t count = size < available ? size : available;
+
+            CoreContext::mem_copy( (void*) data, chunk->data + chunk->size, count );
+
+            chunk->size += count;
+            data += count;
+            size -= count;
+        }
+    }
+
+    /// <summary>
+    /// <para>Returns "size" contiguous bytes to write into , "size" can't be more than the chunk size (at least MIN_CHUNK_SIZE)</para>
+    /// <para>Commit says how many of them were used , used to format numbers in place</para>
+    /// </summary>
+    static inline char* Reserve( ChunkedBuffer* buffer, size_t size )
+    {
+        assert( size <= buffer->chunk_size );
+
+        BufferChunk* chunk = buffer->last;
+
+        if ( chunk == nullptr || chunk->capacity - chunk->size < size )
+        {
+            chunk = AddChunk( buffer );
+        }
+
+        return chunk->data + chunk->size;
+    }
+
+    static inline void Commit( ChunkedBuffer* buffer, size_t size )
+    {
+        assert( buffer->last->size + size <= buffer->last->capacity );
+        buffer->last->size += size;
+    }
+
+    /// <summary>
+    /// Copies everything to "dst" , that needs room for Size() bytes
+    /// </summary>
+    static void CopyTo( const ChunkedBuffer* buffer, char* dst )
+    {
+        for ( BufferChunk* chunk = buffer->first; chunk != nullptr; chunk = chunk->next )
+        {
+            CoreContext::mem_copy( chunk->data, dst, chunk->size );
+            dst += chunk->size;
+        }
+    }
+
+    static void ToString( const ChunkedBuffer* buffer, StringBuffer* out_str, Allocator alloc )
+    {
+        *out_str = StringBuffer::Create( Size( buffer ), alloc );
+        CopyTo( buffer, out_str->buffer );
+    }
+
+    /// <summary>
+    /// <para>Calls "write" with every chunk in order , stops and returns false as soon as it fails</para>
+    /// <para>Lets the content go to a file or a socket without ever being contiguous</para>
+    /// </summary>
+    static bool WriteTo( const ChunkedBuffer* buffer, Func<bool, void*, StringView> write, void* user_data )
+    {
+        for ( BufferChunk* chunk = buffer->first; chunk != nullptr; chunk = chunk->next )
+        {
+            if ( chunk->size != 0 && !write( user_data, ViewOf( chunk ) ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Adds a view per chunk to "out_segments" , the gather list for a vectored write (writev , WriteFileGather)
+    /// </summary>
+    static void Gather( const ChunkedBuffer* buffer, DArray<StringView>* out_segments )
+    {
+        for ( BufferChunk* chunk = buffer->first; chunk != nullptr; chunk = chunk->next )
+        {
+            if ( chunk->size != 0 )
+            {
+                DArray<StringView>::Add( out_segments, ViewOf( chunk ) );
+            }
+        }
+    }
+
+    /// <summary>
+    /// <para>Contiguous view of the whole content , valid until the next write or Reset</para>
+    /// <para>Free when everything fits in one chunk , otherwise the chunks are merged into one allocation of the content size
+    /// and given back to the allocator , so the content is never held twice once it returns</para>
+    /// </summary>
+    static StringView Flatten( ChunkedBuffer* buffer )
+    {
+        if ( buffer->first != buffer->last )
+        {
+            size_t size = Size( buffer );
+            // at least a regular chunk , the merged one goes through the free list like the others
+            size_t capacity = size > buffer->chunk_size ? size : buffer->chunk_size;
+
+            BufferChunk* merged = (BufferChunk*) ALLOC( buffer->alloc, sizeof( BufferChunk ) + capacity );
+            merged->next = nullptr;
+            merged->data = (char*) (merged + 1);
+            merged->size = size;
+            merged->capacity = capacity;
+
+            CopyTo( buffer, merged->data );
+
+            BufferChunk* chunk = buffer->first;
+
+            while ( chunk != nullptr )
+            {
+                BufferChunk* next = chunk->next;
+
+                if ( buffer->alloc.free )
+                {
+                    FREE( buffer->alloc, chunk );
+                }
+
+                chunk = next;
+            }
+
+            buffer->first = merged;
+            buffer->last = merged;
+            buffer->flushed_size = 0;
+        }
+
+        return buffer->first != nullptr ? ViewOf( buffer->first ) : StringView();
+    }
+
+private:
+
+    static inline StringView ViewOf( const BufferChunk* chunk )
+    {
+        StringView view = {};
+        view.buffer = chunk->data;
+        view.length = chunk->size;
+
+        return view;
+    }
+
+    static BufferChunk* AddChunk( ChunkedBuffer* buffer )
+    {
+        BufferChunk* chunk = buffer->free_chunks;
+
+        if ( chunk != nullptr )
+        {
+            buffer->free_chunks = chunk->next;
+        }
+        else
+        {
+            // header and data in one allocation
+            chunk = (BufferChunk*) ALLOC( buffer->alloc, sizeof( BufferChunk ) + buffer->chunk_size );
+            chunk->data = (char*) (chunk + 1);
+            chunk->capacity = buffer->chunk_size;
+        }
+
+        chunk->next = nullptr;
+        chunk->size = 0;
+
+        if ( buffer->last != nullptr )
+        {
+            buffer->flushed_size += buffer->last->size;
+            buffer->last->next = chunk;
+        }
+        else
+        {
+            buffer->first = chunk;
+        }
+
+        buffer->last = chunk;
+
+        return chunk;
+    }
+};
@@ -50,7 +50,7 @@ public:
     {
         if (in_arr->alloc.free)
         {
-            in_arr->alloc.free(&in_arr->alloc, in_arr->data);
+            FREE(in_arr->alloc, in_arr->data);
         }
 
         *in_arr = {};
@@ -160,7 +160,7 @@ public:
     {
         // save arena start point
         Allocator temp_alloc = ArenaAllocator::Create(&CoreContext::core_arena);
-        size_t start_offset = CoreContext::core_arena.offset;
+        ArenaCheckpoint checkpoint = ArenaCheckpoint::Create(&CoreContext::core_arena);
 
         // contains the deleted elements going from last to first
         size_t *indicies = (size_t *)ALLOC(temp_alloc, sizeof(size_t) * in_arr->size);
@@ -201,7 +201,7 @@ public:
         in_arr->size -= indicies_count;
 
         // reset arena
-        CoreContext::core_arena.offset = start_offset;
+        ArenaCheckpoint::Rewind(&checkpoint);
 
         return indicies_count;
     }
@@ -38,21 +38,29 @@ struct DoubleLinkedList
 
     static void RemoveAt(DoubleLinkedList* in_list , size_t index)
     {
-        assert( index < in_list->size && index > -1);
+        assert( index < in_list->size );
 
         Node* n = in_list->first;
         
-        while( size_t i = 0; i != index)
+        for( size_t i = 0; i != index; ++i)
         {
             n = n->next;
         }
 
         Node* prev = n->prev;
         Node* next = n->next;
-        prev->next = next;
-        next->prev = prev;
 
-        in_list->alloc.free(&in_list->alloc , n);
+        if(prev != nullptr)
+            prev->next = next;
+        else
+            in_list->first = next;
+
+        if(next != nullptr)
+            next->prev = prev;
+        else
+            in_list->last = prev;
+
+        FREE(in_list->alloc , n);
 
         in_list->size--;
     }
@@ -1,6 +1,41 @@
 #pragma once
 #include "DArray.h"
+#include "HMap.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// Snapshot of a FreeList's state , see FreeList::GetStats
+/// </summary>
+struct FreeListStats
+{
+    size_t total_mem;
+    size_t used_mem;
+    size_t free_mem;
+
+    size_t used_block_count;
+    size_t free_block_count;
+
+    /// <summary>
+    /// The biggest allocation that can still succeed
+    /// </summary>
+    size_t largest_free_block;
+
+    /// <summary>
+    /// 1 - largest_free_block / free_mem : 0 when all the free memory is in one block , close to 1 when it is scattered in small holes
+    /// </summary>
+    float fragmentation;
+};
+
+/// <summary>
+/// <para>Manages the ranges of a block of memory it doesn't own (a GPU buffer) , hands out Nodes (start , size) that are given back with FreeBlock</para>
+/// <para>Two-level segregated fit (TLSF) : the free blocks are kept in lists by size class , a power of two range (first level) split in SL_COUNT linear steps (second level)</para>
+/// <para>A bitmap per level tells which lists aren't empty , finding a block that fits is two bit scans , so AllocBlock and FreeBlock are O(1) whatever the number of blocks</para>
+/// <para>Physical neighbours are linked so a freed block merges with the free blocks around it right away , the used blocks are found back from their start through an HMap</para>
+/// <para>NOTE : the bookkeeping lives outside the managed memory , nothing is ever written into the buffer itself</para>
+/// </summary>
 struct FreeList
 {
     struct Node
@@ -9,15 +44,53 @@ struct FreeList
         uint32_t size;
     };
 
+    static const uint32_t INVALID_BLOCK = (uint32_t) -1;
+
+    /// <summary>
+    /// Record of the block at offset 0 , splits keep the front part and merges keep the lower block so it is the head of the physical list for the free list's whole life
+    /// </summary>
+    static const uint32_t FIRST_BLOCK = 0;
+
+    static const uint32_t SL_LOG2 = 4;
+    static const uint32_t SL_COUNT = 1 << SL_LOG2;
+
+    /// <summary>
+    /// Sizes below SL_COUNT all go to the first level , one list per size , then one level per power of two up to 2^31
+    /// </summary>
+    static const uint32_t FL_COUNT = 32 - SL_LOG2 + 1;
+
+    /// <summary>
+    /// <para>A range of the managed memory , free or used</para>
+    /// <para>"prev_phys" and "next_phys" are the neighbours in memory , "prev_free" and "next_free" the neighbours in the size class list (or the next unused record)</para>
+    /// </summary>
+    struct Block
+    {
+        uint32_t start;
+        uint32_t size;
+        uint32_t prev_phys;
+        uint32_t next_phys;
+        uint32_t prev_free;
+        uint32_t next_free;
+        bool is_free;
+    };
+
+    /// <summary>
+    /// Every block record , free , used or unused (recycled through "unused_blocks")
+    /// </summary>
+    DArray<Block> blocks;
+    uint32_t unused_blocks;
+
     /// <summary>
-    /// Ordered list of all the used nodes
+    /// Start of every used block to its record
     /// </summary>
-    DArray<Node> used_nodes;
+    HMap<uint32_t, uint32_t> used_blocks;
 
     /// <summary>
-    /// Ordered list of all the free nodes
+    /// Bit "fl" is set when one of the lists of that first level isn't empty , bit "sl" of "sl_bitmaps[fl]" when list [fl][sl] isn't empty
     /// </summary>
-    DArray<Node> free_nodes;
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmaps[FL_COUNT];
+    uint32_t free_heads[FL_COUNT][SL_COUNT];
 
     /// <summary>
     /// Total memory being managed by the free list
@@ -34,103 +107,81 @@ struct FreeList
     /// </summary>
     size_t used_mem;
 
+    size_t free_block_count;
+
     static void Create(FreeList *out_freelist, size_t alignement, size_t nodes_capacity, size_t total_mem, Allocator alloc)
     {
+        assert(alignement != 0);
+        assert(total_mem <= (size_t) UINT32_MAX);
+
+        *out_freelist = {};
         out_freelist->total_mem = total_mem;
         out_freelist->alignment = alignement;
         out_freelist->used_mem = 0;
+        out_freelist->unused_blocks = INVALID_BLOCK;
+
+        for (uint32_t fl = 0; fl < FL_COUNT; ++fl)
+        {
+            for (uint32_t sl = 0; sl < SL_COUNT; ++sl)
+            {
+                out_freelist->free_heads[fl][sl] = INVALID_BLOCK;
+            }
+        }
+
+        DArray<Block>::Create(nodes_capacity, &out_freelist->blocks, alloc, false);
+        HMap<uint32_t, uint32_t>::Create(&out_freelist->used_blocks, alloc, nodes_capacity);
 
-        DArray<Node>::Create(nodes_capacity, &out_freelist->used_nodes, alloc);
-        DArray<Node>::Create(nodes_capacity, &out_freelist->free_nodes, alloc);
+        if (total_mem == 0)
+        {
+            return;
+        }
 
-        Node first = {};
-        first.start = 0;
-        first.size = (uint32_t)total_mem;
+        uint32_t first = NewBlock(out_freelist);
+        Block *block = &out_freelist->blocks.data[first];
+        block->start = 0;
+        block->size = (uint32_t) total_mem;
 
-        DArray<Node>::Add(&out_freelist->free_nodes, first);
+        InsertFree(out_freelist, first);
     }
 
     static void FreeBlock(FreeList *in_freelist, Node in_node)
     {
         assert(IsAligned(in_node.size , in_freelist->alignment));
         assert(IsAligned(in_node.start , in_freelist->alignment));
-        
-        // remove used block
-        {
-            size_t remove_index = {};
-            FindRemoveIndex(&in_freelist->used_nodes, in_node, &remove_index);
 
-            assert(remove_index != -1);
+        uint32_t idx = INVALID_BLOCK;
+        bool found = HMap<uint32_t, uint32_t>::TryRemove(&in_freelist->used_blocks, in_node.start, &idx);
 
-            in_freelist->used_mem -= in_node.size;
+        assert(found);
 
-            DArray<Node>::RemoveAt(&in_freelist->used_nodes, remove_index);
-        }
-
-        // if no free nodes available
-        if (in_freelist->free_nodes.size == 0)
+        if (!found)
         {
-            DArray<Node>::Add(&in_freelist->free_nodes, in_node);
             return;
         }
 
-        // add the free block
-        size_t insert_index = {};
-        FindInsertIndex(&in_freelist->free_nodes, in_node, &insert_index);
-
-        assert(insert_index != -1);
+        assert(in_freelist->blocks.data[idx].size == in_node.size);
 
-        uint32_t start = in_node.start;
-        DArray<Node>::Insert(&in_freelist->free_nodes, in_node, insert_index);
+        in_freelist->used_mem -= in_freelist->blocks.data[idx].size;
 
-        uint32_t start_index = (uint32_t)insert_index;
-        uint32_t size = in_node.size;
-        uint32_t count = 0;
+        // merge with the free blocks right before and right after
+        uint32_t prev = in_freelist->blocks.data[idx].prev_phys;
 
-        // merge backwards
-        for (uint32_t i = start_index - 1; i != -1; i--)
+        if (prev != INVALID_BLOCK && in_freelist->blocks.data[prev].is_free)
         {
-            Node *curr = &in_freelist->free_nodes.data[i];
-
-            if ((curr->start + curr->size) != start)
-            {
-                break;
-            }
-
-            start = curr->start;
-            start_index = i;
-            size += curr->size;
-            count++;
-        }
-        
-        count++;
-
-        // merge forward
-        {
-            for (size_t end = insert_index; end < in_freelist->free_nodes.size - 1; end++)
-            {
-                Node *curr = &in_freelist->free_nodes.data[end];
-                Node *next = &in_freelist->free_nodes.data[end + 1];
-
-                if ((curr->start + curr->size) != next->start)
-                {
-                    break;
-                }
-                size += next->size;
-                count++;
-            }
+            RemoveFree(in_freelist, prev);
+            Merge(in_freelist, prev, idx);
+            idx = prev;
         }
 
-        const uint32_t remove_range = count - 1;
-        const uint32_t remove_index = start_index + 1;
+        uint32_t next = in_freelist->blocks.data[idx].next_phys;
 
-        if (remove_index < in_freelist->free_nodes.size)
+        if (next != INVALID_BLOCK && in_freelist->blocks.data[next].is_free)
         {
-            DArray<Node>::RemoveRange(&in_freelist->free_nodes, remove_index, remove_range);
+            RemoveFree(in_freelist, next);
+            Merge(in_freelist, idx, next);
         }
 
-        in_freelist->free_nodes.data[start_index].start = start;
-        in_freelist->free_nodes.data[start_index].size = size;
+        InsertFree(in_freelist, idx);
     }
 
     static bool IsAligned(size_t size , size_t alignment)
@@ -146,170 +197,380 @@ struct FreeList
 
     static bool AllocBlock(FreeList *in_freelist, const size_t size, Node *out_node)
     {
-        size_t aligned_size = GetSizeAligned(size , in_freelist->alignment);
+        return AllocBlockAligned(in_freelist, size, in_freelist->alignment, out_node);
+    }
+
+    /// <summary>
+    /// <para>Same as AllocBlock with the start aligned on "block_alignment" , a multiple of the free list's alignment</para>
+    /// <para>The space skipped before the start stays a free block</para>
+    /// </summary>
+    static bool AllocBlockAligned(FreeList *in_freelist, const size_t size, const size_t block_alignment, Node *out_node)
+    {
+        assert(block_alignment % in_freelist->alignment == 0);
+
+        size_t aligned_size = GetSizeAligned(size == 0 ? 1 : size , in_freelist->alignment);
 
-        // if we don't have any free nodes available , exit
-        if (in_freelist->free_nodes.size == 0)
+        // room for the worst padding , any block of that class fits without checking
+        size_t search_size = aligned_size + (block_alignment - in_freelist->alignment);
+
+        uint32_t idx = FindFree(in_freelist, search_size);
+
+        if (idx == INVALID_BLOCK)
         {
             return false;
         }
 
-        // try finding a node with enough size to hold our allocation
-        Node *free_node = nullptr;
-        size_t free_node_idx = -1;
+        RemoveFree(in_freelist, idx);
+
+        // padding before the aligned start , given back as a free block
+        uint32_t start = in_freelist->blocks.data[idx].start;
+        uint32_t padding = (uint32_t) (GetSizeAligned(start, block_alignment) - start);
 
-        for (size_t i = 0; i < in_freelist->free_nodes.size; ++i)
+        Claim(in_freelist, idx, padding, aligned_size, out_node);
+
+        return true;
+    }
+
+    /// <summary>
+    /// <para>Allocates "size" bytes right at "start" , fails when that range isn't inside a single free block</para>
+    /// <para>Walks the blocks in memory order so it is O(n) , meant for tools that pick the place themselves (see FreeListDefragmenter) , not for regular allocations</para>
+    /// </summary>
+    static bool AllocBlockAt(FreeList *in_freelist, const size_t start, const size_t size, Node *out_node)
+    {
+        assert(IsAligned(start, in_freelist->alignment));
+
+        size_t aligned_size = GetSizeAligned(size == 0 ? 1 : size , in_freelist->alignment);
+
+        if (in_freelist->blocks.size == 0 || start + aligned_size > in_freelist->total_mem)
         {
-            Node *curr = &in_freelist->free_nodes.data[i];
+            return false;
+        }
 
-            if (curr->size < aligned_size)
-                continue;
+        uint32_t idx = FIRST_BLOCK;
 
-            free_node = curr;
-            free_node_idx = i;
-            break;
+        while (idx != INVALID_BLOCK && (size_t) in_freelist->blocks.data[idx].start + in_freelist->blocks.data[idx].size <= start)
+        {
+            idx = in_freelist->blocks.data[idx].next_phys;
         }
 
-        // if no such node is found , exit
-        if (free_node == nullptr)
+        if (idx == INVALID_BLOCK)
         {
             return false;
         }
 
-        // a valid node have been found , add to the memory used
-        in_freelist->used_mem += aligned_size;
+        Block *block = &in_freelist->blocks.data[idx];
 
-        // add use node
+        if (!block->is_free || (size_t) block->start + block->size < start + aligned_size)
         {
-            Node use = {};
-            use.start = free_node->start;
-            use.size = (uint32_t) aligned_size;
+            return false;
+        }
 
-            size_t used_count = in_freelist->used_nodes.size;
+        uint32_t padding = (uint32_t) (start - block->start);
 
-            if ( used_count == 0 || in_freelist->used_nodes.data[used_count - 1].start < use.start)
-            {
-                DArray<Node>::Add(&in_freelist->used_nodes, use);
-            }
-            else
-            {
-                size_t insert_index = -1;
-                FindInsertIndex(&in_freelist->used_nodes, use, &insert_index);
+        RemoveFree(in_freelist, idx);
+        Claim(in_freelist, idx, padding, aligned_size, out_node);
 
-                assert(insert_index != -1);
-                DArray<Node>::Insert(&in_freelist->used_nodes, use, insert_index);
-            }
-
-            *out_node = use;
-        }
+        return true;
+    }
 
-        // edit free node
-        // if the allocation takes up all the free space in the node
-        // then we just delete it
-        if (aligned_size == free_node->size)
-        {
-            DArray<Node>::RemoveAt(&in_freelist->free_nodes, free_node_idx);
-        }
-        // else , remove the used space from the free node
-        else
+    static FreeListStats GetStats(FreeList *in_freelist)
+    {
+        FreeListStats stats = {};
+        stats.total_mem = in_freelist->total_mem;
+        stats.used_mem = in_freelist->used_mem;
+        stats.free_mem = in_freelist->total_mem - in_freelist->used_mem;
+        stats.used_block_count = in_freelist->used_blocks.count;
+        stats.free_block_count = in_freelist->free_block_count;
+
+        // the biggest block is in the highest non empty list , the lists aren't sorted so look through that one
+        if (in_freelist->fl_bitmap != 0)
         {
-            free_node->start += (uint32_t)aligned_size;
-            free_node->size -= (uint32_t)aligned_size;
+            uint32_t fl = HighestBit(in_freelist->fl_bitmap);
+            uint32_t sl = HighestBit(in_freelist->sl_bitmaps[fl]);
+
+            for (uint32_t idx = in_freelist->free_heads[fl][sl]; idx != INVALID_BLOCK; idx = in_freelist->blocks.data[idx].next_free)
+            {
+                size_t curr = in_freelist->blocks.data[idx].size;
+                stats.largest_free_block = curr > stats.largest_free_block ? curr : stats.largest_free_block;
+            }
         }
 
-        return true;
+        stats.fragmentation = stats.free_mem == 0 ? 0.0f : 1.0f - (float) ((double) stats.largest_free_block / (double) stats.free_mem);
+
+        return stats;
     }
 
     static void Destroy(FreeList *out_freelist)
     {
-        DArray<Node>::Destroy(&out_freelist->free_nodes);
-        DArray<Node>::Destroy(&out_freelist->used_nodes);
+        HMap<uint32_t, uint32_t>::Destroy(&out_freelist->used_blocks);
+        DArray<Block>::Destroy(&out_freelist->blocks);
         *out_freelist = {};
     }
 
 private:
-    // Returns the index where we should insert the node
-    static void FindInsertIndex(DArray<Node> *in_nodes, Node in_node, size_t *out_index)
+
+    static inline uint32_t LowestBit(uint32_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long idx = 0;
+        _BitScanForward(&idx, mask);
+        return (uint32_t) idx;
+#else
+        return (uint32_t) __builtin_ctz(mask);
+#endif
+    }
+
+    static inline uint32_t HighestBit(uint32_t mask)
     {
-        if (in_nodes->size == 0)
+#ifdef _MSC_VER
+        unsigned long idx = 0;
+        _BitScanReverse(&idx, mask);
+        return (uint32_t) idx;
+#else
+        return (uint32_t) (31 - __builtin_clz(mask));
+#endif
+    }
+
+    /// <summary>
+    /// Size class of a block of "size" bytes
+    /// </summary>
+    static inline void Mapping(uint32_t size, uint32_t *out_fl, uint32_t *out_sl)
+    {
+        if (size < SL_COUNT)
         {
-            *out_index = 0;
+            *out_fl = 0;
+            *out_sl = size;
             return;
         }
 
-        size_t best_index = 0;
+        uint32_t log2 = HighestBit(size);
+        *out_sl = (size >> (log2 - SL_LOG2)) ^ SL_COUNT;
+        *out_fl = log2 - SL_LOG2 + 1;
+    }
+
+    /// <summary>
+    /// <para>A free block for "size" bytes or INVALID_BLOCK</para>
+    /// <para>The size is rounded up to the next class first so that any block of the class found fits , when that fails the list of the class itself is searched</para>
+    /// </summary>
+    static uint32_t FindFree(FreeList *in_freelist, size_t size)
+    {
+        if (size > in_freelist->total_mem)
+        {
+            return INVALID_BLOCK;
+        }
 
-        size_t low = 0;
-        size_t high = in_nodes->size - 1;
+        size_t rounded = size;
 
-        size_t node_end = (in_node.start + in_node.size);
+        if (size >= SL_COUNT)
+        {
+            rounded += ((size_t) 1 << (HighestBit((uint32_t) size) - SL_LOG2)) - 1;
+        }
 
-        while (low <= high && high != -1)
+        if (rounded <= (size_t) UINT32_MAX)
         {
-            size_t middle = low + ((high - low) / 2);
+            uint32_t fl = 0;
+            uint32_t sl = 0;
+            Mapping((uint32_t) rounded, &fl, &sl);
 
-            Node *curr = &in_nodes->data[middle];
+            uint32_t sl_map = in_freelist->sl_bitmaps[fl] & (~0u << sl);
 
-            if (curr->start == node_end)
+            if (sl_map == 0)
             {
-                best_index = middle;
-                break;
-            }
+                uint32_t fl_map = fl + 1 < 32 ? in_freelist->fl_bitmap & (~0u << (fl + 1)) : 0;
 
-            if ((curr->start + curr->size) == in_node.start)
-            {
-                best_index = middle + 1;
-                break;
+                if (fl_map != 0)
+                {
+                    fl = LowestBit(fl_map);
+                    sl_map = in_freelist->sl_bitmaps[fl];
+                }
             }
 
-            if (in_node.start < curr->start)
+            if (sl_map != 0)
             {
-                best_index = middle;
-                high = middle - 1;
+                return in_freelist->free_heads[fl][LowestBit(sl_map)];
             }
-            else
+        }
+
+        // the blocks of the exact class can still be big enough , they just aren't all
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping((uint32_t) size, &fl, &sl);
+
+        for (uint32_t idx = in_freelist->free_heads[fl][sl]; idx != INVALID_BLOCK; idx = in_freelist->blocks.data[idx].next_free)
+        {
+            if (in_freelist->blocks.data[idx].size >= size)
             {
-                best_index = middle + 1;
-                low = middle + 1;
+                return idx;
             }
         }
 
-        *out_index = best_index;
+        return INVALID_BLOCK;
     }
 
-    static void FindRemoveIndex(DArray<Node> *in_nodes, Node in_node, size_t *out_index)
+    static void InsertFree(FreeList *in_freelist, uint32_t idx)
     {
-        if (in_nodes->size == 0)
+        Block *block = &in_freelist->blocks.data[idx];
+
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping(block->size, &fl, &sl);
+
+        uint32_t head = in_freelist->free_heads[fl][sl];
+
+        block->is_free = true;
+        block->prev_free = INVALID_BLOCK;
+        block->next_free = head;
+
+        if (head != INVALID_BLOCK)
         {
-            *out_index = -1;
-            return;
+            in_freelist->blocks.data[head].prev_free = idx;
         }
 
-        size_t low = 0;
-        size_t high = in_nodes->size - 1;
+        in_freelist->free_heads[fl][sl] = idx;
+        in_freelist->fl_bitmap |= 1u << fl;
+        in_freelist->sl_bitmaps[fl] |= 1u << sl;
+        in_freelist->free_block_count++;
+    }
+
+    static void RemoveFree(FreeList *in_freelist, uint32_t idx)
+    {
+        Block *block = &in_freelist->blocks.data[idx];
+        assert(block->is_free);
+
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping(block->size, &fl, &sl);
 
-        while (low <= high)
+        if (block->prev_free != INVALID_BLOCK)
+        {
+            in_freelist->blocks.data[block->prev_free].next_free = block->next_free;
+        }
+        else
         {
-            size_t index = low + ((high - low) / 2);
+            in_freelist->free_heads[fl][sl] = block->next_free;
+        }
 
-            Node *curr = &in_nodes->data[index];
+        if (block->next_free != INVALID_BLOCK)
+        {
+            in_freelist->blocks.data[block->next_free].prev_free = block->prev_free;
+        }
 
-            if (CoreContext::mem_compare(curr, &in_node, sizeof(Node)))
-            {
-                *out_index = index;
-                return;
-            }
+        if (in_freelist->free_heads[fl][sl] == INVALID_BLOCK)
+        {
+            in_freelist->sl_bitmaps[fl] &= ~(1u << sl);
 
-            if (in_node.start < curr->start)
-            {
-                high = index - 1;
-            }
-            else
+            if (in_freelist->sl_bitmaps[fl] == 0)
             {
-                low = index + 1;
+                in_freelist->fl_bitmap &= ~(1u << fl);
             }
         }
 
-        *out_index = -1;
+        block->is_free = false;
+        block->prev_free = INVALID_BLOCK;
+        block->next_free = INVALID_BLOCK;
+        in_freelist->free_block_count--;
+    }
+
+    /// <summary>
+    /// Turns "aligned_size" bytes of "idx" , already out of its free list , into a used block , the "padding" bytes before and the remainder after go back as free blocks
+    /// </summary>
+    static void Claim(FreeList *in_freelist, uint32_t idx, uint32_t padding, size_t aligned_size, Node *out_node)
+    {
+        if (padding != 0)
+        {
+            uint32_t front = idx;
+            idx = Split(in_freelist, front, padding);
+            InsertFree(in_freelist, front);
+        }
+
+        // remainder after the block
+        if (in_freelist->blocks.data[idx].size > aligned_size)
+        {
+            uint32_t rest = Split(in_freelist, idx, (uint32_t) aligned_size);
+            InsertFree(in_freelist, rest);
+        }
+
+        Block *block = &in_freelist->blocks.data[idx];
+        block->is_free = false;
+
+        HMap<uint32_t, uint32_t>::TryAdd(&in_freelist->used_blocks, block->start, idx, nullptr);
+        in_freelist->used_mem += block->size;
+
+        out_node->start = block->start;
+        out_node->size = block->size;
+    }
+
+    static uint32_t NewBlock(FreeList *in_freelist)
+    {
+        uint32_t idx = in_freelist->unused_blocks;
+
+        if (idx != INVALID_BLOCK)
+        {
+            in_freelist->unused_blocks = in_freelist->blocks.data[idx].next_free;
+        }
+        else
+        {
+            idx = (uint32_t) in_freelist->blocks.size;
+            DArray<Block>::Add(&in_freelist->blocks, Block{});
+        }
+
+        Block *block = &in_freelist->blocks.data[idx];
+        *block = {};
+        block->prev_phys = INVALID_BLOCK;
+        block->next_phys = INVALID_BLOCK;
+        block->prev_free = INVALID_BLOCK;
+        block->next_free = INVALID_BLOCK;
+
+        return idx;
+    }
+
+    /// <summary>
+    /// Cuts "idx" after "size" bytes , returns the record of the part after , neither is in a free list
+    /// </summary>
+    static uint32_t Split(FreeList *in_freelist, uint32_t idx, uint32_t size)
+    {
+        // NOTE : NewBlock can grow "blocks" , no pointers into it before
+        uint32_t rest = NewBlock(in_freelist);
+
+        Block *block = &in_freelist->blocks.data[idx];
+        Block *rest_block = &in_freelist->blocks.data[rest];
+
+        rest_block->start = block->start + size;
+        rest_block->size = block->size - size;
+        rest_block->prev_phys = idx;
+        rest_block->next_phys = block->next_phys;
+
+        if (block->next_phys != INVALID_BLOCK)
+        {
+            in_freelist->blocks.data[block->next_phys].prev_phys = rest;
+        }
+
+        block->size = size;
+        block->next_phys = rest;
+
+        return rest;
+    }
+
+    /// <summary>
+    /// Grows "idx" over "next" , its neighbour in memory , and recycles the record of "next"
+    /// </summary>
+    static void Merge(FreeList *in_freelist, uint32_t idx, uint32_t next)
+    {
+        Block *block = &in_freelist->blocks.data[idx];
+        Block *next_block = &in_freelist->blocks.data[next];
+
+        assert(block->next_phys == next);
+
+        block->size += next_block->size;
+        block->next_phys = next_block->next_phys;
+
+        if (next_block->next_phys != INVALID_BLOCK)
+        {
+            in_freelist->blocks.data[next_block->next_phys].prev_phys = idx;
+        }
+
+        *next_block = {};
+        next_block->next_free = in_freelist->unused_blocks;
+        in_freelist->unused_blocks = next;
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,196 @@
+#pragma once
+#include "DArray.h"
+#include "ArrayView.h"
+#include "FreeList.h"
+#include "ContainerUtils.h"
+
+/// <summary>
+/// One block moved by FreeListDefragmenter::Step , the content of "src" has to be copied to "dst" in the managed buffer
+/// </summary>
+struct FreeListMove
+{
+    FreeList::Node src;
+    FreeList::Node dst;
+};
+
+/// <summary>
+/// <para>Compacts a FreeList a few blocks at a time : the highest used blocks are moved into the lowest holes that fit them , so the free memory gathers at the end</para>
+/// <para>Only the blocks of the handles given to Step can move , each handle is patched in place and "moves" keeps the relocation table of the step for the copies and for the copies of the handles held elsewhere</para>
+/// <para>Every "dst" was free before the step and every "src" was used , so the ranges of a step never overlap and can go in a single buffer to buffer copy</para>
+/// <para>NOTE : only planning happens here , nothing touches the managed memory , the caller copies the moves before anything else is written in the buffer</para>
+/// <para>NOTE : moved blocks keep the free list's alignment only , blocks from AllocBlockAligned must not be handed to Step</para>
+/// </summary>
+struct FreeListDefragmenter
+{
+    /// <summary>
+    /// Work allowed per Step , a block bigger than "max_bytes" is never moved
+    /// </summary>
+    struct Options
+    {
+        size_t max_bytes;
+        size_t max_moves;
+    };
+
+    /// <summary>
+    /// Relocation table of the last Step
+    /// </summary>
+    DArray<FreeListMove> moves;
+
+    DArray<FreeList::Node*> candidates;
+    DArray<FreeList::Node> holes;
+
+    size_t total_moved_bytes;
+    size_t total_move_count;
+
+    static void Create(FreeListDefragmenter *out_defragmenter, size_t capacity, Allocator alloc)
+    {
+        *out_defragmenter = {};
+
+        DArray<FreeListMove>::Create(capacity, &out_defragmenter->moves, alloc, false);
+        DArray<FreeList::Node*>::Create(capacity, &out_defragmenter->candidates, alloc, false);
+        DArray<FreeList::Node>::Create(capacity, &out_defragmenter->holes, alloc, false);
+    }
+
+    /// <summary>
+    /// <para>Plans and applies to "in_freelist" at most "options.max_moves" moves for at most "options.max_bytes" , returns the number of moves</para>
+    /// <para>0 means nothing among "handles" can go lower , the free list is as compact as those handles allow</para>
+    /// <para>The handles must be used blocks of "in_freelist" (or empty) , the same block can be there more than once</para>
+    /// </summary>
+    static size_t Step(FreeListDefragmenter *in_defragmenter, FreeList *in_freelist, ArrayView<FreeList::Node*> handles, Options options)
+    {
+        DArray<FreeListMove>::Clear(&in_defragmenter->moves);
+        DArray<FreeList::Node*>::Clear(&in_defragmenter->candidates);
+        DArray<FreeList::Node>::Clear(&in_defragmenter->holes);
+
+        if (in_freelist->free_block_count == 0 || options.max_moves == 0)
+        {
+            return 0;
+        }
+
+        // holes in memory order , the lowest one first
+        for (uint32_t idx = FreeList::FIRST_BLOCK; idx != FreeList::INVALID_BLOCK; idx = in_freelist->blocks.data[idx].next_phys)
+        {
+            FreeList::Block *block = &in_freelist->blocks.data[idx];
+
+            if (block->is_free)
+            {
+                DArray<FreeList::Node>::Add(&in_defragmenter->holes, FreeList::Node{ block->start, block->size });
+            }
+        }
+
+        // only what sits above the first hole can go lower
+        uint32_t lowest_hole = in_defragmenter->holes.data[0].start;
+
+        for (size_t i = 0; i < handles.size; ++i)
+        {
+            FreeList::Node *handle = handles.data[i];
+
+            if (handle->size != 0 && handle->start > lowest_hole && handle->size <= options.max_bytes)
+            {
+                DArray<FreeList::Node*>::Add(&in_defragmenter->candidates, handle);
+            }
+        }
+
+        // highest first , the holes freed behind them are above every candidate left
+        ContainerUtils::Sort(in_defragmenter->candidates.data, 0, in_defragmenter->candidates.size, IsLower);
+
+        size_t moved_bytes = 0;
+
+        for (size_t i = 0; i < in_defragmenter->candidates.size; ++i)
+        {
+            FreeList::Node *handle = in_defragmenter->candidates.data[i];
+
+            // another handle on a block that already moved
+            if (Relocate(in_defragmenter, handle))
+            {
+                continue;
+            }
+
+            if (in_defragmenter->moves.size == options.max_moves)
+            {
+                break;
+            }
+
+            if (moved_bytes + handle->size > options.max_bytes)
+            {
+                continue;
+            }
+
+            for (size_t h = 0; h < in_defragmenter->holes.size; ++h)
+            {
+                FreeList::Node *hole = &in_defragmenter->holes.data[h];
+
+                if (hole->start >= handle->start)
+                {
+                    break;
+                }
+
+                if (hole->size < handle->size)
+                {
+                    continue;
+                }
+
+                FreeListMove move = {};
+                move.src = *handle;
+
+                bool allocated = FreeList::AllocBlockAt(in_freelist, hole->start, handle->size, &move.dst);
+                assert(allocated);
+
+                if (!allocated)
+                {
+                    break;
+                }
+
+                FreeList::FreeBlock(in_freelist, move.src);
+
+                hole->start += move.dst.size;
+                hole->size -= move.dst.size;
+
+                DArray<FreeListMove>::Add(&in_defragmenter->moves, move);
+                moved_bytes += move.dst.size;
+                *handle = move.dst;
+
+                break;
+            }
+        }
+
+        in_defragmenter->total_moved_bytes += moved_bytes;
+        in_defragmenter->total_move_count += in_defragmenter->moves.size;
+
+        return in_defragmenter->moves.size;
+    }
+
+    /// <summary>
+    /// Patches "inout_node" when its block moved during the last Step , returns false when it didn't move
+    /// </summary>
+    static bool Relocate(const FreeListDefragmenter *in_defragmenter, FreeList::Node *inout_node)
+    {
+        for (size_t i = 0; i < in_defragmenter->moves.size; ++i)
+        {
+            FreeListMove *move = &in_defragmenter->moves.data[i];
+
+            if (move->src.start == inout_node->start && move->src.size == inout_node->size)
+            {
+                *inout_node = move->dst;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static void Destroy(FreeListDefragmenter *out_defragmenter)
+    {
+        DArray<FreeListMove>::Destroy(&out_defragmenter->moves);
+        DArray<FreeList::Node*>::Destroy(&out_defragmenter->candidates);
+        DArray<FreeList::Node>::Destroy(&out_defragmenter->holes);
+        *out_defragmenter = {};
+    }
+
+private:
+
+    static bool IsLower(FreeList::Node *curr, FreeList::Node *other)
+    {
+        return curr->start < other->start;
+    }
+};
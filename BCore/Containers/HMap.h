@@ -2,12 +2,18 @@
 #include "DArray.h"
 #include "../Typedefs/Typedefs.h"
 #include "../Allocators/Allocator.h"
+#include "HashPolicies.h"
 
-struct BucketLimits
-{
-    size_t index;
-    BucketLimits* next_ptr;
-};
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HMAP_SSE2 1
+#include <emmintrin.h>
+#else
+#define HMAP_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 template<typename K, typename V>
 struct Pair
@@ -16,351 +22,472 @@ struct Pair
     V value;
 };
 
-template<typename TKey, typename TValue>
+/// <summary>
+/// <para>Control bytes of a Swiss table , one per slot</para>
+/// <para>A full slot stores the low 7 bits of its key's hash (H2) , an empty slot has its high bit set</para>
+/// <para>Probing checks 16 control bytes at once , with SSE2 when available</para>
+/// </summary>
+struct ControlGroup
+{
+    static const size_t WIDTH = 16;
+    static const uint8_t EMPTY = 0x80;
+
+    /// <summary>
+    /// Bitmask of the bytes in the group that are equal to "h2"
+    /// </summary>
+    static inline uint32_t Match( const uint8_t* group, uint8_t h2 )
+    {
+#if HMAP_SSE2
+        __m128i ctrl = _mm_loadu_si128( (const __m128i*) group );
+        __m128i cmp = _mm_cmpeq_epi8( ctrl, _mm_set1_epi8( (char) h2 ) );
+        return (uint32_t) _mm_movemask_epi8( cmp );
+#else
+        uint32_t mask = 0;
+
+        for ( size_t i = 0; i < WIDTH; ++i )
+        {
+            mask |= (uint32_t) (group[i] == h2) << i;
+        }
+
+        return mask;
+#endif
+    }
+
+    /// <summary>
+    /// Bitmask of the empty bytes in the group
+    /// </summary>
+    static inline uint32_t MatchEmpty( const uint8_t* group )
+    {
+#if HMAP_SSE2
+        __m128i ctrl = _mm_loadu_si128( (const __m128i*) group );
+        return (uint32_t) _mm_movemask_epi8( ctrl );
+#else
+        uint32_t mask = 0;
+
+        for ( size_t i = 0; i < WIDTH; ++i )
+        {
+            mask |= (uint32_t) ((group[i] & EMPTY) != 0) << i;
+        }
+
+        return mask;
+#endif
+    }
+
+    static inline uint32_t LowestBit( uint32_t mask )
+    {
+#ifdef _MSC_VER
+        unsigned long idx = 0;
+        _BitScanForward( &idx, mask );
+        return (uint32_t) idx;
+#else
+        return (uint32_t) __builtin_ctz( mask );
+#endif
+    }
+};
+
+/// <summary>
+/// <para>Open addressing hash map (Swiss table layout)</para>
+/// <para>Keys and values are stored densely in "all_keys" and "all_values" , the table itself is only control bytes and indicies into them</para>
+/// <para>The slot count is a power of two and the probing is linear , group by group , so a lookup stops at the first group that has an empty slot</para>
+/// <para>Removing shifts the following entries back instead of leaving tombstones , so lookups never degrade over time</para>
+/// <para>THasher and TComparer are policies (see HashPolicies.h) , the defaults are inlined in the probe loop , use FuncHMap to hash through function pointers instead</para>
+/// </summary>
+template<typename TKey, typename TValue, typename THasher = DefaultHasher<TKey>, typename TComparer = DefaultComparer<TKey>>
 struct HMap
 {
 
 public:
 
-    Func<size_t, TKey> hasher;
-    Func<bool, TKey, TKey> comparer;
+    THasher hasher;
+    TComparer comparer;
 
     Allocator allocator;
 
-    Arena internal_arena;
-    DArray<BucketLimits> bucket_per_hash;
+    /// <summary>
+    /// "slot_count + ControlGroup::WIDTH" bytes , the last bytes mirror the first ones so that a group can be read at any slot without wrapping
+    /// </summary>
+    uint8_t* control;
+
+    /// <summary>
+    /// For each full slot , the index of its entry in "all_keys" and "all_values"
+    /// </summary>
+    uint32_t* slots;
+    size_t slot_count;
 
     DArray<TKey> all_keys;
     DArray<TValue> all_values;
 
+    /// <summary>
+    /// Number of entries the map can hold before growing
+    /// </summary>
     size_t capacity;
     size_t count;
 
 private:
 
-    static bool BucketComparer( BucketLimits a, BucketLimits b )
+    static const size_t INVALID_SLOT = (size_t) -1;
+
+    // the user hashers are usually weak (identity for integers) , mix the bits so both H1 and H2 are usable
+    static inline uint64_t Hash( HMap* in_map, TKey key )
     {
-        return a.index == b.index;
+        uint64_t h = (uint64_t) in_map->hasher.Hash( key );
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return h;
     }
 
-    static BucketLimits EmptyBucket()
+    static inline uint8_t H2( uint64_t hash )
     {
-        BucketLimits empty = {};
-        empty.index = -1;
-        empty.next_ptr = nullptr;
-
-        return empty;
+        return (uint8_t) (hash & 0x7F);
     }
 
-public:
+    static inline size_t HomeSlot( HMap* in_map, uint64_t hash )
+    {
+        return (size_t) (hash >> 7) & (in_map->slot_count - 1);
+    }
 
     /// <summary>
-    /// Initialize the dictionary with "capacity" being the number of bucket and "maxBucketCount" beings the initial size of each bucket
+    /// Smallest power of two slot count that keeps the table at most 7/8th full with "capacity" entries
     /// </summary>
-    static bool Create( HMap* out_map, Allocator alloc, size_t capacity, Func<size_t, TKey> hasher, Func<bool, TKey, TKey> comparer )
+    static size_t SlotCountFor( size_t capacity )
     {
-        *out_map = {};
-        out_map->allocator = alloc;
-        out_map->capacity = capacity;
-        out_map->hasher = hasher;
-        out_map->comparer = comparer;
-        out_map->count = 0;
-
-        // NOTE : the idea here is allocate all the space needed for the HMap in once contigious mem block
-        // since it will always be allocated together
-        const size_t total_size = ((sizeof(TKey) + sizeof(TValue) + sizeof(BucketLimits)) * capacity) + sizeof(HMap);
-        out_map->internal_arena.data = ALLOC(out_map->allocator ,total_size );
-        out_map->internal_arena.capacity = total_size;
-        out_map->internal_arena.offset = 0;
-
-        Allocator internal_alloc = ArenaAllocator::Create(&out_map->internal_arena);
-        DArray<BucketLimits>::Create( capacity, &out_map->bucket_per_hash, internal_alloc );
-        DArray<TKey>::Create( capacity, &out_map->all_keys, internal_alloc );
-        DArray<TValue>::Create( capacity, &out_map->all_values, internal_alloc );
+        size_t slot_count = ControlGroup::WIDTH;
 
-        // init all to empty buckets
-        for(size_t i = 0; i < capacity; ++i)
+        while ( capacity > (slot_count / 8) * 7 )
         {
-            BucketLimits empty = EmptyBucket();
-
-            DArray<BucketLimits>::Add(&out_map->bucket_per_hash , empty);
+            slot_count <<= 1;
         }
 
-        return true;
+        return slot_count;
     }
 
-    static bool Destroy( HMap* in_map )
+    static inline void SetControl( HMap* in_map, size_t slot, uint8_t value )
     {
-        FREE(in_map->allocator , in_map->internal_arena.data);
+        in_map->control[slot] = value;
 
-        *in_map = {};
-
-        return true;
+        // keep the mirrored bytes in sync
+        if ( slot < ControlGroup::WIDTH )
+        {
+            in_map->control[in_map->slot_count + slot] = value;
+        }
     }
 
-    static bool TryAdd( HMap* in_map, TKey key, TValue value, size_t* out_idx )
+    static void CreateTable( HMap* in_map, size_t slot_count )
     {
-        if ( (in_map->count + 1) > in_map->capacity )
-        {
-            Resize( in_map, (in_map->count * 2) + 1 );
-        }
+        const size_t total_size = (sizeof(uint32_t) * slot_count) + slot_count + ControlGroup::WIDTH;
 
-        size_t hash = in_map->hasher( key );
-        size_t index = hash % in_map->capacity;
+        void* block = ALLOC( in_map->allocator, total_size );
 
-        // get the bucket using the mod'ed hash
-        BucketLimits* root_bucket = &in_map->bucket_per_hash.data[index];
-        BucketLimits* parent_bucket = nullptr;
+        in_map->slot_count = slot_count;
+        in_map->slots = (uint32_t*) block;
+        in_map->control = (uint8_t*) block + (sizeof(uint32_t) * slot_count);
 
-        size_t idx = {};
+        CoreContext::mem_set( in_map->control, ControlGroup::EMPTY, slot_count + ControlGroup::WIDTH );
+    }
+
+    /// <summary>
+    /// Returns the slot holding "key" , INVALID_SLOT if the key isn't in the map
+    /// </summary>
+    static size_t FindSlot( HMap* in_map, TKey key, uint64_t hash )
+    {
+        const size_t mask = in_map->slot_count - 1;
+        const uint8_t h2 = H2( hash );
+        size_t pos = HomeSlot( in_map, hash );
 
-        // if it's first time filling bucket , then just add and skip
-        if(root_bucket->index == -1)
+        while ( true )
         {
-            // add pair
-            idx = in_map->count;
-            DArray<TKey>::Add( &in_map->all_keys, key );
-            DArray<TValue>::Add( &in_map->all_values, value );
+            const uint8_t* group = &in_map->control[pos];
+            uint32_t matches = ControlGroup::Match( group, h2 );
 
-            BucketLimits new_bucket = {};
-            new_bucket.index = idx;
-            new_bucket.next_ptr = nullptr;
+            while ( matches != 0 )
+            {
+                size_t slot = (pos + ControlGroup::LowestBit( matches )) & mask;
 
-            *root_bucket = new_bucket;
+                if ( in_map->comparer.Equals( in_map->all_keys.data[in_map->slots[slot]], key ) )
+                {
+                    return slot;
+                }
 
-            goto end;
-        }
+                matches &= matches - 1;
+            }
 
-        // else , iterate through the buckets
-        // the goal is to check if the key already exits
-        // AND to find the place for the next bucket
-        while(root_bucket != nullptr)
-        {
-            TKey curr_key = in_map->all_keys.data[root_bucket->index];
-            bool found = in_map->comparer( curr_key, key );
-            
-            if ( found )
+            // NOTE : an entry is never further from its home slot than the first empty slot , so we can stop here
+            if ( ControlGroup::MatchEmpty( group ) != 0 )
             {
-                *out_idx = -1;
-                return false;
+                return INVALID_SLOT;
             }
 
-            parent_bucket = root_bucket;
-            root_bucket = root_bucket->next_ptr;
-        }       
-        
-        // add pair
+            pos = (pos + ControlGroup::WIDTH) & mask;
+        }
+    }
+
+    /// <summary>
+    /// Same as FindSlot but looks for the slot pointing at "entry_index" , used to patch the table when entries move
+    /// </summary>
+    static size_t FindSlotOfEntry( HMap* in_map, uint32_t entry_index, uint64_t hash )
+    {
+        const size_t mask = in_map->slot_count - 1;
+        const uint8_t h2 = H2( hash );
+        size_t pos = HomeSlot( in_map, hash );
+
+        while ( true )
         {
-            idx = in_map->count;
-            DArray<TKey>::Add( &in_map->all_keys, key );
-            DArray<TValue>::Add( &in_map->all_values, value );
+            const uint8_t* group = &in_map->control[pos];
+            uint32_t matches = ControlGroup::Match( group, h2 );
 
-            BucketLimits new_bucket = {};
-            new_bucket.index = idx;
-            new_bucket.next_ptr = nullptr;
+            while ( matches != 0 )
+            {
+                size_t slot = (pos + ControlGroup::LowestBit( matches )) & mask;
 
-            size_t new_bucket_idx = in_map->bucket_per_hash.size;
-            DArray<BucketLimits>::Add(&in_map->bucket_per_hash , new_bucket);
-            parent_bucket->next_ptr = &in_map->bucket_per_hash.data[new_bucket_idx];
-        }
+                if ( in_map->slots[slot] == entry_index )
+                {
+                    return slot;
+                }
 
-end:
-        in_map->count++;
-        
-        if(out_idx != nullptr)
-        {
-            *out_idx = idx;
+                matches &= matches - 1;
+            }
+
+            if ( ControlGroup::MatchEmpty( group ) != 0 )
+            {
+                return INVALID_SLOT;
+            }
+
+            pos = (pos + ControlGroup::WIDTH) & mask;
         }
-        
-        return true;
     }
 
-    static bool TryGet( HMap* in_map, TKey key, TValue** out_val )
+    /// <summary>
+    /// Puts "entry_index" in the first empty slot starting from the key's home slot , the key must not be in the table already
+    /// </summary>
+    static void InsertSlot( HMap* in_map, uint32_t entry_index, uint64_t hash )
     {
-        size_t hash = in_map->hasher( key );
-        size_t index = hash % in_map->capacity;
-
-        // get the bucket using the mod'ed hash
-        BucketLimits* bucket = &in_map->bucket_per_hash.data[index];
-
-        if(bucket->index == -1)
-        {
-            goto end;
-        }
+        const size_t mask = in_map->slot_count - 1;
+        size_t pos = HomeSlot( in_map, hash );
 
-        // check if the key already exists
-        do
+        while ( true )
         {
-            TKey curr_key = in_map->all_keys.data[bucket->index];
+            uint32_t empties = ControlGroup::MatchEmpty( &in_map->control[pos] );
 
-            if ( !in_map->comparer( curr_key, key ) )
+            if ( empties != 0 )
             {
-                bucket = bucket->next_ptr;
-                continue;
+                size_t slot = (pos + ControlGroup::LowestBit( empties )) & mask;
+
+                SetControl( in_map, slot, H2( hash ) );
+                in_map->slots[slot] = entry_index;
+                return;
             }
 
-            TValue* value_ptr = &in_map->all_values.data[bucket->index];
-            *out_val = value_ptr;
-            return true;
+            pos = (pos + ControlGroup::WIDTH) & mask;
         }
-        while (bucket != nullptr);
-        
-end:
-        *out_val = {};
-        return false;
     }
 
     /// <summary>
-    /// Returns the content of the HMap as Key-Value pairs
+    /// Empties "slot" and shifts back the entries that follow it so that no entry is separated from its home slot by an empty slot
     /// </summary>
-    static void GetAll( HMap<TKey, TValue>* in_map, DArray<Pair<TKey, TValue>>* in_result )
+    static void EraseSlot( HMap* in_map, size_t slot )
     {
-        if(in_result->capacity < in_map->count)
-        {
-            DArray<Pair<TKey,TValue>>::Resize(in_result , in_map->count);
-        }
+        const size_t mask = in_map->slot_count - 1;
 
-        size_t idx = 0;
+        size_t hole = slot;
+        size_t curr = (slot + 1) & mask;
 
-        while(in_result->size < in_map->count)
+        while ( in_map->control[curr] != ControlGroup::EMPTY )
         {
-            BucketLimits curr_bucket = in_map->bucket_per_hash.data[idx];
+            uint64_t hash = Hash( in_map, in_map->all_keys.data[in_map->slots[curr]] );
+            size_t home = HomeSlot( in_map, hash );
 
-            if(curr_bucket.index != -1)
+            // the entry can move to the hole if the hole is between its home slot and its current slot
+            if ( ((curr - home) & mask) >= ((curr - hole) & mask) )
             {
-                Pair<TKey, TValue> pair = {};
-                pair.key = in_map->all_keys.data[curr_bucket.index];
-                pair.value = in_map->all_values.data[curr_bucket.index];
-
-                DArray<Pair<TKey, TValue>>::Add( in_result, pair );
+                SetControl( in_map, hole, in_map->control[curr] );
+                in_map->slots[hole] = in_map->slots[curr];
+                hole = curr;
             }
 
-            idx++;
-        }       
+            curr = (curr + 1) & mask;
+        }
+
+        SetControl( in_map, hole, ControlGroup::EMPTY );
     }
 
-    static bool TryRemove( HMap* in_map, TKey key, TValue* out_removed )
+public:
+
+    /// <summary>
+    /// <para>Initialize the dictionary with "capacity" being the number of entries it can hold before growing</para>
+    /// <para>The policies only need to be passed when they hold state (FuncHasher/FuncComparer take the function pointers directly)</para>
+    /// </summary>
+    static bool Create( HMap* out_map, Allocator alloc, size_t capacity, THasher hasher = {}, TComparer comparer = {} )
+    {
+        *out_map = {};
+        out_map->allocator = alloc;
+        out_map->capacity = capacity == 0 ? 1 : capacity;
+        out_map->hasher = hasher;
+        out_map->comparer = comparer;
+        out_map->count = 0;
+
+        DArray<TKey>::Create( out_map->capacity, &out_map->all_keys, alloc, false );
+        DArray<TValue>::Create( out_map->capacity, &out_map->all_values, alloc, false );
+
+        CreateTable( out_map, SlotCountFor( out_map->capacity ) );
+
+        return true;
+    }
+
+    static bool Destroy( HMap* in_map )
     {
-        size_t hash = in_map->hasher( key );
-        size_t index = hash % in_map->capacity;
+        DArray<TKey>::Destroy( &in_map->all_keys );
+        DArray<TValue>::Destroy( &in_map->all_values );
+
+        // the slots and the control bytes share the same block
+        FREE( in_map->allocator, in_map->slots );
+
+        *in_map = {};
 
-        // get the bucket using the mod'ed hash
-        BucketLimits* bucket_to_remove = &in_map->bucket_per_hash.data[index];
-        BucketLimits bucket_to_remove_val = *bucket_to_remove;
+        return true;
+    }
 
-        bool found = false;
+    static bool TryAdd( HMap* in_map, TKey key, TValue value, size_t* out_idx )
+    {
+        uint64_t hash = Hash( in_map, key );
 
-        // if the root is already empty , early exit
-        if(bucket_to_remove->index == -1)
+        if ( FindSlot( in_map, key, hash ) != INVALID_SLOT )
         {
-            *out_removed = {};
+            if ( out_idx != nullptr )
+            {
+                *out_idx = -1;
+            }
+
             return false;
         }
 
-        // check if the key already exists
-        while(bucket_to_remove != nullptr)
+        if ( (in_map->count + 1) > in_map->capacity )
         {
-            TKey curr_key = in_map->all_keys.data[bucket_to_remove->index];
-            found = in_map->comparer( curr_key, key );
-            
-            if ( found )
-            {
-                break;
-            }
+            Resize( in_map, in_map->capacity * 2 );
+        }
+
+        size_t idx = in_map->count;
+        DArray<TKey>::Add( &in_map->all_keys, key );
+        DArray<TValue>::Add( &in_map->all_values, value );
 
-            bucket_to_remove = bucket_to_remove->next_ptr;
+        InsertSlot( in_map, (uint32_t) idx, hash );
+
+        in_map->count++;
+
+        if ( out_idx != nullptr )
+        {
+            *out_idx = idx;
         }
 
-        if ( !found )
+        return true;
+    }
+
+    static bool TryGet( HMap* in_map, TKey key, TValue** out_val )
+    {
+        size_t slot = FindSlot( in_map, key, Hash( in_map, key ) );
+
+        if ( slot == INVALID_SLOT )
         {
-            *out_removed = {};
+            *out_val = {};
             return false;
         }
-    
-        *out_removed = in_map->all_values.data[bucket_to_remove_val.index];
 
-        if(bucket_to_remove->next_ptr == nullptr)
+        *out_val = &in_map->all_values.data[in_map->slots[slot]];
+        return true;
+    }
+
+    /// <summary>
+    /// Returns the content of the HMap as Key-Value pairs
+    /// </summary>
+    static void GetAll( HMap* in_map, DArray<Pair<TKey, TValue>>* in_result )
+    {
+        if ( in_result->capacity < in_result->size + in_map->count )
         {
-            *bucket_to_remove = EmptyBucket();
+            DArray<Pair<TKey, TValue>>::Resize( in_result, in_result->size + in_map->count );
         }
-        else
+
+        for ( size_t i = 0; i < in_map->count; ++i )
         {
-            *bucket_to_remove = *bucket_to_remove->next_ptr;
+            Pair<TKey, TValue> pair = {};
+            pair.key = in_map->all_keys.data[i];
+            pair.value = in_map->all_values.data[i];
+
+            DArray<Pair<TKey, TValue>>::Add( in_result, pair );
         }
+    }
 
-        DArray<TKey>::RemoveAt(&in_map->all_keys , bucket_to_remove_val.index );
-        DArray<TValue>::RemoveAt(&in_map->all_values , bucket_to_remove_val.index );
+    /// <summary>
+    /// <para>Removes the entry with "key" from the map</para>
+    /// <para>NOTE : the last entry is moved into the removed one's place , so the order of "all_keys" and "all_values" isn't kept</para>
+    /// </summary>
+    static bool TryRemove( HMap* in_map, TKey key, TValue* out_removed )
+    {
+        size_t slot = FindSlot( in_map, key, Hash( in_map, key ) );
 
-        for(size_t i = 0; i < in_map->count; ++i)
+        if ( slot == INVALID_SLOT )
         {
-            BucketLimits* curr = &in_map->bucket_per_hash.data[i];
+            *out_removed = {};
+            return false;
+        }
 
-            if(curr->index == -1)
-            {
-                continue;
-            }
-            if(curr->index > bucket_to_remove_val.index)
-            {
-                curr->index--;
-            }
+        uint32_t removed_idx = in_map->slots[slot];
+        uint32_t last_idx = (uint32_t) (in_map->count - 1);
+
+        *out_removed = in_map->all_values.data[removed_idx];
+
+        EraseSlot( in_map, slot );
+
+        // fill the gap in the dense arrays with the last entry
+        if ( removed_idx != last_idx )
+        {
+            TKey last_key = in_map->all_keys.data[last_idx];
+            size_t last_slot = FindSlotOfEntry( in_map, last_idx, Hash( in_map, last_key ) );
+            assert( last_slot != INVALID_SLOT );
+
+            in_map->slots[last_slot] = removed_idx;
+            in_map->all_keys.data[removed_idx] = last_key;
+            in_map->all_values.data[removed_idx] = in_map->all_values.data[last_idx];
         }
-        
+
+        in_map->all_keys.size--;
+        in_map->all_values.size--;
         in_map->count--;
 
         return true;
     }
 
-
     static void Resize( HMap* in_map, size_t new_capacity )
     {
-        int32_t diff = (uint32_t)new_capacity - (uint32_t)in_map->count;
-        assert( diff >= 0 );
+        assert( new_capacity >= in_map->count );
 
-        // TODO : actually expand the map
-        Allocator alloc = ArenaAllocator::Create( &CoreContext::core_arena );
-        size_t start_offset = CoreContext::core_arena.offset;
+        if ( new_capacity > in_map->all_keys.capacity )
         {
-            DArray<Pair<TKey, TValue>> pairs = {};
-            DArray<Pair<TKey, TValue>>::Create( in_map->count, &pairs, alloc );
-
-            // save the old values
-            HMap<TKey, TValue>::GetAll( in_map, &pairs );
+            DArray<TKey>::Resize( &in_map->all_keys, new_capacity );
+            DArray<TValue>::Resize( &in_map->all_values, new_capacity );
+        }
 
-            in_map->capacity = new_capacity;
-            in_map->count = 0;
+        in_map->capacity = new_capacity;
 
-            // TODO : find a way to resize without "keeping the data" since it will be reinserted anyways
-            {
-                // NOTE : the idea here is allocate all the space needed for the HMap in once contigious mem block
-                // since it will always be allocated together
-                const size_t total_size = ((sizeof(TKey) + sizeof(TValue) + sizeof(BucketLimits)) * new_capacity) + sizeof(HMap);
-                FREE(in_map->allocator, in_map->internal_arena.data);
-                in_map->internal_arena.data = ALLOC(in_map->allocator ,total_size );
-                in_map->internal_arena.capacity = total_size;
-                in_map->internal_arena.offset = 0;
-
-                Allocator internal_alloc = ArenaAllocator::Create(&in_map->internal_arena);
-                DArray<BucketLimits>::Create( new_capacity, &in_map->bucket_per_hash, internal_alloc );
-                DArray<TKey>::Create( new_capacity, &in_map->all_keys, internal_alloc );
-                DArray<TValue>::Create( new_capacity, &in_map->all_values, internal_alloc );
-
-                // init all to empty buckets
-                for(size_t i = 0; i < new_capacity; ++i)
-                {
-                    BucketLimits empty = EmptyBucket();
+        size_t new_slot_count = SlotCountFor( new_capacity );
 
-                    DArray<BucketLimits>::Add(&in_map->bucket_per_hash , empty);
-                }
+        if ( new_slot_count == in_map->slot_count )
+        {
+            return;
+        }
 
-            }
+        // the entries don't move , only the table is rebuilt
+        FREE( in_map->allocator, in_map->slots );
+        CreateTable( in_map, new_slot_count );
 
-            // add the key-value back into the new resized hmap
-            for ( size_t i = 0; i < pairs.size; ++i )
-            {
-                Pair<TKey,TValue> p = pairs.data[i];
-                HMap<TKey,TValue>::TryAdd(in_map , p.key , p.value , nullptr);
-            }
+        for ( size_t i = 0; i < in_map->count; ++i )
+        {
+            InsertSlot( in_map, (uint32_t) i, Hash( in_map, in_map->all_keys.data[i] ) );
         }
-        CoreContext::core_arena.offset = start_offset;
     }
-};
\ No newline at end of file
+};
+
+/// <summary>
+/// HMap that hashes and compares through function pointers given to Create , for keys without a built-in hash
+/// </summary>
+template<typename TKey, typename TValue>
+using FuncHMap = HMap<TKey, TValue, FuncHasher<TKey>, FuncComparer<TKey>>;
@@ -0,0 +1,241 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include "../Typedefs/Typedefs.h"
+#include "../Context/CoreContext.h"
+#include "../String/StringView.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// <para>Hashing and equality policies used by the hashed containers (HMap)</para>
+/// <para>A policy is a struct with a "Hash(key)" or "Equals(a , b)" member , picked as a template parameter so the probe loops can inline it</para>
+/// <para>The Func variants keep the old behaviour of calling through a function pointer given at creation</para>
+/// </summary>
+struct HashUtils
+{
+    /// <summary>
+    /// <para>64 bits hash of a block of bytes , same construction as wyhash : 8 bytes reads folded with 64x64->128 multiplies , 48 bytes per loop</para>
+    /// <para>Not cryptographic , it runs at memory speed on long keys and short keys cost a couple of multiplies</para>
+    /// </summary>
+    static inline uint64_t Hash64( const void* data, size_t size, uint64_t seed = 0 )
+    {
+        static constexpr uint64_t SECRET[4] = { 0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull };
+
+        const uint8_t* bytes = (const uint8_t*) data;
+        seed ^= Mix( seed ^ SECRET[0], SECRET[1] );
+
+        uint64_t a = 0;
+        uint64_t b = 0;
+
+        if ( size <= 16 )
+        {
+            if ( size >= 4 )
+            {
+                // two overlapping reads cover 4 to 16 bytes without a loop
+                size_t middle = (size >> 3) << 2;
+                a = (Read4( bytes ) << 32) | Read4( bytes + middle );
+                b = (Read4( bytes + size - 4 ) << 32) | Read4( bytes + size - 4 - middle );
+            }
+            else if ( size > 0 )
+            {
+                a = ((uint64_t) bytes[0] << 16) | ((uint64_t) bytes[size >> 1] << 8) | bytes[size - 1];
+            }
+        }
+        else
+        {
+            size_t remaining = size;
+
+            if ( remaining > 48 )
+            {
+                uint64_t seed_1 = seed;
+                uint64_t seed_2 = seed;
+
+                do
+                {
+                    seed = Mix( Read8( bytes ) ^ SECRET[1], Read8( bytes + 8 ) ^ seed );
+                    seed_1 = Mix( Read8( bytes + 16 ) ^ SECRET[2], Read8( bytes + 24 ) ^ seed_1 );
+                    seed_2 = Mix( Read8( bytes + 32 ) ^ SECRET[3], Read8( bytes + 40 ) ^ seed_2 );
+
+                    bytes += 48;
+                    remaining -= 48;
+                }
+                while ( remaining > 48 );
+
+                seed ^= seed_1 ^ seed_2;
+            }
+
+            while ( remaining > 16 )
+            {
+                seed = Mix( Read8( bytes ) ^ SECRET[1], Read8( bytes + 8 ) ^ seed );
+
+                bytes += 16;
+                remaining -= 16;
+            }
+
+            // the last 16 bytes , overlapping what the loops already read
+            a = Read8( bytes + remaining - 16 );
+            b = Read8( bytes + remaining - 8 );
+        }
+
+        a ^= SECRET[1];
+        b ^= seed;
+        Multiply( &a, &b );
+
+        return Mix( a ^ SECRET[0] ^ size, b ^ SECRET[1] );
+    }
+
+    static inline size_t HashBytes( const void* data, size_t size )
+    {
+        return (size_t) Hash64( data, size );
+    }
+
+private:
+
+    /// <summary>
+    /// Full 128 bits product of "a" and "b" , the low half goes back in "a" and the high half in "b"
+    /// </summary>
+    static inline void Multiply( uint64_t* a, uint64_t* b )
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+        *a = _umul128( *a, *b, b );
+#elif defined(__SIZEOF_INT128__)
+        __uint128_t product = (__uint128_t) *a * *b;
+        *a = (uint64_t) product;
+        *b = (uint64_t) (product >> 64);
+#else
+        uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+        uint64_t lo = t + (rm1 << 32);
+        uint64_t carry = (t < rl) + (lo < t);
+        *a = lo;
+        *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+    }
+
+    static inline uint64_t Mix( uint64_t a, uint64_t b )
+    {
+        Multiply( &a, &b );
+        return a ^ b;
+    }
+
+    // NOTE : little endian reads , memcpy compiles to a single unaligned load
+    static inline uint64_t Read8( const uint8_t* bytes )
+    {
+        uint64_t value;
+        memcpy( &value, bytes, sizeof( value ) );
+        return value;
+    }
+
+    static inline uint64_t Read4( const uint8_t* bytes )
+    {
+        uint32_t value;
+        memcpy( &value, bytes, sizeof( value ) );
+        return value;
+    }
+};
+
+/// <summary>
+/// <para>Built-in hash for integers , enums , pointers , StringView and POD structs</para>
+/// <para>NOTE : POD structs are hashed byte by byte , including their padding , so they have to be zero-initialized (= {}) before being filled</para>
+/// </summary>
+template<typename T>
+struct DefaultHasher
+{
+    inline size_t Hash( const T& key )
+    {
+        if constexpr ( std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> )
+        {
+            // the containers mix the bits themselves , no need to do more than a cast here
+            return (size_t) key;
+        }
+        else
+        {
+            static_assert( std::is_trivially_copyable_v<T>, "DefaultHasher only handles POD types , use FuncHasher or a custom policy" );
+            return HashUtils::HashBytes( &key, sizeof( T ) );
+        }
+    }
+};
+
+template<>
+struct DefaultHasher<StringView>
+{
+    inline size_t Hash( const StringView& key )
+    {
+        return HashUtils::HashBytes( key.buffer, key.length );
+    }
+};
+
+/// <summary>
+/// Built-in equality , same rules as DefaultHasher
+/// </summary>
+template<typename T>
+struct DefaultComparer
+{
+    inline bool Equals( const T& a, const T& b )
+    {
+        if constexpr ( std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> )
+        {
+            return a == b;
+        }
+        else
+        {
+            static_assert( std::is_trivially_copyable_v<T>, "DefaultComparer only handles POD types , use FuncComparer or a custom policy" );
+            return memcmp( &a, &b, sizeof( T ) ) == 0;
+        }
+    }
+};
+
+template<>
+struct DefaultComparer<StringView>
+{
+    inline bool Equals( const StringView& a, const StringView& b )
+    {
+        return a.length == b.length && memcmp( a.buffer, b.buffer, a.length ) == 0;
+    }
+};
+
+/// <summary>
+/// Hashes by calling the function pointer given at creation , for keys that need a custom hash
+/// </summary>
+template<typename T>
+struct FuncHasher
+{
+    Func<size_t, T> fnc;
+
+    FuncHasher() = default;
+
+    FuncHasher( Func<size_t, T> hasher )
+    {
+        fnc = hasher;
+    }
+
+    inline size_t Hash( const T& key )
+    {
+        return fnc( key );
+    }
+};
+
+/// <summary>
+/// Compares by calling the function pointer given at creation , for keys that need a custom equality
+/// </summary>
+template<typename T>
+struct FuncComparer
+{
+    Func<bool, T, T> fnc;
+
+    FuncComparer() = default;
+
+    FuncComparer( Func<bool, T, T> comparer )
+    {
+        fnc = comparer;
+    }
+
+    inline bool Equals( const T& a, const T& b )
+    {
+        return fnc( a, b );
+    }
+};
@@ -0,0 +1,170 @@
+#pragma once
+#include <stdint.h>
+#include <assert.h>
+#include "../Allocators/Allocator.h"
+#include "../Atomic/Atomic.h"
+
+/// <summary>
+/// <para>Fixed capacity lock-free queue , any number of threads can enqueue and a single thread dequeues (bounded Vyukov queue)</para>
+/// <para>Every cell carries a sequence number : a producer claims a cell with one compare-exchange on "enqueue_pos" ,
+/// writes it in place and publishes it by bumping the cell's sequence , the consumer only reads the sequences</para>
+/// <para>Items are written and read where they are (Reserve/Publish , Peek/Pop) , large items are never copied</para>
+/// <para>NOTE : the capacity has to be a power of two. A producer that reserved a cell and hasn't published it yet holds back the consumer</para>
+/// </summary>
+template<typename T>
+struct MPSCQueue
+{
+    struct Cell
+    {
+        volatile int64_t sequence;
+        T value;
+    };
+
+    Cell* cells;
+    size_t capacity;
+    size_t mask;
+    Allocator alloc;
+
+    // producers and the consumer write different cache lines
+    char padding_0[64];
+    volatile int64_t enqueue_pos;
+    char padding_1[64];
+    volatile int64_t dequeue_pos;
+    char padding_2[64];
+
+    static void Create( MPSCQueue* out_queue, size_t capacity, Allocator alloc )
+    {
+        assert( capacity != 0 && (capacity & (capacity - 1)) == 0 );
+
+        *out_queue = {};
+        out_queue->alloc = alloc;
+        out_queue->capacity = capacity;
+        out_queue->mask = capacity - 1;
+        out_queue->cells = (Cell*) ALLOC( alloc, sizeof( Cell ) * capacity );
+
+        for ( size_t i = 0; i < capacity; ++i )
+        {
+            out_queue->cells[i].sequence = (int64_t) i;
+        }
+    }
+
+    static void Destroy( MPSCQueue* inout_queue )
+    {
+        FREE( inout_queue->alloc, inout_queue->cells );
+        *inout_queue = {};
+    }
+
+    /// <summary>
+    /// <para>Any thread , claims the next cell and returns it to be written , nullptr if the queue is full</para>
+    /// <para>The cell is only visible to the consumer once "out_ticket" is given to Publish</para>
+    /// </summary>
+    static T* TryReserve( MPSCQueue* in_queue, int64_t* out_ticket )
+    {
+        int64_t pos = Atomic::Load( &in_queue->enqueue_pos );
+
+        while ( true )
+        {
+            Cell* cell = &in_queue->cells[pos & in_queue->mask];
+            int64_t diff = Atomic::Load( &cell->sequence ) - pos;
+
+            if ( diff == 0 )
+            {
+                int64_t prev = Atomic::CompareExchange( &in_queue->enqueue_pos, pos + 1, pos );
+
+                if ( prev == pos )
+                {
+                    *out_ticket = pos;
+                    return &cell->value;
+                }
+
+                pos = prev;
+            }
+            else if ( diff < 0 )
+            {
+                // the consumer hasn't freed this cell from the previous lap yet
+                return nullptr;
+            }
+            else
+            {
+                // another producer took it
+                pos = Atomic::Load( &in_queue->enqueue_pos );
+            }
+        }
+    }
+
+    static void Publish( MPSCQueue* in_queue, int64_t ticket )
+    {
+        Atomic::Store( &in_queue->cells[ticket & in_queue->mask].sequence, ticket + 1 );
+    }
+
+    static bool TryEnqueue( MPSCQueue* in_queue, const T& item )
+    {
+        int64_t ticket = 0;
+        T* cell = TryReserve( in_queue, &ticket );
+
+        if ( cell == nullptr )
+        {
+            return false;
+        }
+
+        *cell = item;
+        Publish( in_queue, ticket );
+
+        return true;
+    }
+
+    /// <summary>
+    /// Consumer only , the oldest published item or nullptr , it stays valid until Pop
+    /// </summary>
+    static T* TryPeek( MPSCQueue* in_queue )
+    {
+        int64_t pos = in_queue->dequeue_pos;
+        Cell* cell = &in_queue->cells[pos & in_queue->mask];
+
+        if ( Atomic::Load( &cell->sequence ) != pos + 1 )
+        {
+            return nullptr;
+        }
+
+        return &cell->value;
+    }
+
+    /// <summary>
+    /// Consumer only , gives the item returned by TryPeek back to the producers
+    /// </summary>
+    static void Pop( MPSCQueue* in_queue )
+    {
+        int64_t pos = in_queue->dequeue_pos;
+
+        Atomic::Store( &in_queue->cells[pos & in_queue->mask].sequence, pos + (int64_t) in_queue->capacity );
+        Atomic::Store( &in_queue->dequeue_pos, pos + 1 );
+    }
+
+    static bool TryDequeue( MPSCQueue* in_queue, T* out_item )
+    {
+        T* cell = TryPeek( in_queue );
+
+        if ( cell == nullptr )
+        {
+            return false;
+        }
+
+        *out_item = *cell;
+        Pop( in_queue );
+
+        return true;
+    }
+
+    /// <summary>
+    /// Any thread , how many items were ever reserved and ever popped. Popped catching up with a previous Reserved means everything before is consumed
+    /// </summary>
+    static int64_t ReservedCount( MPSCQueue* in_queue )
+    {
+        return Atomic::Load( &in_queue->enqueue_pos );
+    }
+
+    static int64_t PoppedCount( MPSCQueue* in_queue )
+    {
+        return Atomic::Load( &in_queue->dequeue_pos );
+    }
+};
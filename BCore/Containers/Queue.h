@@ -18,12 +18,12 @@ struct Queue
         *out_queue = {};
         out_queue->capacity = capacity;
         out_queue->alloc = alloc;
-        out_queue->data = (T *)out_queue->alloc.alloc(&out_queue->alloc, sizeof(T) * capacity);
+        out_queue->data = (T *)ALLOC(out_queue->alloc, sizeof(T) * capacity);
     }
 
     static void Destroy(Queue *out_queue)
     {
-        out_queue->alloc.free(&out_queue->alloc, out_queue->data);
+        FREE(out_queue->alloc, out_queue->data);
         *out_queue = {};
     }
 
@@ -31,6 +31,8 @@ struct Queue
     {
         assert(new_capacity > inout_queue->capacity);
 
+        size_t old_capacity = inout_queue->capacity;
+
         if (inout_queue->alloc.realloc)
         {
             T* new_data = (T *) REALLOC(inout_queue->alloc, inout_queue->data, new_capacity * sizeof(T));
@@ -40,7 +42,7 @@ struct Queue
         {
             T* old_data = inout_queue->data;
             T* new_data = (T *)ALLOC(inout_queue->alloc ,  new_capacity * sizeof(T));
-            CoreContext::mem_copy(old_data, new_data, inout_queue->size * sizeof(T));
+            CoreContext::mem_copy(old_data, new_data, old_capacity * sizeof(T));
 
             if (inout_queue->alloc.free)
             {
@@ -50,6 +52,20 @@ struct Queue
             inout_queue->data = new_data;
         }
 
+        // the items wrap around the old end , move the part before it to the new end so they stay in order
+        if (inout_queue->dequeque_index + inout_queue->size > old_capacity)
+        {
+            size_t tail_count = old_capacity - inout_queue->dequeque_index;
+            size_t new_dequeue_index = new_capacity - tail_count;
+
+            CoreContext::mem_move(inout_queue->data + inout_queue->dequeque_index, inout_queue->data + new_dequeue_index, tail_count * sizeof(T));
+            inout_queue->dequeque_index = new_dequeue_index;
+        }
+        else
+        {
+            inout_queue->enqueue_index = inout_queue->dequeque_index + inout_queue->size;
+        }
+
         inout_queue->capacity = new_capacity;
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <stdint.h>
 #include <memory>
+#include <string.h>
 #include "../Typedefs/Typedefs.h"
 #include "../Defines/Defines.h"
 
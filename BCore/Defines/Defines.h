@@ -1,69 +1,26 @@
 #pragma once
 
-#ifdef _CORE_EXPORT
-    #define CORE_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef _CORE_EXPORT
+        #define CORE_API __declspec(dllexport)
+    #else
+        #define CORE_API  __declspec(dllimport)
+    #endif
 #else
-    #define CORE_API  __declspec(dllimport)
+    #define CORE_API __attribute__((visibility("default")))
 #endif
 
 #ifdef _DEBUG
 
-    #define REALLOC(allocator , ptr , size)\
-        allocator.realloc( &allocator, ptr , size ); \
-        if(allocator.realloc != nullptr) {\
-            const char filename[] = __FILE__; \
-            const int line = __LINE__;\
-            AllocationData data = {};\
-            data.line_number = line;\
-            data.filepath = filename;\
-            data.user_data = nullptr;\
-            if(allocator.callbacks.realloc_callback){\
-                allocator.callbacks.realloc_callback(&allocator , ptr, size , data);\
-            }\
-        }\
-
-    #define FREE(allocator , ptr)\
-        if(allocator.free != nullptr) {\
-            allocator.free( &allocator, ptr ); \
-            const char filename[] = __FILE__; \
-            const int line = __LINE__;\
-            AllocationData data = {};\
-            data.line_number = line;\
-            data.filepath = filename;\
-            data.user_data = nullptr;\
-            if(allocator.callbacks.free_callback){\
-                allocator.callbacks.free_callback(&allocator , ptr , data);\
-            }\
-        }\
-
-    #define ALLOC_WITH_INFO(allocator , size , metadata) \
-        allocator.alloc( &allocator, size ); \
-        {\
-            const char filename[] = __FILE__; \
-            const int line = __LINE__;\
-            AllocationData data = {};\
-            data.line_number = line;\
-            data.filepath = filename;\
-            data.user_data = metadata;\
-            if(allocator.callbacks.alloc_callback){\
-                allocator.callbacks.alloc_callback(&allocator , size , data);\
-            }\
-        }\
-
-
-    #define ALLOC_NO_INFO(allocator , size) \
-        allocator.alloc( &allocator, size ); \
-        {\
-            const char filename[] = __FILE__; \
-            const int line = __LINE__;\
-            AllocationData data = {};\
-            data.line_number = line;\
-            data.filepath = filename;\
-            data.user_data = nullptr;\
-            if(allocator.callbacks.alloc_callback){\
-                allocator.callbacks.alloc_callback(&allocator , size , data);\
-            }\
-        }\
+    // NOTE : debug builds go through AllocationTracking (Allocator.h) , it calls the allocator's callbacks with the pointer and the call site
+
+    #define REALLOC(allocator , ptr , size) AllocationTracking::Realloc( allocator , ptr , size , __FILE__ , __LINE__ )
+
+    #define FREE(allocator , ptr) AllocationTracking::Free( allocator , ptr , __FILE__ , __LINE__ )
+
+    #define ALLOC_WITH_INFO(allocator , size , metadata) AllocationTracking::Alloc( allocator , size , __FILE__ , __LINE__ , metadata )
+
+    #define ALLOC_NO_INFO(allocator , size) AllocationTracking::Alloc( allocator , size , __FILE__ , __LINE__ , nullptr )
 
     #define GET_ALLOC_MACRO(_1,_2,_3,NAME,...) NAME
 
@@ -71,11 +28,19 @@
 
 #else
 
-    #define ALLOC(allocator , size) \
-    {\
-    allocator.alloc( &allocator, size ); \
-    const char filename[] = __FILE__; \
-    const int line = __LINE__;\
-    }\
+    // NOTE : release builds skip the tracking callbacks , the macros are plain calls so they can be used as expressions
+
+    #define REALLOC(allocator , ptr , size) allocator.realloc( &allocator, ptr , size )
+
+    // allocators that can't free (EmplaceAllocator) leave "free" null , same as AllocationTracking::Free in debug
+    #define FREE(allocator , ptr) ( allocator.free != nullptr ? allocator.free( &allocator, ptr ) : (void) 0 )
+
+    #define ALLOC_WITH_INFO(allocator , size , metadata) allocator.alloc( &allocator, size )
+
+    #define ALLOC_NO_INFO(allocator , size) allocator.alloc( &allocator, size )
+
+    #define GET_ALLOC_MACRO(_1,_2,_3,NAME,...) NAME
+
+    #define ALLOC(...) GET_ALLOC_MACRO(__VA_ARGS__,ALLOC_WITH_INFO, ALLOC_NO_INFO , )(__VA_ARGS__)
 
 #endif
\ No newline at end of file
@@ -0,0 +1,692 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../Allocators/Allocator.h"
+#include "../Allocators/ScratchArena.h"
+#include "../Atomic/Atomic.h"
+#include "../Atomic/AtomicLock.h"
+#include "../Containers/DArray.h"
+#include "../Containers/ChunkedBuffer.h"
+#include "../Serialization/JSONWriter.h"
+#include "../String/StringBuilder.h"
+#include "../Defer/Defer.h"
+#include "../Clock/Clock.h"
+
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PROFILER_HAS_TSC 1
+#else
+#define PROFILER_HAS_TSC 0
+#endif
+
+/// <summary>
+/// One closed zone , in ticks of FrameProfiler::Ticks
+/// </summary>
+struct ProfileEvent
+{
+    uint64_t start;
+    uint64_t end;
+    uint32_t zone;
+};
+
+/// <summary>
+/// <para>A recording thread's ring : the thread writes its events and moves "write_count" , EndFrame reads them and moves "read_count"</para>
+/// <para>When EndFrame falls a whole ring behind the thread drops its new events instead of waiting , "dropped_count" says how many</para>
+/// </summary>
+struct ProfileThread
+{
+    ProfileEvent* events;
+
+    char padding_0[64];
+    volatile int64_t write_count;
+    volatile int64_t dropped_count;
+    char padding_1[64];
+    volatile int64_t read_count;
+    char padding_2[64];
+
+    /// <summary>
+    /// EndFrame's copy of the last events , what ExportChromeTrace writes
+    /// </summary>
+    ProfileEvent* history;
+    int64_t history_count;
+
+    uint32_t id;
+    char name[32];
+};
+
+/// <summary>
+/// Rolling stats of a zone , the durations of its last SAMPLE_HISTORY calls
+/// </summary>
+struct ProfileZoneStats
+{
+    uint64_t* samples;
+    uint64_t sample_count;
+
+    uint32_t frame_calls;
+    uint32_t last_frame_calls;
+    uint64_t frame_ticks;
+    uint64_t last_frame_ticks;
+};
+
+struct ProfileZoneSummary
+{
+    const char* name;
+
+    /// <summary>
+    /// Calls in the last frame and the time they took together
+    /// </summary>
+    uint32_t frame_calls;
+    double frame_ms;
+
+    /// <summary>
+    /// Over the last SAMPLE_HISTORY calls
+    /// </summary>
+    double min_ms;
+    double avg_ms;
+    double p99_ms;
+    double max_ms;
+    size_t sample_count;
+};
+
+/// <summary>
+/// <para>CPU zones for the frame : PROFILE_SCOPE( "name" ) times the rest of the block with the time stamp counter and
+/// writes one event to the calling thread's ring , no lock , no allocation after the thread's first zone</para>
+/// <para>EndFrame , once per frame on the main thread , moves the events out of the rings into the per-zone stats (min , avg , p99 and max
+/// over the last calls) and into a longer history that ExportChromeTrace writes as Chrome trace events (chrome://tracing , Perfetto)</para>
+/// <para>The zones are registered by name once per call site , call sites with the same name share their stats</para>
+/// <para>NOTE : the macros write to the last created profiler , they do nothing before Create or after Destroy.
+/// Define PROFILER_DISABLED to compile them out</para>
+/// </summary>
+struct FrameProfiler
+{
+    static constexpr size_t MAX_THREADS = 64;
+    static constexpr size_t MAX_ZONES = 256;
+    static constexpr uint32_t INVALID_ZONE = UINT32_MAX;
+
+    // powers of two
+    static constexpr size_t EVENTS_PER_THREAD = 8 * 1'024;
+    static constexpr size_t HISTORY_PER_THREAD = 32 * 1'024;
+    static constexpr size_t SAMPLE_HISTORY = 256;
+
+    Allocator alloc;
+    AtomicLock lock;
+
+    /// <summary>
+    /// Filled once per thread under "lock" , the count is published after the pointer
+    /// </summary>
+    ProfileThread* threads[MAX_THREADS];
+    volatile int32_t thread_count;
+
+    /// <summary>
+    /// Tells the threads' cached rings apart when a profiler is destroyed and another one created at the same address
+    /// </summary>
+    int32_t generation;
+
+    ProfileZoneStats zones[MAX_ZONES];
+
+    uint64_t frame_samples[SAMPLE_HISTORY];
+    uint64_t frame_count;
+    uint64_t last_frame_ticks;
+
+    /// <summary>
+    /// Ticks and nanoseconds when created , the conversion between the two is refined from them as time goes on
+    /// </summary>
+    uint64_t base_ticks;
+    uint64_t base_ns;
+    double ns_per_tick;
+
+    static inline FrameProfiler* current = nullptr;
+
+    static void Create( FrameProfiler* out_profiler, Allocator alloc )
+    {
+        *out_profiler = {};
+        out_profiler->alloc = alloc;
+        out_profiler->generation = Atomic::Increment( &next_generation );
+
+        Calibrate( out_profiler );
+        out_profiler->last_frame_ticks = Ticks();
+
+        current = out_profiler;
+    }
+
+    /// <summary>
+    /// The threads that recorded into it must be done with their zones
+    /// </summary>
+    static void Destroy( FrameProfiler* in_profiler )
+    {
+        if ( current == in_profiler )
+        {
+            current = nullptr;
+        }
+
+        for ( int32_t i = 0; i < in_profiler->thread_count; ++i )
+        {
+            ProfileThread* thread = in_profiler->threads[i];
+
+            FREE( in_profiler->alloc, thread->events );
+            FREE( in_profiler->alloc, thread->history );
+            FREE( in_profiler->alloc, thread );
+        }
+
+        for ( size_t i = 0; i < MAX_ZONES; ++i )
+        {
+            if ( in_profiler->zones[i].samples != nullptr )
+            {
+                FREE( in_profiler->alloc, in_profiler->zones[i].samples );
+            }
+        }
+
+        *in_profiler = {};
+    }
+
+    /// <summary>
+    /// <para>Index of the zone called (name) , the same for every call site using the same name</para>
+    /// <para>(name) has to outlive the profilers , the macros pass literals. INVALID_ZONE once MAX_ZONES names are taken</para>
+    /// </summary>
+    static uint32_t RegisterZone( const char* name )
+    {
+        uint32_t index = INVALID_ZONE;
+
+        zone_lock.Lock();
+        {
+            for ( uint32_t i = 0; i < zone_count; ++i )
+            {
+                if ( strcmp( zone_names[i], name ) == 0 )
+                {
+                    index = i;
+                    break;
+                }
+            }
+
+            if ( index == INVALID_ZONE && zone_count < MAX_ZONES )
+            {
+                index = zone_count;
+                zone_names[zone_count++] = name;
+            }
+        }
+        zone_lock.Unlock();
+
+        return index;
+    }
+
+    static const char* GetZoneName( uint32_t zone )
+    {
+        const char* name = "";
+
+        zone_lock.Lock();
+        if ( zone < zone_count )
+        {
+            name = zone_names[zone];
+        }
+        zone_lock.Unlock();
+
+        return name;
+    }
+
+    /// <summary>
+    /// Shows up as the thread's name in the trace , (name) is copied
+    /// </summary>
+    static void SetThreadName( const char* name )
+    {
+        ProfileThread* thread = GetThread();
+
+        if ( thread == nullptr )
+        {
+            return;
+        }
+
+        current->lock.Lock();
+        snprintf( thread->name, sizeof( thread->name ), "%s", name );
+        current->lock.Unlock();
+    }
+
+    /// <summary>
+    /// The calling thread's ring in the current profiler , created on the thread's first zone. nullptr without a profiler or when MAX_THREADS are recording
+    /// </summary>
+    static ProfileThread* GetThread()
+    {
+        FrameProfiler* profiler = current;
+
+        if ( profiler == nullptr )
+        {
+            return nullptr;
+        }
+
+        if ( tls_generation == profiler->generation )
+        {
+            return tls_thread;
+        }
+
+        ProfileThread* thread = nullptr;
+
+        profiler->lock.Lock();
+        {
+            int32_t count = profiler->thread_count;
+
+            if ( count < (int32_t) MAX_THREADS )
+            {
+                thread = (ProfileThread*) ALLOC( profiler->alloc, sizeof( ProfileThread ) );
+                *thread = {};
+                thread->events = (ProfileEvent*) ALLOC( profiler->alloc, sizeof( ProfileEvent ) * EVENTS_PER_THREAD );
+                thread->history = (ProfileEvent*) ALLOC( profiler->alloc, sizeof( ProfileEvent ) * HISTORY_PER_THREAD );
+                thread->id = (uint32_t) count + 1;
+                snprintf( thread->name, sizeof( thread->name ), "Thread %u", thread->id );
+
+                profiler->threads[count] = thread;
+                Atomic::Store( &profiler->thread_count, count + 1 );
+            }
+        }
+        profiler->lock.Unlock();
+
+        tls_thread = thread;
+        tls_generation = profiler->generation;
+
+        return thread;
+    }
+
+    static inline void Record( ProfileThread* thread, uint32_t zone, uint64_t start, uint64_t end )
+    {
+        int64_t write_count = thread->write_count;
+
+        if ( write_count - Atomic::Load( &thread->read_count ) >= (int64_t) EVENTS_PER_THREAD )
+        {
+            Atomic::Store( &thread->dropped_count, thread->dropped_count + 1 );
+            return;
+        }
+
+        ProfileEvent* event = &thread->events[write_count & (EVENTS_PER_THREAD - 1)];
+        event->start = start;
+        event->end = end;
+        event->zone = zone;
+
+        Atomic::Store( &thread->write_count, write_count + 1 );
+    }
+
+    /// <summary>
+    /// Time stamp counter where there's one , nanoseconds otherwise
+    /// </summary>
+    static inline uint64_t Ticks()
+    {
+#if PROFILER_HAS_TSC
+        return __rdtsc();
+#else
+        return Clock::NowNs();
+#endif
+    }
+
+    static inline double TicksToMs( FrameProfiler* in_profiler, uint64_t ticks )
+    {
+        return (double) ticks * in_profiler->ns_per_tick / 1'000'000.0;
+    }
+
+    /// <summary>
+    /// <para>Closes the frame : takes the events out of every thread's ring into the zone stats and the trace history</para>
+    /// <para>NOTE : one thread only , the same one that calls Report , GetStats and ExportChromeTrace</para>
+    /// </summary>
+    static void EndFrame( FrameProfiler* in_profiler )
+    {
+        uint64_t now = Ticks();
+
+        in_profiler->frame_samples[in_profiler->frame_count % SAMPLE_HISTORY] = now - in_profiler->last_frame_ticks;
+        in_profiler->frame_count++;
+        in_profiler->last_frame_ticks = now;
+
+        // the longer the span the better the estimate , a second is plenty
+        uint64_t now_ns = Clock::NowNs();
+
+        if ( PROFILER_HAS_TSC && now_ns - in_profiler->base_ns > 1'000'000'000ull && now > in_profiler->base_ticks )
+        {
+            in_profiler->ns_per_tick = (double) (now_ns - in_profiler->base_ns) / (double) (now - in_profiler->base_ticks);
+        }
+
+        int32_t thread_count = Atomic::Load( &in_profiler->thread_count );
+
+        for ( int32_t t = 0; t < thread_count; ++t )
+        {
+            ProfileThread* thread = in_profiler->threads[t];
+
+            int64_t read_count = thread->read_count;
+            int64_t write_count = Atomic::Load( &thread->write_count );
+
+            for ( int64_t i = read_count; i < write_count; ++i )
+            {
+                ProfileEvent event = thread->events[i & (EVENTS_PER_THREAD - 1)];
+
+                thread->history[thread->history_count & (HISTORY_PER_THREAD - 1)] = event;
+                thread->history_count++;
+
+                AddSample( in_profiler, event.zone, event.end - event.start );
+            }
+
+            Atomic::Store( &thread->read_count, write_count );
+        }
+
+        for ( size_t i = 0; i < MAX_ZONES; ++i )
+        {
+            ProfileZoneStats* stats = &in_profiler->zones[i];
+
+            stats->last_frame_calls = stats->frame_calls;
+            stats->last_frame_ticks = stats->frame_ticks;
+            stats->frame_calls = 0;
+            stats->frame_ticks = 0;
+        }
+    }
+
+    /// <summary>
+    /// Every zone that was called at least once , the ones that took the most time in the last frame first
+    /// </summary>
+    static void GetStats( FrameProfiler* in_profiler, DArray<ProfileZoneSummary>* out_stats, Allocator alloc )
+    {
+        DArray<ProfileZoneSummary>::Create( 16, out_stats, alloc );
+
+        for ( uint32_t i = 0; i < MAX_ZONES; ++i )
+        {
+            ProfileZoneStats* stats = &in_profiler->zones[i];
+
+            if ( stats->sample_count == 0 )
+            {
+                continue;
+            }
+
+            ProfileZoneSummary summary = Summarize( in_profiler, stats->samples, stats->sample_count );
+            summary.name = GetZoneName( i );
+            summary.frame_calls = stats->last_frame_calls;
+            summary.frame_ms = TicksToMs( in_profiler, stats->last_frame_ticks );
+
+            DArray<ProfileZoneSummary>::Add( out_stats, summary );
+        }
+
+        ProfileZoneSummary* summaries = out_stats->data;
+
+        // insertion sort , there are a few dozen zones
+        for ( size_t i = 1; i < out_stats->size; ++i )
+        {
+            ProfileZoneSummary curr = summaries[i];
+            size_t j = i;
+
+            while ( j > 0 && summaries[j - 1].frame_ms < curr.frame_ms )
+            {
+                summaries[j] = summaries[j - 1];
+                --j;
+            }
+
+            summaries[j] = curr;
+        }
+    }
+
+    /// <summary>
+    /// The whole frame , from one EndFrame to the next , over the last SAMPLE_HISTORY frames
+    /// </summary>
+    static ProfileZoneSummary GetFrameStats( FrameProfiler* in_profiler )
+    {
+        ProfileZoneSummary summary = Summarize( in_profiler, in_profiler->frame_samples, in_profiler->frame_count );
+        summary.name = "Frame";
+        summary.frame_calls = 1;
+        summary.frame_ms = in_profiler->frame_count != 0 ? TicksToMs( in_profiler, in_profiler->frame_samples[(in_profiler->frame_count - 1) % SAMPLE_HISTORY] ) : 0;
+
+        return summary;
+    }
+
+    /// <summary>
+    /// The frame stats and a line per zone
+    /// </summary>
+    static void Report( FrameProfiler* in_profiler, StringBuilder* out_builder )
+    {
+        ScratchArena scratch = ScratchArena::Get( out_builder->alloc );
+        DEFER( [&](){ ScratchArena::Release( &scratch ); } );
+
+        DArray<ProfileZoneSummary> zones = {};
+        GetStats( in_profiler, &zones, scratch.alloc );
+
+        ProfileZoneSummary frame = GetFrameStats( in_profiler );
+
+        char line[512];
+
+        snprintf( line, sizeof( line ), "-- Frames : %llu , last %.3f ms , avg %.3f ms , p99 %.3f ms , max %.3f ms (last %zu frames)\n",
+            (unsigned long long) in_profiler->frame_count, frame.frame_ms, frame.avg_ms, frame.p99_ms, frame.max_ms, frame.sample_count );
+        StringBuilder::Append( out_builder, line );
+
+        snprintf( line, sizeof( line ), "%8s | %10s | %10s | %10s | %10s | %10s | %s\n", "calls", "frame ms", "min ms", "avg ms", "p99 ms", "max ms", "zone" );
+        StringBuilder::Append( out_builder, line );
+
+        for ( size_t i = 0; i < zones.size; ++i )
+        {
+            ProfileZoneSummary* zone = &zones.data[i];
+
+            snprintf( line, sizeof( line ), "%8u | %10.3f | %10.3f | %10.3f | %10.3f | %10.3f | %s\n",
+                zone->frame_calls, zone->frame_ms, zone->min_ms, zone->avg_ms, zone->p99_ms, zone->max_ms, zone->name );
+            StringBuilder::Append( out_builder, line );
+        }
+
+        int64_t dropped = 0;
+        int32_t thread_count = Atomic::Load( &in_profiler->thread_count );
+
+        for ( int32_t t = 0; t < thread_count; ++t )
+        {
+            dropped += Atomic::Load( &in_profiler->threads[t]->dropped_count );
+        }
+
+        if ( dropped != 0 )
+        {
+            snprintf( line, sizeof( line ), "-- %lld events dropped , EndFrame wasn't called often enough\n", (long long) dropped );
+            StringBuilder::Append( out_builder, line );
+        }
+    }
+
+    /// <summary>
+    /// <para>The trace history (up to HISTORY_PER_THREAD events per thread) as Chrome trace events , microseconds since the profiler was created</para>
+    /// <para>Open the result in chrome://tracing or ui.perfetto.dev</para>
+    /// </summary>
+    static void ExportChromeTrace( FrameProfiler* in_profiler, ChunkedBuffer* out )
+    {
+        JSONWriter writer = {};
+        JSONWriter::Create( &writer, out );
+
+        JSONWriter::BeginObject( &writer );
+        JSONWriter::Key( &writer, "displayTimeUnit" );
+        JSONWriter::String( &writer, "ms" );
+        JSONWriter::Key( &writer, "traceEvents" );
+        JSONWriter::BeginArray( &writer );
+
+        int32_t thread_count = Atomic::Load( &in_profiler->thread_count );
+
+        for ( int32_t t = 0; t < thread_count; ++t )
+        {
+            ProfileThread* thread = in_profiler->threads[t];
+
+            char name[sizeof( thread->name )];
+
+            in_profiler->lock.Lock();
+            memcpy( name, thread->name, sizeof( name ) );
+            in_profiler->lock.Unlock();
+
+            JSONWriter::BeginObject( &writer );
+            JSONWriter::Key( &writer, "name" );
+            JSONWriter::String( &writer, "thread_name" );
+            JSONWriter::Key( &writer, "ph" );
+            JSONWriter::String( &writer, "M" );
+            JSONWriter::Key( &writer, "pid" );
+            JSONWriter::Integer( &writer, 1 );
+            JSONWriter::Key( &writer, "tid" );
+            JSONWriter::Integer( &writer, thread->id );
+            JSONWriter::Key( &writer, "args" );
+            JSONWriter::BeginObject( &writer );
+            JSONWriter::Key( &writer, "name" );
+            JSONWriter::String( &writer, name );
+            JSONWriter::EndObject( &writer );
+            JSONWriter::EndObject( &writer );
+
+            int64_t first = thread->history_count > (int64_t) HISTORY_PER_THREAD ? thread->history_count - (int64_t) HISTORY_PER_THREAD : 0;
+
+            for ( int64_t i = first; i < thread->history_count; ++i )
+            {
+                ProfileEvent* event = &thread->history[i & (HISTORY_PER_THREAD - 1)];
+
+                // events from before the profiler was created can't happen , the thread only records into it after
+                double start_us = (double) (event->start - in_profiler->base_ticks) * in_profiler->ns_per_tick / 1'000.0;
+                double duration_us = (double) (event->end - event->start) * in_profiler->ns_per_tick / 1'000.0;
+
+                JSONWriter::BeginObject( &writer );
+                JSONWriter::Key( &writer, "name" );
+                JSONWriter::String( &writer, GetZoneName( event->zone ) );
+                JSONWriter::Key( &writer, "cat" );
+                JSONWriter::String( &writer, "cpu" );
+                JSONWriter::Key( &writer, "ph" );
+                JSONWriter::String( &writer, "X" );
+                JSONWriter::Key( &writer, "ts" );
+                JSONWriter::Float( &writer, start_us );
+                JSONWriter::Key( &writer, "dur" );
+                JSONWriter::Float( &writer, duration_us );
+                JSONWriter::Key( &writer, "pid" );
+                JSONWriter::Integer( &writer, 1 );
+                JSONWriter::Key( &writer, "tid" );
+                JSONWriter::Integer( &writer, thread->id );
+                JSONWriter::EndObject( &writer );
+            }
+        }
+
+        JSONWriter::EndArray( &writer );
+        JSONWriter::EndObject( &writer );
+    }
+
+private:
+
+    static inline const char* zone_names[MAX_ZONES] = {};
+    static inline uint32_t zone_count = 0;
+    static inline AtomicLock zone_lock = {};
+    static inline volatile int32_t next_generation = 0;
+
+    static inline thread_local ProfileThread* tls_thread = nullptr;
+    static inline thread_local int32_t tls_generation = 0;
+
+    static void Calibrate( FrameProfiler* in_profiler )
+    {
+        in_profiler->base_ticks = Ticks();
+        in_profiler->base_ns = Clock::NowNs();
+        in_profiler->ns_per_tick = 1.0;
+
+#if PROFILER_HAS_TSC
+        // a first estimate over a millisecond , EndFrame refines it
+        uint64_t now_ns = in_profiler->base_ns;
+
+        while ( now_ns - in_profiler->base_ns < 1'000'000ull )
+        {
+            now_ns = Clock::NowNs();
+        }
+
+        in_profiler->ns_per_tick = (double) (now_ns - in_profiler->base_ns) / (double) (Ticks() - in_profiler->base_ticks);
+#endif
+    }
+
+    static void AddSample( FrameProfiler* in_profiler, uint32_t zone, uint64_t ticks )
+    {
+        ProfileZoneStats* stats = &in_profiler->zones[zone];
+
+        if ( stats->samples == nullptr )
+        {
+            stats->samples = (uint64_t*) ALLOC( in_profiler->alloc, sizeof( uint64_t ) * SAMPLE_HISTORY );
+        }
+
+        stats->samples[stats->sample_count % SAMPLE_HISTORY] = ticks;
+        stats->sample_count++;
+        stats->frame_calls++;
+        stats->frame_ticks += ticks;
+    }
+
+    static ProfileZoneSummary Summarize( FrameProfiler* in_profiler, const uint64_t* samples, uint64_t sample_count )
+    {
+        ProfileZoneSummary summary = {};
+
+        size_t count = sample_count < SAMPLE_HISTORY ? (size_t) sample_count : SAMPLE_HISTORY;
+
+        if ( count == 0 )
+        {
+            return summary;
+        }
+
+        uint64_t sorted[SAMPLE_HISTORY];
+        uint64_t total = 0;
+
+        // insertion sort , at most SAMPLE_HISTORY samples
+        for ( size_t i = 0; i < count; ++i )
+        {
+            uint64_t curr = samples[i];
+            size_t j = i;
+
+            while ( j > 0 && sorted[j - 1] > curr )
+            {
+                sorted[j] = sorted[j - 1];
+                --j;
+            }
+
+            sorted[j] = curr;
+            total += curr;
+        }
+
+        // the smallest sample with at least 99% of the samples at or below it
+        size_t p99_index = (count * 99 + 99) / 100 - 1;
+
+        summary.min_ms = TicksToMs( in_profiler, sorted[0] );
+        summary.max_ms = TicksToMs( in_profiler, sorted[count - 1] );
+        summary.p99_ms = TicksToMs( in_profiler, sorted[p99_index] );
+        summary.avg_ms = TicksToMs( in_profiler, total ) / (double) count;
+        summary.sample_count = count;
+
+        return summary;
+    }
+};
+
+/// <summary>
+/// Records a zone from its construction to the end of its scope , see PROFILE_SCOPE
+/// </summary>
+struct ProfileScope
+{
+    ProfileThread* thread;
+    uint64_t start;
+    uint32_t zone;
+
+    ProfileScope( uint32_t zone ) : thread( nullptr ), start( 0 ), zone( zone )
+    {
+        if ( zone != FrameProfiler::INVALID_ZONE )
+        {
+            thread = FrameProfiler::GetThread();
+            start = FrameProfiler::Ticks();
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if ( thread != nullptr )
+        {
+            FrameProfiler::Record( thread, zone, start, FrameProfiler::Ticks() );
+        }
+    }
+};
+
+#ifndef PROFILER_DISABLED
+
+#define PROFILE_CONCAT_INNER(a , b) a##b
+#define PROFILE_CONCAT(a , b) PROFILE_CONCAT_INNER(a , b)
+
+// the zone is registered the first time the line runs , after that a scope costs two time stamps and a store
+#define PROFILE_SCOPE(name) \
+static const uint32_t PROFILE_CONCAT(profile_zone_ , __LINE__) = FrameProfiler::RegisterZone( name );\
+ProfileScope PROFILE_CONCAT(profile_scope_ , __LINE__)( PROFILE_CONCAT(profile_zone_ , __LINE__) )
+
+#define PROFILE_FUNCTION() PROFILE_SCOPE( __FUNCTION__ )
+
+#else
+
+#define PROFILE_SCOPE(name)
+
+#define PROFILE_FUNCTION()
+
+#endif
@@ -0,0 +1,644 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#include "../Containers/DArray.h"
+#include "../Containers/HMap.h"
+#include "../String/StringBuffer.h"
+#include "../Context/CoreContext.h"
+#include "../Allocators/Allocator.h"
+
+static_assert( sizeof( void* ) == 8, "The binary format stores 64 bits offsets in the pointer slots" );
+
+enum class BinaryKind : uint8_t
+{
+    // copied as raw bytes (numbers , enums , BMaths types , any struct without pointers)
+    Pod,
+    // described field by field by a BinaryDescriptor
+    Struct,
+    // DArray
+    Array,
+    // StringBuffer
+    String,
+    // HMap
+    Map
+};
+
+struct BinaryType;
+using BinaryTypeGetter = const BinaryType* (*)();
+
+struct BinaryField
+{
+    const char* name;
+    size_t offset;
+    // a getter rather than the type itself so that a struct can hold a DArray of itself
+    BinaryTypeGetter get_type;
+};
+
+/// <summary>
+/// Where the parts of a HMap instantiation are , it depends on the key , value and policy types
+/// </summary>
+struct BinaryMapLayout
+{
+    size_t control;
+    size_t slots;
+    size_t slot_count;
+    size_t keys;
+    size_t values;
+    size_t capacity;
+    size_t count;
+};
+
+struct BinaryType
+{
+    BinaryKind kind;
+    size_t size;
+    size_t alignment;
+
+    // Struct
+    const BinaryField* fields;
+    size_t field_count;
+
+    // Array : the element type , Map : the DArray of keys
+    BinaryTypeGetter get_element;
+
+    // Map : the DArray of values
+    BinaryTypeGetter get_values;
+    const BinaryMapLayout* map;
+};
+
+/// <summary>
+/// <para>Specialize it for every struct that holds DArrays , StringBuffers or HMaps (directly or not) with a VERSION and the list of FIELDS :</para>
+/// <para>template&lt;&gt; struct BinaryDescriptor&lt;Level&gt; { static constexpr uint32_t VERSION = 1; static constexpr BinaryField FIELDS[] = { BINARY_FIELD(Level , name) , BINARY_FIELD(Level , entities) }; };</para>
+/// <para>Fields that aren't listed are written as zeros , that's how runtime only state (gpu handles , caches) is left out</para>
+/// <para>NOTE : a member struct without a descriptor is copied as raw bytes , it must not hold pointers</para>
+/// </summary>
+template<typename T>
+struct BinaryDescriptor
+{
+};
+
+#define BINARY_FIELD(type , member) BinaryField{ #member , offsetof( type , member ) , &BinaryTypeOf<decltype( type::member )>::Get }
+
+template<typename T, typename = void>
+struct HasBinaryDescriptor : std::false_type
+{
+};
+
+template<typename T>
+struct HasBinaryDescriptor<T, std::void_t<decltype( BinaryDescriptor<T>::FIELDS )>> : std::true_type
+{
+};
+
+/// <summary>
+/// The BinaryType of "T" , built at compile time from its descriptor or from what the container templates look like
+/// </summary>
+template<typename T>
+struct BinaryTypeOf
+{
+    static constexpr BinaryType Make()
+    {
+        if constexpr ( HasBinaryDescriptor<T>::value )
+        {
+            constexpr size_t field_count = sizeof( BinaryDescriptor<T>::FIELDS ) / sizeof( BinaryField );
+            return BinaryType{ BinaryKind::Struct, sizeof( T ), alignof( T ), BinaryDescriptor<T>::FIELDS, field_count, nullptr, nullptr, nullptr };
+        }
+        else
+        {
+            static_assert( std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>, "Only POD types can be written without a BinaryDescriptor" );
+            return BinaryType{ BinaryKind::Pod, sizeof( T ), alignof( T ), nullptr, 0, nullptr, nullptr, nullptr };
+        }
+    }
+
+    static constexpr BinaryType TYPE = Make();
+
+    static const BinaryType* Get()
+    {
+        return &TYPE;
+    }
+};
+
+template<typename T>
+struct BinaryTypeOf<DArray<T>>
+{
+    static constexpr BinaryType TYPE = { BinaryKind::Array, sizeof( DArray<T> ), alignof( DArray<T> ), nullptr, 0, &BinaryTypeOf<T>::Get, nullptr, nullptr };
+
+    static const BinaryType* Get()
+    {
+        return &TYPE;
+    }
+};
+
+template<>
+struct BinaryTypeOf<StringBuffer>
+{
+    static constexpr BinaryType TYPE = { BinaryKind::String, sizeof( StringBuffer ), alignof( StringBuffer ), nullptr, 0, nullptr, nullptr, nullptr };
+
+    static const BinaryType* Get()
+    {
+        return &TYPE;
+    }
+};
+
+template<typename TKey, typename TValue, typename THasher, typename TComparer>
+struct BinaryTypeOf<HMap<TKey, TValue, THasher, TComparer>>
+{
+    using Map = HMap<TKey, TValue, THasher, TComparer>;
+
+    // the table is reused as it is , so the hashes of the keys can't depend on pointers or on state in the policies
+    static_assert( std::is_empty_v<THasher> && std::is_empty_v<TComparer>, "Only HMaps with stateless policies can be written" );
+    static_assert( BinaryTypeOf<TKey>::TYPE.kind == BinaryKind::Pod, "HMap keys have to be POD to be written" );
+
+    static constexpr BinaryMapLayout LAYOUT = { offsetof( Map, control ), offsetof( Map, slots ), offsetof( Map, slot_count ),
+        offsetof( Map, all_keys ), offsetof( Map, all_values ), offsetof( Map, capacity ), offsetof( Map, count ) };
+
+    static constexpr BinaryType TYPE = { BinaryKind::Map, sizeof( Map ), alignof( Map ), nullptr, 0,
+        &BinaryTypeOf<DArray<TKey>>::Get, &BinaryTypeOf<DArray<TValue>>::Get, &LAYOUT };
+
+    static const BinaryType* Get()
+    {
+        return &TYPE;
+    }
+};
+
+struct BinaryHeader
+{
+    uint32_t magic;
+    uint16_t format_version;
+    // ENDIAN_MARKER as written , reads differently on a host of the other endianness
+    uint16_t endian_marker;
+    // BinaryDescriptor<T>::VERSION of the root
+    uint32_t version;
+    // hash of the sizes , offsets and kinds of everything reachable from the root type
+    uint32_t layout_hash;
+    uint64_t size;
+    uint64_t root_offset;
+    // address the blob has been loaded at , 0 until then
+    uint64_t loaded_base;
+};
+
+/// <summary>
+/// <para>Binary format for BCore structs : the memory image of the root struct followed by the content of its DArrays , StringBuffers and HMaps ,
+/// with offsets from the start of the blob in the pointer slots</para>
+/// <para>Loading checks the header , then walks the descriptors once to turn the offsets back into pointers , there's no parsing
+/// and nothing is copied , the loaded structs point into the blob (that has to stay alive , and be writable if it's a mapped file)</para>
+/// <para>Loaded containers have no allocator : they are read only and must not be destroyed , freeing the blob frees everything.
+/// Little endian 64 bits hosts only , a blob written by a build with a different layout is rejected through "layout_hash"</para>
+/// </summary>
+struct BinarySerializer
+{
+    static constexpr uint32_t MAGIC = 'B' | ('B' << 8) | ('I' << 16) | ('N' << 24);
+    static constexpr uint16_t FORMAT_VERSION = 1;
+    static constexpr uint16_t ENDIAN_MARKER = 0x0102;
+
+    // the blob start has to be aligned on it , any allocator or mapped file is
+    static constexpr size_t ALIGNMENT = 16;
+
+    /// <summary>
+    /// Replaces the content of "out" with the blob of "value"
+    /// </summary>
+    template<typename T>
+    static void Write( const T* value, DArray<uint8_t>* out )
+    {
+        static_assert( HasBinaryDescriptor<T>::value, "The root needs a BinaryDescriptor" );
+        assert( IsLittleEndian() );
+
+        out->size = 0;
+
+        size_t header_offset = Allocate( out, sizeof( BinaryHeader ), ALIGNMENT );
+        size_t root_offset = Allocate( out, sizeof( T ), alignof( T ) > ALIGNMENT ? alignof( T ) : ALIGNMENT );
+
+        WriteValue( out, BinaryTypeOf<T>::Get(), (const uint8_t*) value, root_offset );
+
+        BinaryHeader* header = (BinaryHeader*) (out->data + header_offset);
+        header->magic = MAGIC;
+        header->format_version = FORMAT_VERSION;
+        header->endian_marker = ENDIAN_MARKER;
+        header->version = BinaryDescriptor<T>::VERSION;
+        header->layout_hash = LayoutHash<T>();
+        header->size = out->size;
+        header->root_offset = root_offset;
+    }
+
+    /// <summary>
+    /// <para>Checks the blob and fixes up its pointers in place , "out_root" points into the blob</para>
+    /// <para>Returns false when the blob is for another type , version or layout , or when an offset or a size goes out of the blob</para>
+    /// </summary>
+    template<typename T>
+    static bool Load( void* blob, size_t size, T** out_root )
+    {
+        static_assert( HasBinaryDescriptor<T>::value, "The root needs a BinaryDescriptor" );
+
+        *out_root = nullptr;
+
+        uint8_t* base = (uint8_t*) blob;
+        BinaryHeader* header = (BinaryHeader*) base;
+
+        if ( ((uintptr_t) base % ALIGNMENT) != 0 || size < sizeof( BinaryHeader ) )
+        {
+            return false;
+        }
+
+        bool is_valid_header = header->magic == MAGIC && header->format_version == FORMAT_VERSION && header->endian_marker == ENDIAN_MARKER &&
+            header->version == BinaryDescriptor<T>::VERSION && header->layout_hash == LayoutHash<T>() && header->size <= size &&
+            header->root_offset >= sizeof( BinaryHeader ) && header->root_offset % alignof( T ) == 0 && header->size >= sizeof( T ) &&
+            header->root_offset <= header->size - sizeof( T );
+
+        if ( !is_valid_header )
+        {
+            return false;
+        }
+
+        // already fixed up , only valid at the same address
+        if ( header->loaded_base != 0 )
+        {
+            *out_root = header->loaded_base == (uintptr_t) base ? (T*) (base + header->root_offset) : nullptr;
+            return *out_root != nullptr;
+        }
+
+        if ( !Fixup( base, header->size, BinaryTypeOf<T>::Get(), base + header->root_offset ) )
+        {
+            return false;
+        }
+
+        header->loaded_base = (uintptr_t) base;
+        *out_root = (T*) (base + header->root_offset);
+
+        return true;
+    }
+
+    template<typename T>
+    static uint32_t LayoutHash()
+    {
+        const BinaryType* visited[MAX_DEPTH] = {};
+        uint64_t hash = 0xCBF29CE484222325ull;
+
+        HashType( BinaryTypeOf<T>::Get(), visited, 0, &hash );
+
+        return (uint32_t) (hash ^ (hash >> 32));
+    }
+
+private:
+
+    static constexpr size_t MAX_DEPTH = 64;
+
+    static inline bool IsLittleEndian()
+    {
+        uint16_t marker = ENDIAN_MARKER;
+        return *(uint8_t*) &marker == 0x02;
+    }
+
+    /// <summary>
+    /// Zeroed block at the end of "out" , returns its offset
+    /// </summary>
+    static size_t Allocate( DArray<uint8_t>* out, size_t size, size_t alignment )
+    {
+        size_t offset = (out->size + alignment - 1) & ~(alignment - 1);
+        size_t end = offset + size;
+
+        if ( end > out->capacity )
+        {
+            size_t new_capacity = out->capacity * 2;
+            DArray<uint8_t>::Resize( out, end > new_capacity ? end : new_capacity );
+        }
+
+        CoreContext::mem_set( out->data + out->size, 0, end - out->size );
+        out->size = end;
+
+        return offset;
+    }
+
+    static bool HasPointers( const BinaryType* type )
+    {
+        if ( type->kind != BinaryKind::Struct )
+        {
+            return type->kind != BinaryKind::Pod;
+        }
+
+        for ( size_t i = 0; i < type->field_count; ++i )
+        {
+            if ( HasPointers( type->fields[i].get_type() ) )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// <summary>
+    /// Writes "src" at "dst" , a block that Allocate already zeroed. Anything pointed to is appended and its offset written in the pointer slot
+    /// </summary>
+    static void WriteValue( DArray<uint8_t>* out, const BinaryType* type, const uint8_t* src, size_t dst )
+    {
+        switch ( type->kind )
+        {
+        case BinaryKind::Pod:
+        {
+            CoreContext::mem_copy( (void*) src, out->data + dst, type->size );
+            return;
+        }
+        case BinaryKind::Struct:
+        {
+            for ( size_t i = 0; i < type->field_count; ++i )
+            {
+                const BinaryField* field = &type->fields[i];
+                WriteValue( out, field->get_type(), src + field->offset, dst + field->offset );
+            }
+            return;
+        }
+        case BinaryKind::Array:
+        {
+            // every DArray has the same layout , whatever its element type
+            const DArray<uint8_t>* arr = (const DArray<uint8_t>*) src;
+            const BinaryType* element = type->get_element();
+
+            size_t count = arr->size;
+            size_t offset = 0;
+
+            if ( count != 0 )
+            {
+                offset = Allocate( out, count * element->size, element->alignment );
+
+                if ( HasPointers( element ) )
+                {
+                    for ( size_t i = 0; i < count; ++i )
+                    {
+                        WriteValue( out, element, arr->data + (i * element->size), offset + (i * element->size) );
+                    }
+                }
+                else
+                {
+                    CoreContext::mem_copy( arr->data, out->data + offset, count * element->size );
+                }
+            }
+
+            // after the writes above , they can move "out"
+            DArray<uint8_t>* image = (DArray<uint8_t>*) (out->data + dst);
+            image->data = (uint8_t*) (uintptr_t) offset;
+            image->size = count;
+            image->capacity = count;
+            return;
+        }
+        case BinaryKind::String:
+        {
+            const StringBuffer* str = (const StringBuffer*) src;
+
+            size_t length = str->buffer != nullptr ? str->length : 0;
+            size_t offset = 0;
+
+            if ( length != 0 )
+            {
+                // the terminator comes from the zeroed block
+                offset = Allocate( out, length + 1, 1 );
+                CoreContext::mem_copy( str->buffer, out->data + offset, length );
+            }
+
+            StringBuffer* image = (StringBuffer*) (out->data + dst);
+            image->buffer = (char*) (uintptr_t) offset;
+            image->length = length;
+            return;
+        }
+        case BinaryKind::Map:
+        {
+            const BinaryMapLayout* layout = type->map;
+
+            size_t slot_count = *(const size_t*) (src + layout->slot_count);
+            const uint32_t* slots = *(uint32_t* const*) (src + layout->slots);
+            const uint8_t* control = *(uint8_t* const*) (src + layout->control);
+
+            // same single block as HMap::CreateTable , slots then control bytes
+            size_t slots_size = sizeof( uint32_t ) * slot_count;
+            size_t table = Allocate( out, slots_size + slot_count + ControlGroup::WIDTH, alignof( uint32_t ) );
+
+            CoreContext::mem_copy( (void*) slots, out->data + table, slots_size );
+            CoreContext::mem_copy( (void*) control, out->data + table + slots_size, slot_count + ControlGroup::WIDTH );
+
+            WriteValue( out, type->get_element(), src + layout->keys, dst + layout->keys );
+            WriteValue( out, type->get_values(), src + layout->values, dst + layout->values );
+
+            uint8_t* image = out->data + dst;
+            *(size_t*) (image + layout->slot_count) = slot_count;
+            *(size_t*) (image + layout->capacity) = *(const size_t*) (src + layout->capacity);
+            *(size_t*) (image + layout->count) = *(const size_t*) (src + layout->count);
+            *(uintptr_t*) (image + layout->slots) = table;
+            *(uintptr_t*) (image + layout->control) = table + slots_size;
+            return;
+        }
+        }
+    }
+
+    /// <summary>
+    /// Checks that [offset , offset + count * size) is inside the blob , after the header
+    /// </summary>
+    static inline bool IsInside( size_t blob_size, uint64_t offset, size_t count, size_t size )
+    {
+        return offset >= sizeof( BinaryHeader ) && offset <= blob_size && count <= (blob_size - offset) / size;
+    }
+
+    static bool Fixup( uint8_t* base, size_t blob_size, const BinaryType* type, uint8_t* value )
+    {
+        switch ( type->kind )
+        {
+        case BinaryKind::Pod:
+        {
+            return true;
+        }
+        case BinaryKind::Struct:
+        {
+            for ( size_t i = 0; i < type->field_count; ++i )
+            {
+                const BinaryField* field = &type->fields[i];
+
+                if ( !Fixup( base, blob_size, field->get_type(), value + field->offset ) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case BinaryKind::Array:
+        {
+            DArray<uint8_t>* arr = (DArray<uint8_t>*) value;
+            const BinaryType* element = type->get_element();
+
+            uint64_t offset = (uintptr_t) arr->data;
+            size_t count = arr->size;
+
+            arr->capacity = count;
+            arr->alloc = {};
+
+            if ( count == 0 )
+            {
+                arr->data = nullptr;
+                return true;
+            }
+
+            if ( !IsInside( blob_size, offset, count, element->size ) || offset % element->alignment != 0 )
+            {
+                return false;
+            }
+
+            arr->data = base + offset;
+
+            if ( !HasPointers( element ) )
+            {
+                return true;
+            }
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                if ( !Fixup( base, blob_size, element, arr->data + (i * element->size) ) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case BinaryKind::String:
+        {
+            StringBuffer* str = (StringBuffer*) value;
+
+            uint64_t offset = (uintptr_t) str->buffer;
+            str->alloc = {};
+
+            if ( str->length == 0 )
+            {
+                str->buffer = nullptr;
+                return true;
+            }
+
+            if ( !IsInside( blob_size, offset, str->length + 1, 1 ) || base[offset + str->length] != '\0' )
+            {
+                return false;
+            }
+
+            str->buffer = (char*) (base + offset);
+            return true;
+        }
+        case BinaryKind::Map:
+        {
+            const BinaryMapLayout* layout = type->map;
+
+            size_t slot_count = *(size_t*) (value + layout->slot_count);
+            size_t count = *(size_t*) (value + layout->count);
+            uint64_t table = *(uintptr_t*) (value + layout->slots);
+
+            bool is_valid_table = slot_count >= ControlGroup::WIDTH && (slot_count & (slot_count - 1)) == 0 && table % alignof( uint32_t ) == 0 &&
+                IsInside( blob_size, table, (sizeof( uint32_t ) * slot_count) + slot_count + ControlGroup::WIDTH, 1 );
+
+            if ( !is_valid_table )
+            {
+                return false;
+            }
+
+            if ( !Fixup( base, blob_size, type->get_element(), value + layout->keys ) || !Fixup( base, blob_size, type->get_values(), value + layout->values ) )
+            {
+                return false;
+            }
+
+            const DArray<uint8_t>* keys = (const DArray<uint8_t>*) (value + layout->keys);
+            const DArray<uint8_t>* values = (const DArray<uint8_t>*) (value + layout->values);
+
+            uint32_t* slots = (uint32_t*) (base + table);
+            uint8_t* control = base + table + (sizeof( uint32_t ) * slot_count);
+
+            // the probe loops trust the table : every full slot points to an entry , at least one slot is empty so they stop ,
+            // and the tail mirrors the first group so a probe never reads a slot whose real control byte is empty
+            bool is_valid_entries = keys->size == count && values->size == count && count < slot_count &&
+                CoreContext::mem_compare( control + slot_count, control, ControlGroup::WIDTH );
+
+            size_t full_count = 0;
+
+            for ( size_t i = 0; i < slot_count && is_valid_entries; ++i )
+            {
+                bool is_full = control[i] < ControlGroup::EMPTY;
+
+                is_valid_entries = is_full ? slots[i] < count : control[i] == ControlGroup::EMPTY;
+                full_count += (size_t) is_full;
+            }
+
+            if ( !is_valid_entries || full_count != count )
+            {
+                return false;
+            }
+
+            *(uint32_t**) (value + layout->slots) = slots;
+            *(uint8_t**) (value + layout->control) = control;
+            *(size_t*) (value + layout->capacity) = count < *(size_t*) (value + layout->capacity) ? *(size_t*) (value + layout->capacity) : count;
+            return true;
+        }
+        }
+
+        return false;
+    }
+
+    static inline void HashValue( uint64_t* inout_hash, uint64_t value )
+    {
+        for ( size_t i = 0; i < sizeof( value ); ++i )
+        {
+            *inout_hash ^= (value >> (i * 8)) & 0xFF;
+            *inout_hash *= 0x100000001B3ull;
+        }
+    }
+
+    static void HashType( const BinaryType* type, const BinaryType** visited, size_t depth, uint64_t* inout_hash )
+    {
+        HashValue( inout_hash, (uint64_t) type->kind );
+        HashValue( inout_hash, type->size );
+        HashValue( inout_hash, type->alignment );
+
+        // recursive types , or too deep to matter
+        for ( size_t i = 0; i < depth; ++i )
+        {
+            if ( visited[i] == type )
+            {
+                HashValue( inout_hash, i );
+                return;
+            }
+        }
+
+        if ( depth == MAX_DEPTH )
+        {
+            return;
+        }
+
+        visited[depth] = type;
+
+        switch ( type->kind )
+        {
+        case BinaryKind::Struct:
+        {
+            HashValue( inout_hash, type->field_count );
+
+            for ( size_t i = 0; i < type->field_count; ++i )
+            {
+                HashValue( inout_hash, type->fields[i].offset );
+                HashType( type->fields[i].get_type(), visited, depth + 1, inout_hash );
+            }
+            break;
+        }
+        case BinaryKind::Array:
+        {
+            HashType( type->get_element(), visited, depth + 1, inout_hash );
+            break;
+        }
+        case BinaryKind::Map:
+        {
+            const BinaryMapLayout* layout = type->map;
+            const size_t offsets[] = { layout->control, layout->slots, layout->slot_count, layout->keys, layout->values, layout->capacity, layout->count };
+
+            for ( size_t offset : offsets )
+            {
+                HashValue( inout_hash, offset );
+            }
+
+            HashType( type->get_element(), visited, depth + 1, inout_hash );
+            HashType( type->get_values(), visited, depth + 1, inout_hash );
+            break;
+        }
+        default:
+            break;
+        }
+    }
+};
@@ -0,0 +1,627 @@
+#pragma once
+#include <stdint.h>
+#include "JSONSerializer.h"
+#include "../Containers/DArray.h"
+#include "../Context/CoreContext.h"
+#include "../Allocators/Allocator.h"
+#include "../Allocators/ScratchArena.h"
+#include "../Defer/Defer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON_SSE2 1
+#include <emmintrin.h>
+#else
+#define JSON_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// <para>Stage one of JSONParser : the positions of every structural character ({ } [ ] : ,) outside of strings and of every unescaped quote</para>
+/// <para>The input goes through 64 bytes at a time , each block is classified into bitmasks (with SSE2 when available) and the string regions
+/// come from a prefix xor of the quote mask , so no character is looked at one by one unless the block has a backslash</para>
+/// <para>The last position is always a sentinel equal to the input length</para>
+/// </summary>
+struct JSONStructuralIndex
+{
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    // NOTE : positions are 32 bits , inputs are limited to 4GB
+    DArray<uint32_t> positions;
+
+    static void Create( JSONStructuralIndex* out_index, size_t capacity, Allocator alloc )
+    {
+        DArray<uint32_t>::Create( capacity + BLOCK_SIZE, &out_index->positions, alloc, false );
+    }
+
+    static void Destroy( JSONStructuralIndex* index )
+    {
+        DArray<uint32_t>::Destroy( &index->positions );
+    }
+
+    /// <summary>
+    /// Fills the index from "json" , returns false if the input ends inside a string
+    /// </summary>
+    static bool Build( JSONStructuralIndex* index, StringView json )
+    {
+        assert( json.length < UINT32_MAX );
+
+        DArray<uint32_t>* positions = &index->positions;
+        size_t size = 0;
+
+        // all ones when the previous block ended inside a string
+        uint64_t in_string = 0;
+        bool prev_escaped = false;
+
+        char tail[BLOCK_SIZE];
+
+        for ( size_t offset = 0; offset < json.length; offset += BLOCK_SIZE )
+        {
+            const char* block = json.buffer + offset;
+            size_t remaining = json.length - offset;
+
+            // last partial block is padded with spaces
+            if ( remaining < BLOCK_SIZE )
+            {
+                CoreContext::mem_set( tail, ' ', BLOCK_SIZE );
+                CoreContext::mem_copy( (void*) block, tail, remaining );
+                block = tail;
+            }
+
+            uint64_t quotes = 0;
+            uint64_t backslashes = 0;
+            uint64_t operators = 0;
+            Classify( block, &quotes, &backslashes, &operators );
+
+            if ( backslashes != 0 || prev_escaped )
+            {
+                quotes &= ~EscapedMask( backslashes, &prev_escaped );
+            }
+
+            // strings include their opening quote but not their closing one
+            uint64_t string_mask = PrefixXor( quotes ) ^ in_string;
+            in_string = (uint64_t) ((int64_t) string_mask >> 63);
+
+            uint64_t structurals = (operators & ~string_mask) | quotes;
+
+            if ( positions->capacity < size + BLOCK_SIZE + 1 )
+            {
+                positions->size = size;
+                DArray<uint32_t>::Resize( positions, (positions->capacity * 2) + BLOCK_SIZE + 1 );
+            }
+
+            // writes 4 positions per step whatever the count , the extra ones land in the slack and get overwritten ,
+            // this trades a few stores for a lot less branch mispredictions on dense inputs
+            uint32_t* out = positions->data + size;
+            uint32_t count = PopCount( structurals );
+
+            for ( uint32_t i = 0; i < count; i += 4 )
+            {
+                out[i] = (uint32_t) offset + LowestBit( structurals );
+                structurals &= structurals - 1;
+                out[i + 1] = (uint32_t) offset + LowestBit( structurals );
+                structurals &= structurals - 1;
+                out[i + 2] = (uint32_t) offset + LowestBit( structurals );
+                structurals &= structurals - 1;
+                out[i + 3] = (uint32_t) offset + LowestBit( structurals );
+                structurals &= structurals - 1;
+            }
+
+            size += count;
+        }
+
+        positions->size = size;
+
+        DArray<uint32_t>::Add( positions, (uint32_t) json.length );
+
+        return in_string == 0;
+    }
+
+    /// <summary>
+    /// Bitmasks of the quotes , backslashes and structural characters in a 64 bytes block , bit i is byte i
+    /// </summary>
+    static inline void Classify( const char* block, uint64_t* out_quotes, uint64_t* out_backslashes, uint64_t* out_operators )
+    {
+#if JSON_SSE2
+        const __m128i quote = _mm_set1_epi8( '"' );
+        const __m128i backslash = _mm_set1_epi8( '\\' );
+        const __m128i colon = _mm_set1_epi8( ':' );
+        const __m128i comma = _mm_set1_epi8( ',' );
+        const __m128i case_bit = _mm_set1_epi8( 0x20 );
+        const __m128i open_brace = _mm_set1_epi8( '{' );
+        const __m128i close_brace = _mm_set1_epi8( '}' );
+
+        uint64_t quotes = 0;
+        uint64_t backslashes = 0;
+        uint64_t operators = 0;
+
+        for ( size_t i = 0; i < BLOCK_SIZE / 16; ++i )
+        {
+            __m128i chunk = _mm_loadu_si128( (const __m128i*) (block + (i * 16)) );
+
+            // '[' and ']' are '{' and '}' without the 0x20 bit , no other character folds onto them
+            __m128i folded = _mm_or_si128( chunk, case_bit );
+            __m128i ops = _mm_or_si128( _mm_cmpeq_epi8( folded, open_brace ), _mm_cmpeq_epi8( folded, close_brace ) );
+            ops = _mm_or_si128( ops, _mm_cmpeq_epi8( chunk, colon ) );
+            ops = _mm_or_si128( ops, _mm_cmpeq_epi8( chunk, comma ) );
+
+            size_t shift = i * 16;
+            quotes |= (uint64_t) (uint32_t) _mm_movemask_epi8( _mm_cmpeq_epi8( chunk, quote ) ) << shift;
+            backslashes |= (uint64_t) (uint32_t) _mm_movemask_epi8( _mm_cmpeq_epi8( chunk, backslash ) ) << shift;
+            operators |= (uint64_t) (uint32_t) _mm_movemask_epi8( ops ) << shift;
+        }
+
+        *out_quotes = quotes;
+        *out_backslashes = backslashes;
+        *out_operators = operators;
+#else
+        uint64_t quotes = 0;
+        uint64_t backslashes = 0;
+        uint64_t operators = 0;
+
+        for ( size_t i = 0; i < BLOCK_SIZE; ++i )
+        {
+            char c = block[i];
+            bool is_operator = c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+
+            quotes |= (uint64_t) (c == '"') << i;
+            backslashes |= (uint64_t) (c == '\\') << i;
+            operators |= (uint64_t) is_operator << i;
+        }
+
+        *out_quotes = quotes;
+        *out_backslashes = backslashes;
+        *out_operators = operators;
+#endif
+    }
+
+    /// <summary>
+    /// <para>Bits of the characters escaped by a backslash , "inout_prev_escaped" carries a backslash ending the block to the next one</para>
+    /// <para>Only blocks with backslashes get here , so walking them bit by bit is fine</para>
+    /// </summary>
+    static inline uint64_t EscapedMask( uint64_t backslashes, bool* inout_prev_escaped )
+    {
+        uint64_t escaped = 0;
+
+        if ( *inout_prev_escaped )
+        {
+            escaped = 1;
+            backslashes &= ~(uint64_t) 1;
+        }
+
+        *inout_prev_escaped = false;
+
+        while ( backslashes != 0 )
+        {
+            uint32_t bit = LowestBit( backslashes );
+
+            if ( bit == 63 )
+            {
+                *inout_prev_escaped = true;
+            }
+            else
+            {
+                // an escaped backslash doesn't escape anything
+                uint64_t next = (uint64_t) 1 << (bit + 1);
+                escaped |= next;
+                backslashes &= ~next;
+            }
+
+            backslashes &= backslashes - 1;
+        }
+
+        return escaped;
+    }
+
+    /// <summary>
+    /// Bit i is the xor of bits 0 to i , turns quote bits into "inside a string" bits
+    /// </summary>
+    static inline uint64_t PrefixXor( uint64_t mask )
+    {
+        mask ^= mask << 1;
+        mask ^= mask << 2;
+        mask ^= mask << 4;
+        mask ^= mask << 8;
+        mask ^= mask << 16;
+        mask ^= mask << 32;
+
+        return mask;
+    }
+
+    /// <summary>
+    /// Index of the lowest set bit , 63 for an empty mask
+    /// </summary>
+    static inline uint32_t LowestBit( uint64_t mask )
+    {
+        mask |= (uint64_t) 1 << 63;
+
+#ifdef _MSC_VER
+        unsigned long idx = 0;
+        _BitScanForward64( &idx, mask );
+        return (uint32_t) idx;
+#else
+        return (uint32_t) __builtin_ctzll( mask );
+#endif
+    }
+
+    static inline uint32_t PopCount( uint64_t mask )
+    {
+#ifdef _MSC_VER
+        return (uint32_t) __popcnt64( mask );
+#else
+        return (uint32_t) __builtin_popcountll( mask );
+#endif
+    }
+};
+
+struct JSONParserState
+{
+    StringView json;
+    const uint32_t* positions;
+    size_t positions_count;
+
+    // next structural position to look at
+    size_t current;
+
+    // first character after the last consumed structural
+    size_t text_offset;
+
+    // finished children of the containers being parsed , moved to the tree when their container closes
+    DArray<JSONNode> pending;
+};
+
+/// <summary>
+/// <para>Single pass JSON parser , stage one builds a JSONStructuralIndex , stage two walks the index and builds the JSONNode tree</para>
+/// <para>Nodes are allocated with the given allocator , an arena allocator fits best since the tree is thrown away all at once</para>
+/// <para>Names and values are views into the source , nothing is copied , so the source has to outlive the tree.
+/// Escape sequences are left as they are in the source</para>
+/// </summary>
+struct JSONParser
+{
+    static constexpr size_t MAX_DEPTH = 1'024;
+
+    /// <summary>
+    /// Parses "json" into "out_root" , returns false on malformed input (the nodes built so far stay in "alloc")
+    /// </summary>
+    static bool Parse( StringView json, JSONNode* out_root, Allocator alloc )
+    {
+        *out_root = {};
+
+        ScratchArena scratch = ScratchArena::Get( alloc );
+        DEFER( [&]() { ScratchArena::Release( &scratch ); } );
+
+        JSONStructuralIndex index = {};
+        JSONStructuralIndex::Create( &index, json.length / 4, scratch.alloc );
+
+        if ( !JSONStructuralIndex::Build( &index, json ) )
+        {
+            return false;
+        }
+
+        JSONParserState state = {};
+        state.json = json;
+        state.positions = index.positions.data;
+        state.positions_count = index.positions.size;
+        DArray<JSONNode>::Create( 64, &state.pending, scratch.alloc, false );
+
+        if ( !ParseValue( &state, out_root, alloc, 0 ) )
+        {
+            return false;
+        }
+
+        // only the sentinel and blanks can follow the root
+        bool is_done = state.current == state.positions_count - 1 && IsBlank( json, state.text_offset, json.length );
+
+        return is_done;
+    }
+
+private:
+
+    static inline bool IsSpace( char c )
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    static inline bool IsBlank( StringView json, size_t start, size_t end )
+    {
+        for ( size_t i = start; i < end; ++i )
+        {
+            if ( !IsSpace( json.buffer[i] ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static inline bool IsAtEnd( JSONParserState* state )
+    {
+        return state->current >= state->positions_count - 1;
+    }
+
+    /// <summary>
+    /// Next structural character , '\0' for the sentinel
+    /// </summary>
+    static inline char Peek( JSONParserState* state )
+    {
+        if ( IsAtEnd( state ) )
+        {
+            return '\0';
+        }
+
+        return state->json.buffer[state->positions[state->current]];
+    }
+
+    /// <summary>
+    /// Consumes the next structural if it's "c" and only blanks are in front of it
+    /// </summary>
+    static inline bool Expect( JSONParserState* state, char c )
+    {
+        if ( Peek( state ) != c || !IsBlank( state->json, state->text_offset, state->positions[state->current] ) )
+        {
+            return false;
+        }
+
+        state->text_offset = state->positions[state->current] + 1;
+        state->current++;
+
+        return true;
+    }
+
+    static bool ParseValue( JSONParserState* state, JSONNode* out_node, Allocator alloc, size_t depth )
+    {
+        // scalars don't have structurals , they are whatever sits between two of them
+        size_t start = state->text_offset;
+        size_t end = state->positions[state->current];
+
+        while ( start < end && IsSpace( state->json.buffer[start] ) )
+        {
+            start++;
+        }
+
+        while ( end > start && IsSpace( state->json.buffer[end - 1] ) )
+        {
+            end--;
+        }
+
+        if ( start < end )
+        {
+            state->text_offset = state->positions[state->current];
+
+            StringView scalar = {};
+            scalar.buffer = state->json.buffer + start;
+            scalar.length = end - start;
+
+            return ParseScalar( scalar, out_node );
+        }
+
+        switch ( Peek( state ) )
+        {
+        case '"':
+        {
+            out_node->node_type = JSONNodeType::String;
+            return ParseString( state, &out_node->value );
+        }
+        case '{':
+        {
+            return depth < MAX_DEPTH && ParseObject( state, out_node, alloc, depth );
+        }
+        case '[':
+        {
+            return depth < MAX_DEPTH && ParseArray( state, out_node, alloc, depth );
+        }
+        default:
+            return false;
+        }
+    }
+
+    static bool ParseString( JSONParserState* state, StringView* out_str )
+    {
+        if ( !Expect( state, '"' ) || IsAtEnd( state ) )
+        {
+            return false;
+        }
+
+        // quotes are always paired in the index , the next position is the closing one
+        size_t start = state->text_offset;
+        size_t end = state->positions[state->current];
+
+        out_str->buffer = state->json.buffer + start;
+        out_str->length = end - start;
+
+        state->text_offset = end + 1;
+        state->current++;
+
+        return true;
+    }
+
+    static bool ParseObject( JSONParserState* state, JSONNode* out_node, Allocator alloc, size_t depth )
+    {
+        out_node->node_type = JSONNodeType::Object;
+        Expect( state, '{' );
+
+        size_t first_pending = state->pending.size;
+
+        if ( !Expect( state, '}' ) )
+        {
+            bool is_reading_object = true;
+
+            while ( is_reading_object )
+            {
+                JSONNode sub_node = {};
+
+                if ( !ParseString( state, &sub_node.name ) || !Expect( state, ':' ) )
+                {
+                    return false;
+                }
+
+                if ( !ParseValue( state, &sub_node, alloc, depth + 1 ) )
+                {
+                    return false;
+                }
+
+                DArray<JSONNode>::Add( &state->pending, sub_node );
+
+                is_reading_object = Expect( state, ',' );
+
+                if ( !is_reading_object && !Expect( state, '}' ) )
+                {
+                    return false;
+                }
+            }
+        }
+
+        MovePending( state, first_pending, out_node, alloc );
+
+        return true;
+    }
+
+    static bool ParseArray( JSONParserState* state, JSONNode* out_node, Allocator alloc, size_t depth )
+    {
+        out_node->node_type = JSONNodeType::Array;
+        Expect( state, '[' );
+
+        size_t first_pending = state->pending.size;
+
+        if ( !Expect( state, ']' ) )
+        {
+            bool is_reading_array = true;
+
+            while ( is_reading_array )
+            {
+                JSONNode sub_node = {};
+
+                if ( !ParseValue( state, &sub_node, alloc, depth + 1 ) )
+                {
+                    return false;
+                }
+
+                DArray<JSONNode>::Add( &state->pending, sub_node );
+
+                is_reading_array = Expect( state, ',' );
+
+                if ( !is_reading_array && !Expect( state, ']' ) )
+                {
+                    return false;
+                }
+            }
+        }
+
+        MovePending( state, first_pending, out_node, alloc );
+
+        return true;
+    }
+
+    /// <summary>
+    /// Moves the children pushed since "first_pending" into one contiguous allocation
+    /// </summary>
+    static void MovePending( JSONParserState* state, size_t first_pending, JSONNode* out_node, Allocator alloc )
+    {
+        size_t count = state->pending.size - first_pending;
+
+        out_node->sub_nodes = {};
+
+        if ( count != 0 )
+        {
+            out_node->sub_nodes.data = (JSONNode*) ALLOC( alloc, sizeof( JSONNode ) * count );
+            out_node->sub_nodes.size = count;
+
+            CoreContext::mem_copy( state->pending.data + first_pending, out_node->sub_nodes.data, sizeof( JSONNode ) * count );
+        }
+
+        state->pending.size = first_pending;
+    }
+
+public:
+
+    /// <summary>
+    /// Types an unquoted value (number , true , false or null) , returns false if it's none of them
+    /// </summary>
+    static bool ParseScalar( StringView scalar, JSONNode* out_node )
+    {
+        out_node->value = scalar;
+
+        if ( StringUtils::Compare( scalar, "true" ) || StringUtils::Compare( scalar, "false" ) )
+        {
+            out_node->node_type = JSONNodeType::Boolean;
+            return true;
+        }
+
+        if ( StringUtils::Compare( scalar, "null" ) )
+        {
+            out_node->node_type = JSONNodeType::Null;
+            return true;
+        }
+
+        return ParseNumber( scalar, out_node );
+    }
+
+private:
+
+    /// <summary>
+    /// -?digits(.digits)?([eE][+-]?digits)? , a fraction or an exponent makes it a float
+    /// </summary>
+    static bool ParseNumber( StringView scalar, JSONNode* out_node )
+    {
+        size_t i = 0;
+        bool is_float = false;
+
+        if ( scalar.buffer[i] == '-' )
+        {
+            i++;
+        }
+
+        size_t digits = SkipDigits( scalar, &i );
+
+        if ( digits == 0 )
+        {
+            return false;
+        }
+
+        if ( i < scalar.length && scalar.buffer[i] == '.' )
+        {
+            i++;
+            is_float = true;
+
+            if ( SkipDigits( scalar, &i ) == 0 )
+            {
+                return false;
+            }
+        }
+
+        if ( i < scalar.length && (scalar.buffer[i] == 'e' || scalar.buffer[i] == 'E') )
+        {
+            i++;
+            is_float = true;
+
+            if ( i < scalar.length && (scalar.buffer[i] == '+' || scalar.buffer[i] == '-') )
+            {
+                i++;
+            }
+
+            if ( SkipDigits( scalar, &i ) == 0 )
+            {
+                return false;
+            }
+        }
+
+        out_node->node_type = is_float ? JSONNodeType::Float : JSONNodeType::Integer;
+
+        return i == scalar.length;
+    }
+
+    static inline size_t SkipDigits( StringView scalar, size_t* inout_index )
+    {
+        size_t start = *inout_index;
+
+        while ( *inout_index < scalar.length && '0' <= scalar.buffer[*inout_index] && scalar.buffer[*inout_index] <= '9' )
+        {
+            (*inout_index)++;
+        }
+
+        return *inout_index - start;
+    }
+};
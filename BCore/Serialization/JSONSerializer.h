@@ -4,6 +4,8 @@
 #include "../Containers/ArrayView.h"
 #include "../Containers/Stack.h"
 #include "../Allocators/Allocator.h"
+#include "../Allocators/ScratchArena.h"
+#include "../Defer/Defer.h"
 #include <ctype.h>
 
 enum class JSONNodeType
@@ -12,7 +14,9 @@ enum class JSONNodeType
     String,
     Array,
     Integer,
-    Float
+    Float,
+    Boolean,
+    Null
 };
 
 struct JSONNode
@@ -152,32 +156,40 @@ struct JSONSerializer
             break;
         }
 
+        case JSONNodeType::Boolean:
+        {
+            StringBuilder::Append(in_builder, "<NodeType : Boolean>");
+            break;
+        }
+
+        case JSONNodeType::Null:
+        {
+            StringBuilder::Append(in_builder, "<NodeType : Null>");
+            break;
+        }
+
         default:
             break;
         }
 
         StringBuilder::Append(in_builder, "\t");
         
-        char temp_buffer[1024] = {0};
-
-        Arena temp_arena = {};
-        temp_arena.data = &temp_buffer;
-        temp_arena.capacity = 1024;
-        temp_arena.offset = 0;
+        ScratchArena scratch = ScratchArena::Get(in_builder->alloc);
+        DEFER([&](){ ScratchArena::Release(&scratch); });
 
-        Allocator temp_alloc = ArenaAllocator::Create(&temp_arena);
+        Allocator temp_alloc = scratch.alloc;
         
         // Log name
         if (in_node->name.buffer != nullptr)
         {
-            StringBuffer msg = StringUtils::Format(in_builder->alloc, temp_alloc, "<Name : {}>\t", in_node->name);
+            StringBuffer msg = StringUtils::Format(temp_alloc, "<Name : {}>\t", in_node->name);
             StringBuilder::Append(in_builder, msg.view);
         }
 
         // Log value
         if (in_node->node_type != JSONNodeType::Object && in_node->node_type != JSONNodeType::Array)
         {
-            StringBuffer msg = StringUtils::Format(in_builder->alloc, temp_alloc, "<Value : {}>\t", in_node->value);
+            StringBuffer msg = StringUtils::Format(temp_alloc, "<Value : {}>\t", in_node->value);
             StringBuilder::Append(in_builder, msg.view);
         }
 
@@ -0,0 +1,427 @@
+#pragma once
+#include <stdint.h>
+#include "JSONSerializer.h"
+#include "JSONParser.h"
+#include "StreamToken.h"
+#include "../Typedefs/Typedefs.h"
+#include "../Allocators/Allocator.h"
+
+/// <summary>
+/// Events of a JSONStreamReader , any of them can be null. Views are only valid during the call
+/// </summary>
+struct JSONStreamCallbacks
+{
+    void* user_data;
+
+    ActionParams<void*> begin_object;
+    ActionParams<void*> end_object;
+    ActionParams<void*> begin_array;
+    ActionParams<void*> end_array;
+
+    ActionParams<void*, StringView> key;
+    ActionParams<void*, JSONNodeType, StringView> value;
+};
+
+enum class JSONStreamState : uint8_t
+{
+    // a value is expected (root , after ':' , after ',' in an array)
+    Value,
+    // right after '[' , a value or ']'
+    ValueOrEnd,
+    // after ',' in an object
+    Key,
+    // right after '{' , a key or '}'
+    KeyOrEnd,
+    Colon,
+    // after a value inside a container
+    CommaOrEnd,
+    String,
+    // number , true , false or null
+    Scalar,
+    // the root value is done , only blanks can follow
+    Done,
+    Error
+};
+
+/// <summary>
+/// <para>Event driven (SAX) JSON reader , the document is fed in chunks of any size and callbacks are raised as soon as something is complete</para>
+/// <para>Nothing is kept once it's been reported : memory is the nesting stack (one bit per level) and the carry of a token cut by a chunk boundary ,
+/// so a document of any size can be streamed from a file with Filesystem::read_chunk</para>
+/// <para>Names and values are the same as JSONParser's : escape sequences are left as they are and scalars are typed but not converted</para>
+/// </summary>
+struct JSONStreamReader
+{
+    static constexpr size_t MAX_DEPTH = JSONParser::MAX_DEPTH;
+    static constexpr size_t DEFAULT_MAX_TOKEN_SIZE = 64 * 1'024;
+
+    JSONStreamCallbacks callbacks;
+    StreamToken token;
+
+    // one bit per open container , set for objects
+    uint64_t containers[MAX_DEPTH / 64];
+    size_t depth;
+
+    JSONStreamState state;
+    bool is_key;
+    // the last chunk ended on a backslash inside a string
+    bool is_escaped;
+
+    /// <summary>
+    /// "max_token_size" is the biggest string or number accepted , the carry never grows past it
+    /// </summary>
+    static void Create( JSONStreamReader* out_reader, JSONStreamCallbacks callbacks, Allocator alloc, size_t max_token_size = DEFAULT_MAX_TOKEN_SIZE )
+    {
+        *out_reader = {};
+        out_reader->callbacks = callbacks;
+        StreamToken::Create( &out_reader->token, max_token_size, alloc );
+    }
+
+    static void Destroy( JSONStreamReader* reader )
+    {
+        StreamToken::Destroy( &reader->token );
+        *reader = {};
+    }
+
+    /// <summary>
+    /// Reads the next part of the document , returns false as soon as the input is malformed (and for every call after that)
+    /// </summary>
+    static bool Feed( JSONStreamReader* reader, StringView chunk )
+    {
+        size_t i = 0;
+
+        while ( i < chunk.length && reader->state != JSONStreamState::Error )
+        {
+            switch ( reader->state )
+            {
+            case JSONStreamState::String:
+            {
+                i = FindStringEnd( chunk, i, &reader->is_escaped );
+
+                if ( i < chunk.length )
+                {
+                    EndString( reader, chunk, i );
+                    i++;
+                }
+                break;
+            }
+            case JSONStreamState::Scalar:
+            {
+                while ( i < chunk.length && !IsDelimiter( chunk.buffer[i] ) )
+                {
+                    i++;
+                }
+
+                // the delimiter is read again in the next state
+                if ( i < chunk.length )
+                {
+                    EndScalar( reader, chunk, i );
+                }
+                break;
+            }
+            default:
+            {
+                char c = chunk.buffer[i];
+
+                if ( !IsSpace( c ) )
+                {
+                    ReadStructural( reader, chunk, i );
+                }
+
+                i++;
+                break;
+            }
+            }
+        }
+
+        if ( !StreamToken::Suspend( &reader->token, chunk ) )
+        {
+            reader->state = JSONStreamState::Error;
+        }
+
+        return reader->state != JSONStreamState::Error;
+    }
+
+    /// <summary>
+    /// Call once the whole document has been fed , returns true if it was complete and valid
+    /// </summary>
+    static bool Finish( JSONStreamReader* reader )
+    {
+        // a root scalar only ends with the input
+        if ( reader->state == JSONStreamState::Scalar )
+        {
+            StringView empty = {};
+            EndScalar( reader, empty, 0 );
+        }
+
+        return reader->state == JSONStreamState::Done;
+    }
+
+private:
+
+    static inline bool IsSpace( char c )
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    static inline bool IsDelimiter( char c )
+    {
+        return IsSpace( c ) || c == ',' || c == ']' || c == '}';
+    }
+
+    static inline bool IsObject( JSONStreamReader* reader )
+    {
+        size_t level = reader->depth - 1;
+        return (reader->containers[level / 64] >> (level % 64)) & 1;
+    }
+
+    static void ReadStructural( JSONStreamReader* reader, StringView chunk, size_t index )
+    {
+        char c = chunk.buffer[index];
+
+        switch ( reader->state )
+        {
+        case JSONStreamState::ValueOrEnd:
+        {
+            if ( c == ']' )
+            {
+                EndContainer( reader, false );
+                return;
+            }
+
+            BeginValue( reader, chunk, index );
+            return;
+        }
+        case JSONStreamState::Value:
+        {
+            BeginValue( reader, chunk, index );
+            return;
+        }
+        case JSONStreamState::KeyOrEnd:
+        {
+            if ( c == '}' )
+            {
+                EndContainer( reader, true );
+                return;
+            }
+
+            BeginKey( reader, chunk, index );
+            return;
+        }
+        case JSONStreamState::Key:
+        {
+            BeginKey( reader, chunk, index );
+            return;
+        }
+        case JSONStreamState::Colon:
+        {
+            reader->state = c == ':' ? JSONStreamState::Value : JSONStreamState::Error;
+            return;
+        }
+        case JSONStreamState::CommaOrEnd:
+        {
+            bool is_object = IsObject( reader );
+
+            if ( c == ',' )
+            {
+                reader->state = is_object ? JSONStreamState::Key : JSONStreamState::Value;
+            }
+            else if ( c == (is_object ? '}' : ']') )
+            {
+                EndContainer( reader, is_object );
+            }
+            else
+            {
+                reader->state = JSONStreamState::Error;
+            }
+            return;
+        }
+        default:
+        {
+            reader->state = JSONStreamState::Error;
+            return;
+        }
+        }
+    }
+
+    static void BeginKey( JSONStreamReader* reader, StringView chunk, size_t index )
+    {
+        if ( chunk.buffer[index] != '"' )
+        {
+            reader->state = JSONStreamState::Error;
+            return;
+        }
+
+        reader->is_key = true;
+        reader->state = JSONStreamState::String;
+        StreamToken::Open( &reader->token, index + 1 );
+    }
+
+    static void BeginValue( JSONStreamReader* reader, StringView chunk, size_t index )
+    {
+        char c = chunk.buffer[index];
+
+        switch ( c )
+        {
+        case '{':
+        case '[':
+        {
+            bool is_object = c == '{';
+
+            if ( reader->depth == MAX_DEPTH )
+            {
+                reader->state = JSONStreamState::Error;
+                return;
+            }
+
+            size_t level = reader->depth++;
+            uint64_t bit = 1ull << (level % 64);
+
+            reader->containers[level / 64] = is_object ? (reader->containers[level / 64] | bit) : (reader->containers[level / 64] & ~bit);
+            reader->state = is_object ? JSONStreamState::KeyOrEnd : JSONStreamState::ValueOrEnd;
+
+            ActionParams<void*> callback = is_object ? reader->callbacks.begin_object : reader->callbacks.begin_array;
+
+            if ( callback != nullptr )
+            {
+                callback( reader->callbacks.user_data );
+            }
+            return;
+        }
+        case '"':
+        {
+            reader->is_key = false;
+            reader->state = JSONStreamState::String;
+            StreamToken::Open( &reader->token, index + 1 );
+            return;
+        }
+        default:
+        {
+            bool is_scalar = c == '-' || ('0' <= c && c <= '9') || c == 't' || c == 'f' || c == 'n';
+
+            reader->state = is_scalar ? JSONStreamState::Scalar : JSONStreamState::Error;
+            StreamToken::Open( &reader->token, index );
+            return;
+        }
+        }
+    }
+
+    static void EndContainer( JSONStreamReader* reader, bool is_object )
+    {
+        reader->depth--;
+        EndValue( reader );
+
+        ActionParams<void*> callback = is_object ? reader->callbacks.end_object : reader->callbacks.end_array;
+
+        if ( callback != nullptr )
+        {
+            callback( reader->callbacks.user_data );
+        }
+    }
+
+    static inline void EndValue( JSONStreamReader* reader )
+    {
+        reader->state = reader->depth == 0 ? JSONStreamState::Done : JSONStreamState::CommaOrEnd;
+    }
+
+    static void EndString( JSONStreamReader* reader, StringView chunk, size_t end )
+    {
+        StringView str = {};
+
+        if ( !StreamToken::Close( &reader->token, chunk, end, &str ) )
+        {
+            reader->state = JSONStreamState::Error;
+            return;
+        }
+
+        if ( reader->is_key )
+        {
+            reader->state = JSONStreamState::Colon;
+
+            if ( reader->callbacks.key != nullptr )
+            {
+                reader->callbacks.key( reader->callbacks.user_data, str );
+            }
+            return;
+        }
+
+        EndValue( reader );
+
+        if ( reader->callbacks.value != nullptr )
+        {
+            reader->callbacks.value( reader->callbacks.user_data, JSONNodeType::String, str );
+        }
+    }
+
+    static void EndScalar( JSONStreamReader* reader, StringView chunk, size_t end )
+    {
+        StringView scalar = {};
+        JSONNode node = {};
+
+        if ( !StreamToken::Close( &reader->token, chunk, end, &scalar ) || !JSONParser::ParseScalar( scalar, &node ) )
+        {
+            reader->state = JSONStreamState::Error;
+            return;
+        }
+
+        EndValue( reader );
+
+        if ( reader->callbacks.value != nullptr )
+        {
+            reader->callbacks.value( reader->callbacks.user_data, node.node_type, scalar );
+        }
+    }
+
+    /// <summary>
+    /// Index of the closing quote of the string "from" is in , or the chunk length if it goes on in the next chunk
+    /// </summary>
+    static size_t FindStringEnd( StringView chunk, size_t from, bool* inout_escaped )
+    {
+        size_t i = from;
+
+        if ( *inout_escaped )
+        {
+            *inout_escaped = false;
+            i++;
+        }
+
+        while ( i < chunk.length )
+        {
+#if JSON_SSE2
+            const __m128i quote = _mm_set1_epi8( '"' );
+            const __m128i backslash = _mm_set1_epi8( '\\' );
+
+            for ( ; i + 16 <= chunk.length; i += 16 )
+            {
+                __m128i bytes = _mm_loadu_si128( (const __m128i*) (chunk.buffer + i) );
+                uint32_t mask = (uint32_t) _mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( bytes, quote ), _mm_cmpeq_epi8( bytes, backslash ) ) );
+
+                if ( mask != 0 )
+                {
+                    i += JSONStructuralIndex::LowestBit( mask );
+                    break;
+                }
+            }
+#endif
+            while ( i < chunk.length && chunk.buffer[i] != '"' && chunk.buffer[i] != '\\' )
+            {
+                i++;
+            }
+
+            if ( i == chunk.length || chunk.buffer[i] == '"' )
+            {
+                return i;
+            }
+
+            // backslash , the escaped character can be the first one of the next chunk
+            if ( i + 1 == chunk.length )
+            {
+                *inout_escaped = true;
+                return chunk.length;
+            }
+
+            i += 2;
+        }
+
+        return chunk.length;
+    }
+};
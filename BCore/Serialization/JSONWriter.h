@@ -0,0 +1,329 @@
+#pragma once
+#include <assert.h>
+#include <stdint.h>
+#include "JSONSerializer.h"
+#include "JSONParser.h"
+#include "../Containers/ChunkedBuffer.h"
+#include "../String/NumberFormat.h"
+
+/// <summary>
+/// <para>Writes JSON straight into a ChunkedBuffer , commas , quotes and escapes are handled by the writer</para>
+/// <para>Nothing is allocated per value : numbers are formatted in place and strings are copied in runs between the characters to escape</para>
+/// <para>Pretty output puts every item on its own line , indented with tabs , compact output has no blanks at all</para>
+/// </summary>
+struct JSONWriter
+{
+    static constexpr size_t MAX_DEPTH = JSONParser::MAX_DEPTH;
+
+    ChunkedBuffer* out;
+
+    // one bit per open container , set once it has an item so the next one needs a comma
+    uint64_t has_items[MAX_DEPTH / 64];
+    size_t depth;
+
+    bool is_pretty;
+    // a key was just written , its value follows without a separator
+    bool is_after_key;
+
+    static void Create( JSONWriter* out_writer, ChunkedBuffer* out, bool is_pretty = false )
+    {
+        *out_writer = {};
+        out_writer->out = out;
+        out_writer->is_pretty = is_pretty;
+    }
+
+    static void BeginObject( JSONWriter* writer )
+    {
+        BeginContainer( writer, '{' );
+    }
+
+    static void EndObject( JSONWriter* writer )
+    {
+        EndContainer( writer, '}' );
+    }
+
+    static void BeginArray( JSONWriter* writer )
+    {
+        BeginContainer( writer, '[' );
+    }
+
+    static void EndArray( JSONWriter* writer )
+    {
+        EndContainer( writer, ']' );
+    }
+
+    /// <summary>
+    /// "is_escaped" is for text that already has its escape sequences , like the views of JSONParser or JSONStreamReader
+    /// </summary>
+    static void Key( JSONWriter* writer, StringView key, bool is_escaped = false )
+    {
+        assert( !writer->is_after_key );
+
+        BeginItem( writer );
+        WriteQuoted( writer->out, key, is_escaped );
+
+        ChunkedBuffer::Write( writer->out, ':' );
+
+        if ( writer->is_pretty )
+        {
+            ChunkedBuffer::Write( writer->out, ' ' );
+        }
+
+        writer->is_after_key = true;
+    }
+
+    static void String( JSONWriter* writer, StringView value, bool is_escaped = false )
+    {
+        BeginItem( writer );
+        WriteQuoted( writer->out, value, is_escaped );
+    }
+
+    static void Integer( JSONWriter* writer, int64_t value )
+    {
+        BeginItem( writer );
+
+        char* dst = ChunkedBuffer::Reserve( writer->out, NumberFormat::MAX_LENGTH );
+        ChunkedBuffer::Commit( writer->out, NumberFormat::FormatInt64( value, dst ) );
+    }
+
+    /// <summary>
+    /// JSON has no nan or infinity , they are written as null
+    /// </summary>
+    static void Float( JSONWriter* writer, double value )
+    {
+        if ( value != value || value == HUGE_VAL || value == -HUGE_VAL )
+        {
+            Null( writer );
+            return;
+        }
+
+        BeginItem( writer );
+
+        char* dst = ChunkedBuffer::Reserve( writer->out, NumberFormat::MAX_LENGTH );
+        ChunkedBuffer::Commit( writer->out, NumberFormat::FormatDouble( value, dst ) );
+    }
+
+    /// <summary>
+    /// Shortest text for the float itself , 0.1f gives "0.1" where the double overload gives "0.10000000149011612"
+    /// </summary>
+    static void Float( JSONWriter* writer, float value )
+    {
+        if ( value != value || value == HUGE_VALF || value == -HUGE_VALF )
+        {
+            Null( writer );
+            return;
+        }
+
+        BeginItem( writer );
+
+        char* dst = ChunkedBuffer::Reserve( writer->out, NumberFormat::MAX_LENGTH );
+        ChunkedBuffer::Commit( writer->out, NumberFormat::FormatFloat( value, dst ) );
+    }
+
+    static void Boolean( JSONWriter* writer, bool value )
+    {
+        BeginItem( writer );
+        ChunkedBuffer::Write( writer->out, value ? StringView( "true" ) : StringView( "false" ) );
+    }
+
+    static void Null( JSONWriter* writer )
+    {
+        BeginItem( writer );
+        ChunkedBuffer::Write( writer->out, "null" );
+    }
+
+    /// <summary>
+    /// Writes a whole tree , names and values are taken as they are in the source (escaped , numbers as text)
+    /// </summary>
+    static void WriteNode( JSONWriter* writer, const JSONNode* node )
+    {
+        switch ( node->node_type )
+        {
+        case JSONNodeType::Object:
+        {
+            BeginObject( writer );
+
+            for ( size_t i = 0; i < node->sub_nodes.size; ++i )
+            {
+                const JSONNode* sub_node = &node->sub_nodes.data[i];
+
+                Key( writer, sub_node->name, true );
+                WriteNode( writer, sub_node );
+            }
+
+            EndObject( writer );
+            return;
+        }
+        case JSONNodeType::Array:
+        {
+            BeginArray( writer );
+
+            for ( size_t i = 0; i < node->sub_nodes.size; ++i )
+            {
+                WriteNode( writer, &node->sub_nodes.data[i] );
+            }
+
+            EndArray( writer );
+            return;
+        }
+        case JSONNodeType::String:
+        {
+            String( writer, node->value, true );
+            return;
+        }
+        default:
+        {
+            BeginItem( writer );
+            ChunkedBuffer::Write( writer->out, node->value );
+            return;
+        }
+        }
+    }
+
+private:
+
+    static void BeginItem( JSONWriter* writer )
+    {
+        if ( writer->is_after_key )
+        {
+            writer->is_after_key = false;
+            return;
+        }
+
+        if ( writer->depth == 0 )
+        {
+            return;
+        }
+
+        size_t level = writer->depth - 1;
+        uint64_t bit = 1ull << (level % 64);
+
+        if ( writer->has_items[level / 64] & bit )
+        {
+            ChunkedBuffer::Write( writer->out, ',' );
+        }
+
+        writer->has_items[level / 64] |= bit;
+
+        if ( writer->is_pretty )
+        {
+            NewLine( writer, writer->depth );
+        }
+    }
+
+    static void BeginContainer( JSONWriter* writer, char open )
+    {
+        assert( writer->depth < MAX_DEPTH );
+
+        BeginItem( writer );
+        ChunkedBuffer::Write( writer->out, open );
+
+        size_t level = writer->depth++;
+        writer->has_items[level / 64] &= ~(1ull << (level % 64));
+    }
+
+    static void EndContainer( JSONWriter* writer, char close )
+    {
+        assert( writer->depth != 0 && !writer->is_after_key );
+
+        size_t level = --writer->depth;
+        bool had_items = (writer->has_items[level / 64] >> (level % 64)) & 1;
+
+        // empty containers stay on one line
+        if ( writer->is_pretty && had_items )
+        {
+            NewLine( writer, writer->depth );
+        }
+
+        ChunkedBuffer::Write( writer->out, close );
+    }
+
+    static void NewLine( JSONWriter* writer, size_t indentation )
+    {
+        ChunkedBuffer::Write( writer->out, '\n' );
+
+        for ( size_t i = 0; i < indentation; ++i )
+        {
+            ChunkedBuffer::Write( writer->out, '\t' );
+        }
+    }
+
+    static inline bool NeedsEscape( char c )
+    {
+        return (unsigned char) c < 0x20 || c == '"' || c == '\\';
+    }
+
+    static void WriteQuoted( ChunkedBuffer* out, StringView str, bool is_escaped )
+    {
+        ChunkedBuffer::Write( out, '"' );
+
+        if ( is_escaped )
+        {
+            ChunkedBuffer::Write( out, str );
+            ChunkedBuffer::Write( out, '"' );
+            return;
+        }
+
+        size_t run_start = 0;
+
+        for ( size_t i = 0; i < str.length; ++i )
+        {
+            char c = str.buffer[i];
+
+            if ( !NeedsEscape( c ) )
+            {
+                continue;
+            }
+
+            ChunkedBuffer::Write( out, str.buffer + run_start, i - run_start );
+            run_start = i + 1;
+
+            WriteEscape( out, c );
+        }
+
+        ChunkedBuffer::Write( out, str.buffer + run_start, str.length - run_start );
+        ChunkedBuffer::Write( out, '"' );
+    }
+
+    static void WriteEscape( ChunkedBuffer* out, char c )
+    {
+        static constexpr char HEX[] = "0123456789abcdef";
+
+        char escape[6] = { '\\', c, 0, 0, 0, 0 };
+        size_t length = 2;
+
+        switch ( c )
+        {
+        case '"':
+        case '\\':
+            break;
+        case '\n':
+            escape[1] = 'n';
+            break;
+        case '\r':
+            escape[1] = 'r';
+            break;
+        case '\t':
+            escape[1] = 't';
+            break;
+        case '\b':
+            escape[1] = 'b';
+            break;
+        case '\f':
+            escape[1] = 'f';
+            break;
+        default:
+        {
+            escape[1] = 'u';
+            escape[2] = '0';
+            escape[3] = '0';
+            escape[4] = HEX[((unsigned char) c) >> 4];
+            escape[5] = HEX[((unsigned char) c) & 0xF];
+            length = 6;
+            break;
+        }
+        }
+
+        ChunkedBuffer::Write( out, escape, length );
+    }
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include "../String/StringView.h"
+#include "../Containers/DArray.h"
+#include "../Containers/ArrayView.h"
+#include "../Allocators/Allocator.h"
+
+/// <summary>
+/// <para>A token (string , number , name ...) of a streamed document , it can start in one chunk and end in a later one</para>
+/// <para>While the token is inside the current chunk it stays a view into it , only the part read before a chunk boundary is copied to "carry".
+/// "max_size" caps the carry so memory stays bounded whatever the document size</para>
+/// </summary>
+struct StreamToken
+{
+    DArray<char> carry;
+    size_t max_size;
+
+    // index in the current chunk where the token starts , 0 once it's been carried over
+    size_t start;
+    bool is_open;
+
+    static void Create( StreamToken* out_token, size_t max_size, Allocator alloc )
+    {
+        *out_token = {};
+        out_token->max_size = max_size;
+        DArray<char>::Create( 64, &out_token->carry, alloc, false );
+    }
+
+    static void Destroy( StreamToken* token )
+    {
+        DArray<char>::Destroy( &token->carry );
+    }
+
+    /// <summary>
+    /// Starts a token at "index" of the current chunk , can be the chunk length when it only starts in the next one
+    /// </summary>
+    static inline void Open( StreamToken* token, size_t index )
+    {
+        token->carry.size = 0;
+        token->start = index;
+        token->is_open = true;
+    }
+
+    /// <summary>
+    /// Has to be called when the current chunk is done , copies the part of the open token that is in it.
+    /// Returns false if the token gets bigger than "max_size"
+    /// </summary>
+    static bool Suspend( StreamToken* token, StringView chunk )
+    {
+        if ( !token->is_open )
+        {
+            return true;
+        }
+
+        bool fits = Append( token, chunk, token->start, chunk.length );
+        token->start = 0;
+
+        return fits;
+    }
+
+    /// <summary>
+    /// <para>Ends the token right before "end" , returns false if it's bigger than "max_size"</para>
+    /// <para>The view is either into the chunk or into "carry" , it stays valid until the next chunk or the next Open</para>
+    /// </summary>
+    static bool Close( StreamToken* token, StringView chunk, size_t end, StringView* out_view )
+    {
+        token->is_open = false;
+
+        if ( token->carry.size == 0 )
+        {
+            out_view->buffer = chunk.buffer + token->start;
+            out_view->length = end - token->start;
+
+            return out_view->length <= token->max_size;
+        }
+
+        if ( !Append( token, chunk, token->start, end ) )
+        {
+            return false;
+        }
+
+        out_view->buffer = token->carry.data;
+        out_view->length = token->carry.size;
+
+        return true;
+    }
+
+private:
+
+    static bool Append( StreamToken* token, StringView chunk, size_t start, size_t end )
+    {
+        size_t count = end - start;
+
+        if ( token->carry.size + count > token->max_size )
+        {
+            return false;
+        }
+
+        if ( count != 0 )
+        {
+            ArrayView<char> part = {};
+            part.data = (char*) chunk.buffer + start;
+            part.size = count;
+
+            DArray<char>::AddRange( &token->carry, part );
+        }
+
+        return true;
+    }
+};
@@ -4,6 +4,8 @@
 #include "../Containers/ArrayView.h"
 #include "../Containers/Stack.h"
 #include "../Allocators/Allocator.h"
+#include "../Allocators/ScratchArena.h"
+#include "../Defer/Defer.h"
 #include <ctype.h>
 
 enum class XMLNodeType
@@ -123,14 +125,10 @@ struct XMLSerializer
             StringBuilder::Append(in_builder, "\t");
         }
 
-        char temp_buffer[1024] = {0};
+        ScratchArena scratch = ScratchArena::Get(in_builder->alloc);
+        DEFER([&](){ ScratchArena::Release(&scratch); });
 
-        Arena temp_arena = {};
-        temp_arena.data = &temp_buffer;
-        temp_arena.capacity = 1024;
-        temp_arena.offset = 0;
-
-        Allocator temp_alloc = ArenaAllocator::Create(&temp_arena);
+        Allocator temp_alloc = scratch.alloc;
 
         // Log element
         if (in_node->node_type == XMLNodeType::Element)
@@ -141,7 +139,7 @@ struct XMLSerializer
             {
                 AttributeValuePair attrVal = in_node->attributes.data[i];
 
-                StringBuffer atr = StringUtils::Format(in_builder->alloc, temp_alloc, "\t[Attribute : {} , Value : {}]", attrVal.name, attrVal.value);
+                StringBuffer atr = StringUtils::Format(temp_alloc, "\t[Attribute : {} , Value : {}]", attrVal.name, attrVal.value);
                 StringBuilder::Append(in_builder, atr.view);
             }
             StringBuilder::Append(in_builder, ">");
@@ -150,7 +148,7 @@ struct XMLSerializer
         // Log text
         if (in_node->node_type == XMLNodeType::Text)
         {
-            StringBuffer msg = StringUtils::Format(in_builder->alloc,temp_alloc, "<Text : {}>", in_node->value);
+            StringBuffer msg = StringUtils::Format(temp_alloc, "<Text : {}>", in_node->value);
             StringBuilder::Append(in_builder, msg.view);
         }
 
@@ -171,7 +169,7 @@ struct XMLSerializer
                 StringBuilder::Append(in_builder, "\t");
             }
 
-            StringBuffer name = StringUtils::Format(in_builder->alloc, temp_alloc,"</Element : {}>", in_node->name);
+            StringBuffer name = StringUtils::Format(temp_alloc, "</Element : {}>", in_node->name);
             StringBuilder::Append(in_builder, name.view);
         }
     }
@@ -0,0 +1,523 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "StreamToken.h"
+#include "../Typedefs/Typedefs.h"
+#include "../String/StringUtils.h"
+#include "../Containers/DArray.h"
+#include "../Containers/ArrayView.h"
+#include "../Allocators/Allocator.h"
+
+/// <summary>
+/// Events of a XMLStreamReader , any of them can be null. Views are only valid during the call
+/// </summary>
+struct XMLStreamCallbacks
+{
+    void* user_data;
+
+    // raised when the name is read , the attributes of the element follow
+    ActionParams<void*, StringView> begin_element;
+    ActionParams<void*, StringView, StringView> attribute;
+    ActionParams<void*, StringView> end_element;
+
+    // text between tags , without the leading and trailing blanks , blank only text isn't reported
+    ActionParams<void*, StringView> text;
+};
+
+enum class XMLStreamState : uint8_t
+{
+    Text,
+    // right after '<'
+    TagOpen,
+    TagName,
+    // between the attributes of a tag
+    InTag,
+    AttributeName,
+    // after an attribute name , waiting for '='
+    AttributeEquals,
+    // after '=' , waiting for the opening quote
+    AttributeQuote,
+    AttributeValue,
+    // after '/' in a tag , waiting for '>'
+    SelfClose,
+    CloseName,
+    // after the name of a closing tag , waiting for '>'
+    CloseEnd,
+    // inside <? ?> , <!-- --> or <! >
+    Skip,
+    Error
+};
+
+enum class XMLSkipKind : uint8_t
+{
+    Instruction,
+    Declaration,
+    Comment
+};
+
+/// <summary>
+/// <para>Event driven (SAX) XML reader , the document is fed in chunks of any size and callbacks are raised as soon as something is complete</para>
+/// <para>Memory is the names of the open elements (needed to check the closing tags) and the carry of a token cut by a chunk boundary ,
+/// so a document of any size can be streamed from a file with Filesystem::read_chunk</para>
+/// <para>Attribute values have to be quoted , entities are left as they are. Processing instructions , declarations and comments are skipped</para>
+/// </summary>
+struct XMLStreamReader
+{
+    static constexpr size_t MAX_DEPTH = 1'024;
+    static constexpr size_t DEFAULT_MAX_TOKEN_SIZE = 64 * 1'024;
+
+    XMLStreamCallbacks callbacks;
+    StreamToken token;
+
+    // names of the open elements one after the other , "name_starts" has where each one begins
+    DArray<char> names;
+    DArray<uint32_t> name_starts;
+
+    // name of the attribute whose value is being read
+    DArray<char> attribute_name;
+
+    XMLStreamState state;
+    XMLSkipKind skip_kind;
+    char quote;
+    // last two characters and count of the skipped section , enough to find "?>" and "-->"
+    char skip_history[2];
+    size_t skip_count;
+    bool has_root;
+
+    /// <summary>
+    /// "max_token_size" is the biggest name , attribute value or text accepted , the carry never grows past it
+    /// </summary>
+    static void Create( XMLStreamReader* out_reader, XMLStreamCallbacks callbacks, Allocator alloc, size_t max_token_size = DEFAULT_MAX_TOKEN_SIZE )
+    {
+        *out_reader = {};
+        out_reader->callbacks = callbacks;
+
+        StreamToken::Create( &out_reader->token, max_token_size, alloc );
+        DArray<char>::Create( 256, &out_reader->names, alloc, false );
+        DArray<uint32_t>::Create( 16, &out_reader->name_starts, alloc, false );
+        DArray<char>::Create( 64, &out_reader->attribute_name, alloc, false );
+    }
+
+    static void Destroy( XMLStreamReader* reader )
+    {
+        StreamToken::Destroy( &reader->token );
+        DArray<char>::Destroy( &reader->names );
+        DArray<uint32_t>::Destroy( &reader->name_starts );
+        DArray<char>::Destroy( &reader->attribute_name );
+        *reader = {};
+    }
+
+    /// <summary>
+    /// Reads the next part of the document , returns false as soon as the input is malformed (and for every call after that)
+    /// </summary>
+    static bool Feed( XMLStreamReader* reader, StringView chunk )
+    {
+        size_t i = 0;
+
+        while ( i < chunk.length && reader->state != XMLStreamState::Error )
+        {
+            switch ( reader->state )
+            {
+            case XMLStreamState::Text:
+            {
+                i = ReadText( reader, chunk, i );
+                break;
+            }
+            case XMLStreamState::TagName:
+            case XMLStreamState::AttributeName:
+            case XMLStreamState::CloseName:
+            {
+                while ( i < chunk.length && IsNameChar( chunk.buffer[i] ) )
+                {
+                    i++;
+                }
+
+                // the character after the name is read again in the next state
+                if ( i < chunk.length )
+                {
+                    EndName( reader, chunk, i );
+                }
+                break;
+            }
+            case XMLStreamState::AttributeValue:
+            {
+                const char* end = (const char*) memchr( chunk.buffer + i, reader->quote, chunk.length - i );
+
+                if ( end == nullptr )
+                {
+                    i = chunk.length;
+                    break;
+                }
+
+                i = end - chunk.buffer;
+                EndAttribute( reader, chunk, i );
+                i++;
+                break;
+            }
+            case XMLStreamState::Skip:
+            {
+                Skip( reader, chunk.buffer[i] );
+                i++;
+                break;
+            }
+            default:
+            {
+                ReadTag( reader, chunk, i );
+                i++;
+                break;
+            }
+            }
+        }
+
+        if ( !StreamToken::Suspend( &reader->token, chunk ) )
+        {
+            reader->state = XMLStreamState::Error;
+        }
+
+        return reader->state != XMLStreamState::Error;
+    }
+
+    /// <summary>
+    /// Call once the whole document has been fed , returns true if it was complete and valid
+    /// </summary>
+    static bool Finish( XMLStreamReader* reader )
+    {
+        return reader->state == XMLStreamState::Text && reader->has_root && reader->name_starts.size == 0;
+    }
+
+private:
+
+    static inline bool IsSpace( char c )
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    static inline bool IsNameChar( char c )
+    {
+        return !IsSpace( c ) && c != '<' && c != '>' && c != '/' && c != '=' && c != '"' && c != '\'';
+    }
+
+    static inline StringView TopName( XMLStreamReader* reader )
+    {
+        uint32_t start = reader->name_starts.data[reader->name_starts.size - 1];
+
+        StringView name = {};
+        name.buffer = reader->names.data + start;
+        name.length = reader->names.size - start;
+
+        return name;
+    }
+
+    static inline StringView ToView( DArray<char>* chars )
+    {
+        StringView view = {};
+        view.buffer = chars->data;
+        view.length = chars->size;
+
+        return view;
+    }
+
+    static inline void CopyTo( DArray<char>* dst, StringView src )
+    {
+        ArrayView<char> part = {};
+        part.data = (char*) src.buffer;
+        part.size = src.length;
+
+        DArray<char>::AddRange( dst, part );
+    }
+
+    static size_t ReadText( XMLStreamReader* reader, StringView chunk, size_t from )
+    {
+        size_t i = from;
+
+        if ( !reader->token.is_open )
+        {
+            while ( i < chunk.length && IsSpace( chunk.buffer[i] ) )
+            {
+                i++;
+            }
+
+            if ( i == chunk.length )
+            {
+                return i;
+            }
+
+            if ( chunk.buffer[i] == '<' )
+            {
+                reader->state = XMLStreamState::TagOpen;
+                return i + 1;
+            }
+
+            // text has to be inside the root element
+            if ( reader->name_starts.size == 0 )
+            {
+                reader->state = XMLStreamState::Error;
+                return i;
+            }
+
+            StreamToken::Open( &reader->token, i );
+        }
+
+        const char* end = (const char*) memchr( chunk.buffer + i, '<', chunk.length - i );
+
+        if ( end == nullptr )
+        {
+            return chunk.length;
+        }
+
+        i = end - chunk.buffer;
+
+        StringView text = {};
+
+        if ( !StreamToken::Close( &reader->token, chunk, i, &text ) )
+        {
+            reader->state = XMLStreamState::Error;
+            return i;
+        }
+
+        while ( IsSpace( text.buffer[text.length - 1] ) )
+        {
+            text.length--;
+        }
+
+        reader->state = XMLStreamState::TagOpen;
+
+        if ( reader->callbacks.text != nullptr )
+        {
+            reader->callbacks.text( reader->callbacks.user_data, text );
+        }
+
+        return i + 1;
+    }
+
+    static void ReadTag( XMLStreamReader* reader, StringView chunk, size_t index )
+    {
+        char c = chunk.buffer[index];
+
+        switch ( reader->state )
+        {
+        case XMLStreamState::TagOpen:
+        {
+            if ( c == '/' )
+            {
+                reader->state = reader->name_starts.size != 0 ? XMLStreamState::CloseName : XMLStreamState::Error;
+                StreamToken::Open( &reader->token, index + 1 );
+            }
+            else if ( c == '?' || c == '!' )
+            {
+                reader->state = XMLStreamState::Skip;
+                reader->skip_kind = c == '?' ? XMLSkipKind::Instruction : XMLSkipKind::Declaration;
+                reader->skip_count = 0;
+                reader->skip_history[0] = 0;
+                reader->skip_history[1] = 0;
+            }
+            else if ( IsNameChar( c ) && reader->name_starts.size < MAX_DEPTH )
+            {
+                reader->state = XMLStreamState::TagName;
+                StreamToken::Open( &reader->token, index );
+            }
+            else
+            {
+                reader->state = XMLStreamState::Error;
+            }
+            return;
+        }
+        case XMLStreamState::InTag:
+        {
+            if ( c == '>' )
+            {
+                reader->state = XMLStreamState::Text;
+            }
+            else if ( c == '/' )
+            {
+                reader->state = XMLStreamState::SelfClose;
+            }
+            else if ( IsNameChar( c ) )
+            {
+                reader->state = XMLStreamState::AttributeName;
+                StreamToken::Open( &reader->token, index );
+            }
+            else if ( !IsSpace( c ) )
+            {
+                reader->state = XMLStreamState::Error;
+            }
+            return;
+        }
+        case XMLStreamState::AttributeEquals:
+        {
+            if ( c == '=' )
+            {
+                reader->state = XMLStreamState::AttributeQuote;
+            }
+            else if ( !IsSpace( c ) )
+            {
+                reader->state = XMLStreamState::Error;
+            }
+            return;
+        }
+        case XMLStreamState::AttributeQuote:
+        {
+            if ( c == '"' || c == '\'' )
+            {
+                reader->quote = c;
+                reader->state = XMLStreamState::AttributeValue;
+                StreamToken::Open( &reader->token, index + 1 );
+            }
+            else if ( !IsSpace( c ) )
+            {
+                reader->state = XMLStreamState::Error;
+            }
+            return;
+        }
+        case XMLStreamState::SelfClose:
+        {
+            if ( c != '>' )
+            {
+                reader->state = XMLStreamState::Error;
+                return;
+            }
+
+            EndElement( reader );
+            return;
+        }
+        case XMLStreamState::CloseEnd:
+        {
+            if ( c == '>' )
+            {
+                EndElement( reader );
+            }
+            else if ( !IsSpace( c ) )
+            {
+                reader->state = XMLStreamState::Error;
+            }
+            return;
+        }
+        default:
+        {
+            reader->state = XMLStreamState::Error;
+            return;
+        }
+        }
+    }
+
+    /// <summary>
+    /// Ends the tag , attribute or closing tag name right before "end"
+    /// </summary>
+    static void EndName( XMLStreamReader* reader, StringView chunk, size_t end )
+    {
+        StringView name = {};
+
+        if ( !StreamToken::Close( &reader->token, chunk, end, &name ) || name.length == 0 )
+        {
+            reader->state = XMLStreamState::Error;
+            return;
+        }
+
+        switch ( reader->state )
+        {
+        case XMLStreamState::TagName:
+        {
+            DArray<uint32_t>::Add( &reader->name_starts, (uint32_t) reader->names.size );
+            CopyTo( &reader->names, name );
+
+            reader->has_root = true;
+            reader->state = XMLStreamState::InTag;
+
+            if ( reader->callbacks.begin_element != nullptr )
+            {
+                reader->callbacks.begin_element( reader->callbacks.user_data, name );
+            }
+            return;
+        }
+        case XMLStreamState::AttributeName:
+        {
+            // the value can come chunks later , the name has to be kept
+            reader->attribute_name.size = 0;
+            CopyTo( &reader->attribute_name, name );
+
+            reader->state = XMLStreamState::AttributeEquals;
+            return;
+        }
+        default:
+        {
+            bool is_matching = StringUtils::Compare( name, TopName( reader ) );
+            reader->state = is_matching ? XMLStreamState::CloseEnd : XMLStreamState::Error;
+            return;
+        }
+        }
+    }
+
+    static void EndAttribute( XMLStreamReader* reader, StringView chunk, size_t end )
+    {
+        StringView value = {};
+
+        if ( !StreamToken::Close( &reader->token, chunk, end, &value ) )
+        {
+            reader->state = XMLStreamState::Error;
+            return;
+        }
+
+        reader->state = XMLStreamState::InTag;
+
+        if ( reader->callbacks.attribute != nullptr )
+        {
+            reader->callbacks.attribute( reader->callbacks.user_data, ToView( &reader->attribute_name ), value );
+        }
+    }
+
+    static void EndElement( XMLStreamReader* reader )
+    {
+        StringView name = TopName( reader );
+
+        reader->state = XMLStreamState::Text;
+
+        if ( reader->callbacks.end_element != nullptr )
+        {
+            reader->callbacks.end_element( reader->callbacks.user_data, name );
+        }
+
+        reader->names.size = reader->name_starts.data[reader->name_starts.size - 1];
+        reader->name_starts.size--;
+    }
+
+    static void Skip( XMLStreamReader* reader, char c )
+    {
+        reader->skip_count++;
+
+        bool is_dash_pair = reader->skip_history[0] == '-' && reader->skip_history[1] == '-';
+
+        // "<!--" turns a declaration into a comment , that one can have '>' inside
+        if ( reader->skip_kind == XMLSkipKind::Declaration && reader->skip_count == 3 && is_dash_pair )
+        {
+            reader->skip_kind = XMLSkipKind::Comment;
+        }
+
+        if ( c == '>' )
+        {
+            bool is_end = false;
+
+            switch ( reader->skip_kind )
+            {
+            case XMLSkipKind::Instruction:
+                is_end = reader->skip_history[1] == '?';
+                break;
+            case XMLSkipKind::Comment:
+                // the dashes of "<!--" don't count for the closing "-->"
+                is_end = is_dash_pair && reader->skip_count >= 5;
+                break;
+            case XMLSkipKind::Declaration:
+                is_end = true;
+                break;
+            }
+
+            if ( is_end )
+            {
+                reader->state = XMLStreamState::Text;
+                return;
+            }
+        }
+
+        reader->skip_history[0] = reader->skip_history[1];
+        reader->skip_history[1] = c;
+    }
+};
@@ -0,0 +1,242 @@
+#pragma once
+#include <assert.h>
+#include "XMLSerializer.h"
+#include "../Containers/DArray.h"
+#include "../Containers/ChunkedBuffer.h"
+#include "../Allocators/Allocator.h"
+#include "../String/NumberFormat.h"
+
+struct XMLOpenElement
+{
+    StringView name;
+    // child elements go on their own lines when pretty printing
+    bool has_elements;
+};
+
+/// <summary>
+/// <para>Writes XML straight into a ChunkedBuffer , elements are closed by the writer and text and attribute values are escaped</para>
+/// <para>Element names are kept as views until EndElement , they have to stay alive until then</para>
+/// <para>Pretty output puts every element on its own line , indented with tabs , text stays next to its tags</para>
+/// </summary>
+struct XMLWriter
+{
+    ChunkedBuffer* out;
+    DArray<XMLOpenElement> open_elements;
+
+    bool is_pretty;
+    // "<name attributes" has been written , the '>' isn't yet
+    bool is_tag_open;
+    bool has_content;
+
+    static void Create( XMLWriter* out_writer, ChunkedBuffer* out, Allocator alloc, bool is_pretty = false )
+    {
+        *out_writer = {};
+        out_writer->out = out;
+        out_writer->is_pretty = is_pretty;
+        DArray<XMLOpenElement>::Create( 16, &out_writer->open_elements, alloc, false );
+    }
+
+    static void Destroy( XMLWriter* writer )
+    {
+        DArray<XMLOpenElement>::Destroy( &writer->open_elements );
+        *writer = {};
+    }
+
+    static void Declaration( XMLWriter* writer )
+    {
+        assert( !writer->has_content );
+
+        ChunkedBuffer::Write( writer->out, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" );
+        writer->has_content = true;
+    }
+
+    static void BeginElement( XMLWriter* writer, StringView name )
+    {
+        CloseTag( writer );
+
+        if ( writer->open_elements.size != 0 )
+        {
+            writer->open_elements.data[writer->open_elements.size - 1].has_elements = true;
+        }
+
+        if ( writer->is_pretty && writer->has_content )
+        {
+            NewLine( writer, writer->open_elements.size );
+        }
+
+        ChunkedBuffer::Write( writer->out, '<' );
+        ChunkedBuffer::Write( writer->out, name );
+
+        XMLOpenElement element = {};
+        element.name = name;
+        DArray<XMLOpenElement>::Add( &writer->open_elements, element );
+
+        writer->is_tag_open = true;
+        writer->has_content = true;
+    }
+
+    /// <summary>
+    /// Only right after BeginElement or another Attribute , "is_escaped" is for values that already have their entities
+    /// </summary>
+    static void Attribute( XMLWriter* writer, StringView name, StringView value, bool is_escaped = false )
+    {
+        assert( writer->is_tag_open );
+
+        ChunkedBuffer::Write( writer->out, ' ' );
+        ChunkedBuffer::Write( writer->out, name );
+        ChunkedBuffer::Write( writer->out, "=\"" );
+        WriteEscaped( writer->out, value, is_escaped );
+        ChunkedBuffer::Write( writer->out, '"' );
+    }
+
+    static void IntegerAttribute( XMLWriter* writer, StringView name, int64_t value )
+    {
+        char text[NumberFormat::MAX_LENGTH];
+
+        StringView view = {};
+        view.buffer = text;
+        view.length = NumberFormat::FormatInt64( value, text );
+
+        Attribute( writer, name, view, true );
+    }
+
+    static void FloatAttribute( XMLWriter* writer, StringView name, double value )
+    {
+        char text[NumberFormat::MAX_LENGTH];
+
+        StringView view = {};
+        view.buffer = text;
+        view.length = NumberFormat::FormatDouble( value, text );
+
+        Attribute( writer, name, view, true );
+    }
+
+    static void FloatAttribute( XMLWriter* writer, StringView name, float value )
+    {
+        char text[NumberFormat::MAX_LENGTH];
+
+        StringView view = {};
+        view.buffer = text;
+        view.length = NumberFormat::FormatFloat( value, text );
+
+        Attribute( writer, name, view, true );
+    }
+
+    static void Text( XMLWriter* writer, StringView text, bool is_escaped = false )
+    {
+        assert( writer->open_elements.size != 0 );
+
+        CloseTag( writer );
+        WriteEscaped( writer->out, text, is_escaped );
+    }
+
+    static void EndElement( XMLWriter* writer )
+    {
+        assert( writer->open_elements.size != 0 );
+
+        XMLOpenElement element = writer->open_elements.data[--writer->open_elements.size];
+
+        if ( writer->is_tag_open )
+        {
+            ChunkedBuffer::Write( writer->out, "/>" );
+            writer->is_tag_open = false;
+            return;
+        }
+
+        if ( writer->is_pretty && element.has_elements )
+        {
+            NewLine( writer, writer->open_elements.size );
+        }
+
+        ChunkedBuffer::Write( writer->out, "</" );
+        ChunkedBuffer::Write( writer->out, element.name );
+        ChunkedBuffer::Write( writer->out, '>' );
+    }
+
+    /// <summary>
+    /// Writes a whole tree , values are taken as they are in the source (entities are not escaped again)
+    /// </summary>
+    static void WriteNode( XMLWriter* writer, const XMLNode* node )
+    {
+        if ( node->node_type == XMLNodeType::Text )
+        {
+            Text( writer, node->value, true );
+            return;
+        }
+
+        BeginElement( writer, node->name );
+
+        for ( size_t i = 0; i < node->attributes.size; ++i )
+        {
+            Attribute( writer, node->attributes.data[i].name, node->attributes.data[i].value, true );
+        }
+
+        for ( size_t i = 0; i < node->sub_elements.size; ++i )
+        {
+            WriteNode( writer, &node->sub_elements.data[i] );
+        }
+
+        EndElement( writer );
+    }
+
+private:
+
+    static inline void CloseTag( XMLWriter* writer )
+    {
+        if ( writer->is_tag_open )
+        {
+            ChunkedBuffer::Write( writer->out, '>' );
+            writer->is_tag_open = false;
+        }
+    }
+
+    static void NewLine( XMLWriter* writer, size_t indentation )
+    {
+        ChunkedBuffer::Write( writer->out, '\n' );
+
+        for ( size_t i = 0; i < indentation; ++i )
+        {
+            ChunkedBuffer::Write( writer->out, '\t' );
+        }
+    }
+
+    static void WriteEscaped( ChunkedBuffer* out, StringView str, bool is_escaped )
+    {
+        if ( is_escaped )
+        {
+            ChunkedBuffer::Write( out, str );
+            return;
+        }
+
+        size_t run_start = 0;
+
+        for ( size_t i = 0; i < str.length; ++i )
+        {
+            StringView entity = {};
+
+            switch ( str.buffer[i] )
+            {
+            case '&':
+                entity = "&amp;";
+                break;
+            case '<':
+                entity = "&lt;";
+                break;
+            case '>':
+                entity = "&gt;";
+                break;
+            case '"':
+                entity = "&quot;";
+                break;
+            default:
+                continue;
+            }
+
+            ChunkedBuffer::Write( out, str.buffer + run_start, i - run_start );
+            ChunkedBuffer::Write( out, entity );
+            run_start = i + 1;
+        }
+
+        ChunkedBuffer::Write( out, str.buffer + run_start, str.length - run_start );
+    }
+};
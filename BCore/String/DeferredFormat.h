@@ -0,0 +1,141 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <tuple>
+#include <type_traits>
+#include "../Typedefs/Typedefs.h"
+#include "../Containers/ChunkedBuffer.h"
+#include "FormatString.h"
+#include "StringUtils.h"
+
+/// <summary>
+/// Formats an encoded payload into "out" , returns the number of bytes written. One is instantiated per format and argument types
+/// </summary>
+typedef Func<size_t, const uint8_t*, ChunkedBuffer*> DeferredFormatter;
+
+/// <summary>
+/// <para>Splits formatting in two : the caller only copies the raw arguments into a payload (Encode) ,
+/// the text is produced later , on another thread if needed , from the payload and the FORMAT string (Decode)</para>
+/// <para>Numbers , bools , chars and enums are copied as they are , strings are copied as a 32 bits length and their bytes</para>
+/// <para>NOTE : strings share what's left of the payload after the other arguments , in order , and get cut when it runs out</para>
+/// </summary>
+struct DeferredFormat
+{
+    template<typename T>
+    static constexpr bool IS_RAW = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+    /// <summary>
+    /// The type an argument is read back as , strings come back as views into the payload
+    /// </summary>
+    template<typename T>
+    using Stored = std::conditional_t<IS_RAW<T>, T, StringView>;
+
+    /// <summary>
+    /// Bytes the arguments need before counting the text of the strings
+    /// </summary>
+    template<typename ...Args>
+    static constexpr size_t FixedSize()
+    {
+        return (size_t( 0 ) + ... + (IS_RAW<Args> ? sizeof( Args ) : sizeof( uint32_t )));
+    }
+
+    /// <summary>
+    /// Writes "args" to "payload" , returns the number of bytes used
+    /// </summary>
+    template<size_t Capacity, typename ...Args>
+    static size_t Encode( uint8_t (&payload)[Capacity], const Args&... args )
+    {
+        static_assert( FixedSize<Args...>() <= Capacity, "The arguments don't fit in the payload" );
+
+        size_t text_budget = Capacity - FixedSize<Args...>();
+        uint8_t* cursor = payload;
+
+        (Write( &cursor, &text_budget, args ), ...);
+
+        return (size_t) (cursor - payload);
+    }
+
+    /// <summary>
+    /// Formats a payload written by Encode with the same "Args" , the strings point into "payload" while formatting
+    /// </summary>
+    template<typename TSource, typename ...Args>
+    static size_t Decode( const uint8_t* payload, ChunkedBuffer* out )
+    {
+        const uint8_t* cursor = payload;
+
+        // a braced list is evaluated left to right , the arguments are read in the order they were written
+        std::tuple<Stored<Args>...> values{ Read<Args>( &cursor )... };
+
+        return std::apply( [out]( const Stored<Args>&... decoded ) { return StringUtils::FormatTo( out, CompiledFormat<TSource>{}, decoded... ); }, values );
+    }
+
+    /// <summary>
+    /// The formatter to keep next to a payload encoded from "args" , DeferredFormat::FormatterOf( FORMAT( "{} ms" ) , time )
+    /// </summary>
+    template<typename TSource, typename ...Args>
+    static DeferredFormatter FormatterOf( CompiledFormat<TSource>, const Args&... )
+    {
+        static_assert( CompiledFormat<TSource>::SLOT_COUNT == sizeof...(Args), "The number of arguments doesn't match the number of {} in the format" );
+
+        return Decode<TSource, Args...>;
+    }
+
+private:
+
+    template<typename T>
+    static void Write( uint8_t** cursor, size_t* text_budget, const T& value )
+    {
+        if constexpr ( IS_RAW<T> )
+        {
+            memcpy( *cursor, &value, sizeof( T ) );
+            *cursor += sizeof( T );
+        }
+        else
+        {
+            StringView text = {};
+
+            if constexpr ( std::is_same_v<T, StringBuffer> )
+            {
+                text = value.view;
+            }
+            else
+            {
+                text = value;
+            }
+
+            uint32_t length = (uint32_t) (text.length < *text_budget ? text.length : *text_budget);
+            *text_budget -= length;
+
+            memcpy( *cursor, &length, sizeof( uint32_t ) );
+            memcpy( *cursor + sizeof( uint32_t ), text.buffer, length );
+            *cursor += sizeof( uint32_t ) + length;
+        }
+    }
+
+    template<typename T>
+    static Stored<T> Read( const uint8_t** cursor )
+    {
+        if constexpr ( IS_RAW<T> )
+        {
+            T value;
+            memcpy( &value, *cursor, sizeof( T ) );
+            *cursor += sizeof( T );
+
+            return value;
+        }
+        else
+        {
+            uint32_t length = 0;
+            memcpy( &length, *cursor, sizeof( uint32_t ) );
+
+            StringView text = {};
+            text.buffer = (const char*) (*cursor + sizeof( uint32_t ));
+            text.length = length;
+
+            *cursor += sizeof( uint32_t ) + length;
+
+            return text;
+        }
+    }
+};
@@ -0,0 +1,154 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#include "StringView.h"
+#include "StringBuffer.h"
+#include "NumberFormat.h"
+
+struct FormatSegment
+{
+    size_t start;
+    size_t length;
+};
+
+/// <summary>
+/// The literal text around the "{}" slots of a format string , "segments[i]" comes before slot i and the last one is the tail
+/// </summary>
+template<size_t SLOT_COUNT>
+struct FormatLayout
+{
+    FormatSegment segments[SLOT_COUNT + 1];
+    size_t literal_length;
+};
+
+struct FormatParser
+{
+    static constexpr size_t CountSlots( const char* str, size_t length )
+    {
+        size_t count = 0;
+
+        for ( size_t i = 0; i + 1 < length; ++i )
+        {
+            if ( str[i] == '{' && str[i + 1] == '}' )
+            {
+                count++;
+                i++;
+            }
+        }
+
+        return count;
+    }
+
+    template<size_t SLOT_COUNT>
+    static constexpr FormatLayout<SLOT_COUNT> Parse( const char* str, size_t length )
+    {
+        FormatLayout<SLOT_COUNT> layout = {};
+
+        size_t slot = 0;
+        size_t start = 0;
+
+        for ( size_t i = 0; i + 1 < length; ++i )
+        {
+            if ( str[i] == '{' && str[i + 1] == '}' )
+            {
+                layout.segments[slot++] = { start, i - start };
+                start = i + 2;
+                i++;
+            }
+        }
+
+        layout.segments[SLOT_COUNT] = { start, length - start };
+        layout.literal_length = length - (SLOT_COUNT * 2);
+
+        return layout;
+    }
+};
+
+/// <summary>
+/// <para>A format string parsed at compile time , made with the FORMAT macro : StringUtils::Format( alloc , FORMAT( "{} of {}" ) , a , b )</para>
+/// <para>The slot count is checked against the arguments when compiling , and formatting only copies the literal segments , it never scans the text</para>
+/// </summary>
+template<typename TSource>
+struct CompiledFormat
+{
+    static constexpr const char* TEXT = TSource::Text();
+    static constexpr size_t LENGTH = TSource::Length();
+    static constexpr size_t SLOT_COUNT = FormatParser::CountSlots( TEXT, LENGTH );
+    static constexpr FormatLayout<SLOT_COUNT> LAYOUT = FormatParser::Parse<SLOT_COUNT>( TEXT, LENGTH );
+};
+
+// NOTE : "str" has to be a string literal , the lambda only exists to give it a unique type
+#define FORMAT(str) []() { struct Source { static constexpr const char* Text() { return str; } static constexpr size_t Length() { return sizeof( str ) - 1; } }; return CompiledFormat<Source>{}; }()
+
+/// <summary>
+/// <para>One argument ready to be copied : strings are referenced where they are , numbers are formatted in "digits"</para>
+/// <para>Every argument is prepared once , which gives the exact size of the result before anything is allocated</para>
+/// </summary>
+struct FormatArgument
+{
+    const char* data;
+    size_t length;
+    char digits[NumberFormat::MAX_LENGTH];
+
+    template<typename T>
+    static void Prepare( FormatArgument* out, const T& value )
+    {
+        out->data = out->digits;
+
+        if constexpr ( std::is_same_v<T, bool> )
+        {
+            StringView text = value ? "true" : "false";
+            out->data = text.buffer;
+            out->length = text.length;
+        }
+        else if constexpr ( std::is_same_v<T, char> )
+        {
+            out->digits[0] = value;
+            out->length = 1;
+        }
+        else if constexpr ( std::is_enum_v<T> )
+        {
+            out->length = NumberFormat::FormatInt64( (int64_t) value, out->digits );
+        }
+        else if constexpr ( std::is_integral_v<T> && std::is_signed_v<T> )
+        {
+            out->length = NumberFormat::FormatInt64( (int64_t) value, out->digits );
+        }
+        else if constexpr ( std::is_integral_v<T> )
+        {
+            out->length = NumberFormat::FormatUInt64( (uint64_t) value, out->digits );
+        }
+        else if constexpr ( std::is_same_v<T, float> )
+        {
+            out->length = NumberFormat::FormatFloat( value, out->digits );
+        }
+        else if constexpr ( std::is_same_v<T, double> )
+        {
+            out->length = NumberFormat::FormatDouble( value, out->digits );
+        }
+        else if constexpr ( std::is_same_v<T, StringBuffer> )
+        {
+            out->data = value.buffer;
+            out->length = value.length;
+        }
+        else
+        {
+            // const char* , char* , StringView
+            StringView view = value;
+            out->data = view.buffer;
+            out->length = view.length;
+        }
+    }
+
+    template<typename ...Args>
+    static size_t PrepareAll( FormatArgument* out, const Args&... args )
+    {
+        size_t length = 0;
+        size_t i = 0;
+
+        ((Prepare( &out[i], args ), length += out[i].length, i++), ...);
+
+        return length;
+    }
+};
@@ -0,0 +1,213 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+
+/// <summary>
+/// <para>Number to text conversions that write straight into a caller buffer , nothing is allocated</para>
+/// <para>Integers go two digits at a time through a table , floating point values look for the shortest decimal that reads back
+/// to the same value and only fall back to snprintf when it needs more digits than the fast path handles</para>
+/// </summary>
+struct NumberFormat
+{
+    // big enough for any of the Format functions
+    static constexpr size_t MAX_LENGTH = 32;
+
+    static size_t FormatUInt64( uint64_t value, char* out )
+    {
+        static constexpr char DIGIT_PAIRS[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        size_t length = DigitCount( value );
+        char* cursor = out + length;
+
+        while ( value >= 100 )
+        {
+            size_t pair = (size_t) (value % 100) * 2;
+            value /= 100;
+
+            cursor -= 2;
+            cursor[0] = DIGIT_PAIRS[pair];
+            cursor[1] = DIGIT_PAIRS[pair + 1];
+        }
+
+        if ( value >= 10 )
+        {
+            cursor -= 2;
+            cursor[0] = DIGIT_PAIRS[value * 2];
+            cursor[1] = DIGIT_PAIRS[(value * 2) + 1];
+        }
+        else
+        {
+            cursor[-1] = (char) ('0' + value);
+        }
+
+        return length;
+    }
+
+    static size_t FormatInt64( int64_t value, char* out )
+    {
+        if ( value < 0 )
+        {
+            *out = '-';
+            // negated as unsigned so INT64_MIN doesn't overflow
+            return FormatUInt64( 0 - (uint64_t) value, out + 1 ) + 1;
+        }
+
+        return FormatUInt64( (uint64_t) value, out );
+    }
+
+    /// <summary>
+    /// Shortest text that reads back to "value" , "nan" and "inf" for non finite values
+    /// </summary>
+    static size_t FormatDouble( double value, char* out )
+    {
+        size_t length = 0;
+
+        if ( TryFormatShort( value, out, false, &length ) )
+        {
+            return length;
+        }
+
+        return (size_t) snprintf( out, MAX_LENGTH, "%.17g", value );
+    }
+
+    /// <summary>
+    /// Shortest text that reads back to "value" as a float , "nan" and "inf" for non finite values
+    /// </summary>
+    static size_t FormatFloat( float value, char* out )
+    {
+        size_t length = 0;
+
+        if ( TryFormatShort( value, out, true, &length ) )
+        {
+            return length;
+        }
+
+        return (size_t) snprintf( out, MAX_LENGTH, "%.9g", value );
+    }
+
+    static inline size_t DigitCount( uint64_t value )
+    {
+        size_t count = 1;
+
+        while ( value >= 10'000 )
+        {
+            value /= 10'000;
+            count += 4;
+        }
+
+        while ( value >= 10 )
+        {
+            value /= 10;
+            count++;
+        }
+
+        return count;
+    }
+
+private:
+
+    static constexpr int MAX_FRACTION_DIGITS = 15;
+
+    /// <summary>
+    /// <para>Tries "integer.fraction" with 0 to MAX_FRACTION_DIGITS fraction digits and keeps the first one that reads back to "value"</para>
+    /// <para>The check divides the exact scaled integer by an exact power of ten , IEEE division rounds correctly
+    /// so the result is what a correct parser gives for that text</para>
+    /// </summary>
+    static bool TryFormatShort( double value, char* out, bool is_float, size_t* out_length )
+    {
+        static constexpr double POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+
+        // 2^53 , past it the scaled value isn't an exact integer anymore
+        static constexpr double MAX_EXACT = 9'007'199'254'740'992.0;
+
+        if ( value != value )
+        {
+            *out_length = Copy( "nan", out );
+            return true;
+        }
+
+        if ( value == HUGE_VAL || value == -HUGE_VAL )
+        {
+            *out_length = Copy( value < 0 ? "-inf" : "inf", out );
+            return true;
+        }
+
+        double magnitude = value < 0 ? -value : value;
+
+        for ( int digits = 0; digits <= MAX_FRACTION_DIGITS; ++digits )
+        {
+            double scaled = nearbyint( magnitude * POWERS_OF_TEN[digits] );
+
+            if ( scaled >= MAX_EXACT )
+            {
+                return false;
+            }
+
+            double read_back = scaled / POWERS_OF_TEN[digits];
+            bool is_same = is_float ? (float) read_back == (float) magnitude : read_back == magnitude;
+
+            if ( !is_same )
+            {
+                continue;
+            }
+
+            char* cursor = out;
+
+            // "-0" keeps the sign
+            if ( value < 0 || (value == 0 && signbit( value )) )
+            {
+                *cursor++ = '-';
+            }
+
+            uint64_t fixed = (uint64_t) scaled;
+            uint64_t power = (uint64_t) POWERS_OF_TEN[digits];
+
+            cursor += FormatUInt64( fixed / power, cursor );
+
+            if ( digits != 0 )
+            {
+                *cursor++ = '.';
+
+                // leading zeros of the fraction
+                uint64_t fraction = fixed % power;
+                size_t fraction_length = DigitCount( fraction );
+
+                for ( size_t i = fraction_length; i < (size_t) digits; ++i )
+                {
+                    *cursor++ = '0';
+                }
+
+                cursor += FormatUInt64( fraction, cursor );
+            }
+
+            *out_length = cursor - out;
+            return true;
+        }
+
+        return false;
+    }
+
+    static inline size_t Copy( const char* str, char* out )
+    {
+        size_t length = 0;
+
+        while ( str[length] != '\0' )
+        {
+            out[length] = str[length];
+            length++;
+        }
+
+        return length;
+    }
+};
@@ -58,7 +58,7 @@ StringBuffer StringBuffer::Create( StringView str, Allocator allocator )
 
 void StringBuffer::Destroy( StringBuffer* str )
 {
-    str->alloc.free( &str->alloc, str->buffer );
+    FREE( str->alloc, str->buffer );
     str->buffer = nullptr;
     str->length = 0;
 }
@@ -68,7 +68,7 @@ void StringBuffer::Resize( StringBuffer* str, size_t length )
     if ( str->length <= length )
         return;
 
-    str->buffer = (char*) str->alloc.realloc( &str->alloc, str->buffer, length * sizeof( char ) );
+    str->buffer = (char*) REALLOC( str->alloc, str->buffer, length * sizeof( char ) );
     str->length = str->length;
 
 }
\ No newline at end of file
@@ -1,50 +1,109 @@
 #pragma once
+#include <stdio.h>
 #include "../Allocators/Allocator.h"
-#include "../Containers/DoubleLinkedList.h"
+#include "../Containers/ChunkedBuffer.h"
 #include "StringBuffer.h"
 #include "StringView.h"
 #include "StringUtils.h"
 
+/// <summary>
+/// <para>Appends go into fixed size chunks (an arena allocator works well) , nothing written is ever moved or copied while building</para>
+/// <para>The result can go straight to a file (WriteTo) or a gather list (Gather) chunk by chunk , Flatten merges it in place
+/// only when a contiguous view is really needed , ToString still gives an owned copy</para>
+/// </summary>
 struct StringBuilder
 {
+    // small enough for the many short lived builders of reports and messages
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 4 * 1'024;
+
     size_t size;
-    DoubleLinkedList<StringBuffer> list;
+    ChunkedBuffer chunks;
     Allocator alloc;
 
-    static void Create(StringBuilder* out_builder, Allocator alloc )
+    static void Create(StringBuilder* out_builder, Allocator alloc, size_t chunk_size = DEFAULT_CHUNK_SIZE)
     {
         *out_builder = {};
         out_builder->alloc = alloc;
-        DoubleLinkedList<StringBuffer>::Create(&out_builder->list , alloc);
+        ChunkedBuffer::Create(&out_builder->chunks, alloc, chunk_size);
     }
 
     static void Append(StringBuilder* in_builder , StringView str)
     {
         in_builder->size += str.length;
-        StringBuffer buffer = StringBuffer::Create(str , in_builder->alloc);
-        DoubleLinkedList<StringBuffer>::Append(&in_builder->list , buffer);
+        ChunkedBuffer::Write(&in_builder->chunks, str);
+    }
+
+    static void Append(StringBuilder* in_builder , char c)
+    {
+        in_builder->size++;
+        ChunkedBuffer::Write(&in_builder->chunks, c);
+    }
+
+    /// <summary>
+    /// Formats straight into the chunks : StringBuilder::AppendFormat( &builder , FORMAT( "{} ms" ) , time )
+    /// </summary>
+    template<typename TSource, typename ...Args>
+    static void AppendFormat(StringBuilder* in_builder , CompiledFormat<TSource> format , Args... args)
+    {
+        in_builder->size += StringUtils::FormatTo(&in_builder->chunks, format, args...);
     }
 
+    /// <summary>
+    /// Copies the content to a new StringBuffer allocated with "alloc" , the builder keeps its content
+    /// </summary>
     static void ToString(StringBuilder* in_builder , StringBuffer* out_str , Allocator alloc)
     {
-            *out_str = StringBuffer::Create(in_builder->size , alloc);
+        ChunkedBuffer::ToString(&in_builder->chunks, out_str, alloc);
+    }
 
-            DoubleLinkedList<StringBuffer>::Node* n = in_builder->list.first;
-            
-            size_t offset = 0;
+    /// <summary>
+    /// Contiguous view of the content , valid until the next Append or Clear. See ChunkedBuffer::Flatten
+    /// </summary>
+    static StringView Flatten(StringBuilder* in_builder)
+    {
+        return ChunkedBuffer::Flatten(&in_builder->chunks);
+    }
 
-            while(n != nullptr)
-            {
-                CoreContext::mem_copy( (void*) n->data.buffer ,(void*) (out_str->buffer + offset) , n->data.length);
-                offset += n->data.length;
+    /// <summary>
+    /// Writes the chunks one by one , false if the file stopped accepting bytes
+    /// </summary>
+    static bool WriteTo(StringBuilder* in_builder , FILE* file)
+    {
+        return ChunkedBuffer::WriteTo(&in_builder->chunks, WriteToFile, file);
+    }
 
-                n = n->next;
-            }
+    static bool WriteTo(StringBuilder* in_builder , Func<bool, void*, StringView> write , void* user_data)
+    {
+        return ChunkedBuffer::WriteTo(&in_builder->chunks, write, user_data);
+    }
+
+    /// <summary>
+    /// Adds a view per chunk to "out_segments" , for a vectored write
+    /// </summary>
+    static void Gather(StringBuilder* in_builder , DArray<StringView>* out_segments)
+    {
+        ChunkedBuffer::Gather(&in_builder->chunks, out_segments);
+    }
+
+    /// <summary>
+    /// Empties the builder , the chunks are kept for the next appends
+    /// </summary>
+    static void Clear(StringBuilder* in_builder)
+    {
+        in_builder->size = 0;
+        ChunkedBuffer::Reset(&in_builder->chunks);
     }
 
     static void Destroy(StringBuilder* in_builder)
     {
-        DoubleLinkedList<StringBuffer>::Destroy(&in_builder->list);
+        ChunkedBuffer::Destroy(&in_builder->chunks);
         *in_builder = {};
     }
-};
\ No newline at end of file
+
+private:
+
+    static bool WriteToFile(void* user_data , StringView str)
+    {
+        return fwrite(str.buffer, 1, str.length, (FILE*) user_data) == str.length;
+    }
+};
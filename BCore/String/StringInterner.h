@@ -0,0 +1,238 @@
+#pragma once
+#include <stdint.h>
+#include <assert.h>
+#include "../Allocators/Allocator.h"
+#include "../Atomic/AtomicLock.h"
+#include "../Containers/DArray.h"
+#include "../Containers/HashPolicies.h"
+#include "StringView.h"
+
+/// <summary>
+/// <para>Stable 32 bits handle of an interned string , two names are the same string exactly when their ids are equal</para>
+/// <para>0 is never given out , a zeroed StringID means "no name"</para>
+/// </summary>
+typedef uint32_t StringID;
+
+/// <summary>
+/// <para>Gives every distinct string a StringID , so names can be stored and compared as integers and turned back into text when printed</para>
+/// <para>The text lives in an arena that only grows by chaining blocks , the views GetString returns stay valid until Destroy</para>
+/// <para>The table is open addressing with linear probing , each slot packs the high half of the hash with the id so most misses never touch the text</para>
+/// <para>Every call takes the lock , intern names once when loading and keep the ids , not the strings</para>
+/// </summary>
+struct StringInterner
+{
+    static constexpr StringID INVALID_ID = 0;
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+    static constexpr size_t DEFAULT_ARENA_SIZE = 16 * 1'024;
+
+    Arena arena;
+    Allocator alloc;
+
+    /// <summary>
+    /// (hash >> 32) << 32 | id , 0 for an empty slot. "slot_count" is a power of two
+    /// </summary>
+    uint64_t* slots;
+    size_t slot_count;
+
+    /// <summary>
+    /// Interned text by id , strings.data[id - 1]
+    /// </summary>
+    DArray<StringView> strings;
+
+    AtomicLock lock;
+
+    static void Create( StringInterner* out_interner, Allocator alloc, size_t capacity = DEFAULT_CAPACITY, size_t arena_size = DEFAULT_ARENA_SIZE )
+    {
+        *out_interner = {};
+        out_interner->alloc = alloc;
+        out_interner->arena = Arena::Create( arena_size, false );
+
+        DArray<StringView>::Create( capacity, &out_interner->strings, alloc, false );
+        CreateSlots( out_interner, SlotCountFor( capacity ) );
+    }
+
+    static void Destroy( StringInterner* interner )
+    {
+        FREE( interner->alloc, interner->slots );
+        DArray<StringView>::Destroy( &interner->strings );
+        Arena::Destroy( &interner->arena );
+
+        *interner = {};
+    }
+
+    /// <summary>
+    /// Id of "str" , copies it in the first time it's seen. The empty string is a name like any other
+    /// </summary>
+    static StringID Intern( StringInterner* interner, StringView str )
+    {
+        uint64_t hash = HashUtils::Hash64( str.buffer, str.length );
+
+        interner->lock.Lock();
+
+        size_t slot_idx = 0;
+        StringID id = Lookup( interner, str, hash, &slot_idx );
+
+        if ( id == INVALID_ID )
+        {
+            // NUL terminated so the text can go to C apis as is
+            char* text = (char*) Arena::Push( &interner->arena, str.length + 1, 1 );
+            CoreContext::mem_copy( (void*) str.buffer, text, str.length );
+            text[str.length] = '\0';
+
+            StringView stored = {};
+            stored.buffer = text;
+            stored.length = str.length;
+
+            DArray<StringView>::Add( &interner->strings, stored );
+            id = (StringID) interner->strings.size;
+
+            interner->slots[slot_idx] = Pack( hash, id );
+
+            // keeps the load under 7/8 so probes stay short and always end on an empty slot
+            if ( interner->strings.size * 8 > interner->slot_count * 7 )
+            {
+                Rehash( interner, interner->slot_count * 2 );
+            }
+        }
+
+        interner->lock.Unlock();
+
+        return id;
+    }
+
+    /// <summary>
+    /// Id of "str" if it was interned before , INVALID_ID otherwise. Never adds anything
+    /// </summary>
+    static StringID Find( StringInterner* interner, StringView str )
+    {
+        uint64_t hash = HashUtils::Hash64( str.buffer, str.length );
+
+        interner->lock.Lock();
+
+        size_t slot_idx = 0;
+        StringID id = Lookup( interner, str, hash, &slot_idx );
+
+        interner->lock.Unlock();
+
+        return id;
+    }
+
+    /// <summary>
+    /// The text of "id" , an empty view for INVALID_ID or an id this interner didn't give
+    /// </summary>
+    static StringView GetString( StringInterner* interner, StringID id )
+    {
+        StringView str = {};
+
+        interner->lock.Lock();
+
+        if ( id != INVALID_ID && id <= interner->strings.size )
+        {
+            str = interner->strings.data[id - 1];
+        }
+
+        interner->lock.Unlock();
+
+        return str;
+    }
+
+    static size_t Count( StringInterner* interner )
+    {
+        interner->lock.Lock();
+        size_t count = interner->strings.size;
+        interner->lock.Unlock();
+
+        return count;
+    }
+
+private:
+
+    static inline uint64_t Pack( uint64_t hash, StringID id )
+    {
+        return (hash & 0xFFFFFFFF00000000ull) | id;
+    }
+
+    static size_t SlotCountFor( size_t capacity )
+    {
+        size_t count = 16;
+
+        while ( count * 7 < capacity * 8 )
+        {
+            count <<= 1;
+        }
+
+        return count;
+    }
+
+    static void CreateSlots( StringInterner* interner, size_t slot_count )
+    {
+        interner->slot_count = slot_count;
+        interner->slots = (uint64_t*) ALLOC( interner->alloc, slot_count * sizeof( uint64_t ) );
+        CoreContext::mem_set( interner->slots, 0, slot_count * sizeof( uint64_t ) );
+    }
+
+    /// <summary>
+    /// Id of "str" or INVALID_ID , "out_slot_idx" is the slot it's in or the empty slot it would go in
+    /// </summary>
+    static StringID Lookup( StringInterner* interner, StringView str, uint64_t hash, size_t* out_slot_idx )
+    {
+        size_t mask = interner->slot_count - 1;
+        size_t slot_idx = (size_t) hash & mask;
+        uint64_t tag = hash & 0xFFFFFFFF00000000ull;
+
+        while ( interner->slots[slot_idx] != 0 )
+        {
+            uint64_t slot = interner->slots[slot_idx];
+
+            if ( (slot & 0xFFFFFFFF00000000ull) == tag )
+            {
+                StringID id = (StringID) slot;
+                StringView candidate = interner->strings.data[id - 1];
+
+                if ( candidate.length == str.length && CoreContext::mem_compare( (void*) candidate.buffer, (void*) str.buffer, str.length ) )
+                {
+                    *out_slot_idx = slot_idx;
+                    return id;
+                }
+            }
+
+            slot_idx = (slot_idx + 1) & mask;
+        }
+
+        *out_slot_idx = slot_idx;
+        return INVALID_ID;
+    }
+
+    static void Rehash( StringInterner* interner, size_t slot_count )
+    {
+        uint64_t* old_slots = interner->slots;
+        size_t old_count = interner->slot_count;
+
+        CreateSlots( interner, slot_count );
+
+        size_t mask = slot_count - 1;
+
+        for ( size_t i = 0; i < old_count; ++i )
+        {
+            uint64_t slot = old_slots[i];
+
+            if ( slot == 0 )
+            {
+                continue;
+            }
+
+            // only the high half of the hash is kept , the text is hashed again for the new position
+            StringView str = interner->strings.data[(StringID) slot - 1];
+            size_t slot_idx = (size_t) HashUtils::Hash64( str.buffer, str.length ) & mask;
+
+            while ( interner->slots[slot_idx] != 0 )
+            {
+                slot_idx = (slot_idx + 1) & mask;
+            }
+
+            interner->slots[slot_idx] = slot;
+        }
+
+        FREE( interner->alloc, old_slots );
+    }
+};
@@ -0,0 +1,287 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/// <summary>
+/// <para>Instruction sets the string kernels can use , picked at compile time</para>
+/// <para>SSE2 is always there on x64 , AVX2 only when the compiler targets it (/arch:AVX2 or -mavx2)</para>
+/// </summary>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_SSE2 1
+#include <emmintrin.h>
+#else
+#define STRING_SSE2 0
+#endif
+
+#if STRING_SSE2 && defined(__AVX2__)
+#define STRING_AVX2 1
+#include <immintrin.h>
+#else
+#define STRING_AVX2 0
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// <para>Search , compare and replace kernels over raw bytes , 32 bytes per step with AVX2 , 16 with SSE2 and byte by byte for the tails</para>
+/// <para>StringUtils wraps them for StringViews , they are here to be used on any buffer</para>
+/// </summary>
+struct StringSearch
+{
+    static constexpr size_t NOT_FOUND = (size_t) -1;
+
+    /// <summary>
+    /// Index of the first "c" at or after "from" , NOT_FOUND if there is none
+    /// </summary>
+    static size_t FindChar( const char* data, size_t length, char c, size_t from = 0 )
+    {
+        size_t i = from;
+
+#if STRING_AVX2
+        const __m256i needle_32 = _mm256_set1_epi8( c );
+
+        for ( ; i + 32 <= length; i += 32 )
+        {
+            __m256i block = _mm256_loadu_si256( (const __m256i*) (data + i) );
+            uint32_t mask = (uint32_t) _mm256_movemask_epi8( _mm256_cmpeq_epi8( block, needle_32 ) );
+
+            if ( mask != 0 )
+            {
+                return i + LowestBit( mask );
+            }
+        }
+#endif
+
+#if STRING_SSE2
+        const __m128i needle = _mm_set1_epi8( c );
+
+        for ( ; i + 16 <= length; i += 16 )
+        {
+            __m128i block = _mm_loadu_si128( (const __m128i*) (data + i) );
+            uint32_t mask = (uint32_t) _mm_movemask_epi8( _mm_cmpeq_epi8( block, needle ) );
+
+            if ( mask != 0 )
+            {
+                return i + LowestBit( mask );
+            }
+        }
+#endif
+
+        for ( ; i < length; ++i )
+        {
+            if ( data[i] == c )
+            {
+                return i;
+            }
+        }
+
+        return NOT_FOUND;
+    }
+
+    /// <summary>
+    /// <para>Index of the first "pattern" at or after "from" , NOT_FOUND if there is none</para>
+    /// <para>Blocks are filtered on the first and the last character of the pattern at once , only the candidates that pass both are compared</para>
+    /// </summary>
+    static size_t Find( const char* data, size_t length, const char* pattern, size_t pattern_length, size_t from = 0 )
+    {
+        if ( pattern_length == 0 )
+        {
+            return from <= length ? from : NOT_FOUND;
+        }
+
+        if ( pattern_length == 1 )
+        {
+            return FindChar( data, length, pattern[0], from );
+        }
+
+        if ( pattern_length > length )
+        {
+            return NOT_FOUND;
+        }
+
+        // last position the pattern can start at
+        size_t last_start = length - pattern_length;
+        size_t i = from;
+
+#if STRING_AVX2
+        const __m256i first_32 = _mm256_set1_epi8( pattern[0] );
+        const __m256i last_32 = _mm256_set1_epi8( pattern[pattern_length - 1] );
+
+        for ( ; i + 32 <= last_start + 1; i += 32 )
+        {
+            __m256i block_first = _mm256_loadu_si256( (const __m256i*) (data + i) );
+            __m256i block_last = _mm256_loadu_si256( (const __m256i*) (data + i + pattern_length - 1) );
+
+            uint32_t mask = (uint32_t) _mm256_movemask_epi8( _mm256_and_si256( _mm256_cmpeq_epi8( block_first, first_32 ), _mm256_cmpeq_epi8( block_last, last_32 ) ) );
+
+            while ( mask != 0 )
+            {
+                size_t candidate = i + LowestBit( mask );
+
+                if ( memcmp( data + candidate + 1, pattern + 1, pattern_length - 2 ) == 0 )
+                {
+                    return candidate;
+                }
+
+                mask &= mask - 1;
+            }
+        }
+#endif
+
+#if STRING_SSE2
+        const __m128i first = _mm_set1_epi8( pattern[0] );
+        const __m128i last = _mm_set1_epi8( pattern[pattern_length - 1] );
+
+        for ( ; i + 16 <= last_start + 1; i += 16 )
+        {
+            __m128i block_first = _mm_loadu_si128( (const __m128i*) (data + i) );
+            __m128i block_last = _mm_loadu_si128( (const __m128i*) (data + i + pattern_length - 1) );
+
+            uint32_t mask = (uint32_t) _mm_movemask_epi8( _mm_and_si128( _mm_cmpeq_epi8( block_first, first ), _mm_cmpeq_epi8( block_last, last ) ) );
+
+            while ( mask != 0 )
+            {
+                size_t candidate = i + LowestBit( mask );
+
+                if ( memcmp( data + candidate + 1, pattern + 1, pattern_length - 2 ) == 0 )
+                {
+                    return candidate;
+                }
+
+                mask &= mask - 1;
+            }
+        }
+#endif
+
+        for ( ; i <= last_start; ++i )
+        {
+            if ( data[i] == pattern[0] && data[i + pattern_length - 1] == pattern[pattern_length - 1] && memcmp( data + i + 1, pattern + 1, pattern_length - 2 ) == 0 )
+            {
+                return i;
+            }
+        }
+
+        return NOT_FOUND;
+    }
+
+    /// <summary>
+    /// Byte equality of two buffers of "length" bytes
+    /// </summary>
+    static bool Equals( const char* a, const char* b, size_t length )
+    {
+        size_t i = 0;
+
+#if STRING_AVX2
+        for ( ; i + 32 <= length; i += 32 )
+        {
+            __m256i block_a = _mm256_loadu_si256( (const __m256i*) (a + i) );
+            __m256i block_b = _mm256_loadu_si256( (const __m256i*) (b + i) );
+
+            if ( (uint32_t) _mm256_movemask_epi8( _mm256_cmpeq_epi8( block_a, block_b ) ) != 0xFFFFFFFFu )
+            {
+                return false;
+            }
+        }
+#endif
+
+#if STRING_SSE2
+        for ( ; i + 16 <= length; i += 16 )
+        {
+            __m128i block_a = _mm_loadu_si128( (const __m128i*) (a + i) );
+            __m128i block_b = _mm_loadu_si128( (const __m128i*) (b + i) );
+
+            if ( _mm_movemask_epi8( _mm_cmpeq_epi8( block_a, block_b ) ) != 0xFFFF )
+            {
+                return false;
+            }
+        }
+
+        // the last 16 bytes again rather than a byte loop , when the buffers are long enough
+        if ( i != length && length >= 16 )
+        {
+            __m128i block_a = _mm_loadu_si128( (const __m128i*) (a + length - 16) );
+            __m128i block_b = _mm_loadu_si128( (const __m128i*) (b + length - 16) );
+
+            return _mm_movemask_epi8( _mm_cmpeq_epi8( block_a, block_b ) ) == 0xFFFF;
+        }
+#endif
+
+        for ( ; i < length; ++i )
+        {
+            if ( a[i] != b[i] )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Replaces every "to_replace" with "replace_with" in place , returns how many were replaced
+    /// </summary>
+    static size_t ReplaceChar( char* data, size_t length, char to_replace, char replace_with )
+    {
+        size_t count = 0;
+        size_t i = 0;
+
+#if STRING_SSE2
+        const __m128i from = _mm_set1_epi8( to_replace );
+        const __m128i to = _mm_set1_epi8( replace_with );
+
+        for ( ; i + 16 <= length; i += 16 )
+        {
+            __m128i block = _mm_loadu_si128( (const __m128i*) (data + i) );
+            __m128i matches = _mm_cmpeq_epi8( block, from );
+            uint32_t mask = (uint32_t) _mm_movemask_epi8( matches );
+
+            // blocks without a match aren't written back
+            if ( mask == 0 )
+            {
+                continue;
+            }
+
+            count += BitCount( mask );
+
+            __m128i replaced = _mm_or_si128( _mm_andnot_si128( matches, block ), _mm_and_si128( matches, to ) );
+            _mm_storeu_si128( (__m128i*) (data + i), replaced );
+        }
+#endif
+
+        for ( ; i < length; ++i )
+        {
+            if ( data[i] == to_replace )
+            {
+                data[i] = replace_with;
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    static inline uint32_t LowestBit( uint32_t mask )
+    {
+#ifdef _MSC_VER
+        unsigned long idx = 0;
+        _BitScanForward( &idx, mask );
+        return (uint32_t) idx;
+#else
+        return (uint32_t) __builtin_ctz( mask );
+#endif
+    }
+
+    static inline uint32_t BitCount( uint32_t mask )
+    {
+        // no POPCNT requirement
+        mask = mask - ((mask >> 1) & 0x55555555u);
+        mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+        mask = (mask + (mask >> 4)) & 0x0F0F0F0Fu;
+
+        return (mask * 0x01010101u) >> 24;
+    }
+};
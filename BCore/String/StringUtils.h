@@ -7,27 +7,16 @@
 #include "StringView.h"
 #include "StringBuffer.h"
 #include "ToString.h"
+#include "FormatString.h"
+#include "StringSearch.h"
+#include "../Containers/HashPolicies.h"
+#include "../Containers/ChunkedBuffer.h"
 #include "../Context/CoreContext.h"
 
 class StringUtils
 {
 private:
 
-    template<typename T, typename ...Args>
-    static void FormatAccumulator( DArray<StringBuffer>* accumulate, T first, Args... args )
-    {
-        FormatAccumulator( accumulate, first );
-        FormatAccumulator( accumulate, args... );
-    }
-    template<typename T>
-    static void FormatAccumulator( DArray<StringBuffer>* accumlate, T last )
-    {
-        Allocator temp_alloc = ArenaAllocator::Create( &CoreContext::core_arena );
-        StringBuffer str = ToString( last, temp_alloc );
-        DArray<StringBuffer>::Add( accumlate, str );
-    }
-
-
     static void ConcatInternal( StringBuffer buffer, size_t curr_index, StringView start )
     {
         for ( size_t i = 0; i < start.length; ++i )
@@ -89,113 +78,136 @@ public:
         return res;
     }
 
+    /// <summary>
+    /// <para>Replaces every "{}" of "str" with the next argument , the template is scanned when called</para>
+    /// <para>Nothing but the result is allocated , use the FORMAT overload when the template is a literal</para>
+    /// </summary>
     template<typename ...Args>
-    static StringBuffer Format( Allocator string_alloc, Allocator temp_alloc, StringView str, Args... args )
+    static StringBuffer Format( Allocator string_alloc, StringView str, Args... args )
     {
-        size_t max_slots = sizeof( size_t ) * (str.length / 2);
-        size_t* formatSlots = (size_t*) ALLOC( temp_alloc, max_slots );
-        size_t formatSlotCount = 0;
+        const size_t args_count = sizeof...(args);
 
-        for ( size_t i = 0; i < str.length - 1; ++i )
-        {
-            char first = str.buffer[i];
-            char second = str.buffer[i + 1];
+        assert( FormatParser::CountSlots( str.buffer, str.length ) == args_count );
 
-            if ( (first == '{') && (second == '}') )
-            {
-                // note: we increment i again to skit the second bracket since that comparison is redundant
-                formatSlots[formatSlotCount++] = i++;
-            }
-        }
+        FormatArgument prepared[args_count + 1];
+        size_t size = str.length - (args_count * 2) + FormatArgument::PrepareAll( prepared, args... );
 
-        const size_t argsCount = sizeof...(args);
+        StringBuffer res = StringBuffer::Create( size, string_alloc );
 
-        DArray<StringBuffer> params = {};
-        DArray<StringBuffer>::Create( argsCount, &params, temp_alloc );
+        size_t res_i = 0;
+        size_t start = 0;
+        size_t arg = 0;
 
-        FormatAccumulator( &params, args... );
+        for ( size_t i = 0; i + 1 < str.length; ++i )
+        {
+            if ( str.buffer[i] != '{' || str.buffer[i + 1] != '}' )
+            {
+                continue;
+            }
 
-        assert( params.size == formatSlotCount );
+            // the "template" text before the slot , then the argument
+            CoreContext::mem_copy( (void*) (str.buffer + start), res.buffer + res_i, i - start );
+            res_i += i - start;
 
-        size_t size = str.length - (formatSlotCount * 2);
+            CoreContext::mem_copy( (void*) prepared[arg].data, res.buffer + res_i, prepared[arg].length );
+            res_i += prepared[arg].length;
 
-        for ( size_t i = 0; i < params.size; ++i )
-        {
-            size += params.data[i].length;
+            arg++;
+            start = i + 2;
+            i++;
         }
 
-        StringBuffer res = StringBuffer::Create( size, string_alloc );
+        CoreContext::mem_copy( (void*) (str.buffer + start), res.buffer + res_i, str.length - start );
 
-        // copy to the final string
-        {
-            size_t prev_res_i = 0;
-            size_t prev_temp_i = 0;
+        return res;
+    }
 
-            for ( size_t p = 0; p < formatSlotCount; ++p )
-            {
-                StringBuffer curr_param = params.data[p];
-                size_t offset = formatSlots[p];
+    /// <summary>
+    /// <para>Format with a template parsed at compile time : StringUtils::Format( alloc , FORMAT( "{} / {}" ) , a , b )</para>
+    /// <para>The size is known before allocating and the literal parts are copied as segments , numbers go through NumberFormat</para>
+    /// </summary>
+    template<typename TSource, typename ...Args>
+    static StringBuffer Format( Allocator string_alloc, CompiledFormat<TSource>, Args... args )
+    {
+        using Compiled = CompiledFormat<TSource>;
+        static_assert( Compiled::SLOT_COUNT == sizeof...(args), "The number of arguments doesn't match the number of {} in the format" );
 
-                // copy the previous "template" text
-                size_t prev_size = offset - prev_temp_i;
-                CoreContext::mem_copy( (void*) (str.buffer + prev_temp_i), (void*) (res.buffer + prev_res_i), prev_size );
+        FormatArgument prepared[sizeof...(args) + 1];
+        size_t size = Compiled::LAYOUT.literal_length + FormatArgument::PrepareAll( prepared, args... );
 
-                prev_temp_i += prev_size + 2;
+        StringBuffer res = StringBuffer::Create( size, string_alloc );
+        char* dst = res.buffer;
 
-                // copy the word into the slot
-                CoreContext::mem_copy( (void*) curr_param.buffer, (void*) (res.buffer + prev_res_i + prev_size), curr_param.length );
+        for ( size_t i = 0; i < Compiled::SLOT_COUNT; ++i )
+        {
+            FormatSegment segment = Compiled::LAYOUT.segments[i];
 
-                prev_res_i += prev_size + curr_param.length;
-            }
+            CoreContext::mem_copy( (void*) (Compiled::TEXT + segment.start), dst, segment.length );
+            dst += segment.length;
 
-            // copy the remaining part
-            {
-                size_t remaining_temp = formatSlots[formatSlotCount - 1] + 2;
-                CoreContext::mem_copy( (void*) (str.buffer + remaining_temp), (void*) (res.buffer + prev_res_i), str.length - remaining_temp );
-            }
+            CoreContext::mem_copy( (void*) prepared[i].data, dst, prepared[i].length );
+            dst += prepared[i].length;
         }
 
+        FormatSegment tail = Compiled::LAYOUT.segments[Compiled::SLOT_COUNT];
+        CoreContext::mem_copy( (void*) (Compiled::TEXT + tail.start), dst, tail.length );
+
         return res;
     }
 
-    static bool EndsWith(const StringView str , const StringView e)
+    /// <summary>
+    /// Appends the formatted text to "out" without any intermediate string , returns the number of bytes written
+    /// </summary>
+    template<typename TSource, typename ...Args>
+    static size_t FormatTo( ChunkedBuffer* out, CompiledFormat<TSource>, Args... args )
     {
-        if(str.length < e.length)
+        using Compiled = CompiledFormat<TSource>;
+        static_assert( Compiled::SLOT_COUNT == sizeof...(args), "The number of arguments doesn't match the number of {} in the format" );
+
+        FormatArgument prepared[sizeof...(args) + 1];
+        size_t size = Compiled::LAYOUT.literal_length + FormatArgument::PrepareAll( prepared, args... );
+
+        for ( size_t i = 0; i < Compiled::SLOT_COUNT; ++i )
         {
-            return false;
+            FormatSegment segment = Compiled::LAYOUT.segments[i];
+
+            ChunkedBuffer::Write( out, Compiled::TEXT + segment.start, segment.length );
+            ChunkedBuffer::Write( out, prepared[i].data, prepared[i].length );
         }
 
-        for(size_t i = 0; i < e.length ; ++i)
-        {
-            char cmp_char = e.buffer[e.length - 1 - i];
-            char str_char = str.buffer[str.length - 1 - i];
+        FormatSegment tail = Compiled::LAYOUT.segments[Compiled::SLOT_COUNT];
+        ChunkedBuffer::Write( out, Compiled::TEXT + tail.start, tail.length );
 
-            if(cmp_char == str_char)
-            {
-                continue;
-            }
+        return size;
+    }
 
+    static bool EndsWith(const StringView str , const StringView e)
+    {
+        if(str.length < e.length)
+        {
             return false;
         }
 
-        return true;
+        return StringSearch::Equals(str.buffer + str.length - e.length, e.buffer, e.length);
     }
 
     static bool Compare( const StringView a, const StringView b )
     {
-        if ( a.length != b.length )
-            return false;
-
-        bool keep_looping = true;
-
-        for ( size_t i = 0; i < a.length && keep_looping; ++i )
-        {
-            keep_looping &= (a.buffer[i] == b.buffer[i]);
-        }
+        return a.length == b.length && StringSearch::Equals( a.buffer, b.buffer, a.length );
+    }
 
-        return true;
+    /// <summary>
+    /// Index of the first "pattern" in "str" at or after "from" , StringSearch::NOT_FOUND if there is none
+    /// </summary>
+    static size_t Find( const StringView str, const StringView pattern, size_t from = 0 )
+    {
+        return StringSearch::Find( str.buffer, str.length, pattern.buffer, pattern.length, from );
     }
 
+    static size_t FindChar( const StringView str, char c, size_t from = 0 )
+    {
+        return StringSearch::FindChar( str.buffer, str.length, c, from );
+    }
 
     static bool Compare( const char* a, const char* b, size_t length )
     {
@@ -211,92 +223,58 @@ public:
     
     static inline size_t GetCStrLength( const char* str )
     {
-        size_t cnt = 0;
-
-        while ( str[cnt] != '\0' )
-        {
-            ++cnt;
-        }
-
-        return cnt;
+        return strlen( str );
     }
     static size_t ReplaceChar( char* string, const char to_replace, const char replace_with )
     {
-        size_t curr_index = 0;
-        size_t occurence = 0;
-        char curr_char;
-
-        while ( (curr_char = string[curr_index]) != '\0' )
-        {
-            if ( curr_char == to_replace )
-            {
-                string[curr_index] = replace_with;
-                occurence++;
-            }
-
-            ++curr_index;
-        }
-
-        return occurence;
+        return StringSearch::ReplaceChar( string, strlen( string ), to_replace, replace_with );
     }
 
     static size_t Hash(const StringView in_str)
     {
-        size_t hash = 5381;
-        
-        for(size_t i = 0 ; i< in_str.length ; ++i)
-        {
-            hash = ((hash << 5) + hash) + in_str.buffer[i]; /* hash * 33 + c */
-        }
-
-        return hash;
+        return (size_t) HashUtils::Hash64( in_str.buffer, in_str.length );
     }
 
+    /// <summary>
+    /// Copy of "original" with every "to_replace" replaced by "replace_with" , the matches don't overlap
+    /// </summary>
     static StringBuffer Replace( const StringView original, StringView to_replace, StringView replace_with, Allocator allocator )
     {
-        size_t len = original.length;
-        size_t old_char_len = to_replace.length;
-        size_t new_char_len = replace_with.length;
-
-        size_t length_needed = len * sizeof( size_t );
-        Allocator temp_alloc = STACK_ALLOC( length_needed );
-        size_t* and_indicies = (size_t*) ALLOC( temp_alloc, length_needed );
-        size_t and_count = 0;
-        for ( size_t i = 0; i < len; ++i )
+        assert( to_replace.length != 0 );
+
+        size_t count = 0;
+
+        for ( size_t i = Find( original, to_replace ); i != StringSearch::NOT_FOUND; i = Find( original, to_replace, i + to_replace.length ) )
         {
-            if ( Compare( (original.buffer + i), to_replace.buffer, old_char_len ) )
-            {
-                and_indicies[and_count++] = i;
-            }
+            count++;
         }
 
-        StringBuffer new_string = StringBuffer::Create( len + and_count, allocator );
+        StringBuffer new_string = StringBuffer::Create( original.length - (count * to_replace.length) + (count * replace_with.length), allocator );
         size_t old_string_start = 0;
         size_t new_string_start = 0;
 
-        for ( size_t i = 0; i < and_count; ++i )
+        for ( size_t i = 0; i < count; ++i )
         {
-            size_t index = and_indicies[i];
+            size_t index = Find( original, to_replace, old_string_start );
             size_t size_to_copy = index - old_string_start;
 
             CoreContext::mem_copy( (void*) (original.buffer + old_string_start), new_string.buffer + new_string_start, size_to_copy );
-
-            old_string_start += size_to_copy + old_char_len;
             new_string_start += size_to_copy;
 
-            CoreContext::mem_copy( (void*) (replace_with.buffer), new_string.buffer + new_string_start, size_to_copy );
+            CoreContext::mem_copy( (void*) replace_with.buffer, new_string.buffer + new_string_start, replace_with.length );
+            new_string_start += replace_with.length;
 
-            new_string_start += new_char_len;
+            old_string_start = index + to_replace.length;
         }
 
-        CoreContext::mem_copy( (void*) (original.buffer + old_string_start), new_string.buffer + new_string_start, len - old_string_start );
+        CoreContext::mem_copy( (void*) (original.buffer + old_string_start), new_string.buffer + new_string_start, original.length - old_string_start );
 
         return new_string;
     }
 
     static StringBuffer GetFilename( StringView path, Allocator allocator )
     {
-        _ASSERT( path.buffer != nullptr );
+        assert( path.buffer != nullptr );
 
         size_t last_anti_slash = -1;
         size_t total_length = 0;
@@ -316,7 +294,7 @@ public:
 
     static StringBuffer GetExtension( StringView path, Allocator alloc )
     {
-        _ASSERT( path.buffer != nullptr );
+        assert( path.buffer != nullptr );
 
         size_t last_dot = -1;
         size_t total_length = 0;
@@ -335,7 +313,7 @@ public:
 
     static StringBuffer GetFolder( StringView path, Allocator alloc )
     {
-        _ASSERT( path.buffer != nullptr );
+        assert( path.buffer != nullptr );
 
         size_t last_anti_slash = -1;
         size_t curr_index = path.length - 1;
@@ -1,4 +1,5 @@
 #pragma once
+#include <string.h>
 #include "../Defines/Defines.h"
 
 struct Allocator;
@@ -36,13 +37,9 @@ struct CORE_API StringView
 
     StringView( const char* c_str )
     {
+        // the CRT strlen is already vectorized
         buffer = c_str;
-        length = 0;
-
-        while ( c_str[length] != '\0' )
-        {
-            ++length;
-        }
+        length = strlen( c_str );
     }
 
     StringView() = default;
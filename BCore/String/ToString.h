@@ -1,4 +1,6 @@
 #pragma once
+#include <stdio.h>
+#include <stdlib.h>
 #include "../String/StringBuffer.h"
 
 template <typename T>
@@ -68,8 +70,8 @@ static StringBuffer ToString( StringView value, Allocator alloc )
 
 static StringBuffer ToString( float value, Allocator alloc )
 {
-    char* buf = (char*) alloc.alloc( &alloc, 50);
-    sprintf_s( buf, 50 , "%g", value );
+    char* buf = (char*) ALLOC( alloc, 50 );
+    snprintf( buf, 50 , "%g", value );
 
     return StringBuffer::Create( buf, alloc );
 }
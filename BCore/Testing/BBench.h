@@ -0,0 +1,706 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Typedefs/Typedefs.h"
+#include "../Allocators/Allocator.h"
+#include "../Containers/DArray.h"
+#include "../Containers/ChunkedBuffer.h"
+#include "../Serialization/JSONWriter.h"
+#include "../Serialization/JSONParser.h"
+#include "../String/StringView.h"
+#include "../String/StringUtils.h"
+#include "../Clock/Clock.h"
+
+/// <summary>
+/// <para>What a benchmark gets : it runs its body "iterations" times , the harness times the whole call</para>
+/// <para>Setup before the loop goes before BBench::ResetTiming , teardown after BBench::StopTiming</para>
+/// </summary>
+struct BenchState
+{
+    uint64_t iterations;
+
+    /// <summary>
+    /// The current value of the benchmark's range , 0 without one
+    /// </summary>
+    int64_t arg;
+
+    /// <summary>
+    /// What one iteration processes , for the ops/s and bytes/s columns. "items_per_iteration" is 1 unless the benchmark says otherwise
+    /// </summary>
+    uint64_t items_per_iteration;
+    uint64_t bytes_per_iteration;
+
+    uint64_t start_ns;
+    uint64_t paused_ns;
+    uint64_t pause_start_ns;
+    uint64_t stop_ns;
+};
+
+using BenchCallback = ActionParams<BenchState*>;
+
+struct BenchDefinition
+{
+    const char* name;
+    BenchCallback run;
+
+    /// <summary>
+    /// start , start * multiplier , ... up to end (always included) , a multiplier of 0 means no range
+    /// </summary>
+    int64_t range_start;
+    int64_t range_end;
+    int64_t range_multiplier;
+};
+
+struct BenchResult
+{
+    const char* name;
+    int64_t arg;
+    bool has_arg;
+
+    /// <summary>
+    /// Iterations per sample , found by doubling until a sample lasts "min_sample_ns"
+    /// </summary>
+    uint64_t iterations;
+    size_t sample_count;
+
+    /// <summary>
+    /// Nanoseconds per item (per iteration unless "items_per_iteration" was set) , MAD is the median absolute deviation of the samples
+    /// </summary>
+    double median_ns;
+    double mad_ns;
+    double min_ns;
+    double max_ns;
+
+    double items_per_second;
+    double bytes_per_second;
+
+    bool has_baseline;
+    double baseline_ns;
+
+    /// <summary>
+    /// median / baseline - 1 , a regression when above the threshold
+    /// </summary>
+    double change;
+    bool is_regression;
+};
+
+/// <summary>
+/// <para>Benchmark harness , the counterpart of BTest : BENCHMARK( Name ) { ... } registers a benchmark , BBench::RunAll runs them</para>
+/// <para>Every benchmark is warmed up , its iteration count is scaled until a sample lasts long enough for the clock ,
+/// then "sample_count" samples give the median , the MAD , the ops/s and the bytes/s</para>
+/// <para>The results can be written as JSON and compared against a previous JSON run , a benchmark slower than the baseline
+/// by more than the threshold is a regression and RunAll returns how many there are</para>
+/// <para>Command line : --filter=text --json=path --baseline=path --threshold=0.1 --samples=11 --min-time-ms=10 --warmup-ms=50</para>
+/// </summary>
+struct BBench
+{
+    static constexpr size_t MAX_BENCHMARKS = 1'024;
+    static constexpr size_t MAX_SAMPLES = 64;
+    static constexpr uint64_t MAX_ITERATIONS = 1'000'000'000;
+    static constexpr size_t MAX_RANGE_ARGS = 64;
+
+    /// <summary>
+    /// A sample , setup included , doesn't take longer than this many times "min_sample_ns"
+    /// </summary>
+    static constexpr uint64_t MAX_WALL_FACTOR = 20;
+
+    struct Options
+    {
+        /// <summary>
+        /// Only the benchmarks whose name contains it , nullptr runs everything
+        /// </summary>
+        const char* filter = nullptr;
+        const char* json_path = nullptr;
+        const char* baseline_path = nullptr;
+
+        double regression_threshold = 0.10;
+        uint32_t sample_count = 11;
+        uint64_t min_sample_ns = 10'000'000;
+        uint64_t warmup_ns = 50'000'000;
+    };
+
+    // NOTE : a fixed array , the registrations run before main and before CoreContext has its allocation functions
+    static inline BenchDefinition all_benchmarks[MAX_BENCHMARKS] = {};
+    static inline size_t benchmark_count = 0;
+
+    static bool Register( const char* name, BenchCallback run, int64_t range_start = 0, int64_t range_end = 0, int64_t range_multiplier = 0 )
+    {
+        if ( benchmark_count == MAX_BENCHMARKS )
+        {
+            return false;
+        }
+
+        BenchDefinition* definition = &all_benchmarks[benchmark_count++];
+        definition->name = name;
+        definition->run = run;
+        definition->range_start = range_start;
+        definition->range_end = range_end;
+        definition->range_multiplier = range_multiplier;
+
+        return true;
+    }
+
+    /// <summary>
+    /// Starts the clock over , call it once the setup is done
+    /// </summary>
+    static void ResetTiming( BenchState* state )
+    {
+        state->paused_ns = 0;
+        state->start_ns = Clock::NowNs();
+    }
+
+    /// <summary>
+    /// Ends the timed part , what follows (teardown) isn't counted
+    /// </summary>
+    static void StopTiming( BenchState* state )
+    {
+        state->stop_ns = Clock::NowNs();
+    }
+
+    /// <summary>
+    /// Leaves work inside the loop out of the time , costs two clock reads so keep it out of short loops
+    /// </summary>
+    static void PauseTiming( BenchState* state )
+    {
+        state->pause_start_ns = Clock::NowNs();
+    }
+
+    static void ResumeTiming( BenchState* state )
+    {
+        state->paused_ns += Clock::NowNs() - state->pause_start_ns;
+    }
+
+    /// <summary>
+    /// Keeps the compiler from optimizing away a result
+    /// </summary>
+    template<typename T>
+    static inline void DoNotOptimize( const T& value )
+    {
+#ifdef _MSC_VER
+        volatile const char* ptr = (const char*) &value;
+        (void) *ptr;
+        _ReadWriteBarrier();
+#else
+        asm volatile( "" : : "g"( &value ) : "memory" );
+#endif
+    }
+
+    static Options ParseOptions( int argc, char** argv )
+    {
+        Options options = {};
+
+        for ( int i = 1; i < argc; ++i )
+        {
+            const char* arg = argv[i];
+            const char* value = nullptr;
+
+            if ( (value = OptionValue( arg, "--filter=" )) != nullptr )
+            {
+                options.filter = value;
+            }
+            else if ( (value = OptionValue( arg, "--json=" )) != nullptr )
+            {
+                options.json_path = value;
+            }
+            else if ( (value = OptionValue( arg, "--baseline=" )) != nullptr )
+            {
+                options.baseline_path = value;
+            }
+            else if ( (value = OptionValue( arg, "--threshold=" )) != nullptr )
+            {
+                options.regression_threshold = strtod( value, nullptr );
+            }
+            else if ( (value = OptionValue( arg, "--samples=" )) != nullptr )
+            {
+                uint32_t samples = (uint32_t) strtoul( value, nullptr, 10 );
+                options.sample_count = samples == 0 ? 1 : (samples > MAX_SAMPLES ? (uint32_t) MAX_SAMPLES : samples);
+            }
+            else if ( (value = OptionValue( arg, "--min-time-ms=" )) != nullptr )
+            {
+                options.min_sample_ns = strtoull( value, nullptr, 10 ) * 1'000'000ull;
+            }
+            else if ( (value = OptionValue( arg, "--warmup-ms=" )) != nullptr )
+            {
+                options.warmup_ns = strtoull( value, nullptr, 10 ) * 1'000'000ull;
+            }
+        }
+
+        return options;
+    }
+
+    /// <summary>
+    /// Runs every registered benchmark that passes the filter , prints a table , writes and compares the JSON if asked to.
+    /// Returns the number of regressions
+    /// </summary>
+    static size_t RunAll( Options options, Allocator alloc )
+    {
+        DArray<BenchResult> results = {};
+        DArray<BenchResult>::Create( 64, &results, alloc );
+
+        printf( "\n-- %zu benchmarks , %u samples of at least %.1f ms\n", benchmark_count, options.sample_count, (double) options.min_sample_ns / 1'000'000.0 );
+        PrintHeader();
+
+        for ( size_t i = 0; i < benchmark_count; ++i )
+        {
+            BenchDefinition* definition = &all_benchmarks[i];
+
+            if ( options.filter != nullptr && strstr( definition->name, options.filter ) == nullptr )
+            {
+                continue;
+            }
+
+            int64_t args[MAX_RANGE_ARGS] = {};
+            size_t arg_count = GetArgs( definition, args, MAX_RANGE_ARGS );
+
+            for ( size_t j = 0; j < arg_count; ++j )
+            {
+                BenchResult result = Run( definition, args[j], definition->range_multiplier != 0, options );
+                PrintResult( &result );
+                DArray<BenchResult>::Add( &results, result );
+            }
+        }
+
+        size_t regression_count = 0;
+
+        if ( options.baseline_path != nullptr )
+        {
+            ChunkedBuffer baseline = {};
+            ChunkedBuffer::Create( &baseline, alloc );
+
+            if ( ReadFile( options.baseline_path, &baseline ) )
+            {
+                regression_count = CompareBaseline( &results, ChunkedBuffer::Flatten( &baseline ), options.regression_threshold );
+
+                printf( "\n-- Against %s (threshold %.1f%%)\n", options.baseline_path, options.regression_threshold * 100.0 );
+                PrintHeader();
+
+                for ( size_t i = 0; i < results.size; ++i )
+                {
+                    PrintResult( &results.data[i] );
+                }
+
+                printf( "-- %zu regressions\n", regression_count );
+            }
+            else
+            {
+                printf( "-- Couldn't read the baseline %s\n", options.baseline_path );
+            }
+
+            ChunkedBuffer::Destroy( &baseline );
+        }
+
+        if ( options.json_path != nullptr )
+        {
+            ChunkedBuffer json = {};
+            ChunkedBuffer::Create( &json, alloc );
+            WriteJSON( &results, &json );
+
+            if ( !WriteFile( options.json_path, &json ) )
+            {
+                printf( "-- Couldn't write %s\n", options.json_path );
+            }
+
+            ChunkedBuffer::Destroy( &json );
+        }
+
+        DArray<BenchResult>::Destroy( &results );
+
+        return regression_count;
+    }
+
+    /// <summary>
+    /// The values "state->arg" takes : start , start * multiplier , ... and end , a single 0 without a range
+    /// </summary>
+    static size_t GetArgs( const BenchDefinition* definition, int64_t* out_args, size_t capacity )
+    {
+        if ( definition->range_multiplier == 0 )
+        {
+            out_args[0] = 0;
+            return 1;
+        }
+
+        size_t count = 0;
+        int64_t arg = definition->range_start;
+
+        while ( count < capacity )
+        {
+            out_args[count++] = arg;
+
+            if ( arg >= definition->range_end )
+            {
+                break;
+            }
+
+            // a start of 0 or a multiplier of 1 would never get there
+            int64_t next = arg * definition->range_multiplier;
+            arg = next <= arg || next > definition->range_end ? definition->range_end : next;
+        }
+
+        return count;
+    }
+
+    /// <summary>
+    /// Warmup , iteration scaling and the samples of one benchmark at one value of its range
+    /// </summary>
+    static BenchResult Run( BenchDefinition* definition, int64_t arg, bool has_arg, Options options )
+    {
+        BenchState state = {};
+        uint64_t iterations = 1;
+        uint64_t elapsed = 0;
+        uint64_t warmup_start = Clock::NowNs();
+
+        bool first_run = true;
+
+        // doubling (or more when far off) until a sample is long enough , the calibration runs count as warmup
+        while ( true )
+        {
+            uint64_t wall_start = Clock::NowNs();
+            elapsed = RunOnce( definition, arg, iterations, &state );
+            uint64_t wall = Clock::NowNs() - wall_start;
+
+            // paused setup can outweigh the timed part by far , stop growing before a sample takes seconds.
+            // the first run is left out , it pays for the one time setup of the benchmark
+            uint64_t max_wall = options.min_sample_ns * MAX_WALL_FACTOR;
+            bool too_long = !first_run && wall * 2 >= max_wall;
+
+            if ( elapsed >= options.min_sample_ns || iterations >= MAX_ITERATIONS || too_long )
+            {
+                break;
+            }
+
+            double scale = elapsed == 0 ? 10.0 : 1.4 * (double) options.min_sample_ns / (double) elapsed;
+            scale = scale < 2.0 ? 2.0 : (scale > 10.0 ? 10.0 : scale);
+
+            if ( !first_run && wall != 0 )
+            {
+                double max_scale = (double) max_wall / (double) wall;
+                scale = scale > max_scale ? max_scale : scale;
+            }
+
+            first_run = false;
+
+            iterations = (uint64_t) ((double) iterations * scale);
+            iterations = iterations > MAX_ITERATIONS ? MAX_ITERATIONS : iterations;
+        }
+
+        while ( Clock::NowNs() - warmup_start < options.warmup_ns )
+        {
+            RunOnce( definition, arg, iterations, &state );
+        }
+
+        size_t sample_count = options.sample_count > MAX_SAMPLES ? MAX_SAMPLES : options.sample_count;
+        double samples[MAX_SAMPLES] = {};
+
+        for ( size_t i = 0; i < sample_count; ++i )
+        {
+            elapsed = RunOnce( definition, arg, iterations, &state );
+
+            uint64_t items = iterations * (state.items_per_iteration == 0 ? 1 : state.items_per_iteration);
+            samples[i] = (double) elapsed / (double) items;
+        }
+
+        BenchResult result = {};
+        result.name = definition->name;
+        result.arg = arg;
+        result.has_arg = has_arg;
+        result.iterations = iterations;
+        result.sample_count = sample_count;
+
+        Summarize( samples, sample_count, &result );
+
+        uint64_t items_per_iteration = state.items_per_iteration == 0 ? 1 : state.items_per_iteration;
+
+        result.items_per_second = result.median_ns > 0 ? 1'000'000'000.0 / result.median_ns : 0;
+        result.bytes_per_second = result.median_ns > 0 ? (double) state.bytes_per_iteration / (double) items_per_iteration * 1'000'000'000.0 / result.median_ns : 0;
+
+        return result;
+    }
+
+    /// <summary>
+    /// Median , median absolute deviation , min and max of (samples) , they get sorted
+    /// </summary>
+    static void Summarize( double* samples, size_t count, BenchResult* out_result )
+    {
+        if ( count == 0 )
+        {
+            return;
+        }
+
+        SortSamples( samples, count );
+
+        double median = Median( samples, count );
+
+        double deviations[MAX_SAMPLES] = {};
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            deviations[i] = samples[i] > median ? samples[i] - median : median - samples[i];
+        }
+
+        SortSamples( deviations, count );
+
+        out_result->median_ns = median;
+        out_result->mad_ns = Median( deviations, count );
+        out_result->min_ns = samples[0];
+        out_result->max_ns = samples[count - 1];
+    }
+
+    /// <summary>
+    /// { "benchmarks" : [ { "name" , "arg" , "iterations" , "samples" , "median_ns" , "mad_ns" , "min_ns" , "max_ns" , "items_per_second" , "bytes_per_second" } ] }
+    /// </summary>
+    static void WriteJSON( DArray<BenchResult>* results, ChunkedBuffer* out )
+    {
+        JSONWriter writer = {};
+        JSONWriter::Create( &writer, out, true );
+
+        JSONWriter::BeginObject( &writer );
+        JSONWriter::Key( &writer, "benchmarks" );
+        JSONWriter::BeginArray( &writer );
+
+        for ( size_t i = 0; i < results->size; ++i )
+        {
+            BenchResult* result = &results->data[i];
+
+            JSONWriter::BeginObject( &writer );
+            JSONWriter::Key( &writer, "name" );
+            JSONWriter::String( &writer, result->name );
+
+            if ( result->has_arg )
+            {
+                JSONWriter::Key( &writer, "arg" );
+                JSONWriter::Integer( &writer, result->arg );
+            }
+
+            JSONWriter::Key( &writer, "iterations" );
+            JSONWriter::Integer( &writer, (int64_t) result->iterations );
+            JSONWriter::Key( &writer, "samples" );
+            JSONWriter::Integer( &writer, (int64_t) result->sample_count );
+            JSONWriter::Key( &writer, "median_ns" );
+            JSONWriter::Float( &writer, result->median_ns );
+            JSONWriter::Key( &writer, "mad_ns" );
+            JSONWriter::Float( &writer, result->mad_ns );
+            JSONWriter::Key( &writer, "min_ns" );
+            JSONWriter::Float( &writer, result->min_ns );
+            JSONWriter::Key( &writer, "max_ns" );
+            JSONWriter::Float( &writer, result->max_ns );
+            JSONWriter::Key( &writer, "items_per_second" );
+            JSONWriter::Float( &writer, result->items_per_second );
+            JSONWriter::Key( &writer, "bytes_per_second" );
+            JSONWriter::Float( &writer, result->bytes_per_second );
+            JSONWriter::EndObject( &writer );
+        }
+
+        JSONWriter::EndArray( &writer );
+        JSONWriter::EndObject( &writer );
+    }
+
+    /// <summary>
+    /// Matches the results with a previous WriteJSON output by name and arg , fills the baseline fields. Returns the number of regressions
+    /// </summary>
+    static size_t CompareBaseline( DArray<BenchResult>* inout_results, StringView baseline_json, double threshold )
+    {
+        Arena arena = Arena::Create( 64 * 1'024 );
+        JSONNode root = {};
+
+        if ( !JSONParser::Parse( baseline_json, &root, ArenaAllocator::Create( &arena ) ) )
+        {
+            Arena::Destroy( &arena );
+            return 0;
+        }
+
+        JSONNode* benchmarks = FindKey( &root, "benchmarks" );
+        size_t regression_count = 0;
+
+        for ( size_t i = 0; benchmarks != nullptr && i < inout_results->size; ++i )
+        {
+            BenchResult* result = &inout_results->data[i];
+
+            for ( size_t j = 0; j < benchmarks->sub_nodes.size; ++j )
+            {
+                JSONNode* entry = &benchmarks->sub_nodes.data[j];
+                JSONNode* name = FindKey( entry, "name" );
+                JSONNode* arg = FindKey( entry, "arg" );
+                JSONNode* median = FindKey( entry, "median_ns" );
+
+                bool same_name = name != nullptr && StringUtils::Compare( name->value, result->name );
+                bool same_arg = (arg != nullptr) == result->has_arg && (arg == nullptr || (int64_t) ParseNumber( arg->value ) == result->arg);
+
+                if ( !same_name || !same_arg || median == nullptr )
+                {
+                    continue;
+                }
+
+                result->has_baseline = true;
+                result->baseline_ns = ParseNumber( median->value );
+                result->change = result->baseline_ns > 0 ? result->median_ns / result->baseline_ns - 1.0 : 0;
+                result->is_regression = result->change > threshold;
+
+                regression_count += result->is_regression ? 1 : 0;
+                break;
+            }
+        }
+
+        Arena::Destroy( &arena );
+
+        return regression_count;
+    }
+
+private:
+
+    static uint64_t RunOnce( BenchDefinition* definition, int64_t arg, uint64_t iterations, BenchState* out_state )
+    {
+        BenchState state = {};
+        state.iterations = iterations;
+        state.arg = arg;
+        state.items_per_iteration = 1;
+        state.start_ns = Clock::NowNs();
+
+        definition->run( &state );
+
+        uint64_t end = state.stop_ns != 0 ? state.stop_ns : Clock::NowNs();
+        *out_state = state;
+
+        return end - state.start_ns - state.paused_ns;
+    }
+
+    static const char* OptionValue( const char* arg, const char* option )
+    {
+        size_t length = strlen( option );
+        return strncmp( arg, option, length ) == 0 ? arg + length : nullptr;
+    }
+
+    static void SortSamples( double* samples, size_t count )
+    {
+        // insertion sort , MAX_SAMPLES at most
+        for ( size_t i = 1; i < count; ++i )
+        {
+            double curr = samples[i];
+            size_t j = i;
+
+            while ( j > 0 && samples[j - 1] > curr )
+            {
+                samples[j] = samples[j - 1];
+                --j;
+            }
+
+            samples[j] = curr;
+        }
+    }
+
+    static double Median( const double* sorted, size_t count )
+    {
+        return count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    }
+
+    static JSONNode* FindKey( JSONNode* object, StringView key )
+    {
+        for ( size_t i = 0; i < object->sub_nodes.size; ++i )
+        {
+            if ( StringUtils::Compare( object->sub_nodes.data[i].name, key ) )
+            {
+                return &object->sub_nodes.data[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    static double ParseNumber( StringView value )
+    {
+        char buffer[64] = {};
+        size_t length = value.length < sizeof( buffer ) - 1 ? value.length : sizeof( buffer ) - 1;
+        memcpy( buffer, value.buffer, length );
+
+        return strtod( buffer, nullptr );
+    }
+
+    static void PrintHeader()
+    {
+        printf( "%-44s | %12s | %12s | %7s | %14s | %12s | %s\n", "benchmark", "iterations", "median ns", "MAD %", "items/s", "MB/s", "baseline" );
+    }
+
+    static void PrintResult( BenchResult* result )
+    {
+        char name[128];
+
+        if ( result->has_arg )
+        {
+            snprintf( name, sizeof( name ), "%s/%lld", result->name, (long long) result->arg );
+        }
+        else
+        {
+            snprintf( name, sizeof( name ), "%s", result->name );
+        }
+
+        char baseline[64] = "-";
+
+        if ( result->has_baseline )
+        {
+            snprintf( baseline, sizeof( baseline ), "%+.1f%%%s", result->change * 100.0, result->is_regression ? " REGRESSION" : "" );
+        }
+
+        double mad_percent = result->median_ns > 0 ? result->mad_ns / result->median_ns * 100.0 : 0;
+
+        printf( "%-44s | %12llu | %12.2f | %7.2f | %14.0f | %12.1f | %s\n",
+            name, (unsigned long long) result->iterations, result->median_ns, mad_percent,
+            result->items_per_second, result->bytes_per_second / 1'000'000.0, baseline );
+    }
+
+    static bool ReadFile( const char* path, ChunkedBuffer* out )
+    {
+        FILE* file = fopen( path, "rb" );
+
+        if ( file == nullptr )
+        {
+            return false;
+        }
+
+        char block[4'096];
+        size_t read = 0;
+
+        while ( (read = fread( block, 1, sizeof( block ), file )) != 0 )
+        {
+            ChunkedBuffer::Write( out, block, read );
+        }
+
+        fclose( file );
+
+        return true;
+    }
+
+    static bool WriteFile( const char* path, ChunkedBuffer* in )
+    {
+        FILE* file = fopen( path, "wb" );
+
+        if ( file == nullptr )
+        {
+            return false;
+        }
+
+        bool written = ChunkedBuffer::WriteTo( in, []( void* user_data, StringView str )
+        {
+            return fwrite( str.buffer, 1, str.length, (FILE*) user_data ) == str.length;
+        }, file );
+
+        fclose( file );
+
+        return written;
+    }
+};
+
+#define BENCH_CONCAT_INNER(a , b) a##b
+#define BENCH_CONCAT(a , b) BENCH_CONCAT_INNER(a , b)
+
+// at namespace scope : BENCHMARK( DArrayAdd ) { for ( uint64_t i = 0; i < state->iterations; ++i ) { ... } }
+#define BENCHMARK(name) \
+inline void name( BenchState* state );\
+inline const bool BENCH_CONCAT(name , _registered) = BBench::Register( #name, name );\
+inline void name( BenchState* state )
+
+// same with "state->arg" going from start to end , multiplied by multiplier every time
+#define BENCHMARK_RANGE(name , start , end , multiplier) \
+inline void name( BenchState* state );\
+inline const bool BENCH_CONCAT(name , _registered) = BBench::Register( #name, name, start, end, multiplier );\
+inline void name( BenchState* state )
@@ -2,7 +2,7 @@
 
 #include "../Typedefs/Typedefs.h"
 #include "../Containers/DArray.h"
-#include <Windows.h>
+#include "../Clock/Clock.h"
 
 struct TestResult
 {
@@ -85,23 +85,18 @@ struct BTest
 
     static void RunAll()
     {
-        LARGE_INTEGER freq = {};
-        QueryPerformanceFrequency(&freq);
-
         for (size_t i = 0; i < all_tests.size; ++i)
         {
             TestCallback fncPtr = all_tests.data[i];
 
-            LARGE_INTEGER before = {}; 
-            QueryPerformanceCounter(&before);
+            uint64_t before = Clock::NowNs();
 
             TestResult result = fncPtr();
-            
-            LARGE_INTEGER after = {};
-            QueryPerformanceCounter(&after);
 
-            int64_t ticks = after.QuadPart - before.QuadPart;
-            double ms = (double) ( ( (ticks) * 1000) / freq.QuadPart);
+            uint64_t after = Clock::NowNs();
+
+            uint64_t ns = after - before;
+            double ms = (double) ns / 1'000'000.0;
 
             if (!result.success)
             {
@@ -120,7 +115,7 @@ struct BTest
             printf("\033[0m");
             printf(" => ");
             printf("Name : %s , ", result.function);       
-            printf("Time : %f ms , %lld ticks", ms , ticks);
+            printf("Time : %f ms , %llu ns", ms , (unsigned long long) ns);
 
             if (!result.success)
             {
@@ -12,4 +12,4 @@ template <typename TReturn , typename... Args>
 using Func = TReturn(*)(Args...);
 
 template <typename... Args>
-using EventArray = DArray<ActionParams<Args>>;
\ No newline at end of file
+using EventArray = DArray<ActionParams<Args...>>;
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <Allocators/Allocator.h>
+#include <Allocators/PoolAllocator.h>
+#include <Containers/DArray.h>
+#include "BenchmarkUtils.h"
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// <para>Keeps "live_count" small blocks alive and replaces a random one at every iteration</para>
+    /// <para>Returns the average nanoseconds per free + alloc pair</para>
+    /// </summary>
+    static double RunSmallObjectChurn(Allocator alloc, size_t live_count, size_t iterations, size_t max_size)
+    {
+        Random rand = Random::Create(live_count);
+
+        void** live = (void**) CoreContext::malloc(sizeof(void*) * live_count);
+
+        for (size_t i = 0; i < live_count; ++i)
+        {
+            size_t size = 8 + (size_t) (Random::Next(&rand) % max_size);
+            live[i] = ALLOC(alloc, size);
+        }
+
+        uint64_t start = NowNs();
+
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            uint64_t r = Random::Next(&rand);
+            size_t idx = (size_t) (r % live_count);
+            size_t size = 8 + (size_t) ((r >> 32) % max_size);
+
+            FREE(alloc, live[idx]);
+            live[idx] = ALLOC(alloc, size);
+
+            // touch the block like a real object would
+            *(uint64_t*) live[idx] = r;
+        }
+
+        uint64_t end = NowNs();
+
+        for (size_t i = 0; i < live_count; ++i)
+        {
+            FREE(alloc, live[i]);
+        }
+
+        CoreContext::free(live);
+
+        return (double) (end - start) / (double) iterations;
+    }
+
+    static void SmallObjectChurn()
+    {
+        const size_t live_counts[] = { 1'000, 100'000, 1'000'000 };
+        const size_t max_sizes[] = { 64, 256, 2048 };
+        const size_t iterations = 4'000'000;
+
+        printf("\n-- Small object churn (%zu free+alloc pairs , ns/op)\n", iterations);
+        printf("%10s | %10s | %12s | %12s\n", "live", "max size", "heap", "pool");
+
+        for (size_t max_size : max_sizes)
+        {
+            for (size_t live_count : live_counts)
+            {
+                double heap_ns = RunSmallObjectChurn(HeapAllocator::Create(), live_count, iterations, max_size);
+
+                Pool pool = {};
+                Pool::Create(&pool, (size_t) 4 * 1'024 * 1'024 * 1'024);
+                double pool_ns = RunSmallObjectChurn(PoolAllocator::Create(&pool), live_count, iterations, max_size);
+                Pool::Destroy(&pool);
+
+                printf("%10zu | %10zu | %12.2f | %12.2f\n", live_count, max_size, heap_ns, pool_ns);
+            }
+        }
+    }
+}
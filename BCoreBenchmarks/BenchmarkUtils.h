@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+
+#include <Clock/Clock.h>
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Monotonic clock in nanoseconds
+    /// </summary>
+    static uint64_t NowNs()
+    {
+        return Clock::NowNs();
+    }
+
+    /// <summary>
+    /// xorshift64* , deterministic so that every run benchmarks the same data
+    /// </summary>
+    struct Random
+    {
+        uint64_t state;
+
+        static Random Create(uint64_t seed)
+        {
+            Random res = {};
+            res.state = seed == 0 ? 0x9E3779B97F4A7C15ull : seed;
+            return res;
+        }
+
+        static uint64_t Next(Random* in_rand)
+        {
+            in_rand->state ^= in_rand->state >> 12;
+            in_rand->state ^= in_rand->state << 25;
+            in_rand->state ^= in_rand->state >> 27;
+            return in_rand->state * 0x2545F4914F6CDD1Dull;
+        }
+    };
+
+    /// <summary>
+    /// Keeps the compiler from optimizing away a result
+    /// </summary>
+    static volatile uint64_t sink = 0;
+}
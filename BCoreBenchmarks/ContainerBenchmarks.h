@@ -0,0 +1,1015 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <queue>
+#include <stack>
+#include <unordered_map>
+#include <functional>
+#include <Testing/BBench.h>
+#include <Allocators/Allocator.h>
+#include <Containers/DArray.h>
+#include <Containers/HMap.h>
+#include <Containers/Queue.h>
+#include <Containers/Stack.h>
+#include <Containers/FreeList.h>
+#include <Containers/SlotArray.h>
+#include <Containers/MinHeap.h>
+#include "BenchmarkUtils.h"
+
+/// <summary>
+/// <para>Every BCore container against its std equivalent from 1K to 10M elements : insert , lookup , remove , iterate and resize</para>
+/// <para>"state->arg" is the element count and the results are per element , run a single container with --filter=HMap</para>
+/// <para>FreeList and SlotArray have no std equivalent , they are measured on their own</para>
+/// </summary>
+namespace Benchmarks
+{
+    static constexpr int64_t CONTAINER_MIN_COUNT = 1'000;
+    static constexpr int64_t CONTAINER_MAX_COUNT = 10'000'000;
+
+    static constexpr uint32_t FREELIST_BLOCK_SIZE = 64;
+
+    /// <summary>
+    /// <para>Random keys and a shuffled order of their indices , shared by all the benchmarks of the same size</para>
+    /// <para>Rebuilt only when the size changes so generating 10M keys isn't counted in every sample's setup</para>
+    /// </summary>
+    struct ContainerData
+    {
+        size_t count;
+        DArray<size_t> keys;
+        DArray<size_t> order;
+
+        static ContainerData* Get(size_t count)
+        {
+            static ContainerData data = {};
+
+            if (data.count == count)
+            {
+                return &data;
+            }
+
+            if (data.count != 0)
+            {
+                DArray<size_t>::Destroy(&data.keys);
+                DArray<size_t>::Destroy(&data.order);
+            }
+
+            Allocator alloc = HeapAllocator::Create();
+            Random rand = Random::Create(count);
+
+            data.count = count;
+            DArray<size_t>::Create(count, &data.keys, alloc, false);
+            DArray<size_t>::Create(count, &data.order, alloc, false);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                DArray<size_t>::Add(&data.keys, (size_t) Random::Next(&rand));
+                DArray<size_t>::Add(&data.order, i);
+            }
+
+            for (size_t i = count - 1; i > 0; --i)
+            {
+                size_t j = (size_t) (Random::Next(&rand) % (i + 1));
+                size_t tmp = data.order.data[i];
+                data.order.data[i] = data.order.data[j];
+                data.order.data[j] = tmp;
+            }
+
+            return &data;
+        }
+    };
+
+    // DArray vs std::vector
+
+    BENCHMARK_RANGE(DArrayAdd, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            DArray<size_t> arr = {};
+            DArray<size_t>::Create(16, &arr, alloc, false);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                DArray<size_t>::Add(&arr, data->keys.data[i]);
+            }
+
+            BBench::DoNotOptimize(arr.data);
+            DArray<size_t>::Destroy(&arr);
+        }
+    }
+
+    BENCHMARK_RANGE(StdVectorPushBack, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            std::vector<size_t> arr;
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                arr.push_back(data->keys.data[i]);
+            }
+
+            BBench::DoNotOptimize(arr.data());
+        }
+    }
+
+    BENCHMARK_RANGE(DArrayAddReserved, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            DArray<size_t> arr = {};
+            DArray<size_t>::Create(data->count, &arr, alloc, false);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                DArray<size_t>::Add(&arr, data->keys.data[i]);
+            }
+
+            BBench::DoNotOptimize(arr.data);
+            DArray<size_t>::Destroy(&arr);
+        }
+    }
+
+    BENCHMARK_RANGE(StdVectorPushBackReserved, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            std::vector<size_t> arr;
+            arr.reserve(data->count);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                arr.push_back(data->keys.data[i]);
+            }
+
+            BBench::DoNotOptimize(arr.data());
+        }
+    }
+
+    BENCHMARK_RANGE(DArrayRandomAccess, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                sum += data->keys.data[data->order.data[i]];
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+    }
+
+    BENCHMARK_RANGE(StdVectorRandomAccess, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        std::vector<size_t> arr(data->keys.data, data->keys.data + data->count);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                sum += arr[data->order.data[i]];
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+        BBench::StopTiming(state);
+    }
+
+    BENCHMARK_RANGE(DArrayIterate, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+        state->bytes_per_iteration = data->count * sizeof(size_t);
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            for (size_t i = 0; i < data->keys.size; ++i)
+            {
+                sum += data->keys.data[i];
+            }
+
+            BBench::DoNotOptimize(sum);
+        }
+    }
+
+    BENCHMARK_RANGE(StdVectorIterate, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        std::vector<size_t> arr(data->keys.data, data->keys.data + data->count);
+        state->items_per_iteration = data->count;
+        state->bytes_per_iteration = data->count * sizeof(size_t);
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            for (size_t value : arr)
+            {
+                sum += value;
+            }
+
+            BBench::DoNotOptimize(sum);
+        }
+
+        BBench::StopTiming(state);
+    }
+
+    BENCHMARK_RANGE(DArrayRemoveBack, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        DArray<size_t> arr = {};
+        DArray<size_t>::Create(data->count, &arr, HeapAllocator::Create(), false);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            DArray<size_t>::AddRange(&arr, ArrayView<size_t>{ data->keys.data, data->count });
+            BBench::ResumeTiming(state);
+
+            while (arr.size != 0)
+            {
+                sum += arr.data[arr.size - 1];
+                DArray<size_t>::RemoveAt(&arr, arr.size - 1);
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+        BBench::StopTiming(state);
+        DArray<size_t>::Destroy(&arr);
+    }
+
+    BENCHMARK_RANGE(StdVectorPopBack, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        std::vector<size_t> arr;
+        arr.reserve(data->count);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            arr.insert(arr.end(), data->keys.data, data->keys.data + data->count);
+            BBench::ResumeTiming(state);
+
+            while (!arr.empty())
+            {
+                sum += arr.back();
+                arr.pop_back();
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+        BBench::StopTiming(state);
+    }
+
+    // HMap vs std::unordered_map
+
+    static void FillHMap(HMap<size_t, size_t>* map, ContainerData* data)
+    {
+        for (size_t i = 0; i < data->count; ++i)
+        {
+            HMap<size_t, size_t>::TryAdd(map, data->keys.data[i], i, nullptr);
+        }
+    }
+
+    static void FillStdMap(std::unordered_map<size_t, size_t>* map, ContainerData* data)
+    {
+        for (size_t i = 0; i < data->count; ++i)
+        {
+            map->emplace(data->keys.data[i], i);
+        }
+    }
+
+    BENCHMARK_RANGE(HMapInsert, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            HMap<size_t, size_t> map = {};
+            HMap<size_t, size_t>::Create(&map, alloc, 16);
+            FillHMap(&map, data);
+            BBench::DoNotOptimize(map.count);
+            HMap<size_t, size_t>::Destroy(&map);
+        }
+    }
+
+    BENCHMARK_RANGE(StdUnorderedMapInsert, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            std::unordered_map<size_t, size_t> map;
+            FillStdMap(&map, data);
+            BBench::DoNotOptimize(map.size());
+        }
+    }
+
+    BENCHMARK_RANGE(HMapLookup, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        HMap<size_t, size_t> map = {};
+        HMap<size_t, size_t>::Create(&map, HeapAllocator::Create(), data->count);
+        FillHMap(&map, data);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                size_t* value = nullptr;
+                sum += HMap<size_t, size_t>::TryGet(&map, data->keys.data[data->order.data[i]], &value) ? *value : 0;
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+        BBench::StopTiming(state);
+
+        HMap<size_t, size_t>::Destroy(&map);
+    }
+
+    BENCHMARK_RANGE(StdUnorderedMapLookup, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        std::unordered_map<size_t, size_t> map;
+        map.reserve(data->count);
+        FillStdMap(&map, data);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                auto found = map.find(data->keys.data[data->order.data[i]]);
+                sum += found != map.end() ? found->second : 0;
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+        BBench::StopTiming(state);
+    }
+
+    BENCHMARK_RANGE(HMapRemove, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        HMap<size_t, size_t> map = {};
+        HMap<size_t, size_t>::Create(&map, HeapAllocator::Create(), data->count);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            FillHMap(&map, data);
+            BBench::ResumeTiming(state);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                size_t removed = 0;
+                HMap<size_t, size_t>::TryRemove(&map, data->keys.data[data->order.data[i]], &removed);
+            }
+
+            BBench::DoNotOptimize(map.count);
+        }
+
+        BBench::StopTiming(state);
+        HMap<size_t, size_t>::Destroy(&map);
+    }
+
+    BENCHMARK_RANGE(StdUnorderedMapErase, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        std::unordered_map<size_t, size_t> map;
+        map.reserve(data->count);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            FillStdMap(&map, data);
+            BBench::ResumeTiming(state);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                map.erase(data->keys.data[data->order.data[i]]);
+            }
+
+            BBench::DoNotOptimize(map.size());
+        }
+
+        BBench::StopTiming(state);
+    }
+
+    BENCHMARK_RANGE(HMapIterate, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        HMap<size_t, size_t> map = {};
+        HMap<size_t, size_t>::Create(&map, HeapAllocator::Create(), data->count);
+        FillHMap(&map, data);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        // the entries are dense , iterating is walking two arrays
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            for (size_t i = 0; i < map.count; ++i)
+            {
+                sum += map.all_keys.data[i] ^ map.all_values.data[i];
+            }
+
+            BBench::DoNotOptimize(sum);
+        }
+
+        BBench::StopTiming(state);
+        HMap<size_t, size_t>::Destroy(&map);
+    }
+
+    BENCHMARK_RANGE(StdUnorderedMapIterate, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        std::unordered_map<size_t, size_t> map;
+        map.reserve(data->count);
+        FillStdMap(&map, data);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            for (auto& pair : map)
+            {
+                sum += pair.first ^ pair.second;
+            }
+
+            BBench::DoNotOptimize(sum);
+        }
+
+        BBench::StopTiming(state);
+    }
+
+    BENCHMARK_RANGE(HMapResize, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            HMap<size_t, size_t> map = {};
+            HMap<size_t, size_t>::Create(&map, alloc, data->count);
+            FillHMap(&map, data);
+            BBench::ResumeTiming(state);
+
+            HMap<size_t, size_t>::Resize(&map, data->count * 2);
+
+            BBench::PauseTiming(state);
+            HMap<size_t, size_t>::Destroy(&map);
+            BBench::ResumeTiming(state);
+        }
+
+        BBench::StopTiming(state);
+    }
+
+    BENCHMARK_RANGE(StdUnorderedMapRehash, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            std::unordered_map<size_t, size_t>* map = new std::unordered_map<size_t, size_t>();
+            map->reserve(data->count);
+            FillStdMap(map, data);
+            BBench::ResumeTiming(state);
+
+            map->reserve(data->count * 2);
+
+            BBench::PauseTiming(state);
+            delete map;
+            BBench::ResumeTiming(state);
+        }
+
+        BBench::StopTiming(state);
+    }
+
+    // Queue vs std::queue , Stack vs std::stack
+
+    BENCHMARK_RANGE(QueueEnqueueDequeue, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            Queue<size_t> queue = {};
+            Queue<size_t>::Create(&queue, 16, alloc);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                Queue<size_t>::Enqueue(&queue, data->keys.data[i]);
+            }
+
+            size_t value = 0;
+
+            while (Queue<size_t>::TryDequeue(&queue, &value))
+            {
+                sum += value;
+            }
+
+            Queue<size_t>::Destroy(&queue);
+        }
+
+        BBench::DoNotOptimize(sum);
+    }
+
+    BENCHMARK_RANGE(StdQueuePushPop, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            std::queue<size_t> queue;
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                queue.push(data->keys.data[i]);
+            }
+
+            while (!queue.empty())
+            {
+                sum += queue.front();
+                queue.pop();
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+    }
+
+    BENCHMARK_RANGE(StackPushPop, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            Stack<size_t> stack = {};
+            Stack<size_t>::Create(&stack, 16, alloc);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                Stack<size_t>::Push(&stack, data->keys.data[i]);
+            }
+
+            size_t value = 0;
+
+            while (Stack<size_t>::TryPop(&stack, &value))
+            {
+                sum += value;
+            }
+
+            Stack<size_t>::Destroy(&stack);
+        }
+
+        BBench::DoNotOptimize(sum);
+    }
+
+    BENCHMARK_RANGE(StdStackPushPop, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            std::stack<size_t> stack;
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                stack.push(data->keys.data[i]);
+            }
+
+            while (!stack.empty())
+            {
+                sum += stack.top();
+                stack.pop();
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+    }
+
+    // MinHeap vs std::priority_queue
+
+    static size_t SizePriority(size_t value)
+    {
+        return value;
+    }
+
+    BENCHMARK_RANGE(MinHeapAddPop, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            MinHeap<size_t> heap = {};
+            MinHeap<size_t>::Create(alloc, &heap, 16, SizePriority);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                heap.Add(data->keys.data[i]);
+            }
+
+            while (heap.data.size != 0)
+            {
+                sum += heap.Pop();
+            }
+
+            MinHeap<size_t>::Destroy(&heap);
+        }
+
+        BBench::DoNotOptimize(sum);
+    }
+
+    BENCHMARK_RANGE(StdPriorityQueuePushPop, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> heap;
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                heap.push(data->keys.data[i]);
+            }
+
+            while (!heap.empty())
+            {
+                sum += heap.top();
+                heap.pop();
+            }
+        }
+
+        BBench::DoNotOptimize(sum);
+    }
+
+    // FreeList , same sized blocks so that every benchmark has the same layout
+
+    static void FillFreeList(FreeList* freelist, size_t count, FreeList::Node* out_nodes)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            FreeList::AllocBlock(freelist, FREELIST_BLOCK_SIZE, &out_nodes[i]);
+        }
+    }
+
+    BENCHMARK_RANGE(FreeListAlloc, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        size_t count = (size_t) state->arg;
+        Allocator alloc = HeapAllocator::Create();
+        DArray<FreeList::Node> nodes = {};
+        DArray<FreeList::Node>::Create(count, &nodes, alloc, false);
+        state->items_per_iteration = count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            FreeList freelist = {};
+            FreeList::Create(&freelist, 16, count, count * FREELIST_BLOCK_SIZE, alloc);
+            FillFreeList(&freelist, count, nodes.data);
+            BBench::DoNotOptimize(freelist.used_mem);
+            FreeList::Destroy(&freelist);
+        }
+
+        BBench::StopTiming(state);
+        DArray<FreeList::Node>::Destroy(&nodes);
+    }
+
+    BENCHMARK_RANGE(FreeListFreeReverse, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        size_t count = (size_t) state->arg;
+        Allocator alloc = HeapAllocator::Create();
+        DArray<FreeList::Node> nodes = {};
+        DArray<FreeList::Node>::Create(count, &nodes, alloc, false);
+        state->items_per_iteration = count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            FreeList freelist = {};
+            FreeList::Create(&freelist, 16, count, count * FREELIST_BLOCK_SIZE, alloc);
+            FillFreeList(&freelist, count, nodes.data);
+            BBench::ResumeTiming(state);
+
+            for (size_t i = count; i > 0; --i)
+            {
+                FreeList::FreeBlock(&freelist, nodes.data[i - 1]);
+            }
+
+            BBench::PauseTiming(state);
+            FreeList::Destroy(&freelist);
+            BBench::ResumeTiming(state);
+        }
+
+        BBench::StopTiming(state);
+        DArray<FreeList::Node>::Destroy(&nodes);
+    }
+
+    BENCHMARK_RANGE(FreeListFreeRandom, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        DArray<FreeList::Node> nodes = {};
+        DArray<FreeList::Node>::Create(data->count, &nodes, alloc, false);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            FreeList freelist = {};
+            FreeList::Create(&freelist, 16, data->count, data->count * FREELIST_BLOCK_SIZE, alloc);
+            FillFreeList(&freelist, data->count, nodes.data);
+            BBench::ResumeTiming(state);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                FreeList::FreeBlock(&freelist, nodes.data[data->order.data[i]]);
+            }
+
+            BBench::PauseTiming(state);
+            FreeList::Destroy(&freelist);
+            BBench::ResumeTiming(state);
+        }
+
+        BBench::StopTiming(state);
+        DArray<FreeList::Node>::Destroy(&nodes);
+    }
+
+    /// <summary>
+    /// Every other block is freed , then blocks twice as big are allocated : none of them fit in the holes
+    /// </summary>
+    BENCHMARK_RANGE(FreeListFragmentedAlloc, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        size_t count = (size_t) state->arg;
+        size_t big_count = count / 2;
+        Allocator alloc = HeapAllocator::Create();
+        DArray<FreeList::Node> nodes = {};
+        DArray<FreeList::Node>::Create(count, &nodes, alloc, false);
+        state->items_per_iteration = big_count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            FreeList freelist = {};
+            FreeList::Create(&freelist, 16, count * 2, (count + big_count * 2) * FREELIST_BLOCK_SIZE, alloc);
+            FillFreeList(&freelist, count, nodes.data);
+
+            for (size_t i = 1; i < count; i += 2)
+            {
+                FreeList::FreeBlock(&freelist, nodes.data[i]);
+            }
+
+            BBench::ResumeTiming(state);
+
+            for (size_t i = 0; i < big_count; ++i)
+            {
+                FreeList::Node node = {};
+                FreeList::AllocBlock(&freelist, FREELIST_BLOCK_SIZE * 2, &node);
+            }
+
+            BBench::PauseTiming(state);
+            FreeList::Destroy(&freelist);
+            BBench::ResumeTiming(state);
+        }
+
+        BBench::StopTiming(state);
+        DArray<FreeList::Node>::Destroy(&nodes);
+    }
+
+    // SlotArray
+
+    BENCHMARK_RANGE(SlotArrayAdd, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            // creating pushes every free index , not part of adding
+            BBench::PauseTiming(state);
+            SlotArray<size_t> slots = {};
+            SlotArray<size_t>::Create(&slots, data->count, alloc);
+            BBench::ResumeTiming(state);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                slots.Add(data->keys.data[i]);
+            }
+
+            BBench::PauseTiming(state);
+            BBench::DoNotOptimize(slots.data);
+            SlotArray<size_t>::Destroy(&slots);
+            BBench::ResumeTiming(state);
+        }
+
+        BBench::StopTiming(state);
+    }
+
+    BENCHMARK_RANGE(SlotArrayRemove, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            BBench::PauseTiming(state);
+            SlotArray<size_t> slots = {};
+            SlotArray<size_t>::Create(&slots, data->count, alloc);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                slots.Add(data->keys.data[i]);
+            }
+
+            BBench::ResumeTiming(state);
+
+            for (size_t i = 0; i < data->count; ++i)
+            {
+                slots.RemoveAt(data->order.data[i]);
+            }
+
+            BBench::PauseTiming(state);
+            SlotArray<size_t>::Destroy(&slots);
+            BBench::ResumeTiming(state);
+        }
+
+        BBench::StopTiming(state);
+    }
+
+    BENCHMARK_RANGE(SlotArrayIterate, CONTAINER_MIN_COUNT, CONTAINER_MAX_COUNT, 10)
+    {
+        ContainerData* data = ContainerData::Get((size_t) state->arg);
+        Allocator alloc = HeapAllocator::Create();
+
+        // half the slots used , every other one
+        SlotArray<size_t> slots = {};
+        SlotArray<size_t>::Create(&slots, data->count, alloc);
+
+        for (size_t i = 0; i < data->count; ++i)
+        {
+            slots.Add(data->keys.data[i]);
+        }
+
+        for (size_t i = 0; i < data->count; i += 2)
+        {
+            slots.RemoveAt(i);
+        }
+
+        DArray<SlotArray<size_t>::SlotArrayElem> elems = {};
+        DArray<SlotArray<size_t>::SlotArrayElem>::Create(slots.size, &elems, alloc, false);
+        state->items_per_iteration = data->count;
+
+        BBench::ResetTiming(state);
+
+        size_t sum = 0;
+
+        for (uint64_t it = 0; it < state->iterations; ++it)
+        {
+            DArray<SlotArray<size_t>::SlotArrayElem>::Clear(&elems);
+            slots.GetAll(&elems);
+
+            for (size_t i = 0; i < elems.size; ++i)
+            {
+                sum += elems.data[i].item;
+            }
+
+            BBench::DoNotOptimize(sum);
+        }
+
+        BBench::StopTiming(state);
+
+        DArray<SlotArray<size_t>::SlotArrayElem>::Destroy(&elems);
+        SlotArray<size_t>::Destroy(&slots);
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <Allocators/Allocator.h>
+#include <Containers/DArray.h>
+#include <Containers/HMap.h>
+#include "BenchmarkUtils.h"
+
+namespace Benchmarks
+{
+    static size_t SizeHasher(size_t key)
+    {
+        return key;
+    }
+
+    static bool SizeComparer(size_t a, size_t b)
+    {
+        return a == b;
+    }
+
+    struct HMapTimings
+    {
+        double insert_ns;
+        double hit_ns;
+        double miss_ns;
+    };
+
+    /// <summary>
+    /// <para>Inserts "keys" then looks all of them up in a shuffled order , then looks up as many keys that aren't in the map</para>
+    /// <para>Returns the average nanoseconds per operation for each phase</para>
+    /// </summary>
+    template<typename TMap>
+    static HMapTimings RunHMap(TMap* map, DArray<size_t>* keys, DArray<size_t>* lookups, DArray<size_t>* misses)
+    {
+        HMapTimings res = {};
+        uint64_t checksum = 0;
+
+        uint64_t start = NowNs();
+
+        for (size_t i = 0; i < keys->size; ++i)
+        {
+            TMap::TryAdd(map, keys->data[i], (uint32_t) i, nullptr);
+        }
+
+        uint64_t after_insert = NowNs();
+
+        for (size_t i = 0; i < lookups->size; ++i)
+        {
+            uint32_t* value = nullptr;
+            checksum += TMap::TryGet(map, lookups->data[i], &value) ? *value : 0;
+        }
+
+        uint64_t after_hits = NowNs();
+
+        for (size_t i = 0; i < misses->size; ++i)
+        {
+            uint32_t* value = nullptr;
+            checksum += TMap::TryGet(map, misses->data[i], &value);
+        }
+
+        uint64_t after_misses = NowNs();
+
+        sink = checksum;
+
+        res.insert_ns = (double) (after_insert - start) / (double) keys->size;
+        res.hit_ns = (double) (after_hits - after_insert) / (double) lookups->size;
+        res.miss_ns = (double) (after_misses - after_hits) / (double) misses->size;
+
+        return res;
+    }
+
+    /// <summary>
+    /// Compares the inlined default policies with the function pointer ones (FuncHMap) from 1K to 10M keys
+    /// </summary>
+    static void HMapPolicies(Allocator alloc)
+    {
+        const size_t key_counts[] = { 1'000, 10'000, 100'000, 1'000'000, 10'000'000 };
+
+        printf("\n-- HMap<size_t , uint32_t> , default policies vs function pointers (ns/op , map starts small and grows)\n");
+        printf("%10s | %12s | %12s | %12s | %12s | %12s | %12s\n", "keys", "insert", "func insert", "hit", "func hit", "miss", "func miss");
+
+        for (size_t key_count : key_counts)
+        {
+            Random rand = Random::Create(key_count);
+
+            DArray<size_t> keys = {};
+            DArray<size_t> lookups = {};
+            DArray<size_t> misses = {};
+            DArray<size_t>::Create(key_count, &keys, alloc, false);
+            DArray<size_t>::Create(key_count, &lookups, alloc, false);
+            DArray<size_t>::Create(key_count, &misses, alloc, false);
+
+            // even keys are inserted , odd keys are the misses
+            for (size_t i = 0; i < key_count; ++i)
+            {
+                size_t key = (size_t) Random::Next(&rand) & ~(size_t) 1;
+                DArray<size_t>::Add(&keys, key);
+                DArray<size_t>::Add(&lookups, key);
+                DArray<size_t>::Add(&misses, key | 1);
+            }
+
+            // shuffle the lookups so they don't follow the insertion order
+            for (size_t i = key_count - 1; i > 0; --i)
+            {
+                size_t j = (size_t) (Random::Next(&rand) % (i + 1));
+                size_t tmp = lookups.data[i];
+                lookups.data[i] = lookups.data[j];
+                lookups.data[j] = tmp;
+            }
+
+            HMap<size_t, uint32_t> default_map = {};
+            HMap<size_t, uint32_t>::Create(&default_map, alloc, 16);
+            HMapTimings default_timings = RunHMap(&default_map, &keys, &lookups, &misses);
+            HMap<size_t, uint32_t>::Destroy(&default_map);
+
+            FuncHMap<size_t, uint32_t> func_map = {};
+            FuncHMap<size_t, uint32_t>::Create(&func_map, alloc, 16, SizeHasher, SizeComparer);
+            HMapTimings func_timings = RunHMap(&func_map, &keys, &lookups, &misses);
+            FuncHMap<size_t, uint32_t>::Destroy(&func_map);
+
+            printf("%10zu | %12.2f | %12.2f | %12.2f | %12.2f | %12.2f | %12.2f\n",
+                key_count,
+                default_timings.insert_ns, func_timings.insert_ns,
+                default_timings.hit_ns, func_timings.hit_ns,
+                default_timings.miss_ns, func_timings.miss_ns);
+
+            DArray<size_t>::Destroy(&keys);
+            DArray<size_t>::Destroy(&lookups);
+            DArray<size_t>::Destroy(&misses);
+        }
+    }
+}
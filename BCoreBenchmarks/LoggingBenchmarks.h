@@ -0,0 +1,123 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <thread>
+#include <Allocators/Allocator.h>
+#include <Allocators/ScratchArena.h>
+#include <Atomic/Atomic.h>
+#include <Containers/MPSCQueue.h>
+#include <Containers/ChunkedBuffer.h>
+#include <String/StringUtils.h>
+#include <String/DeferredFormat.h>
+#include "BenchmarkUtils.h"
+
+namespace Benchmarks
+{
+    // same shape as the engine's LogRecord
+    struct BenchLogRecord
+    {
+        DeferredFormatter format;
+        uint32_t size;
+        uint8_t payload[236];
+    };
+
+    /// <summary>
+    /// <para>What a log line costs the thread that logs it : formatting it there , against copying its arguments into a queue
+    /// that another thread drains and formats (the engine's Logger)</para>
+    /// <para>Only the producer side is timed , the consumer drains the queue between two batches</para>
+    /// </summary>
+    static void DeferredLogging( Allocator alloc )
+    {
+        const size_t count = 1'000'000;
+        const size_t runs = 5;
+
+        StringView system = "renderer";
+        uint64_t best_eager = UINT64_MAX;
+        uint64_t best_deferred = UINT64_MAX;
+        size_t total = 0;
+
+        MPSCQueue<BenchLogRecord> queue = {};
+        MPSCQueue<BenchLogRecord>::Create( &queue, 4'096, alloc );
+
+        volatile int32_t is_running = 1;
+        volatile int64_t formatted = 0;
+
+        std::thread consumer( [&]()
+        {
+            ChunkedBuffer line = {};
+            ChunkedBuffer::Create( &line, HeapAllocator::Create() );
+
+            while ( Atomic::Load( &is_running ) || MPSCQueue<BenchLogRecord>::TryPeek( &queue ) )
+            {
+                BenchLogRecord* record = MPSCQueue<BenchLogRecord>::TryPeek( &queue );
+
+                if ( record == nullptr )
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                ChunkedBuffer::Reset( &line );
+                Atomic::Add( &formatted, (int64_t) record->format( record->payload, &line ) );
+                MPSCQueue<BenchLogRecord>::Pop( &queue );
+            }
+
+            ChunkedBuffer::Destroy( &line );
+        } );
+
+        for ( size_t run = 0; run < runs; ++run )
+        {
+            uint64_t start = NowNs();
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                ScratchArena scratch = ScratchArena::Get();
+                StringBuffer line = StringUtils::Format( scratch.alloc, FORMAT( "[{}] frame {} took {} ms , {} draws" ), system, i, (float) i * 0.25f, (int32_t) (i & 1023) );
+                total += line.length;
+                ScratchArena::Release( &scratch );
+            }
+
+            uint64_t after_eager = NowNs();
+            uint64_t deferred = 0;
+
+            // a queue's worth at a time , then wait for the consumer , so the producer never waits on a full queue
+            for ( size_t batch = 0; batch < count; batch += queue.capacity )
+            {
+                uint64_t batch_start = NowNs();
+
+                for ( size_t i = batch; i < batch + queue.capacity && i < count; ++i )
+                {
+                    int64_t ticket = 0;
+                    BenchLogRecord* record = MPSCQueue<BenchLogRecord>::TryReserve( &queue, &ticket );
+
+                    record->format = DeferredFormat::FormatterOf( FORMAT( "[{}] frame {} took {} ms , {} draws" ), system, i, (float) i * 0.25f, (int32_t) (i & 1023) );
+                    record->size = (uint32_t) DeferredFormat::Encode( record->payload, system, i, (float) i * 0.25f, (int32_t) (i & 1023) );
+
+                    MPSCQueue<BenchLogRecord>::Publish( &queue, ticket );
+                }
+
+                deferred += NowNs() - batch_start;
+
+                while ( MPSCQueue<BenchLogRecord>::PoppedCount( &queue ) != MPSCQueue<BenchLogRecord>::ReservedCount( &queue ) )
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            best_eager = (after_eager - start) < best_eager ? (after_eager - start) : best_eager;
+            best_deferred = deferred < best_deferred ? deferred : best_deferred;
+        }
+
+        Atomic::Store( &is_running, 0 );
+        consumer.join();
+
+        MPSCQueue<BenchLogRecord>::Destroy( &queue );
+
+        printf( "\n-- Logging , %zu lines , best of %zu runs (ns per line on the logging thread)\n", count, runs );
+        printf( "%12s | %12s\n", "format", "deferred" );
+        printf( "%12.1f | %12.1f\n", (double) best_eager / count, (double) best_deferred / count );
+
+        // keeps the results alive
+        printf( "(%zu + %lld bytes)\n", total, (long long) formatted );
+    }
+}
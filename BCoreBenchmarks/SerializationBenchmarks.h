@@ -0,0 +1,283 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <Allocators/Allocator.h>
+#include <Allocators/ScratchArena.h>
+#include <Containers/DArray.h>
+#include <Containers/ChunkedBuffer.h>
+#include <String/StringBuilder.h>
+#include <String/StringUtils.h>
+#include <Serialization/JSONParser.h>
+#include <Serialization/JSONWriter.h>
+#include <Serialization/XMLWriter.h>
+#include <Serialization/XMLStreamReader.h>
+#include "BenchmarkUtils.h"
+
+namespace Benchmarks
+{
+    struct SceneEntity
+    {
+        int32_t id;
+        float position[3];
+        float scale;
+        bool is_visible;
+    };
+
+    static void WriteSceneJSON( JSONWriter* writer, SceneEntity* entities, size_t count )
+    {
+        JSONWriter::BeginObject( writer );
+        JSONWriter::Key( writer, "entities" );
+        JSONWriter::BeginArray( writer );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            SceneEntity* entity = &entities[i];
+
+            JSONWriter::BeginObject( writer );
+            JSONWriter::Key( writer, "id" );
+            JSONWriter::Integer( writer, entity->id );
+            JSONWriter::Key( writer, "name" );
+            JSONWriter::String( writer, "entity" );
+            JSONWriter::Key( writer, "position" );
+            JSONWriter::BeginArray( writer );
+            JSONWriter::Float( writer, entity->position[0] );
+            JSONWriter::Float( writer, entity->position[1] );
+            JSONWriter::Float( writer, entity->position[2] );
+            JSONWriter::EndArray( writer );
+            JSONWriter::Key( writer, "scale" );
+            JSONWriter::Float( writer, entity->scale );
+            JSONWriter::Key( writer, "visible" );
+            JSONWriter::Boolean( writer, entity->is_visible );
+            JSONWriter::EndObject( writer );
+        }
+
+        JSONWriter::EndArray( writer );
+        JSONWriter::EndObject( writer );
+    }
+
+    /// <summary>
+    /// The same document the way it had to be written before , one Format per entity appended to a StringBuilder
+    /// </summary>
+    static void WriteSceneFormat( StringBuilder* builder, SceneEntity* entities, size_t count )
+    {
+        StringBuilder::Append( builder, "{\"entities\":[" );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            SceneEntity* entity = &entities[i];
+
+            ScratchArena scratch = ScratchArena::Get();
+            DEFER( [&]() { ScratchArena::Release( &scratch ); } );
+
+            StringBuffer item = StringUtils::Format( scratch.alloc, "{\"id\":{},\"name\":\"entity\",\"position\":[{},{},{}],\"scale\":{},\"visible\":{}}",
+                entity->id, entity->position[0], entity->position[1], entity->position[2], entity->scale, entity->is_visible ? "true" : "false" );
+
+            if ( i != 0 )
+            {
+                StringBuilder::Append( builder, "," );
+            }
+
+            StringBuilder::Append( builder, item.view );
+        }
+
+        StringBuilder::Append( builder, "]}" );
+    }
+
+    static void WriteSceneXML( XMLWriter* writer, SceneEntity* entities, size_t count )
+    {
+        XMLWriter::BeginElement( writer, "scene" );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            SceneEntity* entity = &entities[i];
+
+            XMLWriter::BeginElement( writer, "entity" );
+            XMLWriter::IntegerAttribute( writer, "id", entity->id );
+            XMLWriter::Attribute( writer, "name", "entity" );
+            XMLWriter::FloatAttribute( writer, "x", entity->position[0] );
+            XMLWriter::FloatAttribute( writer, "y", entity->position[1] );
+            XMLWriter::FloatAttribute( writer, "z", entity->position[2] );
+            XMLWriter::FloatAttribute( writer, "scale", entity->scale );
+            XMLWriter::Text( writer, entity->is_visible ? "visible" : "hidden" );
+            XMLWriter::EndElement( writer );
+        }
+
+        XMLWriter::EndElement( writer );
+    }
+
+    /// <summary>
+    /// Counts the "entity" elements seen by the reader
+    /// </summary>
+    static void CountEntity( void* user_data, StringView name )
+    {
+        (*(size_t*) user_data) += (size_t) StringUtils::Compare( name, "entity" );
+    }
+
+    static double MBPerSecond( size_t bytes, uint64_t ns )
+    {
+        return ((double) bytes / (1'024.0 * 1'024.0)) / ((double) ns / 1'000'000'000.0);
+    }
+
+    /// <summary>
+    /// <para>Writes a scene of "count" entities with JSONWriter and with Format + StringBuilder , parses it back with JSONParser ,
+    /// writes the tree again and checks it gives the same text. Then the same scene through XMLWriter and XMLStreamReader</para>
+    /// <para>Writers reuse their ChunkedBuffer between runs like a long lived exporter would , so only the first run allocates chunks</para>
+    /// </summary>
+    static void SerializationRoundTrip( Allocator alloc )
+    {
+        const size_t entity_counts[] = { 1'000, 10'000, 100'000 };
+        const size_t runs = 5;
+
+        printf( "\n-- Serialization round trip , best of %zu runs (MB/s of text)\n", runs );
+        printf( "%10s | %10s | %12s | %12s | %12s | %12s | %12s | %12s | %8s\n", "entities", "json KB",
+            "json write", "format", "json parse", "json rewrite", "xml write", "xml read", "same" );
+
+        for ( size_t count : entity_counts )
+        {
+            Random rand = Random::Create( count );
+
+            SceneEntity* entities = (SceneEntity*) CoreContext::malloc( sizeof( SceneEntity ) * count );
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                uint64_t r = Random::Next( &rand );
+
+                entities[i].id = (int32_t) i;
+                // a mix of short decimals and full precision floats
+                entities[i].position[0] = (float) (int32_t) (r % 20'000) / 8.0f;
+                entities[i].position[1] = (float) (r >> 32) / 4'096.0f;
+                entities[i].position[2] = (float) (int32_t) ((r >> 16) % 1'000) / 10.0f;
+                entities[i].scale = 1.0f + (float) ((r >> 8) % 4) * 0.5f;
+                entities[i].is_visible = (r & 1) != 0;
+            }
+
+            ChunkedBuffer json = {};
+            ChunkedBuffer::Create( &json, alloc );
+            ChunkedBuffer rewrite = {};
+            ChunkedBuffer::Create( &rewrite, alloc );
+            ChunkedBuffer xml = {};
+            ChunkedBuffer::Create( &xml, alloc );
+
+            uint64_t best[6] = { UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX };
+            size_t json_size = 0;
+            size_t format_size = 0;
+            size_t xml_size = 0;
+            bool is_same = true;
+
+            for ( size_t run = 0; run < runs; ++run )
+            {
+                // json writer
+                uint64_t start = NowNs();
+
+                ChunkedBuffer::Reset( &json );
+                JSONWriter writer = {};
+                JSONWriter::Create( &writer, &json );
+                WriteSceneJSON( &writer, entities, count );
+
+                uint64_t after_write = NowNs();
+
+                // format + string builder
+                StringBuilder builder = {};
+                StringBuilder::Create( &builder, alloc );
+                WriteSceneFormat( &builder, entities, count );
+
+                uint64_t after_format = NowNs();
+
+                format_size = builder.size;
+                StringBuilder::Destroy( &builder );
+
+                // parse
+                json_size = ChunkedBuffer::Size( &json );
+                char* text = (char*) CoreContext::malloc( json_size );
+                ChunkedBuffer::CopyTo( &json, text );
+
+                StringView view = {};
+                view.buffer = text;
+                view.length = json_size;
+
+                Arena arena = Arena::Create( 64 * 1'024 * 1'024 );
+                Allocator arena_alloc = ArenaAllocator::Create( &arena );
+
+                uint64_t before_parse = NowNs();
+
+                JSONNode root = {};
+                is_same &= JSONParser::Parse( view, &root, arena_alloc );
+
+                uint64_t after_parse = NowNs();
+
+                ChunkedBuffer::Reset( &rewrite );
+                JSONWriter::Create( &writer, &rewrite );
+                JSONWriter::WriteNode( &writer, &root );
+
+                uint64_t after_rewrite = NowNs();
+
+                char* rewritten = (char*) CoreContext::malloc( json_size );
+                is_same &= ChunkedBuffer::Size( &rewrite ) == json_size;
+
+                if ( is_same )
+                {
+                    ChunkedBuffer::CopyTo( &rewrite, rewritten );
+                    is_same &= memcmp( text, rewritten, json_size ) == 0;
+                }
+
+                CoreContext::free( rewritten );
+                CoreContext::free( text );
+                Arena::Destroy( &arena );
+
+                // xml
+                uint64_t before_xml = NowNs();
+
+                ChunkedBuffer::Reset( &xml );
+                XMLWriter xml_writer = {};
+                XMLWriter::Create( &xml_writer, &xml, alloc );
+                WriteSceneXML( &xml_writer, entities, count );
+                XMLWriter::Destroy( &xml_writer );
+
+                uint64_t after_xml = NowNs();
+
+                // the reader is fed the chunks as they are , like a file read with a 16KB buffer
+                size_t entity_count = 0;
+
+                XMLStreamCallbacks callbacks = {};
+                callbacks.user_data = &entity_count;
+                callbacks.begin_element = CountEntity;
+
+                XMLStreamReader reader = {};
+                XMLStreamReader::Create( &reader, callbacks, alloc );
+
+                for ( BufferChunk* chunk = xml.first; chunk != nullptr; chunk = chunk->next )
+                {
+                    StringView chunk_view = {};
+                    chunk_view.buffer = chunk->data;
+                    chunk_view.length = chunk->size;
+
+                    XMLStreamReader::Feed( &reader, chunk_view );
+                }
+
+                is_same &= XMLStreamReader::Finish( &reader ) && entity_count == count;
+                XMLStreamReader::Destroy( &reader );
+
+                uint64_t after_read = NowNs();
+
+                xml_size = ChunkedBuffer::Size( &xml );
+
+                uint64_t timings[6] = { after_write - start, after_format - after_write, after_parse - before_parse,
+                    after_rewrite - after_parse, after_xml - before_xml, after_read - after_xml };
+
+                for ( size_t i = 0; i < 6; ++i )
+                {
+                    best[i] = timings[i] < best[i] ? timings[i] : best[i];
+                }
+            }
+
+            printf( "%10zu | %10zu | %12.1f | %12.1f | %12.1f | %12.1f | %12.1f | %12.1f | %8s\n", count, json_size / 1'024,
+                MBPerSecond( json_size, best[0] ), MBPerSecond( format_size, best[1] ), MBPerSecond( json_size, best[2] ),
+                MBPerSecond( json_size, best[3] ), MBPerSecond( xml_size, best[4] ), MBPerSecond( xml_size, best[5] ), is_same ? "yes" : "NO" );
+
+            ChunkedBuffer::Destroy( &json );
+            ChunkedBuffer::Destroy( &rewrite );
+            ChunkedBuffer::Destroy( &xml );
+            CoreContext::free( entities );
+        }
+    }
+}
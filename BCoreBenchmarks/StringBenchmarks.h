@@ -0,0 +1,250 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <Allocators/Allocator.h>
+#include <Allocators/ScratchArena.h>
+#include <Containers/ChunkedBuffer.h>
+#include <String/StringUtils.h>
+#include <String/FormatString.h>
+#include <String/StringSearch.h>
+#include <Containers/HashPolicies.h>
+#include "BenchmarkUtils.h"
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// <para>Formats the same log line "count" times : runtime template , FORMAT into a new string , FORMAT into a ChunkedBuffer and snprintf</para>
+    /// <para>The strings go to a scratch arena released every line , like the logger does</para>
+    /// </summary>
+    static void FormatLines( Allocator alloc )
+    {
+        const size_t count = 1'000'000;
+        const size_t runs = 5;
+
+        StringView system = "renderer";
+        uint64_t best[4] = { UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX };
+        size_t total = 0;
+
+        ChunkedBuffer out = {};
+        ChunkedBuffer::Create( &out, alloc );
+
+        for ( size_t run = 0; run < runs; ++run )
+        {
+            uint64_t start = NowNs();
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                ScratchArena scratch = ScratchArena::Get();
+                StringBuffer line = StringUtils::Format( scratch.alloc, "[{}] frame {} took {} ms , {} draws", system, i, (float) i * 0.25f, (int32_t) (i & 1023) );
+                total += line.length;
+                ScratchArena::Release( &scratch );
+            }
+
+            uint64_t after_runtime = NowNs();
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                ScratchArena scratch = ScratchArena::Get();
+                StringBuffer line = StringUtils::Format( scratch.alloc, FORMAT( "[{}] frame {} took {} ms , {} draws" ), system, i, (float) i * 0.25f, (int32_t) (i & 1023) );
+                total += line.length;
+                ScratchArena::Release( &scratch );
+            }
+
+            uint64_t after_compiled = NowNs();
+
+            ChunkedBuffer::Reset( &out );
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                total += StringUtils::FormatTo( &out, FORMAT( "[{}] frame {} took {} ms , {} draws\n" ), system, i, (float) i * 0.25f, (int32_t) (i & 1023) );
+            }
+
+            uint64_t after_chunked = NowNs();
+
+            char line[128];
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                total += (size_t) snprintf( line, sizeof( line ), "[%.*s] frame %zu took %g ms , %d draws", (int) system.length, system.buffer, i, (float) i * 0.25f, (int32_t) (i & 1023) );
+            }
+
+            uint64_t after_snprintf = NowNs();
+
+            uint64_t timings[4] = { after_runtime - start, after_compiled - after_runtime, after_chunked - after_compiled, after_snprintf - after_chunked };
+
+            for ( size_t i = 0; i < 4; ++i )
+            {
+                best[i] = timings[i] < best[i] ? timings[i] : best[i];
+            }
+        }
+
+        ChunkedBuffer::Destroy( &out );
+
+        printf( "\n-- Format , %zu log lines , best of %zu runs (ns per line)\n", count, runs );
+        printf( "%12s | %12s | %12s | %12s\n", "runtime", "FORMAT", "FormatTo", "snprintf" );
+        printf( "%12.1f | %12.1f | %12.1f | %12.1f\n", (double) best[0] / count, (double) best[1] / count, (double) best[2] / count, (double) best[3] / count );
+
+        // keeps the results alive
+        printf( "(%zu bytes)\n", total );
+    }
+
+    // the byte at a time versions StringUtils had before the SIMD kernels , kept as the baseline
+
+    static size_t ScalarFindChar( const char* data, size_t length, char c )
+    {
+        for ( size_t i = 0; i < length; ++i )
+        {
+            if ( data[i] == c )
+            {
+                return i;
+            }
+        }
+
+        return StringSearch::NOT_FOUND;
+    }
+
+    static size_t ScalarFind( const char* data, size_t length, const char* pattern, size_t pattern_length )
+    {
+        for ( size_t i = 0; i + pattern_length <= length; ++i )
+        {
+            size_t j = 0;
+
+            while ( j < pattern_length && data[i + j] == pattern[j] )
+            {
+                j++;
+            }
+
+            if ( j == pattern_length )
+            {
+                return i;
+            }
+        }
+
+        return StringSearch::NOT_FOUND;
+    }
+
+    static bool ScalarEquals( const char* a, const char* b, size_t length )
+    {
+        bool keep_looping = true;
+
+        for ( size_t i = 0; i < length && keep_looping; ++i )
+        {
+            keep_looping &= (a[i] == b[i]);
+        }
+
+        return keep_looping;
+    }
+
+    static uint64_t ScalarHash( const char* data, size_t length )
+    {
+        uint64_t hash = 5381;
+
+        for ( size_t i = 0; i < length; ++i )
+        {
+            hash = ((hash << 5) + hash) + data[i];
+        }
+
+        return hash;
+    }
+
+    static size_t ScalarReplaceChar( char* data, size_t length, char to_replace, char replace_with )
+    {
+        size_t count = 0;
+
+        for ( size_t i = 0; i < length; ++i )
+        {
+            if ( data[i] == to_replace )
+            {
+                data[i] = replace_with;
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    /// <summary>
+    /// Best time in ns per call of "body" repeated so that every size processes about the same number of bytes
+    /// </summary>
+    template<typename TBody>
+    static double BestNsPerCall( size_t size, TBody body )
+    {
+        const size_t bytes_per_run = 64 * 1'024 * 1'024;
+        const size_t calls = bytes_per_run / size;
+
+        uint64_t best = UINT64_MAX;
+
+        for ( size_t run = 0; run < 5; ++run )
+        {
+            uint64_t start = NowNs();
+
+            for ( size_t i = 0; i < calls; ++i )
+            {
+                body();
+            }
+
+            uint64_t time = NowNs() - start;
+            best = time < best ? time : best;
+        }
+
+        return (double) best / (double) calls;
+    }
+
+    /// <summary>
+    /// <para>Scalar against SIMD for find char , find substring , compare , replace char and hash on 16B to 1MB inputs , in GB/s</para>
+    /// <para>The searches scan everything : the char isn't in the text and the pattern is only at the very end , after many near misses</para>
+    /// </summary>
+    static void StringSearchSizes()
+    {
+        const size_t sizes[] = { 16, 256, 4 * 1'024, 64 * 1'024, 1'024 * 1'024 };
+        const size_t max_size = 1'024 * 1'024;
+
+        char* text = (char*) CoreContext::malloc( max_size );
+        char* copy = (char*) CoreContext::malloc( max_size );
+
+        StringView pattern = "needle";
+
+        printf( "\n-- String kernels , scalar / simd (GB/s) , %s\n", STRING_AVX2 ? "AVX2" : (STRING_SSE2 ? "SSE2" : "no SIMD") );
+        printf( "%10s | %17s | %17s | %17s | %17s | %17s\n", "size", "find char", "find", "compare", "replace char", "hash" );
+
+        volatile size_t sink = 0;
+
+        for ( size_t size : sizes )
+        {
+            // "needl" repeated , then the pattern at the end
+            for ( size_t i = 0; i < size; ++i )
+            {
+                text[i] = pattern.buffer[i % (pattern.length - 1)];
+            }
+
+            CoreContext::mem_copy( (void*) pattern.buffer, text + size - pattern.length, pattern.length );
+            CoreContext::mem_copy( text, copy, size );
+
+            double ns[10] = {};
+
+            ns[0] = BestNsPerCall( size, [&]() { sink = sink + ScalarFindChar( text, size, 'e' + 1 ); } );
+            ns[1] = BestNsPerCall( size, [&]() { sink = sink + StringSearch::FindChar( text, size, 'e' + 1 ); } );
+            ns[2] = BestNsPerCall( size, [&]() { sink = sink + ScalarFind( text, size, pattern.buffer, pattern.length ); } );
+            ns[3] = BestNsPerCall( size, [&]() { sink = sink + StringSearch::Find( text, size, pattern.buffer, pattern.length ); } );
+            ns[4] = BestNsPerCall( size, [&]() { sink = sink + ScalarEquals( text, copy, size ); } );
+            ns[5] = BestNsPerCall( size, [&]() { sink = sink + StringSearch::Equals( text, copy, size ); } );
+            // swaps two characters back and forth , a match every 5 bytes
+            ns[6] = BestNsPerCall( size, [&]() { sink = sink + ScalarReplaceChar( copy, size, 'e', 'E' ) + ScalarReplaceChar( copy, size, 'E', 'e' ); } ) / 2;
+            ns[7] = BestNsPerCall( size, [&]() { sink = sink + StringSearch::ReplaceChar( copy, size, 'e', 'E' ) + StringSearch::ReplaceChar( copy, size, 'E', 'e' ); } ) / 2;
+            ns[8] = BestNsPerCall( size, [&]() { sink = sink + ScalarHash( text, size ); } );
+            ns[9] = BestNsPerCall( size, [&]() { sink = sink + HashUtils::Hash64( text, size ); } );
+
+            printf( "%10zu", size );
+
+            for ( size_t i = 0; i < 10; i += 2 )
+            {
+                printf( " | %7.2f / %7.2f", (double) size / ns[i], (double) size / ns[i + 1] );
+            }
+
+            printf( "\n" );
+        }
+
+        CoreContext::free( copy );
+        CoreContext::free( text );
+    }
+}
@@ -0,0 +1,3 @@
+CALL vcvarsall x64
+CALL cmake --build ./CMakeGenerated
+pause
\ No newline at end of file
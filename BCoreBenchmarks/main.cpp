@@ -0,0 +1,36 @@
+#include <stdio.h>
+#include <Context/CoreContext.h>
+#include <Allocators/Allocator.h>
+#include <Testing/BBench.h>
+#include "HMapBenchmarks.h"
+#include "AllocatorBenchmarks.h"
+#include "SerializationBenchmarks.h"
+#include "StringBenchmarks.h"
+#include "LoggingBenchmarks.h"
+#include "ContainerBenchmarks.h"
+
+int main(int argc , char** argv)
+{
+    CoreContext::DefaultContext();
+
+    Allocator alloc = HeapAllocator::Create();
+
+    BBench::Options options = BBench::ParseOptions(argc, argv);
+
+    printf("BCore benchmarks\n");
+
+    // the comparison tables only run in full runs , --filter= selects among the registered BENCHMARKs
+    if (options.filter == nullptr)
+    {
+        Benchmarks::HMapPolicies(alloc);
+        Benchmarks::SmallObjectChurn();
+        Benchmarks::SerializationRoundTrip(alloc);
+        Benchmarks::FormatLines(alloc);
+        Benchmarks::StringSearchSizes();
+        Benchmarks::DeferredLogging(alloc);
+    }
+
+    size_t regression_count = BBench::RunAll(options, alloc);
+
+    return regression_count == 0 ? 0 : 1;
+}
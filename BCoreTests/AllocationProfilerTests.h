@@ -0,0 +1,274 @@
+#pragma once
+
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Allocators/Allocator.h>
+#include <Allocators/AllocationProfiler.h>
+
+namespace Tests
+{
+    struct AllocationProfilerTests
+    {
+        TEST_DECLARATION(CountsPerCallSite)
+        {
+            CoreContext::DefaultContext();
+
+            AllocationProfiler profiler = {};
+            AllocationProfiler::Create( &profiler, HeapAllocator::Create() );
+
+            ProfiledAllocator profiled = {};
+            Allocator alloc = ProfiledAllocator::Create( &profiled, HeapAllocator::Create(), &profiler );
+
+            void* ptrs[10] = {};
+
+            for ( size_t i = 0; i < 10; ++i )
+            {
+                ptrs[i] = ALLOC( alloc, 100 );
+            }
+
+            void* other = ALLOC( alloc, 5'000 );
+
+            EVALUATE( profiler.allocation_count == 11 );
+            EVALUATE( profiler.allocated_bytes == 6'000 );
+            EVALUATE( profiler.live_bytes == 6'000 );
+            EVALUATE( profiler.sites.count == 2 );
+
+            for ( size_t i = 0; i < 10; ++i )
+            {
+                FREE( alloc, ptrs[i] );
+            }
+
+            FREE( alloc, other );
+
+            EVALUATE( profiler.free_count == 11 );
+            EVALUATE( profiler.live_bytes == 0 );
+            EVALUATE( profiler.peak_live_bytes == 6'000 );
+
+            AllocationProfiler::Destroy( &profiler );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ReallocMovesTheLiveBytes)
+        {
+            CoreContext::DefaultContext();
+
+            AllocationProfiler profiler = {};
+            AllocationProfiler::Create( &profiler, HeapAllocator::Create() );
+
+            ProfiledAllocator profiled = {};
+            Allocator alloc = ProfiledAllocator::Create( &profiled, HeapAllocator::Create(), &profiler );
+
+            DArray<int> arr = {};
+            DArray<int>::Create( 4, &arr, alloc );
+
+            for ( int i = 0; i < 100; ++i )
+            {
+                DArray<int>::Add( &arr, i );
+            }
+
+            size_t live = profiler.live_bytes;
+            size_t expected = arr.capacity * sizeof( int );
+
+            EVALUATE( live == expected );
+
+            DArray<int>::Destroy( &arr );
+
+            EVALUATE( profiler.live_bytes == 0 );
+
+            AllocationProfiler::Destroy( &profiler );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(LeakReport)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator heap = HeapAllocator::Create();
+
+            AllocationProfiler profiler = {};
+            AllocationProfiler::Create( &profiler, heap );
+
+            ProfiledAllocator profiled = {};
+            Allocator alloc = ProfiledAllocator::Create( &profiled, heap, &profiler );
+
+            void* kept = ALLOC( alloc, 64 );
+            void* freed = ALLOC( alloc, 64 );
+            FREE( alloc, freed );
+
+            StringBuilder report = {};
+            StringBuilder::Create( &report, heap );
+
+            size_t leaks = AllocationProfiler::ReportLeaks( &profiler, &report );
+
+            EVALUATE( leaks == 1 );
+            EVALUATE( report.size != 0 );
+
+            StringBuilder::Destroy( &report );
+            FREE( alloc, kept );
+
+            StringBuilder::Create( &report, heap );
+            leaks = AllocationProfiler::ReportLeaks( &profiler, &report );
+
+            EVALUATE( leaks == 0 );
+            EVALUATE( report.size == 0 );
+
+            StringBuilder::Destroy( &report );
+            AllocationProfiler::Destroy( &profiler );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(FrameHistogram)
+        {
+            CoreContext::DefaultContext();
+
+            AllocationProfiler profiler = {};
+            AllocationProfiler::Create( &profiler, HeapAllocator::Create() );
+
+            // arena memory is counted but never live
+            Arena arena = Arena::Create( 4'096 );
+            ProfiledAllocator profiled = {};
+            Allocator alloc = ProfiledAllocator::Create( &profiled, ArenaAllocator::Create( &arena ), &profiler, false );
+
+            ALLOC( alloc, 8 );
+            ALLOC( alloc, 16 );
+            ALLOC( alloc, 17 );
+            AllocationProfiler::EndFrame( &profiler );
+
+            ALLOC( alloc, 1'000 );
+            AllocationProfiler::EndFrame( &profiler );
+
+            AllocationFrameStats last = {};
+            AllocationFrameStats previous = {};
+            AllocationFrameStats none = {};
+
+            EVALUATE( AllocationProfiler::TryGetFrame( &profiler, 0, &last ) );
+            EVALUATE( AllocationProfiler::TryGetFrame( &profiler, 1, &previous ) );
+            EVALUATE( !AllocationProfiler::TryGetFrame( &profiler, 2, &none ) );
+
+            EVALUATE( previous.allocation_count == 3 );
+            EVALUATE( previous.histogram[0] == 2 );
+            EVALUATE( previous.histogram[1] == 1 );
+            EVALUATE( last.allocation_count == 1 );
+            EVALUATE( last.histogram[AllocationProfiler::BucketIndex( 1'000 )] == 1 );
+            EVALUATE( profiler.live_bytes == 0 );
+
+            AllocationProfiler::Destroy( &profiler );
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(Sampling)
+        {
+            CoreContext::DefaultContext();
+
+            AllocationProfiler profiler = {};
+            AllocationProfiler::Create( &profiler, HeapAllocator::Create(), 1'024 );
+
+            AllocationSite site = {};
+            site.filepath = "sampled.cpp";
+            site.line_number = 1;
+
+            // 64 bytes at a time , one in 16 gets recorded and stands for 1KB
+            for ( size_t i = 0; i < 1'600; ++i )
+            {
+                AllocationProfiler::RecordAlloc( &profiler, (void*) (i + 1), 64, site, false );
+            }
+
+            // estimates , off by one sample at most
+            size_t expected_bytes = 1'600 * 64;
+            size_t bytes_error = profiler.allocated_bytes > expected_bytes ? profiler.allocated_bytes - expected_bytes : expected_bytes - profiler.allocated_bytes;
+            size_t count_error = profiler.allocation_count > 1'600 ? profiler.allocation_count - 1'600 : 1'600 - profiler.allocation_count;
+
+            EVALUATE( profiler.sites.count == 1 );
+            EVALUATE( bytes_error <= 1'024 );
+            EVALUATE( count_error <= 16 );
+
+            AllocationProfiler::Destroy( &profiler );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(UnsampledFreeSkipsLock)
+        {
+            CoreContext::DefaultContext();
+
+            AllocationProfiler profiler = {};
+            AllocationProfiler::Create( &profiler, HeapAllocator::Create(), 1'024 );
+
+            AllocationSite site = {};
+            site.filepath = "sampled.cpp";
+            site.line_number = 1;
+
+            // 16 allocations of 64 bytes , only the last one is sampled
+            void* sampled = nullptr;
+
+            for ( size_t i = 0; i < 16; ++i )
+            {
+                AllocationProfiler::RecordAlloc( &profiler, (void*) ((i + 1) * 64), 64, site, true );
+
+                if ( profiler.live.count == 1 && sampled == nullptr )
+                {
+                    sampled = (void*) ((i + 1) * 64);
+                }
+            }
+
+            EVALUATE( sampled != nullptr );
+            EVALUATE( AllocationProfiler::MayBeLive( &profiler, sampled ) );
+
+            bool unsampled_filtered = true;
+
+            for ( size_t i = 0; i < 16; ++i )
+            {
+                void* ptr = (void*) ((i + 1) * 64);
+                unsampled_filtered &= ptr == sampled || !AllocationProfiler::MayBeLive( &profiler, ptr );
+            }
+
+            EVALUATE( unsampled_filtered );
+
+            // the unsampled ones never reach the lock , a held lock would hang otherwise
+            profiler.lock.Lock();
+
+            for ( size_t i = 0; i < 16; ++i )
+            {
+                void* ptr = (void*) ((i + 1) * 64);
+
+                if ( ptr != sampled )
+                {
+                    AllocationProfiler::RecordFree( &profiler, ptr );
+                }
+            }
+
+            profiler.lock.Unlock();
+
+            AllocationProfiler::RecordFree( &profiler, sampled );
+
+            EVALUATE( profiler.live.count == 0 );
+            EVALUATE( profiler.free_count == 16 );
+            EVALUATE( !AllocationProfiler::MayBeLive( &profiler, sampled ) );
+
+            AllocationProfiler::Destroy( &profiler );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(5 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , AllocationProfilerTests::CountsPerCallSite);
+            DArray<TestCallback>::Add(&arr , AllocationProfilerTests::ReallocMovesTheLiveBytes);
+            DArray<TestCallback>::Add(&arr , AllocationProfilerTests::LeakReport);
+            DArray<TestCallback>::Add(&arr , AllocationProfilerTests::FrameHistogram);
+            DArray<TestCallback>::Add(&arr , AllocationProfilerTests::Sampling);
+            DArray<TestCallback>::Add(&arr , AllocationProfilerTests::UnsampledFreeSkipsLock);
+
+            return arr;
+        };
+    };
+}
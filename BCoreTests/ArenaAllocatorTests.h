@@ -0,0 +1,199 @@
+#pragma once
+
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Allocators/Allocator.h>
+
+namespace Tests
+{
+    struct ArenaAllocatorTests
+    {
+        TEST_DECLARATION(Alignment)
+        {
+            CoreContext::DefaultContext();
+
+            Arena arena = Arena::Create( 1024 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            void* a = ALLOC( alloc, 3 );
+            void* b = ALLOC( alloc, 5 );
+            void* c = Arena::Push( &arena, 1, 64 );
+            void* d = Arena::Push( &arena, 8, 8 );
+
+            EVALUATE( ((uintptr_t) a % Arena::DEFAULT_ALIGNMENT) == 0 );
+            EVALUATE( ((uintptr_t) b % Arena::DEFAULT_ALIGNMENT) == 0 );
+            EVALUATE( ((uintptr_t) c % 64) == 0 );
+            EVALUATE( ((uintptr_t) d % 8) == 0 );
+            EVALUATE( (char*) b >= (char*) a + 3 );
+
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(GrowsByChainingBlocks)
+        {
+            CoreContext::DefaultContext();
+
+            Arena arena = Arena::Create( 256 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            void* first_block = arena.data;
+
+            char* small = (char*) ALLOC( alloc, 200 );
+            CoreContext::mem_set( small, 'a', 200 );
+
+            // doesn't fit in what's left , goes to a 2nd block
+            char* next = (char*) ALLOC( alloc, 200 );
+            CoreContext::mem_set( next, 'b', 200 );
+
+            // bigger than the block size , gets a block of its own
+            char* huge = (char*) ALLOC( alloc, 4096 );
+            CoreContext::mem_set( huge, 'c', 4096 );
+
+            EVALUATE( arena.chain != nullptr );
+            EVALUATE( arena.chain->prev != nullptr );
+            EVALUATE( small[199] == 'a' && next[199] == 'b' && huge[4095] == 'c' );
+
+            Arena::Reset( &arena );
+
+            EVALUATE( arena.chain == nullptr );
+            EVALUATE( arena.data == first_block );
+            EVALUATE( arena.offset == 0 );
+
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ReallocInPlace)
+        {
+            CoreContext::DefaultContext();
+
+            Arena arena = Arena::Create( 4096 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            DArray<int> arr = {};
+            DArray<int>::Create( 1, &arr, alloc );
+
+            int* start = arr.data;
+
+            for ( int i = 0; i < 500; ++i )
+            {
+                DArray<int>::Add( &arr, i );
+            }
+
+            // the array was the last allocation the whole time , it never moved
+            bool stayed = arr.data == start;
+            bool intact = arr.data[0] == 0 && arr.data[499] == 499;
+
+            EVALUATE( stayed );
+            EVALUATE( intact );
+
+            // another allocation in between , the next growth has to move
+            void* other = ALLOC( alloc, 16 );
+            DArray<int>::Resize( &arr, 800 );
+
+            bool moved = arr.data != start;
+            bool moved_intact = arr.data[0] == 0 && arr.data[499] == 499;
+
+            EVALUATE( other != nullptr );
+            EVALUATE( moved );
+            EVALUATE( moved_intact );
+
+            // freeing the last allocation gives the memory back
+            size_t offset = arena.offset;
+            void* last = ALLOC( alloc, 64 );
+            FREE( alloc, last );
+
+            EVALUATE( arena.offset == offset );
+
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ReallocAcrossBlocks)
+        {
+            CoreContext::DefaultContext();
+
+            Arena arena = Arena::Create( 128 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            char* ptr = (char*) ALLOC( alloc, 100 );
+            CoreContext::mem_set( ptr, 'x', 100 );
+
+            // no room left in the first block
+            char* grown = (char*) REALLOC( alloc, ptr, 1000 );
+
+            EVALUATE( grown != ptr );
+            EVALUATE( arena.chain != nullptr );
+            EVALUATE( grown[0] == 'x' && grown[99] == 'x' );
+
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(NestedCheckpoints)
+        {
+            CoreContext::DefaultContext();
+
+            Arena arena = Arena::Create( 256 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            ALLOC( alloc, 64 );
+
+            ArenaCheckpoint outer = ArenaCheckpoint::Create( &arena );
+            size_t outer_offset = arena.offset;
+            void* outer_block = arena.data;
+
+            ALLOC( alloc, 128 );
+
+            ArenaCheckpoint inner = ArenaCheckpoint::Create( &arena );
+            size_t inner_offset = arena.offset;
+
+            // spills into new blocks
+            ALLOC( alloc, 512 );
+            ALLOC( alloc, 512 );
+
+            ArenaCheckpoint::Rewind( &inner );
+
+            EVALUATE( arena.data == outer_block );
+            EVALUATE( arena.offset == inner_offset );
+            EVALUATE( arena.chain == nullptr );
+            EVALUATE( arena.spare != nullptr );
+
+            // the spare block gets reused instead of allocating a new one
+            ArenaBlock* spare = arena.spare;
+            ALLOC( alloc, 200 );
+
+            EVALUATE( arena.chain == spare );
+
+            ArenaCheckpoint::Rewind( &outer );
+
+            EVALUATE( arena.data == outer_block );
+            EVALUATE( arena.offset == outer_offset );
+            EVALUATE( arena.chain == nullptr );
+
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(5 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , ArenaAllocatorTests::Alignment);
+            DArray<TestCallback>::Add(&arr , ArenaAllocatorTests::GrowsByChainingBlocks);
+            DArray<TestCallback>::Add(&arr , ArenaAllocatorTests::ReallocInPlace);
+            DArray<TestCallback>::Add(&arr , ArenaAllocatorTests::ReallocAcrossBlocks);
+            DArray<TestCallback>::Add(&arr , ArenaAllocatorTests::NestedCheckpoints);
+
+            return arr;
+        };
+    };
+}
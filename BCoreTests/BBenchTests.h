@@ -0,0 +1,192 @@
+#pragma once
+
+#include <Testing/BTest.h>
+#include <Testing/BBench.h>
+#include <Containers/DArray.h>
+#include <Containers/ChunkedBuffer.h>
+#include <Allocators/Allocator.h>
+
+namespace Tests
+{
+    struct BBenchTests
+    {
+        static void Accumulate( BenchState* state )
+        {
+            uint64_t acc = 0;
+
+            for ( uint64_t i = 0; i < state->iterations; ++i )
+            {
+                acc += i * (uint64_t) state->arg;
+                BBench::DoNotOptimize( acc );
+            }
+
+            state->bytes_per_iteration = sizeof( uint64_t );
+        }
+
+        TEST_DECLARATION(Summarize)
+        {
+            // one outlier , it moves neither the median nor the MAD
+            double samples[] = { 10.0, 12.0, 11.0, 1'000.0, 9.0 };
+
+            BenchResult result = {};
+            BBench::Summarize( samples, 5, &result );
+
+            EVALUATE( result.median_ns == 11.0 );
+
+            // deviations 1 , 1 , 0 , 989 , 2 => 0 1 1 2 989
+            EVALUATE( result.mad_ns == 1.0 );
+            EVALUATE( result.min_ns == 9.0 );
+            EVALUATE( result.max_ns == 1'000.0 );
+
+            double even[] = { 4.0, 1.0, 3.0, 2.0 };
+            BBench::Summarize( even, 4, &result );
+
+            EVALUATE( result.median_ns == 2.5 );
+            EVALUATE( result.mad_ns == 1.0 );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(Ranges)
+        {
+            int64_t args[BBench::MAX_RANGE_ARGS] = {};
+
+            BenchDefinition definition = {};
+            definition.range_start = 8;
+            definition.range_end = 1'000;
+            definition.range_multiplier = 8;
+
+            // the end is always there even when not a power
+            size_t count = BBench::GetArgs( &definition, args, BBench::MAX_RANGE_ARGS );
+
+            EVALUATE( count == 4 );
+            EVALUATE( args[0] == 8 && args[1] == 64 && args[2] == 512 && args[3] == 1'000 );
+
+            definition.range_start = 0;
+            definition.range_end = 16;
+            definition.range_multiplier = 2;
+            count = BBench::GetArgs( &definition, args, BBench::MAX_RANGE_ARGS );
+
+            EVALUATE( count == 2 );
+            EVALUATE( args[0] == 0 && args[1] == 16 );
+
+            definition.range_multiplier = 0;
+            count = BBench::GetArgs( &definition, args, BBench::MAX_RANGE_ARGS );
+
+            EVALUATE( count == 1 );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(RunScalesIterations)
+        {
+            BenchDefinition definition = {};
+            definition.name = "Tests::Accumulate";
+            definition.run = Accumulate;
+
+            BBench::Options options = {};
+            options.sample_count = 3;
+            options.min_sample_ns = 1'000'000;
+            options.warmup_ns = 0;
+
+            BenchResult result = BBench::Run( &definition, 3, true, options );
+
+            EVALUATE( result.iterations > 1 );
+            EVALUATE( result.sample_count == 3 );
+            EVALUATE( result.median_ns > 0 );
+            EVALUATE( result.min_ns <= result.median_ns && result.median_ns <= result.max_ns );
+            EVALUATE( result.items_per_second > 0 );
+            EVALUATE( result.bytes_per_second == result.items_per_second * sizeof( uint64_t ) );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(BaselineRegressions)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator alloc = HeapAllocator::Create();
+
+            DArray<BenchResult> baseline = {};
+            DArray<BenchResult>::Create( 3, &baseline, alloc );
+
+            BenchResult result = {};
+            result.name = "Tests::Fast";
+            result.median_ns = 100.0;
+            DArray<BenchResult>::Add( &baseline, result );
+
+            result.name = "Tests::Ranged";
+            result.has_arg = true;
+            result.arg = 64;
+            result.median_ns = 50.0;
+            DArray<BenchResult>::Add( &baseline, result );
+
+            ChunkedBuffer json = {};
+            ChunkedBuffer::Create( &json, alloc );
+            BBench::WriteJSON( &baseline, &json );
+
+            // same names , one 5% slower , one 30% slower , one not in the baseline
+            DArray<BenchResult> current = {};
+            DArray<BenchResult>::Create( 3, &current, alloc );
+
+            result = {};
+            result.name = "Tests::Fast";
+            result.median_ns = 105.0;
+            DArray<BenchResult>::Add( &current, result );
+
+            result.name = "Tests::Ranged";
+            result.has_arg = true;
+            result.arg = 64;
+            result.median_ns = 65.0;
+            DArray<BenchResult>::Add( &current, result );
+
+            result.arg = 128;
+            DArray<BenchResult>::Add( &current, result );
+
+            size_t regression_count = BBench::CompareBaseline( &current, ChunkedBuffer::Flatten( &json ), 0.10 );
+
+            EVALUATE( regression_count == 1 );
+            EVALUATE( current.data[0].has_baseline && !current.data[0].is_regression );
+            EVALUATE( current.data[0].baseline_ns == 100.0 );
+            EVALUATE( current.data[1].has_baseline && current.data[1].is_regression );
+            EVALUATE( current.data[1].change > 0.29 && current.data[1].change < 0.31 );
+            EVALUATE( !current.data[2].has_baseline );
+
+            DArray<BenchResult>::Destroy( &current );
+            DArray<BenchResult>::Destroy( &baseline );
+            ChunkedBuffer::Destroy( &json );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ParseOptions)
+        {
+            char* argv[] = { (char*) "bench", (char*) "--filter=HMap", (char*) "--threshold=0.25", (char*) "--samples=500", (char*) "--min-time-ms=2" };
+
+            BBench::Options options = BBench::ParseOptions( 5, argv );
+
+            EVALUATE( StringUtils::Compare( options.filter, "HMap" ) );
+            EVALUATE( options.regression_threshold == 0.25 );
+            EVALUATE( options.sample_count == BBench::MAX_SAMPLES );
+            EVALUATE( options.min_sample_ns == 2'000'000 );
+            EVALUATE( options.json_path == nullptr );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(5 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , BBenchTests::Summarize);
+            DArray<TestCallback>::Add(&arr , BBenchTests::Ranges);
+            DArray<TestCallback>::Add(&arr , BBenchTests::RunScalesIterations);
+            DArray<TestCallback>::Add(&arr , BBenchTests::BaselineRegressions);
+            DArray<TestCallback>::Add(&arr , BBenchTests::ParseOptions);
+
+            return arr;
+        }
+    };
+}
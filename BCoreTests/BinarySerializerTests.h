@@ -0,0 +1,424 @@
+#pragma once
+
+#include <stdint.h>
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Containers/HMap.h>
+#include <Allocators/Allocator.h>
+#include <String/StringBuffer.h>
+#include <String/StringUtils.h>
+#include <Serialization/BinarySerializer.h>
+
+namespace Tests
+{
+    struct BinaryTransform
+    {
+        float position[3];
+        float scale;
+    };
+
+    struct BinaryEntity
+    {
+        StringBuffer name;
+        BinaryTransform transform;
+        DArray<uint32_t> tags;
+        // runtime only , not in the descriptor
+        void* handle;
+        DArray<BinaryEntity> children;
+    };
+
+    struct BinaryLevel
+    {
+        uint32_t id;
+        StringBuffer name;
+        DArray<BinaryEntity> entities;
+        HMap<uint32_t, BinaryTransform> spawns;
+    };
+
+    // the same layout under a new version
+    struct BinaryLevelV4 : BinaryLevel
+    {
+    };
+}
+
+template<>
+struct BinaryDescriptor<Tests::BinaryEntity>
+{
+    static constexpr uint32_t VERSION = 1;
+    static constexpr BinaryField FIELDS[] = { BINARY_FIELD( Tests::BinaryEntity, name ), BINARY_FIELD( Tests::BinaryEntity, transform ),
+        BINARY_FIELD( Tests::BinaryEntity, tags ), BINARY_FIELD( Tests::BinaryEntity, children ) };
+};
+
+template<>
+struct BinaryDescriptor<Tests::BinaryLevel>
+{
+    static constexpr uint32_t VERSION = 3;
+    static constexpr BinaryField FIELDS[] = { BINARY_FIELD( Tests::BinaryLevel, id ), BINARY_FIELD( Tests::BinaryLevel, name ),
+        BINARY_FIELD( Tests::BinaryLevel, entities ), BINARY_FIELD( Tests::BinaryLevel, spawns ) };
+};
+
+template<>
+struct BinaryDescriptor<Tests::BinaryLevelV4>
+{
+    static constexpr uint32_t VERSION = 4;
+    static constexpr BinaryField FIELDS[] = { BINARY_FIELD( Tests::BinaryLevel, id ), BINARY_FIELD( Tests::BinaryLevel, name ),
+        BINARY_FIELD( Tests::BinaryLevel, entities ), BINARY_FIELD( Tests::BinaryLevel, spawns ) };
+};
+
+namespace Tests
+{
+    struct BinarySerializerTests
+    {
+        static void CreateEntity( BinaryEntity* out_entity, const char* name, uint32_t seed, Allocator alloc )
+        {
+            *out_entity = {};
+            out_entity->name = StringBuffer::Create( name, alloc );
+            out_entity->transform = { { (float) seed, 2.0f, -3.5f }, 0.5f * (float) seed };
+            out_entity->handle = out_entity;
+
+            DArray<uint32_t>::Create( 4, &out_entity->tags, alloc );
+
+            for ( uint32_t i = 0; i < seed; ++i )
+            {
+                DArray<uint32_t>::Add( &out_entity->tags, seed * 100 + i );
+            }
+
+            DArray<BinaryEntity>::Create( 2, &out_entity->children, alloc );
+        }
+
+        static void DestroyEntity( BinaryEntity* entity )
+        {
+            for ( size_t i = 0; i < entity->children.size; ++i )
+            {
+                DestroyEntity( &entity->children.data[i] );
+            }
+
+            StringBuffer::Destroy( &entity->name );
+            DArray<uint32_t>::Destroy( &entity->tags );
+            DArray<BinaryEntity>::Destroy( &entity->children );
+        }
+
+        static void CreateLevel( BinaryLevel* out_level, Allocator alloc )
+        {
+            *out_level = {};
+            out_level->id = 42;
+            out_level->name = StringBuffer::Create( "level_01", alloc );
+
+            DArray<BinaryEntity>::Create( 4, &out_level->entities, alloc );
+
+            for ( uint32_t i = 0; i < 3; ++i )
+            {
+                BinaryEntity entity = {};
+                CreateEntity( &entity, "entity", i + 1, alloc );
+                DArray<BinaryEntity>::Add( &out_level->entities, entity );
+            }
+
+            BinaryEntity child = {};
+            CreateEntity( &child, "child", 5, alloc );
+            DArray<BinaryEntity>::Add( &out_level->entities.data[1].children, child );
+
+            HMap<uint32_t, BinaryTransform>::Create( &out_level->spawns, alloc, 4 );
+
+            // enough to grow the map past its first table
+            for ( uint32_t i = 0; i < 100; ++i )
+            {
+                HMap<uint32_t, BinaryTransform>::TryAdd( &out_level->spawns, i * 7, { { (float) i, 0.0f, 0.0f }, 1.0f }, nullptr );
+            }
+        }
+
+        static void DestroyLevel( BinaryLevel* level )
+        {
+            for ( size_t i = 0; i < level->entities.size; ++i )
+            {
+                DestroyEntity( &level->entities.data[i] );
+            }
+
+            StringBuffer::Destroy( &level->name );
+            DArray<BinaryEntity>::Destroy( &level->entities );
+            HMap<uint32_t, BinaryTransform>::Destroy( &level->spawns );
+        }
+
+        static bool IsSameEntity( const BinaryEntity* a, const BinaryEntity* b )
+        {
+            bool is_same = StringUtils::Compare( a->name.view, b->name.view ) && a->transform.scale == b->transform.scale &&
+                a->transform.position[0] == b->transform.position[0] && a->tags.size == b->tags.size && a->children.size == b->children.size;
+
+            for ( size_t i = 0; is_same && i < a->tags.size; ++i )
+            {
+                is_same = a->tags.data[i] == b->tags.data[i];
+            }
+
+            for ( size_t i = 0; is_same && i < a->children.size; ++i )
+            {
+                is_same = IsSameEntity( &a->children.data[i], &b->children.data[i] );
+            }
+
+            return is_same;
+        }
+
+        static bool IsInside( const void* ptr, const DArray<uint8_t>* blob )
+        {
+            return (const uint8_t*) ptr >= blob->data && (const uint8_t*) ptr < blob->data + blob->size;
+        }
+
+        TEST_DECLARATION(RoundTrip)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            BinaryLevel level = {};
+            CreateLevel( &level, alloc );
+
+            DArray<uint8_t> blob = {};
+            DArray<uint8_t>::Create( 256, &blob, alloc );
+            BinarySerializer::Write( &level, &blob );
+
+            BinaryLevel* loaded = nullptr;
+            bool is_loaded = BinarySerializer::Load( blob.data, blob.size, &loaded );
+
+            EVALUATE( is_loaded );
+            EVALUATE( IsInside( loaded, &blob ) );
+            EVALUATE( loaded->id == 42 );
+            EVALUATE( StringUtils::Compare( loaded->name.view, "level_01" ) );
+            EVALUATE( loaded->name.buffer[loaded->name.length] == '\0' );
+            EVALUATE( IsInside( loaded->entities.data, &blob ) );
+            EVALUATE( loaded->entities.size == 3 );
+
+            bool entities_ok = true;
+
+            for ( size_t i = 0; i < level.entities.size; ++i )
+            {
+                entities_ok &= IsSameEntity( &level.entities.data[i], &loaded->entities.data[i] );
+                // fields out of the descriptor are zero
+                entities_ok &= loaded->entities.data[i].handle == nullptr;
+            }
+
+            EVALUATE( entities_ok );
+            EVALUATE( loaded->entities.data[0].children.data == nullptr );
+            EVALUATE( loaded->entities.data[1].children.data[0].tags.size == 5 );
+
+            // the table is used as it was written
+            bool spawns_ok = loaded->spawns.count == 100;
+
+            for ( uint32_t i = 0; i < 100; ++i )
+            {
+                BinaryTransform* spawn = nullptr;
+                spawns_ok &= HMap<uint32_t, BinaryTransform>::TryGet( &loaded->spawns, i * 7, &spawn ) && spawn->position[0] == (float) i;
+            }
+
+            BinaryTransform* missing = nullptr;
+            spawns_ok &= !HMap<uint32_t, BinaryTransform>::TryGet( &loaded->spawns, 3, &missing );
+
+            EVALUATE( spawns_ok );
+            EVALUATE( loaded->spawns.allocator.alloc == nullptr );
+
+            // loading again at the same address gives the same root
+            BinaryLevel* reloaded = nullptr;
+            EVALUATE( BinarySerializer::Load( blob.data, blob.size, &reloaded ) );
+            EVALUATE( reloaded == loaded );
+
+            DArray<uint8_t>::Destroy( &blob );
+            DestroyLevel( &level );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(Deterministic)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            BinaryLevel level = {};
+            CreateLevel( &level, alloc );
+
+            DArray<uint8_t> first = {};
+            DArray<uint8_t>::Create( 16, &first, alloc );
+            DArray<uint8_t> second = {};
+            DArray<uint8_t>::Create( 4'096, &second, alloc );
+
+            BinarySerializer::Write( &level, &first );
+            BinarySerializer::Write( &level, &second );
+
+            // padding and skipped fields are zeroed , the same data always gives the same bytes
+            EVALUATE( first.size == second.size );
+            EVALUATE( memcmp( first.data, second.data, first.size ) == 0 );
+
+            DArray<uint8_t>::Destroy( &first );
+            DArray<uint8_t>::Destroy( &second );
+            DestroyLevel( &level );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(RejectsMismatch)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            BinaryLevel level = {};
+            CreateLevel( &level, alloc );
+
+            DArray<uint8_t> blob = {};
+            DArray<uint8_t>::Create( 256, &blob, alloc );
+            BinarySerializer::Write( &level, &blob );
+
+            DArray<uint8_t> copy = {};
+            DArray<uint8_t>::Create( blob.size, &copy, alloc );
+
+            BinaryLevel* loaded = nullptr;
+            BinaryLevelV4* loaded_v4 = nullptr;
+            BinaryEntity* loaded_entity = nullptr;
+
+            // other version , other type
+            EVALUATE( !BinarySerializer::Load( blob.data, blob.size, &loaded_v4 ) );
+            EVALUATE( !BinarySerializer::Load( blob.data, blob.size, &loaded_entity ) );
+            bool is_other_hash = BinarySerializer::LayoutHash<BinaryLevel>() != BinarySerializer::LayoutHash<BinaryEntity>();
+            EVALUATE( is_other_hash );
+
+            // truncated
+            EVALUATE( !BinarySerializer::Load( blob.data, blob.size - 1, &loaded ) );
+            EVALUATE( !BinarySerializer::Load( blob.data, sizeof( BinaryHeader ) - 1, &loaded ) );
+
+            // an offset out of the blob
+            CoreContext::mem_copy( blob.data, copy.data, blob.size );
+            size_t root_offset = (size_t) ((BinaryHeader*) copy.data)->root_offset;
+            BinaryLevel* image = (BinaryLevel*) (copy.data + root_offset);
+            image->entities.data = (BinaryEntity*) (uintptr_t) (blob.size - 8);
+
+            EVALUATE( !BinarySerializer::Load( copy.data, blob.size, &loaded ) );
+            EVALUATE( loaded == nullptr );
+
+            // a string without its terminator
+            CoreContext::mem_copy( blob.data, copy.data, blob.size );
+            copy.data[(uintptr_t) image->name.buffer + image->name.length] = 'x';
+
+            EVALUATE( !BinarySerializer::Load( copy.data, blob.size, &loaded ) );
+
+            // truncated right after the header , the size left can't even hold the root
+            alignas( BinarySerializer::ALIGNMENT ) BinaryHeader truncated = *(BinaryHeader*) blob.data;
+            truncated.size = sizeof( BinaryHeader );
+            truncated.root_offset = sizeof( BinaryHeader );
+
+            EVALUATE( !BinarySerializer::Load( &truncated, sizeof( BinaryHeader ), &loaded ) );
+            EVALUATE( loaded == nullptr );
+
+            // corrupt magic
+            CoreContext::mem_copy( blob.data, copy.data, blob.size );
+            copy.data[0] ^= 0xFF;
+
+            EVALUATE( !BinarySerializer::Load( copy.data, blob.size, &loaded ) );
+
+            // the untouched copy still loads
+            CoreContext::mem_copy( blob.data, copy.data, blob.size );
+
+            EVALUATE( BinarySerializer::Load( copy.data, blob.size, &loaded ) );
+
+            DArray<uint8_t>::Destroy( &copy );
+            DArray<uint8_t>::Destroy( &blob );
+            DestroyLevel( &level );
+
+            TEST_END()
+        }
+
+        using SpawnMap = HMap<uint32_t, BinaryTransform>;
+
+        /// <summary>
+        /// Writes a level whose spawn table went through "corrupt" first , returns whether the blob still loads
+        /// </summary>
+        static bool LoadsCorruptMap( void (*corrupt)( SpawnMap* ), Allocator alloc )
+        {
+            BinaryLevel level = {};
+            CreateLevel( &level, alloc );
+            corrupt( &level.spawns );
+
+            DArray<uint8_t> blob = {};
+            DArray<uint8_t>::Create( 256, &blob, alloc );
+            BinarySerializer::Write( &level, &blob );
+
+            BinaryLevel* loaded = nullptr;
+            bool is_loaded = BinarySerializer::Load( blob.data, blob.size, &loaded );
+
+            DArray<uint8_t>::Destroy( &blob );
+            DestroyLevel( &level );
+
+            return is_loaded || loaded != nullptr;
+        }
+
+        /// <summary>
+        /// First slot after the mirrored group with the given control byte state
+        /// </summary>
+        static size_t FindSlot( SpawnMap* map, bool is_full )
+        {
+            for ( size_t i = ControlGroup::WIDTH; i < map->slot_count; ++i )
+            {
+                if ( (map->control[i] < ControlGroup::EMPTY) == is_full )
+                {
+                    return i;
+                }
+            }
+
+            return 0;
+        }
+
+        TEST_DECLARATION(RejectsCorruptMap)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            // the untouched level loads
+            EVALUATE( LoadsCorruptMap( []( SpawnMap* ) {}, alloc ) );
+
+            // no empty slot left , a lookup of a missing key would never stop probing
+            EVALUATE( !LoadsCorruptMap( []( SpawnMap* map )
+            {
+                for ( size_t i = 0; i < map->slot_count; ++i )
+                {
+                    if ( map->control[i] == ControlGroup::EMPTY )
+                    {
+                        map->slots[i] = (uint32_t) map->count++;
+                        DArray<uint32_t>::Add( &map->all_keys, (uint32_t) (1'000 + i) );
+                        DArray<BinaryTransform>::Add( &map->all_values, {} );
+                    }
+                }
+
+                CoreContext::mem_set( map->control, 0, map->slot_count + ControlGroup::WIDTH );
+            }, alloc ) );
+
+            // a mirrored byte that says full while the real one is empty , or the other way around
+            EVALUATE( !LoadsCorruptMap( []( SpawnMap* map )
+            {
+                map->control[map->slot_count] = map->control[0] == ControlGroup::EMPTY ? 0 : ControlGroup::EMPTY;
+            }, alloc ) );
+
+            // a byte that is neither empty nor a hash
+            EVALUATE( !LoadsCorruptMap( []( SpawnMap* map )
+            {
+                map->control[FindSlot( map, false )] = 0xFE;
+            }, alloc ) );
+
+            // one more full slot than there are entries
+            EVALUATE( !LoadsCorruptMap( []( SpawnMap* map )
+            {
+                size_t slot = FindSlot( map, false );
+                map->control[slot] = 0x01;
+                map->slots[slot] = 0;
+            }, alloc ) );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(4 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , BinarySerializerTests::RoundTrip);
+            DArray<TestCallback>::Add(&arr , BinarySerializerTests::Deterministic);
+            DArray<TestCallback>::Add(&arr , BinarySerializerTests::RejectsMismatch);
+            DArray<TestCallback>::Add(&arr , BinarySerializerTests::RejectsCorruptMap);
+
+            return arr;
+        };
+    };
+}
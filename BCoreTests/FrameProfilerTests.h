@@ -0,0 +1,204 @@
+#pragma once
+
+#include <thread>
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Containers/ChunkedBuffer.h>
+#include <Allocators/Allocator.h>
+#include <String/StringUtils.h>
+#include <Serialization/JSONParser.h>
+#include <Profiler/FrameProfiler.h>
+
+namespace Tests
+{
+    struct FrameProfilerTests
+    {
+        static void ProfiledInner()
+        {
+            PROFILE_SCOPE( "Tests::Inner" );
+
+            volatile uint32_t acc = 0;
+
+            for ( uint32_t i = 0; i < 1'000; ++i )
+            {
+                acc = acc + i;
+            }
+        }
+
+        TEST_DECLARATION(ZoneStats)
+        {
+            CoreContext::DefaultContext();
+
+            // static , Create makes it the current profiler
+            static FrameProfiler profiler = {};
+            FrameProfiler::Create( &profiler, HeapAllocator::Create() );
+
+            for ( size_t frame = 0; frame < 10; ++frame )
+            {
+                PROFILE_SCOPE( "Tests::Outer" );
+
+                for ( size_t i = 0; i < 4; ++i )
+                {
+                    ProfiledInner();
+                }
+            }
+
+            FrameProfiler::EndFrame( &profiler );
+
+            // one more frame with a single call
+            ProfiledInner();
+            FrameProfiler::EndFrame( &profiler );
+
+            DArray<ProfileZoneSummary> stats = {};
+            FrameProfiler::GetStats( &profiler, &stats, HeapAllocator::Create() );
+
+            EVALUATE( stats.size == 2 );
+
+            ProfileZoneSummary* inner = StringUtils::Compare( stats.data[0].name, "Tests::Inner" ) ? &stats.data[0] : &stats.data[1];
+            ProfileZoneSummary* outer = inner == &stats.data[0] ? &stats.data[1] : &stats.data[0];
+
+            bool ordered = inner->min_ms <= inner->avg_ms && inner->avg_ms <= inner->p99_ms && inner->p99_ms <= inner->max_ms;
+
+            EVALUATE( inner->frame_calls == 1 );
+            EVALUATE( inner->sample_count == 41 );
+            EVALUATE( outer->frame_calls == 0 );
+            EVALUATE( outer->sample_count == 10 );
+            EVALUATE( ordered );
+            EVALUATE( inner->min_ms > 0 );
+
+            // the outer zone holds four inner ones
+            EVALUATE( outer->min_ms >= inner->min_ms * 4 );
+
+            ProfileZoneSummary frame = FrameProfiler::GetFrameStats( &profiler );
+            EVALUATE( frame.sample_count == 2 );
+
+            // same name from another call site , same zone
+            char copy[] = "Tests::Inner";
+            EVALUATE( FrameProfiler::RegisterZone( copy ) == FrameProfiler::RegisterZone( "Tests::Inner" ) );
+
+            DArray<ProfileZoneSummary>::Destroy( &stats );
+            FrameProfiler::Destroy( &profiler );
+
+            // nothing recorded without a profiler
+            ProfiledInner();
+            EVALUATE( FrameProfiler::current == nullptr );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ChromeTrace)
+        {
+            CoreContext::DefaultContext();
+
+            static FrameProfiler profiler = {};
+            FrameProfiler::Create( &profiler, HeapAllocator::Create() );
+            FrameProfiler::SetThreadName( "Main" );
+
+            for ( size_t i = 0; i < 3; ++i )
+            {
+                ProfiledInner();
+            }
+
+            std::thread worker( []()
+            {
+                FrameProfiler::SetThreadName( "Worker" );
+
+                for ( size_t i = 0; i < 5; ++i )
+                {
+                    ProfiledInner();
+                }
+            } );
+
+            worker.join();
+
+            FrameProfiler::EndFrame( &profiler );
+
+            ChunkedBuffer out = {};
+            ChunkedBuffer::Create( &out, HeapAllocator::Create() );
+            FrameProfiler::ExportChromeTrace( &profiler, &out );
+
+            Arena arena = Arena::Create( 16 * 1'024 );
+            JSONNode root = {};
+            bool parsed = JSONParser::Parse( ChunkedBuffer::Flatten( &out ), &root, ArenaAllocator::Create( &arena ) );
+
+            EVALUATE( parsed );
+            EVALUATE( profiler.thread_count == 2 );
+
+            JSONNode* events = &root.sub_nodes.data[1];
+
+            // a name per thread and one event per call
+            EVALUATE( events->sub_nodes.size == 2 + 3 + 5 );
+
+            size_t complete_count = 0;
+            bool has_worker = false;
+
+            for ( size_t i = 0; i < events->sub_nodes.size; ++i )
+            {
+                JSONNode* event = &events->sub_nodes.data[i];
+
+                // { name , ph , pid , tid , args } for the thread names , { name , cat , ph , ts , dur , pid , tid } for the zones
+                if ( StringUtils::Compare( event->sub_nodes.data[0].value, "thread_name" ) )
+                {
+                    has_worker |= StringUtils::Compare( event->sub_nodes.data[4].sub_nodes.data[0].value, "Worker" );
+                }
+                else if ( StringUtils::Compare( event->sub_nodes.data[2].value, "X" ) )
+                {
+                    complete_count += StringUtils::Compare( event->sub_nodes.data[0].value, "Tests::Inner" ) ? 1 : 0;
+                }
+            }
+
+            EVALUATE( complete_count == 8 );
+            EVALUATE( has_worker );
+
+            Arena::Destroy( &arena );
+            ChunkedBuffer::Destroy( &out );
+            FrameProfiler::Destroy( &profiler );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(DropsWhenBehind)
+        {
+            CoreContext::DefaultContext();
+
+            static FrameProfiler profiler = {};
+            FrameProfiler::Create( &profiler, HeapAllocator::Create() );
+
+            for ( size_t i = 0; i < FrameProfiler::EVENTS_PER_THREAD + 5; ++i )
+            {
+                PROFILE_SCOPE( "Tests::Empty" );
+            }
+
+            EVALUATE( profiler.threads[0]->dropped_count == 5 );
+
+            FrameProfiler::EndFrame( &profiler );
+
+            // room again
+            {
+                PROFILE_SCOPE( "Tests::Empty" );
+            }
+
+            FrameProfiler::EndFrame( &profiler );
+
+            EVALUATE( profiler.threads[0]->dropped_count == 5 );
+            EVALUATE( profiler.threads[0]->history_count == (int64_t) FrameProfiler::EVENTS_PER_THREAD + 1 );
+
+            FrameProfiler::Destroy( &profiler );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(3 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , FrameProfilerTests::ZoneStats);
+            DArray<TestCallback>::Add(&arr , FrameProfilerTests::ChromeTrace);
+            DArray<TestCallback>::Add(&arr , FrameProfilerTests::DropsWhenBehind);
+
+            return arr;
+        }
+    };
+}
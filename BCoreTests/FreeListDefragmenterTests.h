@@ -0,0 +1,309 @@
+#pragma once
+
+#include <Testing/BTest.h>
+#include <Containers/FreeList.h>
+#include <Containers/FreeListDefragmenter.h>
+#include <Allocators/Allocator.h>
+
+namespace Tests
+{
+    struct FreeListDefragmenterTests
+    {
+        static constexpr FreeListDefragmenter::Options UNBOUNDED = { (size_t) -1, (size_t) -1 };
+
+        /// <summary>
+        /// 8 blocks of 64 bytes with every even one freed , the odd ones go in "out_nodes"
+        /// </summary>
+        static void CreateHoles(FreeList *out_freelist, FreeList::Node *out_nodes, Allocator alloc)
+        {
+            FreeList::Create( out_freelist, 16 , 16, 1024, alloc );
+
+            FreeList::Node all[8] = {};
+
+            for ( size_t i = 0; i < 8; ++i )
+            {
+                FreeList::AllocBlock( out_freelist, 64, &all[i] );
+            }
+
+            for ( size_t i = 0; i < 8; ++i )
+            {
+                if ( i % 2 == 0 )
+                {
+                    FreeList::FreeBlock( out_freelist, all[i] );
+                }
+                else
+                {
+                    out_nodes[i / 2] = all[i];
+                }
+            }
+        }
+
+        TEST_DECLARATION(CompactsToFront)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator allocator = HeapAllocator::Create();
+
+            FreeList flist;
+            FreeList::Node nodes[4] = {};
+            CreateHoles( &flist, nodes, allocator );
+
+            FreeListDefragmenter defrag;
+            FreeListDefragmenter::Create( &defrag, 4, allocator );
+
+            FreeList::Node *handles[4] = { &nodes[0], &nodes[1], &nodes[2], &nodes[3] };
+            size_t move_count = FreeListDefragmenter::Step( &defrag, &flist, { handles, 4 }, UNBOUNDED );
+
+            // the two highest blocks go to the two lowest holes , the others are already packed against them
+            EVALUATE( move_count == 2 );
+            EVALUATE( defrag.moves.data[0].src.start == 448 && defrag.moves.data[0].dst.start == 0 );
+            EVALUATE( defrag.moves.data[1].src.start == 320 && defrag.moves.data[1].dst.start == 128 );
+            EVALUATE( nodes[0].start == 64 && nodes[1].start == 192 );
+            EVALUATE( nodes[2].start == 128 && nodes[3].start == 0 );
+
+            FreeListStats stats = FreeList::GetStats( &flist );
+
+            EVALUATE( stats.used_block_count == 4 );
+            EVALUATE( stats.used_mem == 256 );
+            EVALUATE( stats.free_block_count == 1 );
+            EVALUATE( stats.largest_free_block == 768 );
+            EVALUATE( stats.fragmentation == 0.0f );
+
+            // nothing left to do
+            EVALUATE( FreeListDefragmenter::Step( &defrag, &flist, { handles, 4 }, UNBOUNDED ) == 0 );
+
+            for ( size_t i = 0; i < 4; ++i )
+            {
+                FreeList::FreeBlock( &flist, nodes[i] );
+            }
+
+            EVALUATE( flist.used_mem == 0 );
+
+            FreeListDefragmenter::Destroy( &defrag );
+            FreeList::Destroy( &flist );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(BoundedSteps)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator allocator = HeapAllocator::Create();
+
+            FreeList flist;
+            FreeList::Node nodes[4] = {};
+            CreateHoles( &flist, nodes, allocator );
+
+            FreeListDefragmenter defrag;
+            FreeListDefragmenter::Create( &defrag, 4, allocator );
+
+            FreeList::Node *handles[4] = { &nodes[0], &nodes[1], &nodes[2], &nodes[3] };
+
+            // not enough bytes for a single block
+            FreeListDefragmenter::Options options = { 32, 4 };
+
+            EVALUATE( FreeListDefragmenter::Step( &defrag, &flist, { handles, 4 }, options ) == 0 );
+            EVALUATE( nodes[3].start == 448 );
+
+            // one move per step
+            options = { 1024, 1 };
+
+            EVALUATE( FreeListDefragmenter::Step( &defrag, &flist, { handles, 4 }, options ) == 1 );
+            EVALUATE( nodes[3].start == 0 );
+            EVALUATE( FreeList::GetStats( &flist ).free_block_count == 3 );
+
+            EVALUATE( FreeListDefragmenter::Step( &defrag, &flist, { handles, 4 }, options ) == 1 );
+            EVALUATE( nodes[2].start == 128 );
+            EVALUATE( FreeList::GetStats( &flist ).free_block_count == 1 );
+
+            EVALUATE( FreeListDefragmenter::Step( &defrag, &flist, { handles, 4 }, options ) == 0 );
+
+            EVALUATE( defrag.total_move_count == 2 );
+            EVALUATE( defrag.total_moved_bytes == 128 );
+
+            FreeListDefragmenter::Destroy( &defrag );
+            FreeList::Destroy( &flist );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(RelocationTable)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator allocator = HeapAllocator::Create();
+
+            FreeList flist;
+            FreeList::Node nodes[4] = {};
+            CreateHoles( &flist, nodes, allocator );
+
+            FreeListDefragmenter defrag;
+            FreeListDefragmenter::Create( &defrag, 4, allocator );
+
+            // the same block behind two handles , a copy that isn't given to Step and a block that can't move
+            FreeList::Node shared = nodes[3];
+            FreeList::Node copy = nodes[3];
+            FreeList::Node *handles[3] = { &nodes[3], &shared, &nodes[0] };
+
+            EVALUATE( FreeListDefragmenter::Step( &defrag, &flist, { handles, 3 }, UNBOUNDED ) == 1 );
+            EVALUATE( nodes[3].start == 0 && shared.start == 0 );
+
+            EVALUATE( FreeListDefragmenter::Relocate( &defrag, &copy ) );
+            EVALUATE( copy.start == 0 && copy.size == 64 );
+
+            // blocks that aren't among the handles stay where they are
+            FreeList::Node unmoved = nodes[2];
+
+            EVALUATE( !FreeListDefragmenter::Relocate( &defrag, &unmoved ) );
+            EVALUATE( unmoved.start == 320 );
+
+            for ( size_t i = 0; i < 4; ++i )
+            {
+                FreeList::FreeBlock( &flist, nodes[i] );
+            }
+
+            EVALUATE( flist.used_mem == 0 );
+
+            FreeListDefragmenter::Destroy( &defrag );
+            FreeList::Destroy( &flist );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(RandomCompaction)
+        {
+            CoreContext::DefaultContext();
+
+            const size_t total_mem = 1 << 16;
+            const size_t slot_count = 64;
+
+            Allocator allocator = HeapAllocator::Create();
+
+            FreeList flist;
+            FreeList::Create( &flist, 16 , 16, total_mem, allocator );
+
+            FreeListDefragmenter defrag;
+            FreeListDefragmenter::Create( &defrag, 8, allocator );
+
+            // simulated buffer , every block is filled with its slot so the moves can be checked by copying them
+            uint8_t *memory = (uint8_t*) ALLOC( allocator, total_mem );
+            CoreContext::mem_init( memory, total_mem );
+
+            FreeList::Node nodes[slot_count] = {};
+            FreeList::Node *handles[slot_count] = {};
+            uint32_t rand = 4242;
+
+            for ( size_t slot = 0; slot < slot_count; ++slot )
+            {
+                rand = rand * 1664525u + 1013904223u;
+                FreeList::AllocBlock( &flist, 1 + ((rand >> 16) % 1'000), &nodes[slot] );
+                CoreContext::mem_set( memory + nodes[slot].start, (int32_t) slot, nodes[slot].size );
+            }
+
+            // free half of them at random
+            size_t handle_count = 0;
+
+            for ( size_t slot = 0; slot < slot_count; ++slot )
+            {
+                rand = rand * 1664525u + 1013904223u;
+
+                if ( (rand >> 16) % 2 == 0 )
+                {
+                    FreeList::FreeBlock( &flist, nodes[slot] );
+                    nodes[slot] = {};
+                    continue;
+                }
+
+                handles[handle_count++] = &nodes[slot];
+            }
+
+            FreeListStats before = FreeList::GetStats( &flist );
+            FreeListDefragmenter::Options options = { 4'096, 4 };
+
+            bool no_overlap = true;
+            size_t step_count = 0;
+
+            while ( FreeListDefragmenter::Step( &defrag, &flist, { handles, handle_count }, options ) != 0 && step_count < 1'000 )
+            {
+                step_count++;
+
+                size_t step_bytes = 0;
+
+                for ( size_t i = 0; i < defrag.moves.size; ++i )
+                {
+                    FreeListMove *move = &defrag.moves.data[i];
+                    step_bytes += move->src.size;
+
+                    // no range of a step overlaps another one , sources and destinations alike
+                    for ( size_t j = 0; j < defrag.moves.size; ++j )
+                    {
+                        FreeList::Node ranges[2] = { defrag.moves.data[j].src, defrag.moves.data[j].dst };
+
+                        for ( size_t r = 0; r < 2; ++r )
+                        {
+                            bool src_clear = (i == j && r == 0) || move->src.start >= ranges[r].start + ranges[r].size || ranges[r].start >= move->src.start + move->src.size;
+                            bool dst_clear = (i == j && r == 1) || move->dst.start >= ranges[r].start + ranges[r].size || ranges[r].start >= move->dst.start + move->dst.size;
+                            no_overlap &= src_clear && dst_clear;
+                        }
+                    }
+
+                    CoreContext::mem_copy( memory + move->src.start, memory + move->dst.start, move->src.size );
+                }
+
+                EVALUATE( defrag.moves.size <= options.max_moves );
+                EVALUATE( step_bytes <= options.max_bytes );
+            }
+
+            EVALUATE( step_count > 0 && step_count < 1'000 );
+            EVALUATE( no_overlap );
+
+            FreeListStats after = FreeList::GetStats( &flist );
+
+            EVALUATE( after.used_mem == before.used_mem );
+            EVALUATE( after.used_block_count == before.used_block_count );
+            EVALUATE( after.largest_free_block > before.largest_free_block );
+
+            // every handle points at its own content
+            bool content_kept = true;
+
+            for ( size_t slot = 0; slot < slot_count; ++slot )
+            {
+                for ( size_t b = 0; b < nodes[slot].size; ++b )
+                {
+                    content_kept &= memory[nodes[slot].start + b] == (uint8_t) slot;
+                }
+            }
+
+            EVALUATE( content_kept );
+
+            for ( size_t i = 0; i < handle_count; ++i )
+            {
+                FreeList::FreeBlock( &flist, *handles[i] );
+            }
+
+            EVALUATE( flist.used_mem == 0 );
+            EVALUATE( FreeList::GetStats( &flist ).free_block_count == 1 );
+
+            FREE( allocator, memory );
+            FreeListDefragmenter::Destroy( &defrag );
+            FreeList::Destroy( &flist );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(4 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , FreeListDefragmenterTests::CompactsToFront);
+            DArray<TestCallback>::Add(&arr , FreeListDefragmenterTests::BoundedSteps);
+            DArray<TestCallback>::Add(&arr , FreeListDefragmenterTests::RelocationTable);
+            DArray<TestCallback>::Add(&arr , FreeListDefragmenterTests::RandomCompaction);
+
+            return arr;
+        }
+    };
+}
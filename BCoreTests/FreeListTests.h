@@ -45,10 +45,12 @@ namespace Tests
             EVALUATE( node.size == claim_size );
             EVALUATE( node.start == 0 );
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == claim_size );
-            EVALUATE( flist.used_nodes.size == 1 );
-            EVALUATE( flist.free_nodes.size == 1 );
+            EVALUATE( stats.used_block_count == 1 );
+            EVALUATE( stats.free_block_count == 1 );
 
             FreeList::Destroy( &flist );
 
@@ -76,10 +78,12 @@ namespace Tests
                 FreeList::AllocBlock( &flist, claim_size, &node[i] );
             }
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == claim_size * alloc_count );
-            EVALUATE( flist.used_nodes.size == alloc_count );
-            EVALUATE( flist.free_nodes.size == 0 );
+            EVALUATE( stats.used_block_count == alloc_count );
+            EVALUATE( stats.free_block_count == 0 );
 
             FreeList::Destroy( &flist );
             
@@ -109,10 +113,12 @@ namespace Tests
             FreeList::FreeBlock( &flist, FreeList::Node{ 32 ,32 } );
             FreeList::FreeBlock( &flist, FreeList::Node{ 0 , 32 } );
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == claim_size * (alloc_count - 2) );
-            EVALUATE( flist.used_nodes.size == (alloc_count - 2) );
-            EVALUATE( flist.free_nodes.size == 1 );
+            EVALUATE( stats.used_block_count == (alloc_count - 2) );
+            EVALUATE( stats.free_block_count == 1 );
 
             FreeList::Destroy( &flist );
             
@@ -142,10 +148,12 @@ namespace Tests
             FreeList::FreeBlock( &flist, FreeList::Node{ 32 ,32 } );
             FreeList::FreeBlock( &flist, FreeList::Node{ 64 ,32 } );
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == claim_size * (alloc_count - 2) );
-            EVALUATE( flist.used_nodes.size == (alloc_count - 2) );
-            EVALUATE( flist.free_nodes.size == 1 );
+            EVALUATE( stats.used_block_count == (alloc_count - 2) );
+            EVALUATE( stats.free_block_count == 1 );
 
             FreeList::Destroy( &flist );
             
@@ -176,10 +184,12 @@ namespace Tests
             FreeList::FreeBlock( &flist, FreeList::Node{ 128 ,32 } );
             FreeList::FreeBlock( &flist, FreeList::Node{ 64 ,32 } );
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == claim_size * (alloc_count - 3) );
-            EVALUATE( flist.used_nodes.size == (alloc_count - 3) );
-            EVALUATE( flist.free_nodes.size == 2 );
+            EVALUATE( stats.used_block_count == (alloc_count - 3) );
+            EVALUATE( stats.free_block_count == 2 );
 
             FreeList::Destroy( &flist );
         
@@ -209,10 +219,12 @@ namespace Tests
             FreeList::FreeBlock( &flist, FreeList::Node{ 64 ,32 } );
             FreeList::FreeBlock( &flist, FreeList::Node{ 128 ,32 } );
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == claim_size * (alloc_count - 2) );
-            EVALUATE( flist.used_nodes.size == (alloc_count - 2) );
-            EVALUATE( flist.free_nodes.size == 2 );
+            EVALUATE( stats.used_block_count == (alloc_count - 2) );
+            EVALUATE( stats.free_block_count == 2 );
 
             FreeList::Destroy( &flist );
         
@@ -242,10 +254,12 @@ namespace Tests
             FreeList::FreeBlock( &flist, FreeList::Node{ 64 ,32 } );
             FreeList::FreeBlock( &flist, FreeList::Node{ 32 ,32 } );
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == claim_size * (alloc_count - 2) );
-            EVALUATE( flist.used_nodes.size == (alloc_count - 2) );
-            EVALUATE( flist.free_nodes.size == 1 );
+            EVALUATE( stats.used_block_count == (alloc_count - 2) );
+            EVALUATE( stats.free_block_count == 1 );
 
             FreeList::Destroy( &flist );
 
@@ -278,10 +292,12 @@ namespace Tests
                 FreeList::FreeBlock( &flist, node[alloc_count - i - 1] );
             }
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == 0 );
-            EVALUATE( flist.used_nodes.size == 0 );
-            EVALUATE( flist.free_nodes.size == 1 );
+            EVALUATE( stats.used_block_count == 0 );
+            EVALUATE( stats.free_block_count == 1 );
 
             FreeList::Destroy( &flist );
 
@@ -313,16 +329,231 @@ namespace Tests
                 FreeList::FreeBlock( &flist, node[i] );
             }
 
+            FreeListStats stats = FreeList::GetStats( &flist );
+
             EVALUATE( flist.total_mem == total_mem );
             EVALUATE( flist.used_mem == 0 );
-            EVALUATE( flist.used_nodes.size == 0 );
-            EVALUATE( flist.free_nodes.size == 1 );
+            EVALUATE( stats.used_block_count == 0 );
+            EVALUATE( stats.free_block_count == 1 );
 
             FreeList::Destroy( &flist );
         
             TEST_END()
         }
 
+        TEST_DECLARATION(AllocBlockAligned)
+        {
+            CoreContext::DefaultContext();
+
+            FreeList flist;
+
+            Allocator allocator = HeapAllocator::Create();
+            FreeList::Create( &flist, 16 , 8, 4096, allocator );
+
+            FreeList::Node first = {};
+            FreeList::Node aligned = {};
+            FreeList::AllocBlock( &flist, 48, &first );
+            bool allocated = FreeList::AllocBlockAligned( &flist, 100, 256, &aligned );
+
+            EVALUATE( allocated );
+            EVALUATE( aligned.start == 256 );
+            EVALUATE( aligned.size == 112 );
+
+            // the padding between the two is a free block again
+            FreeList::Node padding = {};
+            FreeList::AllocBlock( &flist, 200, &padding );
+
+            EVALUATE( padding.start == 48 );
+
+            FreeListStats stats = FreeList::GetStats( &flist );
+
+            EVALUATE( stats.used_block_count == 3 );
+            EVALUATE( stats.used_mem == 48 + 112 + 208 );
+
+            FreeList::Destroy( &flist );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(AllocBlockAt)
+        {
+            CoreContext::DefaultContext();
+
+            FreeList flist;
+
+            Allocator allocator = HeapAllocator::Create();
+            FreeList::Create( &flist, 16 , 8, 1024, allocator );
+
+            FreeList::Node middle = {};
+            bool allocated = FreeList::AllocBlockAt( &flist, 256, 100, &middle );
+
+            EVALUATE( allocated );
+            EVALUATE( middle.start == 256 );
+            EVALUATE( middle.size == 112 );
+
+            // the free space before and after are still free blocks
+            FreeListStats stats = FreeList::GetStats( &flist );
+
+            EVALUATE( stats.used_block_count == 1 );
+            EVALUATE( stats.free_block_count == 2 );
+
+            // over a used block , across the end or past the end
+            FreeList::Node node = {};
+
+            EVALUATE( !FreeList::AllocBlockAt( &flist, 240, 32, &node ) );
+            EVALUATE( !FreeList::AllocBlockAt( &flist, 256, 16, &node ) );
+            EVALUATE( !FreeList::AllocBlockAt( &flist, 1008, 32, &node ) );
+            EVALUATE( !FreeList::AllocBlockAt( &flist, 2048, 16, &node ) );
+
+            EVALUATE( FreeList::AllocBlockAt( &flist, 0, 256, &node ) );
+            EVALUATE( FreeList::AllocBlockAt( &flist, 368, 656, &node ) );
+
+            stats = FreeList::GetStats( &flist );
+
+            EVALUATE( stats.free_mem == 0 );
+            EVALUATE( stats.free_block_count == 0 );
+
+            FreeList::FreeBlock( &flist, middle );
+
+            stats = FreeList::GetStats( &flist );
+
+            EVALUATE( stats.free_block_count == 1 );
+            EVALUATE( stats.largest_free_block == 112 );
+
+            FreeList::Destroy( &flist );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(FragmentationStats)
+        {
+            CoreContext::DefaultContext();
+
+            FreeList flist;
+
+            Allocator allocator = HeapAllocator::Create();
+            FreeList::Create( &flist, 1 , 32, 1024, allocator );
+
+            const size_t alloc_count = 16;
+            FreeList::Node node[alloc_count] = {};
+
+            for ( size_t i = 0; i < alloc_count; ++i )
+            {
+                FreeList::AllocBlock( &flist, 64, &node[i] );
+            }
+
+            FreeListStats full = FreeList::GetStats( &flist );
+
+            EVALUATE( full.free_mem == 0 );
+            EVALUATE( full.largest_free_block == 0 );
+            EVALUATE( full.fragmentation == 0.0f );
+
+            // every other block , 8 holes of 64 bytes
+            for ( size_t i = 0; i < alloc_count; i += 2 )
+            {
+                FreeList::FreeBlock( &flist, node[i] );
+            }
+
+            FreeListStats holes = FreeList::GetStats( &flist );
+            FreeList::Node big = {};
+
+            EVALUATE( holes.free_mem == 512 );
+            EVALUATE( holes.free_block_count == 8 );
+            EVALUATE( holes.largest_free_block == 64 );
+            EVALUATE( holes.fragmentation > 0.8f );
+            EVALUATE( !FreeList::AllocBlock( &flist, 128, &big ) );
+
+            // the rest , everything merges back
+            for ( size_t i = 1; i < alloc_count; i += 2 )
+            {
+                FreeList::FreeBlock( &flist, node[i] );
+            }
+
+            FreeListStats empty = FreeList::GetStats( &flist );
+
+            EVALUATE( empty.free_block_count == 1 );
+            EVALUATE( empty.largest_free_block == 1024 );
+            EVALUATE( empty.fragmentation == 0.0f );
+
+            FreeList::Destroy( &flist );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(RandomAllocFree)
+        {
+            CoreContext::DefaultContext();
+
+            const size_t total_mem = 1 << 20;
+            const size_t slot_count = 256;
+
+            FreeList flist;
+
+            Allocator allocator = HeapAllocator::Create();
+            FreeList::Create( &flist, 16 , 16, total_mem, allocator );
+
+            FreeList::Node nodes[slot_count] = {};
+            bool live[slot_count] = {};
+            uint32_t rand = 12345;
+            bool no_overlap = true;
+            bool in_range = true;
+
+            for ( size_t step = 0; step < 20'000; ++step )
+            {
+                rand = rand * 1664525u + 1013904223u;
+                size_t slot = (rand >> 8) % slot_count;
+
+                if ( live[slot] )
+                {
+                    FreeList::FreeBlock( &flist, nodes[slot] );
+                    live[slot] = false;
+                    continue;
+                }
+
+                size_t size = 1 + ((rand >> 16) % 8'000);
+
+                if ( !FreeList::AllocBlock( &flist, size, &nodes[slot] ) )
+                {
+                    continue;
+                }
+
+                live[slot] = true;
+                in_range &= nodes[slot].size >= size && nodes[slot].start + nodes[slot].size <= total_mem;
+
+                for ( size_t i = 0; i < slot_count; ++i )
+                {
+                    if ( i == slot || !live[i] )
+                    {
+                        continue;
+                    }
+
+                    no_overlap &= nodes[slot].start >= nodes[i].start + nodes[i].size || nodes[i].start >= nodes[slot].start + nodes[slot].size;
+                }
+            }
+
+            EVALUATE( no_overlap );
+            EVALUATE( in_range );
+
+            for ( size_t i = 0; i < slot_count; ++i )
+            {
+                if ( live[i] )
+                {
+                    FreeList::FreeBlock( &flist, nodes[i] );
+                }
+            }
+
+            FreeListStats stats = FreeList::GetStats( &flist );
+
+            EVALUATE( flist.used_mem == 0 );
+            EVALUATE( stats.used_block_count == 0 );
+            EVALUATE( stats.free_block_count == 1 );
+            EVALUATE( stats.largest_free_block == total_mem );
+
+            FreeList::Destroy( &flist );
+
+            TEST_END()
+        }
+
         static inline DArray<TestCallback> GetAll() 
         {
             Allocator alloc = HeapAllocator::Create();
@@ -339,6 +570,10 @@ namespace Tests
             DArray<TestCallback>::Add(&arr , FreeListTests::MultipleAllocBlockAndAFree);
             DArray<TestCallback>::Add(&arr , FreeListTests::MultipleAllocBlockAndAFreeOrdered);
             DArray<TestCallback>::Add(&arr , FreeListTests::MultipleAllocBlockAndAFreeReverseOrder);
+            DArray<TestCallback>::Add(&arr , FreeListTests::AllocBlockAligned);
+            DArray<TestCallback>::Add(&arr , FreeListTests::AllocBlockAt);
+            DArray<TestCallback>::Add(&arr , FreeListTests::FragmentationStats);
+            DArray<TestCallback>::Add(&arr , FreeListTests::RandomAllocFree);
 
             return arr;
         }; 
@@ -26,22 +26,22 @@ namespace Tests
             size_t capacity = 10;
             size_t size = 5;
 
-            HMap<int, float> map = {};
+            FuncHMap<int, float> map = {};
 
             Allocator allocator = HeapAllocator::Create();
-            HMap<int, float>::Create( &map, allocator, capacity, IntHasher, IntComparer );
+            FuncHMap<int, float>::Create( &map, allocator, capacity, IntHasher, IntComparer );
 
             for ( size_t i = 0; i < size; ++i )
             {
                 int as_int = (int) i;
                 size_t out_idx = {};
-                HMap<int, float>::TryAdd( &map, as_int, 420.0f + i, &out_idx );
+                FuncHMap<int, float>::TryAdd( &map, as_int, 420.0f + i, &out_idx );
             }
 
             DArray<Pair<int, float>> result = {};
             DArray<Pair<int, float>>::Create( map.count, &result, allocator );
 
-            HMap<int, float>::GetAll( &map, &result );
+            FuncHMap<int, float>::GetAll( &map, &result );
 
             EVALUATE( map.capacity == capacity );
             EVALUATE( map.count == size );
@@ -58,22 +58,22 @@ namespace Tests
             size_t start_capacity = 3;
             size_t size = 5;
 
-            HMap<int, float> map = {};
+            FuncHMap<int, float> map = {};
 
             Allocator allocator = HeapAllocator::Create();
-            HMap<int, float>::Create( &map, allocator, start_capacity, IntHasher, IntComparer );
+            FuncHMap<int, float>::Create( &map, allocator, start_capacity, IntHasher, IntComparer );
 
             for ( size_t i = 0; i < size; ++i )
             {
                 int as_int = (int) i;
                 size_t out_idx = {};
-                HMap<int, float>::TryAdd( &map, as_int, 420.0f + i, &out_idx );
+                FuncHMap<int, float>::TryAdd( &map, as_int, 420.0f + i, &out_idx );
             }
 
             DArray<Pair<int, float>> result = {};
             DArray<Pair<int, float>>::Create( map.count, &result, allocator );
 
-            HMap<int, float>::GetAll( &map, &result );
+            FuncHMap<int, float>::GetAll( &map, &result );
 
             EVALUATE( map.capacity > start_capacity );
             EVALUATE( map.count == size );
@@ -91,24 +91,24 @@ namespace Tests
             size_t capacity = 10;
             size_t size = 5;
 
-            HMap<int, float> map = {};
+            FuncHMap<int, float> map = {};
 
             Allocator allocator = HeapAllocator::Create();
-            HMap<int, float>::Create( &map, allocator, capacity, IntHasher, IntComparer );
+            FuncHMap<int, float>::Create( &map, allocator, capacity, IntHasher, IntComparer );
 
 
             for ( size_t i = 0; i < size; ++i )
             {
                 int as_int = (int) i;
                 size_t out_idx = {};
-                HMap<int, float>::TryAdd( &map, (int) i, 420.0f + i, &out_idx );
+                FuncHMap<int, float>::TryAdd( &map, (int) i, 420.0f + i, &out_idx );
             }
 
             float* zero_value = {};
-            bool has_zero_key = HMap<int, float>::TryGet( &map, 0, &zero_value );
+            bool has_zero_key = FuncHMap<int, float>::TryGet( &map, 0, &zero_value );
 
             float* six_value = {};
-            bool has_six_key = HMap<int, float>::TryGet( &map, 6, &six_value );
+            bool has_six_key = FuncHMap<int, float>::TryGet( &map, 6, &six_value );
 
             EVALUATE( has_zero_key );
             EVALUATE( !has_six_key );
@@ -129,23 +129,23 @@ namespace Tests
             size_t capacity = 10;
             size_t size = 5;
 
-            HMap<int, float> map = {};
+            FuncHMap<int, float> map = {};
 
             Allocator allocator = HeapAllocator::Create();
-            HMap<int, float>::Create( &map, allocator, capacity, IntHasher, IntComparer );
+            FuncHMap<int, float>::Create( &map, allocator, capacity, IntHasher, IntComparer );
 
 
             for ( size_t i = 0; i < size; ++i )
             {
                 int as_int = (int) i;
                 size_t out_idx = {};
-                HMap<int, float>::TryAdd( &map, 0, 420.0f + i, &out_idx );
+                FuncHMap<int, float>::TryAdd( &map, 0, 420.0f + i, &out_idx );
             }
 
             DArray<Pair<int, float>> result = {};
             DArray<Pair<int, float>>::Create( map.count, &result, allocator );
 
-            HMap<int, float>::GetAll( &map, &result );
+            FuncHMap<int, float>::GetAll( &map, &result );
 
             EVALUATE( map.capacity == capacity );
             EVALUATE( map.count == 1 );
@@ -162,27 +162,27 @@ namespace Tests
             const size_t capacity = 10;
             const size_t size = 5;
 
-            HMap<int, float> map = {};
+            FuncHMap<int, float> map = {};
 
             Allocator allocator = HeapAllocator::Create();
-            HMap<int, float>::Create( &map, allocator, capacity, IntHasher, IntComparer );
+            FuncHMap<int, float>::Create( &map, allocator, capacity, IntHasher, IntComparer );
 
 
             for ( int i = 0; i < size; ++i )
             {
                 size_t out_idx = {};
-                HMap<int, float>::TryAdd( &map,i, 420.0f + i, &out_idx );
+                FuncHMap<int, float>::TryAdd( &map,i, 420.0f + i, &out_idx );
             }
 
             float fifty_removed = {};
             float three_removed = {};
-            bool success_50 = HMap<int, float>::TryRemove( &map, 50, &fifty_removed );
-            bool success_3 = HMap<int, float>::TryRemove( &map, 3, &three_removed );
+            bool success_50 = FuncHMap<int, float>::TryRemove( &map, 50, &fifty_removed );
+            bool success_3 = FuncHMap<int, float>::TryRemove( &map, 3, &three_removed );
 
             DArray<Pair<int, float>> result = {};
             DArray<Pair<int, float>>::Create( map.count, &result, allocator );
 
-            HMap<int, float>::GetAll( &map, &result );    
+            FuncHMap<int, float>::GetAll( &map, &result );    
 
             EVALUATE( map.capacity == capacity );
             EVALUATE( map.count == 4 );
@@ -192,7 +192,127 @@ namespace Tests
             TEST_END()
         }
 
-        static inline DArray<TestCallback> GetAll() 
+        TEST_DECLARATION(TryGetAfterRemove)
+        {
+            CoreContext::DefaultContext();
+
+            const int size = 2000;
+
+            HMap<int, float> map = {};
+
+            Allocator allocator = HeapAllocator::Create();
+            HMap<int, float>::Create( &map, allocator, 8 );
+
+            for ( int i = 0; i < size; ++i )
+            {
+                HMap<int, float>::TryAdd( &map, i, (float) i, nullptr );
+            }
+
+            // remove every third key , the remaining entries get moved around in the table and in the dense arrays
+            for ( int i = 0; i < size; i += 3 )
+            {
+                float removed = {};
+                bool success = HMap<int, float>::TryRemove( &map, i, &removed );
+
+                EVALUATE( success );
+                EVALUATE( removed == (float) i );
+            }
+
+            for ( int i = 0; i < size; ++i )
+            {
+                float* value = {};
+                bool found = HMap<int, float>::TryGet( &map, i, &value );
+
+                EVALUATE( found == ((i % 3) != 0) );
+                EVALUATE( !found || *value == (float) i );
+            }
+
+            EVALUATE( map.count == size - ((size + 2) / 3) );
+            EVALUATE( map.all_keys.size == map.count );
+
+            HMap<int, float>::Destroy( &map );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(AddAfterRemove)
+        {
+            CoreContext::DefaultContext();
+
+            HMap<int, float> map = {};
+
+            Allocator allocator = HeapAllocator::Create();
+            HMap<int, float>::Create( &map, allocator, 10 );
+
+            // keep adding and removing so that the slots get reused without ever growing the map
+            for ( int round = 0; round < 100; ++round )
+            {
+                for ( int i = 0; i < 10; ++i )
+                {
+                    bool added = HMap<int, float>::TryAdd( &map, round * 10 + i, (float) round, nullptr );
+                    EVALUATE( added );
+                }
+
+                for ( int i = 0; i < 10; ++i )
+                {
+                    float removed = {};
+                    bool success = HMap<int, float>::TryRemove( &map, round * 10 + i, &removed );
+                    EVALUATE( success );
+                }
+            }
+
+            float* value = {};
+            bool found = HMap<int, float>::TryGet( &map, 0, &value );
+
+            EVALUATE( map.count == 0 );
+            EVALUATE( map.capacity == 10 );
+            EVALUATE( !found );
+
+            HMap<int, float>::Destroy( &map );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(StringViewKeys)
+        {
+            CoreContext::DefaultContext();
+
+            HMap<StringView, int> map = {};
+
+            Allocator allocator = HeapAllocator::Create();
+            HMap<StringView, int>::Create( &map, allocator, 4 );
+
+            const char* names[] = { "color", "depth", "normal", "albedo", "emission", "position" };
+
+            for ( int i = 0; i < 6; ++i )
+            {
+                HMap<StringView, int>::TryAdd( &map, StringView( names[i] ), i, nullptr );
+            }
+
+            // same content , different buffer
+            char depth_copy[] = "depth";
+            StringView depth_view = StringView( depth_copy );
+
+            int* depth_value = {};
+            bool has_depth = HMap<StringView, int>::TryGet( &map, depth_view, &depth_value );
+
+            int* missing_value = {};
+            bool has_missing = HMap<StringView, int>::TryGet( &map, StringView( "dept" ), &missing_value );
+
+            bool added_twice = HMap<StringView, int>::TryAdd( &map, depth_view, 42, nullptr );
+
+            EVALUATE( has_depth );
+            EVALUATE( *depth_value == 1 );
+            EVALUATE( !has_missing );
+            EVALUATE( !added_twice );
+            EVALUATE( map.count == 6 );
+
+            HMap<StringView, int>::Destroy( &map );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
         {
             Allocator alloc = HeapAllocator::Create();
             DArray<TestCallback> arr = {};
@@ -203,6 +323,9 @@ namespace Tests
             DArray<TestCallback>::Add(&arr , HMapTests::TryGet);
             DArray<TestCallback>::Add(&arr , HMapTests::TryAdd);
             DArray<TestCallback>::Add(&arr , HMapTests::TryRemove);
+            DArray<TestCallback>::Add(&arr , HMapTests::TryGetAfterRemove);
+            DArray<TestCallback>::Add(&arr , HMapTests::AddAfterRemove);
+            DArray<TestCallback>::Add(&arr , HMapTests::StringViewKeys);
 
             return arr;
         };
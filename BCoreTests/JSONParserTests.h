@@ -0,0 +1,223 @@
+#pragma once
+
+#include <stdio.h>
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Allocators/Allocator.h>
+#include <String/StringUtils.h>
+#include <Serialization/JSONParser.h>
+
+namespace Tests
+{
+    struct JSONParserTests
+    {
+        TEST_DECLARATION(ParsesDocument)
+        {
+            CoreContext::DefaultContext();
+
+            Arena arena = Arena::Create( 4'096 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            StringView json = R"json(
+            {
+                "name" : "scene",
+                "version": 3,
+                "scale": -1.5e2,
+                "visible": true,
+                "parent": null,
+                "tags": [ "a", "b,c", "{not : an object}" ],
+                "child": { "quote": "say \"hi\"", "empty": {}, "list": [] }
+            }
+            )json";
+
+            JSONNode root = {};
+            bool parsed = JSONParser::Parse( json, &root, alloc );
+
+            EVALUATE( parsed );
+            EVALUATE( root.node_type == JSONNodeType::Object );
+            EVALUATE( root.sub_nodes.size == 7 );
+
+            JSONNode* nodes = root.sub_nodes.data;
+
+            bool name_ok = StringUtils::Compare( nodes[0].name, "name" ) && StringUtils::Compare( nodes[0].value, "scene" );
+            bool version_ok = nodes[1].node_type == JSONNodeType::Integer && StringUtils::Compare( nodes[1].value, "3" );
+            bool scale_ok = nodes[2].node_type == JSONNodeType::Float && StringUtils::Compare( nodes[2].value, "-1.5e2" );
+            bool visible_ok = nodes[3].node_type == JSONNodeType::Boolean && StringUtils::Compare( nodes[3].value, "true" );
+
+            EVALUATE( name_ok );
+            EVALUATE( version_ok );
+            EVALUATE( scale_ok );
+            EVALUATE( visible_ok );
+            EVALUATE( nodes[4].node_type == JSONNodeType::Null );
+
+            JSONNode* tags = &nodes[5];
+            bool tags_ok = StringUtils::Compare( tags->sub_nodes.data[1].value, "b,c" ) && StringUtils::Compare( tags->sub_nodes.data[2].value, "{not : an object}" );
+
+            EVALUATE( tags->node_type == JSONNodeType::Array );
+            EVALUATE( tags->sub_nodes.size == 3 );
+            EVALUATE( tags_ok );
+
+            JSONNode* child = &nodes[6];
+            bool quote_ok = StringUtils::Compare( child->sub_nodes.data[0].value, "say \\\"hi\\\"" );
+
+            EVALUATE( child->sub_nodes.size == 3 );
+            EVALUATE( quote_ok );
+            EVALUATE( child->sub_nodes.data[1].node_type == JSONNodeType::Object );
+            EVALUATE( child->sub_nodes.data[1].sub_nodes.size == 0 );
+            EVALUATE( child->sub_nodes.data[2].node_type == JSONNodeType::Array );
+            EVALUATE( child->sub_nodes.data[2].sub_nodes.size == 0 );
+
+            // values are views into the source
+            EVALUATE( nodes[0].value.buffer > json.buffer );
+            EVALUATE( nodes[0].value.buffer < json.buffer + json.length );
+
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(EscapeAcrossBlocks)
+        {
+            CoreContext::DefaultContext();
+
+            Arena arena = Arena::Create( 4'096 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            // the backslash is the last byte of the first 64 bytes block and escapes the first quote of the next one
+            char buffer[128] = {};
+            size_t length = 0;
+
+            length += snprintf( buffer, sizeof( buffer ), "{\"k\":\"" );
+
+            while ( length < JSONStructuralIndex::BLOCK_SIZE - 1 )
+            {
+                buffer[length++] = 'a';
+            }
+
+            length += snprintf( buffer + length, sizeof( buffer ) - length, "\\\"x\" , \"n\" : [1] }" );
+
+            StringView json = {};
+            json.buffer = buffer;
+            json.length = length;
+
+            JSONNode root = {};
+            bool parsed = JSONParser::Parse( json, &root, alloc );
+
+            EVALUATE( parsed );
+            EVALUATE( root.sub_nodes.size == 2 );
+            // 'a's up to the backslash , then \"x
+            EVALUATE( root.sub_nodes.data[0].value.length == JSONStructuralIndex::BLOCK_SIZE - 1 - 6 + 3 );
+            EVALUATE( root.sub_nodes.data[1].sub_nodes.size == 1 );
+
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(LargeArray)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator heap = HeapAllocator::Create();
+            Arena arena = Arena::Create( 64 * 1'024 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            const size_t count = 10'000;
+
+            DArray<char> text = {};
+            DArray<char>::Create( count * 16, &text, heap );
+            DArray<char>::Add( &text, '[' );
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                char number[32] = {};
+                int written = snprintf( number, sizeof( number ), i == 0 ? "%zu" : ",\n\t%zu", i );
+
+                for ( int c = 0; c < written; ++c )
+                {
+                    DArray<char>::Add( &text, number[c] );
+                }
+            }
+
+            DArray<char>::Add( &text, ']' );
+
+            StringView json = {};
+            json.buffer = text.data;
+            json.length = text.size;
+
+            JSONNode root = {};
+            bool parsed = JSONParser::Parse( json, &root, alloc );
+
+            EVALUATE( parsed );
+            EVALUATE( root.sub_nodes.size == count );
+
+            bool all_ok = true;
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                char number[32] = {};
+                snprintf( number, sizeof( number ), "%zu", i );
+
+                all_ok &= StringUtils::Compare( root.sub_nodes.data[i].value, number );
+            }
+
+            EVALUATE( all_ok );
+
+            DArray<char>::Destroy( &text );
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(RejectsMalformed)
+        {
+            CoreContext::DefaultContext();
+
+            Arena arena = Arena::Create( 4'096 );
+            Allocator alloc = ArenaAllocator::Create( &arena );
+
+            const char* inputs[] =
+            {
+                "",
+                "{\"a\":1,}",
+                "[1 2]",
+                "{\"a\" 1}",
+                "{\"a\":tru}",
+                "\"unterminated",
+                "[1,[2]",
+                "{} {}",
+                "01x",
+                "[1.]",
+                "{a:1}",
+            };
+
+            bool any_parsed = false;
+
+            for ( const char* input : inputs )
+            {
+                JSONNode root = {};
+                any_parsed |= JSONParser::Parse( input, &root, alloc );
+            }
+
+            EVALUATE( !any_parsed );
+
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(4 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , JSONParserTests::ParsesDocument);
+            DArray<TestCallback>::Add(&arr , JSONParserTests::EscapeAcrossBlocks);
+            DArray<TestCallback>::Add(&arr , JSONParserTests::LargeArray);
+            DArray<TestCallback>::Add(&arr , JSONParserTests::RejectsMalformed);
+
+            return arr;
+        };
+    };
+}
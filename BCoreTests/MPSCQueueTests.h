@@ -0,0 +1,147 @@
+#pragma once
+
+#include <thread>
+#include <Testing/BTest.h>
+#include <Containers/MPSCQueue.h>
+#include <Allocators/Allocator.h>
+
+namespace Tests
+{
+    struct MPSCQueueTests
+    {
+        TEST_DECLARATION(FifoAndFull)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator alloc = HeapAllocator::Create();
+            MPSCQueue<uint32_t> queue = {};
+            MPSCQueue<uint32_t>::Create( &queue, 8, alloc );
+
+            uint32_t out = 0;
+            EVALUATE( !MPSCQueue<uint32_t>::TryDequeue( &queue, &out ) );
+
+            // a few laps around the cells
+            bool in_order = true;
+
+            for ( uint32_t lap = 0; lap < 3; ++lap )
+            {
+                for ( uint32_t i = 0; i < 8; ++i )
+                {
+                    in_order &= MPSCQueue<uint32_t>::TryEnqueue( &queue, lap * 8 + i );
+                }
+
+                in_order &= !MPSCQueue<uint32_t>::TryEnqueue( &queue, 99 );
+
+                for ( uint32_t i = 0; i < 8; ++i )
+                {
+                    in_order &= MPSCQueue<uint32_t>::TryDequeue( &queue, &out ) && out == lap * 8 + i;
+                }
+            }
+
+            EVALUATE( in_order );
+
+            // a reserved cell holds back the ones published after it
+            int64_t first = 0;
+            int64_t second = 0;
+            uint32_t* first_cell = MPSCQueue<uint32_t>::TryReserve( &queue, &first );
+            uint32_t* second_cell = MPSCQueue<uint32_t>::TryReserve( &queue, &second );
+            *second_cell = 2;
+            MPSCQueue<uint32_t>::Publish( &queue, second );
+
+            EVALUATE( MPSCQueue<uint32_t>::TryPeek( &queue ) == nullptr );
+
+            *first_cell = 1;
+            MPSCQueue<uint32_t>::Publish( &queue, first );
+
+            EVALUATE( MPSCQueue<uint32_t>::TryDequeue( &queue, &out ) && out == 1 );
+            EVALUATE( MPSCQueue<uint32_t>::TryDequeue( &queue, &out ) && out == 2 );
+            EVALUATE( MPSCQueue<uint32_t>::PoppedCount( &queue ) == MPSCQueue<uint32_t>::ReservedCount( &queue ) );
+
+            MPSCQueue<uint32_t>::Destroy( &queue );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ManyProducers)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator alloc = HeapAllocator::Create();
+            MPSCQueue<uint64_t> queue = {};
+            // much smaller than what goes through , the producers keep hitting a full queue
+            MPSCQueue<uint64_t>::Create( &queue, 64, alloc );
+
+            const uint64_t producer_count = 4;
+            const uint64_t per_producer = 50'000;
+
+            std::thread producers[producer_count];
+
+            for ( uint64_t p = 0; p < producer_count; ++p )
+            {
+                producers[p] = std::thread( [&queue, p]()
+                {
+                    for ( uint64_t i = 0; i < per_producer; ++i )
+                    {
+                        // yields rather than spins , the machine may have fewer cores than threads
+                        while ( !MPSCQueue<uint64_t>::TryEnqueue( &queue, (p << 32) | i ) )
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                } );
+            }
+
+            // every producer's items have to come out in the order it pushed them
+            uint64_t next[producer_count] = {};
+            uint64_t received = 0;
+            bool in_order = true;
+
+            while ( received < producer_count * per_producer )
+            {
+                uint64_t item = 0;
+
+                if ( !MPSCQueue<uint64_t>::TryDequeue( &queue, &item ) )
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                uint64_t p = item >> 32;
+                received++;
+
+                if ( p >= producer_count )
+                {
+                    in_order = false;
+                    continue;
+                }
+
+                in_order &= (item & 0xFFFFFFFF) == next[p];
+                next[p] = (item & 0xFFFFFFFF) + 1;
+            }
+
+            for ( uint64_t p = 0; p < producer_count; ++p )
+            {
+                producers[p].join();
+            }
+
+            EVALUATE( in_order );
+            EVALUATE( MPSCQueue<uint64_t>::TryPeek( &queue ) == nullptr );
+
+            MPSCQueue<uint64_t>::Destroy( &queue );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(2 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , MPSCQueueTests::FifoAndFull);
+            DArray<TestCallback>::Add(&arr , MPSCQueueTests::ManyProducers);
+
+            return arr;
+        };
+    };
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Allocators/Allocator.h>
+#include <Allocators/PoolAllocator.h>
+
+namespace Tests
+{
+    struct PoolAllocatorTests
+    {
+        TEST_DECLARATION(SizeClasses)
+        {
+            EVALUATE( Pool::ClassIndex( 0 ) == 0 );
+            EVALUATE( Pool::ClassIndex( 1 ) == 0 );
+            EVALUATE( Pool::ClassIndex( 16 ) == 0 );
+            EVALUATE( Pool::ClassIndex( 17 ) == 1 );
+            EVALUATE( Pool::ClassIndex( 2048 ) == Pool::CLASS_COUNT - 1 );
+            EVALUATE( Pool::ClassSize( Pool::CLASS_COUNT - 1 ) == Pool::MAX_CLASS_SIZE );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(AllocAndFree)
+        {
+            CoreContext::DefaultContext();
+
+            Pool pool = {};
+            Pool::Create( &pool, 4 * Pool::SLAB_SIZE * Pool::CLASS_COUNT );
+            Allocator alloc = PoolAllocator::Create( &pool );
+
+            const size_t count = 1000;
+            void* ptrs[count] = {};
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                size_t size = 1 + (i * 7) % Pool::MAX_CLASS_SIZE;
+                ptrs[i] = ALLOC( alloc, size );
+                CoreContext::mem_set( ptrs[i], (int32_t) (i & 0xFF), size );
+            }
+
+            bool all_owned = true;
+            bool all_intact = true;
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                size_t size = 1 + (i * 7) % Pool::MAX_CLASS_SIZE;
+                unsigned char* bytes = (unsigned char*) ptrs[i];
+
+                all_owned &= Pool::Owns( &pool, ptrs[i] );
+                all_intact &= bytes[0] == (i & 0xFF) && bytes[size - 1] == (i & 0xFF);
+            }
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                FREE( alloc, ptrs[i] );
+            }
+
+            Pool::FlushThreadCache( &pool );
+            PoolStats stats = Pool::GetStats( &pool );
+
+            EVALUATE( all_owned );
+            EVALUATE( all_intact );
+            EVALUATE( stats.allocation_count == count );
+            EVALUATE( stats.free_count == count );
+            EVALUATE( stats.live_bytes == 0 );
+            EVALUATE( stats.peak_live_bytes > 0 );
+            EVALUATE( stats.committed_bytes > 0 );
+
+            Pool::Destroy( &pool );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(FreedBlocksAreReused)
+        {
+            CoreContext::DefaultContext();
+
+            Pool pool = {};
+            Pool::Create( &pool );
+            Allocator alloc = PoolAllocator::Create( &pool );
+
+            void* first = ALLOC( alloc, 24 );
+            FREE( alloc, first );
+            void* second = ALLOC( alloc, 30 );
+
+            Pool::FlushThreadCache( &pool );
+            PoolStats stats = Pool::GetStats( &pool );
+
+            EVALUATE( first == second );
+            EVALUATE( stats.live_blocks[1] == 1 );
+            EVALUATE( stats.committed_bytes == Pool::SLAB_SIZE );
+
+            Pool::Destroy( &pool );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(Realloc)
+        {
+            CoreContext::DefaultContext();
+
+            Pool pool = {};
+            Pool::Create( &pool );
+            Allocator alloc = PoolAllocator::Create( &pool );
+
+            char* ptr = (char*) ALLOC( alloc, 20 );
+            CoreContext::mem_set( ptr, 'a', 20 );
+
+            // same class , stays in place
+            char* same = (char*) REALLOC( alloc, ptr, 32 );
+
+            // next class , moves and keeps the content
+            char* moved = (char*) REALLOC( alloc, same, 100 );
+            bool moved_intact = moved[0] == 'a' && moved[19] == 'a';
+
+            // too big for the classes , ends up on the heap
+            char* large = (char*) REALLOC( alloc, moved, 10'000 );
+
+            EVALUATE( same == ptr );
+            EVALUATE( moved != same );
+            EVALUATE( moved_intact );
+            EVALUATE( !Pool::Owns( &pool, large ) );
+            EVALUATE( large[0] == 'a' && large[19] == 'a' );
+
+            PoolStats stats = Pool::GetStats( &pool );
+            EVALUATE( stats.large_allocation_count == 1 );
+
+            FREE( alloc, large );
+
+            stats = Pool::GetStats( &pool );
+            EVALUATE( stats.large_allocation_count == 0 );
+
+            Pool::Destroy( &pool );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ReserveExhausted)
+        {
+            CoreContext::DefaultContext();
+
+            // a single slab , the 2nd class can't get one
+            Pool pool = {};
+            Pool::Create( &pool, Pool::SLAB_SIZE );
+            Allocator alloc = PoolAllocator::Create( &pool );
+
+            void* small = ALLOC( alloc, 16 );
+            void* other = ALLOC( alloc, 64 );
+
+            EVALUATE( Pool::Owns( &pool, small ) );
+            EVALUATE( !Pool::Owns( &pool, other ) );
+
+            FREE( alloc, small );
+            FREE( alloc, other );
+
+            Pool::Destroy( &pool );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(HeapPointersAreNotLarge)
+        {
+            CoreContext::DefaultContext();
+
+            Pool pool = {};
+            Pool::Create( &pool );
+            Allocator alloc = PoolAllocator::Create( &pool );
+
+            // heap memory freed and resized through the pool isn't one of its large blocks
+            void* heap = CoreContext::malloc( 64 );
+            heap = REALLOC( alloc, heap, 128 );
+            FREE( alloc, heap );
+
+            EVALUATE( Pool::GetStats( &pool ).large_allocation_count == 0 );
+
+            // a large block keeps being counted when the heap moves it
+            void* large = ALLOC( alloc, 4'096 );
+            large = REALLOC( alloc, large, 1'000'000 );
+
+            EVALUATE( Pool::GetStats( &pool ).large_allocation_count == 1 );
+
+            FREE( alloc, large );
+
+            EVALUATE( Pool::GetStats( &pool ).large_allocation_count == 0 );
+
+            Pool::Destroy( &pool );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(LivePoolsOwnTheirCache)
+        {
+            CoreContext::DefaultContext();
+
+            Pool pools[Pool::MAX_POOLS + 1] = {};
+            bool distinct = true;
+
+            for ( size_t i = 0; i < Pool::MAX_POOLS + 1; ++i )
+            {
+                Pool::Create( &pools[i], Pool::SLAB_SIZE * Pool::CLASS_COUNT );
+
+                for ( size_t j = 0; j < i && i < Pool::MAX_POOLS; ++j )
+                {
+                    distinct &= pools[i].cache_index != pools[j].cache_index;
+                }
+            }
+
+            EVALUATE( distinct );
+
+            // switching between two pools on one thread keeps both caches
+            Allocator first = PoolAllocator::Create( &pools[0] );
+            Allocator second = PoolAllocator::Create( &pools[1] );
+
+            void* a = ALLOC( first, 32 );
+            void* b = ALLOC( second, 32 );
+            FREE( first, a );
+            FREE( second, b );
+
+            EVALUATE( ALLOC( first, 32 ) == a );
+            EVALUATE( ALLOC( second, 32 ) == b );
+
+            // no slot left , the last one works from the heap
+            Allocator extra = PoolAllocator::Create( &pools[Pool::MAX_POOLS] );
+            void* c = ALLOC( extra, 32 );
+
+            EVALUATE( pools[Pool::MAX_POOLS].base == nullptr );
+            EVALUATE( !Pool::Owns( &pools[Pool::MAX_POOLS], c ) );
+            EVALUATE( Pool::GetStats( &pools[Pool::MAX_POOLS] ).large_allocation_count == 1 );
+
+            FREE( extra, c );
+
+            for ( size_t i = 0; i < Pool::MAX_POOLS + 1; ++i )
+            {
+                Pool::Destroy( &pools[i] );
+            }
+
+            // the slots are free again
+            Pool pool = {};
+            Pool::Create( &pool );
+
+            EVALUATE( pool.base != nullptr );
+
+            Pool::Destroy( &pool );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(5 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , PoolAllocatorTests::SizeClasses);
+            DArray<TestCallback>::Add(&arr , PoolAllocatorTests::AllocAndFree);
+            DArray<TestCallback>::Add(&arr , PoolAllocatorTests::FreedBlocksAreReused);
+            DArray<TestCallback>::Add(&arr , PoolAllocatorTests::Realloc);
+            DArray<TestCallback>::Add(&arr , PoolAllocatorTests::ReserveExhausted);
+            DArray<TestCallback>::Add(&arr , PoolAllocatorTests::HeapPointersAreNotLarge);
+            DArray<TestCallback>::Add(&arr , PoolAllocatorTests::LivePoolsOwnTheirCache);
+
+            return arr;
+        };
+    };
+}
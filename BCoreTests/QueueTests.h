@@ -147,6 +147,49 @@ namespace Tests
             TEST_END()
         }
         
+        TEST_DECLARATION(ResizeKeepsOrder)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator alloc = HeapAllocator::Create();
+            Queue<int> queue = {};
+            Queue<int>::Create(&queue , 4 , alloc);
+
+            // full with the indices back at 0 , then wrapped around the end
+            for (int i = 0; i < 4; ++i)
+            {
+                Queue<int>::Enqueue(&queue , i);
+            }
+
+            Queue<int>::Enqueue(&queue , 4);
+            EVALUATE(queue.size == 5);
+
+            int val = {};
+            Queue<int>::Dequeue(&queue , &val);
+            Queue<int>::Dequeue(&queue , &val);
+            EVALUATE(val == 1);
+
+            for (int i = 5; i < 40; ++i)
+            {
+                Queue<int>::Enqueue(&queue , i);
+            }
+
+            bool in_order = true;
+
+            for (int i = 2; i < 40; ++i)
+            {
+                Queue<int>::Dequeue(&queue , &val);
+                in_order &= val == i;
+            }
+
+            EVALUATE(in_order);
+            EVALUATE(queue.size == 0);
+
+            Queue<int>::Destroy(&queue);
+
+            TEST_END()
+        }
+
         static inline DArray<TestCallback> GetAll() 
         {
             Allocator alloc = HeapAllocator::Create();
@@ -156,6 +199,7 @@ namespace Tests
             DArray<TestCallback>::Add(&arr , QueueTests::Create);
             DArray<TestCallback>::Add(&arr , QueueTests::Enqueue);
             DArray<TestCallback>::Add(&arr , QueueTests::EnqueueThenDequeue);
+            DArray<TestCallback>::Add(&arr , QueueTests::ResizeKeepsOrder);
 
             return arr;
         }; 
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Allocators/Allocator.h>
+#include <Allocators/ScratchArena.h>
+#include <String/StringUtils.h>
+
+namespace Tests
+{
+    struct ScratchArenaTests
+    {
+        TEST_DECLARATION(ReleaseRewinds)
+        {
+            CoreContext::DefaultContext();
+
+            ScratchArena scratch = ScratchArena::Get();
+            size_t start_offset = scratch.arena->offset;
+
+            ALLOC( scratch.alloc, 100 );
+            ALLOC( scratch.alloc, 100'000 );
+
+            EVALUATE( scratch.arena->chain != nullptr );
+
+            ScratchArena::Release( &scratch );
+
+            EVALUATE( scratch.arena->chain == nullptr );
+            EVALUATE( scratch.arena->offset == start_offset );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ConflictPicksTheOtherArena)
+        {
+            CoreContext::DefaultContext();
+
+            ScratchArena outer = ScratchArena::Get();
+            ScratchArena inner = ScratchArena::Get( outer.alloc );
+            ScratchArena unrelated = ScratchArena::Get( HeapAllocator::Create() );
+
+            EVALUATE( inner.arena != outer.arena );
+            EVALUATE( unrelated.arena == outer.arena );
+
+            ScratchArena::Release( &unrelated );
+            ScratchArena::Release( &inner );
+            ScratchArena::Release( &outer );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(FormatIntoScratch)
+        {
+            CoreContext::DefaultContext();
+
+            // the result lives in the scratch , the arguments are prepared on the stack
+            ScratchArena outer = ScratchArena::Get();
+            size_t outer_offset = outer.arena->offset;
+
+            StringBuffer str = StringUtils::Format( outer.alloc, "{} and {}", "first", "second" );
+
+            bool same = StringUtils::Compare( str.view, "first and second" );
+
+            EVALUATE( same );
+            EVALUATE( outer.arena->offset > outer_offset );
+
+            ScratchArena::Release( &outer );
+
+            EVALUATE( outer.arena->offset == outer_offset );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(3 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , ScratchArenaTests::ReleaseRewinds);
+            DArray<TestCallback>::Add(&arr , ScratchArenaTests::ConflictPicksTheOtherArena);
+            DArray<TestCallback>::Add(&arr , ScratchArenaTests::FormatIntoScratch);
+
+            return arr;
+        };
+    };
+}
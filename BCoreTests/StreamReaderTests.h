@@ -0,0 +1,400 @@
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Allocators/Allocator.h>
+#include <String/StringUtils.h>
+#include <Serialization/JSONStreamReader.h>
+#include <Serialization/XMLStreamReader.h>
+
+namespace Tests
+{
+    struct StreamReaderTests
+    {
+        static constexpr size_t CHUNK_SIZES[] = { 1, 2, 3, 7, 16, 64, 4'096 };
+
+        static void Log( void* log, StringView text )
+        {
+            ArrayView<char> chars = {};
+            chars.data = (char*) text.buffer;
+            chars.size = text.length;
+
+            DArray<char>::AddRange( (DArray<char>*) log, chars );
+        }
+
+        static void OnBeginObject( void* log ) { Log( log, "{" ); }
+        static void OnEndObject( void* log ) { Log( log, "}" ); }
+        static void OnBeginArray( void* log ) { Log( log, "[" ); }
+        static void OnEndArray( void* log ) { Log( log, "]" ); }
+
+        static void OnKey( void* log, StringView key )
+        {
+            Log( log, "k:" );
+            Log( log, key );
+            Log( log, ";" );
+        }
+
+        static void OnValue( void* log, JSONNodeType type, StringView value )
+        {
+            char prefix[8] = {};
+            snprintf( prefix, sizeof( prefix ), "v%d:", (int) type );
+
+            Log( log, prefix );
+            Log( log, value );
+            Log( log, ";" );
+        }
+
+        static void OnBeginElement( void* log, StringView name )
+        {
+            Log( log, "<" );
+            Log( log, name );
+            Log( log, ";" );
+        }
+
+        static void OnAttribute( void* log, StringView name, StringView value )
+        {
+            Log( log, "@" );
+            Log( log, name );
+            Log( log, "=" );
+            Log( log, value );
+            Log( log, ";" );
+        }
+
+        static void OnText( void* log, StringView text )
+        {
+            Log( log, "t:" );
+            Log( log, text );
+            Log( log, ";" );
+        }
+
+        static void OnEndElement( void* log, StringView name )
+        {
+            Log( log, ">" );
+            Log( log, name );
+            Log( log, ";" );
+        }
+
+        /// <summary>
+        /// Feeds "doc" "chunk_size" bytes at a time through a buffer that gets overwritten after each chunk , like a file read
+        /// </summary>
+        template<typename TReader, typename TCallbacks>
+        static bool Stream( StringView doc, size_t chunk_size, TCallbacks callbacks, size_t max_token_size, DArray<char>* out_log )
+        {
+            Allocator alloc = HeapAllocator::Create();
+
+            out_log->size = 0;
+            callbacks.user_data = out_log;
+
+            TReader reader = {};
+            TReader::Create( &reader, callbacks, alloc, max_token_size );
+
+            char buffer[4'096] = {};
+            bool is_valid = true;
+
+            for ( size_t offset = 0; offset < doc.length && is_valid; offset += chunk_size )
+            {
+                size_t size = doc.length - offset < chunk_size ? doc.length - offset : chunk_size;
+                memcpy( buffer, doc.buffer + offset, size );
+
+                StringView chunk = {};
+                chunk.buffer = buffer;
+                chunk.length = size;
+
+                is_valid = TReader::Feed( &reader, chunk );
+                memset( buffer, '#', size );
+            }
+
+            is_valid = is_valid && TReader::Finish( &reader );
+
+            TReader::Destroy( &reader );
+
+            return is_valid;
+        }
+
+        static JSONStreamCallbacks JSONLogCallbacks()
+        {
+            JSONStreamCallbacks callbacks = {};
+            callbacks.begin_object = OnBeginObject;
+            callbacks.end_object = OnEndObject;
+            callbacks.begin_array = OnBeginArray;
+            callbacks.end_array = OnEndArray;
+            callbacks.key = OnKey;
+            callbacks.value = OnValue;
+
+            return callbacks;
+        }
+
+        static XMLStreamCallbacks XMLLogCallbacks()
+        {
+            XMLStreamCallbacks callbacks = {};
+            callbacks.begin_element = OnBeginElement;
+            callbacks.attribute = OnAttribute;
+            callbacks.text = OnText;
+            callbacks.end_element = OnEndElement;
+
+            return callbacks;
+        }
+
+        TEST_DECLARATION(JSONAnyChunking)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            StringView json = R"json(
+            {
+                "name" : "scene",
+                "version": 3,
+                "scale": -1.5e2,
+                "flags": [ true, false, null ],
+                "quote": "say \"hi\" \\",
+                "child": { "empty": {}, "list": [[], [1]] }
+            }
+            )json";
+
+            StringView expected =
+                "{k:name;v1:scene;k:version;v3:3;k:scale;v4:-1.5e2;"
+                "k:flags;[v5:true;v5:false;v6:null;]"
+                "k:quote;v1:say \\\"hi\\\" \\\\;"
+                "k:child;{k:empty;{}k:list;[[][v3:1;]]}}";
+
+            DArray<char> log = {};
+            DArray<char>::Create( 256, &log, alloc, false );
+
+            bool all_valid = true;
+            bool all_match = true;
+
+            for ( size_t chunk_size : CHUNK_SIZES )
+            {
+                all_valid &= Stream<JSONStreamReader>( json, chunk_size, JSONLogCallbacks(), 64, &log );
+
+                StringView result = {};
+                result.buffer = log.data;
+                result.length = log.size;
+
+                all_match &= StringUtils::Compare( result, expected );
+            }
+
+            EVALUATE( all_valid );
+            EVALUATE( all_match );
+
+            // a root scalar only ends with the input
+            bool scalar_valid = Stream<JSONStreamReader>( " 12.5", 2, JSONLogCallbacks(), 64, &log );
+
+            StringView scalar_log = {};
+            scalar_log.buffer = log.data;
+            scalar_log.length = log.size;
+
+            bool scalar_ok = scalar_valid && StringUtils::Compare( scalar_log, "v4:12.5;" );
+
+            EVALUATE( scalar_ok );
+
+            DArray<char>::Destroy( &log );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(JSONRejectsMalformed)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            const char* inputs[] =
+            {
+                "",
+                "{\"a\":1,}",
+                "[1 2]",
+                "{\"a\" 1}",
+                "{\"a\":tru}",
+                "\"unterminated",
+                "[1,[2]",
+                "[1,2}",
+                "{} {}",
+                "01x",
+                "[1.]",
+                "{a:1}",
+                "[\"string longer than the token limit\"]",
+            };
+
+            DArray<char> log = {};
+            DArray<char>::Create( 256, &log, alloc, false );
+
+            bool any_valid = false;
+
+            for ( const char* input : inputs )
+            {
+                any_valid |= Stream<JSONStreamReader>( input, 1, JSONLogCallbacks(), 16, &log );
+                any_valid |= Stream<JSONStreamReader>( input, 4'096, JSONLogCallbacks(), 16, &log );
+            }
+
+            EVALUATE( !any_valid );
+
+            DArray<char>::Destroy( &log );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(JSONBoundedMemory)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            const size_t count = 20'000;
+
+            DArray<char> text = {};
+            DArray<char>::Create( count * 16, &text, alloc );
+            DArray<char>::Add( &text, '[' );
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                char item[32] = {};
+                int written = snprintf( item, sizeof( item ), i == 0 ? "\"%zu\"" : ",\n{\"n\":%zu}", i );
+
+                for ( int c = 0; c < written; ++c )
+                {
+                    DArray<char>::Add( &text, item[c] );
+                }
+            }
+
+            DArray<char>::Add( &text, ']' );
+
+            size_t values = 0;
+
+            JSONStreamCallbacks callbacks = {};
+            callbacks.user_data = &values;
+            callbacks.value = []( void* user_data, JSONNodeType, StringView ) { (*(size_t*) user_data)++; };
+
+            JSONStreamReader reader = {};
+            JSONStreamReader::Create( &reader, callbacks, alloc );
+
+            const size_t chunk_size = 100;
+            bool is_valid = true;
+
+            for ( size_t offset = 0; offset < text.size && is_valid; offset += chunk_size )
+            {
+                StringView chunk = {};
+                chunk.buffer = text.data + offset;
+                chunk.length = text.size - offset < chunk_size ? text.size - offset : chunk_size;
+
+                is_valid = JSONStreamReader::Feed( &reader, chunk );
+            }
+
+            is_valid = is_valid && JSONStreamReader::Finish( &reader );
+
+            EVALUATE( is_valid );
+            EVALUATE( values == count );
+            // the carry never grew past its starting capacity , no token was bigger
+            EVALUATE( reader.token.carry.capacity == 64 );
+
+            JSONStreamReader::Destroy( &reader );
+            DArray<char>::Destroy( &text );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(XMLAnyChunking)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            StringView xml = R"xml(<?xml version="1.0"?>
+            <!-- level -- data > here -->
+            <!DOCTYPE level>
+            <level name="first" size = '3'>
+                <entity id="1"/>
+                <entity id="2" >
+                    some text &amp; more
+                </entity >
+                <!---->
+                <empty></empty>
+            </level>
+            )xml";
+
+            StringView expected =
+                "<level;@name=first;@size=3;"
+                "<entity;@id=1;>entity;"
+                "<entity;@id=2;t:some text &amp; more;>entity;"
+                "<empty;>empty;"
+                ">level;";
+
+            DArray<char> log = {};
+            DArray<char>::Create( 256, &log, alloc, false );
+
+            bool all_valid = true;
+            bool all_match = true;
+
+            for ( size_t chunk_size : CHUNK_SIZES )
+            {
+                all_valid &= Stream<XMLStreamReader>( xml, chunk_size, XMLLogCallbacks(), 64, &log );
+
+                StringView result = {};
+                result.buffer = log.data;
+                result.length = log.size;
+
+                all_match &= StringUtils::Compare( result, expected );
+            }
+
+            EVALUATE( all_valid );
+            EVALUATE( all_match );
+
+            DArray<char>::Destroy( &log );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(XMLRejectsMalformed)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            const char* inputs[] =
+            {
+                "",
+                "text",
+                "<a>",
+                "<a></b>",
+                "<a></a>text",
+                "<a b=c/>",
+                "<a b/>",
+                "<a/ >",
+                "</a>",
+                "<a><!-- unterminated </a>",
+                "<>",
+                "<a>text longer than the token limit</a>",
+            };
+
+            DArray<char> log = {};
+            DArray<char>::Create( 256, &log, alloc, false );
+
+            bool any_valid = false;
+
+            for ( const char* input : inputs )
+            {
+                any_valid |= Stream<XMLStreamReader>( input, 1, XMLLogCallbacks(), 16, &log );
+                any_valid |= Stream<XMLStreamReader>( input, 4'096, XMLLogCallbacks(), 16, &log );
+            }
+
+            EVALUATE( !any_valid );
+
+            DArray<char>::Destroy( &log );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(5 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , StreamReaderTests::JSONAnyChunking);
+            DArray<TestCallback>::Add(&arr , StreamReaderTests::JSONRejectsMalformed);
+            DArray<TestCallback>::Add(&arr , StreamReaderTests::JSONBoundedMemory);
+            DArray<TestCallback>::Add(&arr , StreamReaderTests::XMLAnyChunking);
+            DArray<TestCallback>::Add(&arr , StreamReaderTests::XMLRejectsMalformed);
+
+            return arr;
+        };
+    };
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <stdio.h>
+#include <thread>
+#include <Testing/BTest.h>
+#include <Allocators/Allocator.h>
+#include <String/StringInterner.h>
+#include <String/StringUtils.h>
+
+namespace Tests
+{
+    struct StringInternerTests
+    {
+        TEST_DECLARATION(InternAndLookup)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            StringInterner interner = {};
+            StringInterner::Create( &interner, alloc, 4 );
+
+            StringID color = StringInterner::Intern( &interner, "Color attachment ID" );
+            StringID depth = StringInterner::Intern( &interner, "Depth attachment ID" );
+
+            EVALUATE( color != StringInterner::INVALID_ID );
+            EVALUATE( depth != StringInterner::INVALID_ID );
+            EVALUATE( color != depth );
+
+            // same text from another buffer , same id
+            char copy[] = "Color attachment ID";
+            EVALUATE( StringInterner::Intern( &interner, copy ) == color );
+            EVALUATE( StringInterner::Find( &interner, copy ) == color );
+            EVALUATE( StringInterner::Find( &interner, "Stencil attachment ID" ) == StringInterner::INVALID_ID );
+            EVALUATE( StringInterner::Count( &interner ) == 2 );
+
+            // a prefix is another name
+            StringView prefix = {};
+            prefix.buffer = copy;
+            prefix.length = 5;
+            EVALUATE( StringInterner::Intern( &interner, prefix ) != color );
+
+            StringView text = StringInterner::GetString( &interner, depth );
+            EVALUATE( StringUtils::Compare( text, "Depth attachment ID" ) );
+            EVALUATE( text.buffer[text.length] == '\0' );
+            EVALUATE( StringInterner::GetString( &interner, StringInterner::INVALID_ID ).length == 0 );
+            EVALUATE( StringInterner::GetString( &interner, 1000 ).buffer == nullptr );
+
+            StringInterner::Destroy( &interner );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(StableWhileGrowing)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            StringInterner interner = {};
+            // a tiny arena so the text goes over many blocks
+            StringInterner::Create( &interner, alloc, 4, 64 );
+
+            const uint32_t count = 5'000;
+            char name[32];
+
+            StringID first = StringInterner::Intern( &interner, "asset_0" );
+            const char* first_text = StringInterner::GetString( &interner, first ).buffer;
+
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                snprintf( name, sizeof( name ), "asset_%u", i );
+                StringInterner::Intern( &interner, name );
+            }
+
+            // ids are given in order and never change , the text never moves
+            bool all_found = StringInterner::Count( &interner ) == count;
+
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                snprintf( name, sizeof( name ), "asset_%u", i );
+                StringID id = StringInterner::Find( &interner, name );
+                all_found &= id == i + 1 && StringUtils::Compare( StringInterner::GetString( &interner, id ), name );
+            }
+
+            EVALUATE( all_found );
+            EVALUATE( StringInterner::GetString( &interner, first ).buffer == first_text );
+            EVALUATE( interner.slot_count * 7 >= count * 8 );
+
+            StringInterner::Destroy( &interner );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ConcurrentIntern)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            StringInterner interner = {};
+            StringInterner::Create( &interner, alloc );
+
+            const uint32_t thread_count = 4;
+            const uint32_t name_count = 2'000;
+
+            // every thread interns the same names in another order , they all have to agree on the ids
+            StringID ids[thread_count][name_count] = {};
+            std::thread threads[thread_count];
+
+            for ( uint32_t t = 0; t < thread_count; ++t )
+            {
+                threads[t] = std::thread( [&interner, &ids, t]()
+                {
+                    char name[32];
+
+                    for ( uint32_t i = 0; i < name_count; ++i )
+                    {
+                        // shifted start , odd threads walk backwards
+                        uint32_t idx = (i + t * 97) % name_count;
+                        idx = (t & 1) ? name_count - 1 - idx : idx;
+                        snprintf( name, sizeof( name ), "pass_%u", idx );
+                        ids[t][idx] = StringInterner::Intern( &interner, name );
+                    }
+                } );
+            }
+
+            for ( uint32_t t = 0; t < thread_count; ++t )
+            {
+                threads[t].join();
+            }
+
+            bool all_agree = StringInterner::Count( &interner ) == name_count;
+            char name[32];
+
+            for ( uint32_t i = 0; i < name_count; ++i )
+            {
+                snprintf( name, sizeof( name ), "pass_%u", i );
+                all_agree &= StringUtils::Compare( StringInterner::GetString( &interner, ids[0][i] ), name );
+
+                for ( uint32_t t = 1; t < thread_count; ++t )
+                {
+                    all_agree &= ids[t][i] == ids[0][i];
+                }
+            }
+
+            EVALUATE( all_agree );
+
+            StringInterner::Destroy( &interner );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(3 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , StringInternerTests::InternAndLookup);
+            DArray<TestCallback>::Add(&arr , StringInternerTests::StableWhileGrowing);
+            DArray<TestCallback>::Add(&arr , StringInternerTests::ConcurrentIntern);
+
+            return arr;
+        };
+    };
+}
@@ -4,6 +4,8 @@
 #include <String/StringBuffer.h>
 #include <String/StringView.h>
 #include <String/StringUtils.h>
+#include <String/StringBuilder.h>
+#include <String/DeferredFormat.h>
 #include <Allocators/Allocator.h>
 
 namespace Tests
@@ -55,16 +57,284 @@ namespace Tests
 
             TEST_END()
         }
-        
+
+        TEST_DECLARATION(TestCompiledFormat)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator alloc = HeapAllocator::Create();
+
+            auto format = FORMAT( "{}: {} of {} , {}% {}" );
+
+            bool is_parsed = decltype( format )::SLOT_COUNT == 5 && decltype( format )::LAYOUT.literal_length == 11;
+            EVALUATE( is_parsed );
+
+            StringView name = "load";
+            StringBuffer result = StringUtils::Format( alloc, format, name, (int32_t) -3, (size_t) 40, 12.5f, true );
+
+            EVALUATE( StringUtils::Compare( result.view, "load: -3 of 40 , 12.5% true" ) );
+
+            // the runtime template gives the same text
+            StringBuffer runtime = StringUtils::Format( alloc, "{}: {} of {} , {}% {}", name, (int32_t) -3, (size_t) 40, 12.5f, true );
+
+            EVALUATE( StringUtils::Compare( result.view, runtime.view ) );
+
+            StringBuffer no_slots = StringUtils::Format( alloc, FORMAT( "plain" ) );
+            StringBuffer only_slot = StringUtils::Format( alloc, FORMAT( "{}" ), 'x' );
+
+            EVALUATE( StringUtils::Compare( no_slots.view, "plain" ) );
+            EVALUATE( StringUtils::Compare( only_slot.view, "x" ) );
+
+            StringBuilder builder = {};
+            StringBuilder::Create( &builder, alloc );
+            StringBuilder::AppendFormat( &builder, FORMAT( "[{}] {}" ), (uint64_t) 7, result );
+
+            EVALUATE( builder.size == 4 + result.length );
+            EVALUATE( StringUtils::Compare( StringBuilder::Flatten( &builder ), "[7] load: -3 of 40 , 12.5% true" ) );
+
+            StringBuilder::Destroy( &builder );
+            StringBuffer::Destroy( &only_slot );
+            StringBuffer::Destroy( &no_slots );
+            StringBuffer::Destroy( &runtime );
+            StringBuffer::Destroy( &result );
+
+            TEST_END()
+        }
+
+        static size_t NaiveFind( StringView str, StringView pattern, size_t from )
+        {
+            for ( size_t i = from; i + pattern.length <= str.length; ++i )
+            {
+                if ( memcmp( str.buffer + i, pattern.buffer, pattern.length ) == 0 )
+                {
+                    return i;
+                }
+            }
+
+            return StringSearch::NOT_FOUND;
+        }
+
+        TEST_DECLARATION(TestSearch)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator alloc = HeapAllocator::Create();
+
+            StringView text = "the quick brown fox jumps over the lazy dog , the end";
+
+            EVALUATE( StringUtils::FindChar( text, 'q' ) == 4 );
+            EVALUATE( StringUtils::FindChar( text, 'z' ) == 37 );
+            EVALUATE( StringUtils::FindChar( text, '#' ) == StringSearch::NOT_FOUND );
+            EVALUATE( StringUtils::Find( text, "the" ) == 0 );
+            EVALUATE( StringUtils::Find( text, "the", 1 ) == 31 );
+            EVALUATE( StringUtils::Find( text, "the end" ) == 46 );
+            EVALUATE( StringUtils::Find( text, "dogs" ) == StringSearch::NOT_FOUND );
+            EVALUATE( StringUtils::EndsWith( text, "the end" ) );
+            EVALUATE( !StringUtils::EndsWith( text, "the and" ) );
+
+            // every length and position around the block sizes , against a byte by byte search
+            char haystack[200];
+            bool find_ok = true;
+            bool compare_ok = true;
+            uint64_t state = 0x9E3779B97F4A7C15ull;
+
+            for ( size_t round = 0; round < 2'000; ++round )
+            {
+                state ^= state >> 12;
+                state ^= state << 25;
+                state ^= state >> 27;
+                uint64_t r = state * 0x2545F4914F6CDD1Dull;
+
+                size_t length = r % sizeof( haystack );
+
+                // a small alphabet so that partial matches happen often
+                for ( size_t i = 0; i < length; ++i )
+                {
+                    haystack[i] = 'a' + (char) ((r >> (i % 61)) + i * 7) % 3;
+                }
+
+                StringView str = {};
+                str.buffer = haystack;
+                str.length = length;
+
+                size_t pattern_start = length == 0 ? 0 : (r >> 8) % length;
+                StringView pattern = {};
+                pattern.buffer = haystack + pattern_start;
+                pattern.length = ((r >> 16) % 40) % (length - pattern_start + 1);
+
+                size_t from = (r >> 24) % 8;
+
+                find_ok &= StringUtils::Find( str, pattern, from ) == NaiveFind( str, pattern, from );
+
+                StringView other = {};
+                other.buffer = haystack + 1;
+                other.length = length == 0 ? 0 : length - 1;
+
+                StringView same = {};
+                same.buffer = haystack;
+                same.length = other.length;
+
+                compare_ok &= StringUtils::Compare( same, other ) == (memcmp( same.buffer, other.buffer, same.length ) == 0);
+                compare_ok &= StringUtils::Compare( str, str );
+            }
+
+            EVALUATE( find_ok );
+            EVALUATE( compare_ok );
+
+            char path[] = "C:/engine/assets/shaders/very/deep/folder/file.vert";
+            EVALUATE( StringUtils::ReplaceChar( path, '/', '\\' ) == 7 );
+            EVALUATE( StringUtils::FindChar( path, '/' ) == StringSearch::NOT_FOUND );
+            EVALUATE( path[2] == '\\' );
+
+            StringBuffer replaced = StringUtils::Replace( "a&b&&c", "&", "^&", alloc );
+            EVALUATE( StringUtils::Compare( replaced.view, "a^&b^&^&c" ) );
+
+            StringBuffer shorter = StringUtils::Replace( "one::two::three", "::", ".", alloc );
+            EVALUATE( StringUtils::Compare( shorter.view, "one.two.three" ) );
+
+            // same text same hash , every length changes it
+            bool hash_ok = StringUtils::Hash( "renderer" ) == StringUtils::Hash( StringView( "xrenderer" ).buffer + 1 );
+
+            for ( size_t i = 0; i < 64; ++i )
+            {
+                StringView prefix = {};
+                prefix.buffer = haystack;
+                prefix.length = i;
+
+                StringView longer = {};
+                longer.buffer = haystack;
+                longer.length = i + 1;
+
+                hash_ok &= StringUtils::Hash( prefix ) != StringUtils::Hash( longer );
+            }
+
+            EVALUATE( hash_ok );
+
+            StringBuffer::Destroy( &shorter );
+            StringBuffer::Destroy( &replaced );
+
+            TEST_END()
+        }
+
+        static bool CountSegment( void* user_data, StringView str )
+        {
+            (*(size_t*) user_data) += str.length;
+            return true;
+        }
+
+        TEST_DECLARATION(TestBuilder)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator alloc = HeapAllocator::Create();
+
+            StringBuilder builder = {};
+            StringBuilder::Create( &builder, alloc, ChunkedBuffer::MIN_CHUNK_SIZE );
+
+            for ( size_t i = 0; i < 50; ++i )
+            {
+                StringBuilder::Append( &builder, "abc" );
+                StringBuilder::Append( &builder, (char) ('0' + (i % 10)) );
+            }
+
+            EVALUATE( builder.size == 200 );
+
+            // the content stays spread over the chunks until it's flattened
+            DArray<StringView> segments = {};
+            DArray<StringView>::Create( 4, &segments, alloc );
+            StringBuilder::Gather( &builder, &segments );
+
+            size_t written = 0;
+            StringBuilder::WriteTo( &builder, CountSegment, &written );
+
+            EVALUATE( segments.size == 4 );
+            EVALUATE( written == 200 );
+
+            StringBuffer copy = {};
+            StringBuilder::ToString( &builder, &copy, alloc );
+
+            StringView flat = StringBuilder::Flatten( &builder );
+
+            EVALUATE( flat.length == 200 );
+            EVALUATE( StringUtils::Compare( flat, copy.view ) );
+            EVALUATE( flat.buffer[199] == '9' );
+            EVALUATE( builder.chunks.first == builder.chunks.last );
+
+            // appending after a flatten carries on in new chunks
+            StringBuilder::Append( &builder, "end" );
+            flat = StringBuilder::Flatten( &builder );
+
+            EVALUATE( flat.length == 203 );
+            EVALUATE( flat.buffer[200] == 'e' );
+
+            StringBuilder::Clear( &builder );
+
+            EVALUATE( StringBuilder::Flatten( &builder ).length == 0 );
+
+            StringBuffer::Destroy( &copy );
+            DArray<StringView>::Destroy( &segments );
+            StringBuilder::Destroy( &builder );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(TestDeferredFormat)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator alloc = HeapAllocator::Create();
+
+            ChunkedBuffer out = {};
+            ChunkedBuffer::Create( &out, alloc );
+
+            // the argument buffers are gone by the time the payload is formatted
+            uint8_t payload[64];
+            DeferredFormatter formatter = nullptr;
+            {
+                char name[] = "renderer";
+                StringBuffer owned = StringBuffer::Create( "gpu", alloc );
+
+                formatter = DeferredFormat::FormatterOf( FORMAT( "[{}] {} frame {} took {} ms {}" ), name, owned, (uint64_t) 42, 1.5f, true );
+                DeferredFormat::Encode( payload, name, owned, (uint64_t) 42, 1.5f, true );
+
+                name[0] = 'X';
+                StringBuffer::Destroy( &owned );
+            }
+
+            size_t size = formatter( payload, &out );
+            StringView text = ChunkedBuffer::Flatten( &out );
+
+            EVALUATE( size == text.length );
+            EVALUATE( StringUtils::Compare( text, "[renderer] gpu frame 42 took 1.5 ms true" ) );
+
+            // 8 bytes for the number and 4 for the length , the string gets the last 4
+            uint8_t small[16];
+            size_t used = DeferredFormat::Encode( small, (int64_t) -7, "truncated" );
+
+            ChunkedBuffer::Reset( &out );
+            DeferredFormat::FormatterOf( FORMAT( "{}:{}" ), (int64_t) -7, "truncated" )( small, &out );
+
+            EVALUATE( used == 16 );
+            EVALUATE( StringUtils::Compare( ChunkedBuffer::Flatten( &out ), "-7:trun" ) );
+
+            ChunkedBuffer::Destroy( &out );
+
+            TEST_END()
+        }
+
         static inline DArray<TestCallback> GetAll() 
         {
             Allocator alloc = HeapAllocator::Create();
             DArray<TestCallback> arr = {};
-            DArray<TestCallback>::Create(3 , &arr , alloc);
+            DArray<TestCallback>::Create(6 , &arr , alloc);
 
             DArray<TestCallback>::Add(&arr , StringTests::TestGetLength);
             DArray<TestCallback>::Add(&arr , StringTests::TestConcat);
             DArray<TestCallback>::Add(&arr , StringTests::TestFormat);
+            DArray<TestCallback>::Add(&arr , StringTests::TestCompiledFormat);
+            DArray<TestCallback>::Add(&arr , StringTests::TestSearch);
+            DArray<TestCallback>::Add(&arr , StringTests::TestBuilder);
+            DArray<TestCallback>::Add(&arr , StringTests::TestDeferredFormat);
 
             return arr;
         };
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <Testing/BTest.h>
+#include <Containers/DArray.h>
+#include <Containers/ChunkedBuffer.h>
+#include <Allocators/Allocator.h>
+#include <String/StringUtils.h>
+#include <String/NumberFormat.h>
+#include <Serialization/JSONParser.h>
+#include <Serialization/JSONWriter.h>
+#include <Serialization/XMLWriter.h>
+
+namespace Tests
+{
+    struct WriterTests
+    {
+        static bool Matches( const ChunkedBuffer* buffer, StringView expected, Allocator alloc )
+        {
+            StringBuffer str = {};
+            ChunkedBuffer::ToString( buffer, &str, alloc );
+
+            bool res = StringUtils::Compare( str.view, expected );
+
+            StringBuffer::Destroy( &str );
+
+            return res;
+        }
+
+        static bool FormatsAs( size_t length, const char* text, const char* expected )
+        {
+            StringView view = {};
+            view.buffer = text;
+            view.length = length;
+
+            return StringUtils::Compare( view, expected );
+        }
+
+        TEST_DECLARATION(NumberFormatting)
+        {
+            CoreContext::DefaultContext();
+
+            char text[NumberFormat::MAX_LENGTH] = {};
+
+            EVALUATE( FormatsAs( NumberFormat::FormatInt64( 0, text ), text, "0" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatInt64( -7, text ), text, "-7" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatInt64( 1'000'000, text ), text, "1000000" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatInt64( INT64_MAX, text ), text, "9223372036854775807" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatInt64( INT64_MIN, text ), text, "-9223372036854775808" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatUInt64( UINT64_MAX, text ), text, "18446744073709551615" ) );
+
+            EVALUATE( FormatsAs( NumberFormat::FormatDouble( 1.5, text ), text, "1.5" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatDouble( -0.0, text ), text, "-0" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatDouble( 100, text ), text, "100" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatDouble( 0.001, text ), text, "0.001" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatFloat( 0.1f, text ), text, "0.1" ) );
+            EVALUATE( FormatsAs( NumberFormat::FormatFloat( -3.14159f, text ), text, "-3.14159" ) );
+
+            // whatever the path taken , the text reads back to the same value
+            bool doubles_ok = true;
+            bool floats_ok = true;
+            uint64_t state = 0x9E3779B97F4A7C15ull;
+
+            for ( size_t i = 0; i < 20'000; ++i )
+            {
+                state ^= state >> 12;
+                state ^= state << 25;
+                state ^= state >> 27;
+                uint64_t bits = state * 0x2545F4914F6CDD1Dull;
+
+                // mix of short decimals and full precision values over many magnitudes
+                double value = (i % 2 == 0) ? (double) (int64_t) (bits % 2'000'000) / 1'000.0 : ((double) bits / (double) UINT64_MAX - 0.5) * pow( 10.0, (double) (int) (bits % 40) - 20 );
+
+                size_t length = NumberFormat::FormatDouble( value, text );
+                text[length] = '\0';
+                doubles_ok &= strtod( text, nullptr ) == value;
+
+                length = NumberFormat::FormatFloat( (float) value, text );
+                text[length] = '\0';
+                floats_ok &= strtof( text, nullptr ) == (float) value;
+            }
+
+            EVALUATE( doubles_ok );
+            EVALUATE( floats_ok );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ChunkedBufferReuse)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            ChunkedBuffer buffer = {};
+            ChunkedBuffer::Create( &buffer, alloc, ChunkedBuffer::MIN_CHUNK_SIZE );
+
+            for ( size_t i = 0; i < 100; ++i )
+            {
+                ChunkedBuffer::Write( &buffer, "012345678" );
+                ChunkedBuffer::Write( &buffer, '9' );
+            }
+
+            StringBuffer str = {};
+            ChunkedBuffer::ToString( &buffer, &str, alloc );
+
+            bool content_ok = str.length == 1'000;
+
+            for ( size_t i = 0; i < str.length; ++i )
+            {
+                content_ok &= str.buffer[i] == (char) ('0' + (i % 10));
+            }
+
+            StringBuffer::Destroy( &str );
+
+            EVALUATE( ChunkedBuffer::Size( &buffer ) == 1'000 );
+            EVALUATE( content_ok );
+            EVALUATE( buffer.first != buffer.last );
+
+            BufferChunk* first = buffer.first;
+            ChunkedBuffer::Reset( &buffer );
+
+            EVALUATE( ChunkedBuffer::Size( &buffer ) == 0 );
+
+            // the same chunks come back
+            char* dst = ChunkedBuffer::Reserve( &buffer, 4 );
+            dst[0] = 'a';
+            dst[1] = 'b';
+            ChunkedBuffer::Commit( &buffer, 2 );
+
+            EVALUATE( buffer.first == first );
+            EVALUATE( Matches( &buffer, "ab", alloc ) );
+
+            ChunkedBuffer::Destroy( &buffer );
+
+            TEST_END()
+        }
+
+        static void WriteScene( JSONWriter* writer )
+        {
+            JSONWriter::BeginObject( writer );
+
+            JSONWriter::Key( writer, "name" );
+            JSONWriter::String( writer, "say \"hi\"\n" );
+            JSONWriter::Key( writer, "ids" );
+            JSONWriter::BeginArray( writer );
+            JSONWriter::Integer( writer, 1 );
+            JSONWriter::Integer( writer, -20 );
+            JSONWriter::EndArray( writer );
+            JSONWriter::Key( writer, "scale" );
+            JSONWriter::Float( writer, 0.25 );
+            JSONWriter::Key( writer, "empty" );
+            JSONWriter::BeginObject( writer );
+            JSONWriter::EndObject( writer );
+            JSONWriter::Key( writer, "flags" );
+            JSONWriter::BeginArray( writer );
+            JSONWriter::Boolean( writer, true );
+            JSONWriter::Null( writer );
+            JSONWriter::EndArray( writer );
+
+            JSONWriter::EndObject( writer );
+        }
+
+        TEST_DECLARATION(JSONWriting)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            ChunkedBuffer buffer = {};
+            ChunkedBuffer::Create( &buffer, alloc, ChunkedBuffer::MIN_CHUNK_SIZE );
+
+            JSONWriter writer = {};
+            JSONWriter::Create( &writer, &buffer );
+            WriteScene( &writer );
+
+            StringView compact = R"({"name":"say \"hi\"\n","ids":[1,-20],"scale":0.25,"empty":{},"flags":[true,null]})";
+
+            EVALUATE( Matches( &buffer, compact, alloc ) );
+
+            ChunkedBuffer::Reset( &buffer );
+            JSONWriter::Create( &writer, &buffer, true );
+            WriteScene( &writer );
+
+            StringView pretty =
+                "{\n"
+                "\t\"name\": \"say \\\"hi\\\"\\n\",\n"
+                "\t\"ids\": [\n"
+                "\t\t1,\n"
+                "\t\t-20\n"
+                "\t],\n"
+                "\t\"scale\": 0.25,\n"
+                "\t\"empty\": {},\n"
+                "\t\"flags\": [\n"
+                "\t\ttrue,\n"
+                "\t\tnull\n"
+                "\t]\n"
+                "}";
+
+            EVALUATE( Matches( &buffer, pretty, alloc ) );
+
+            ChunkedBuffer::Destroy( &buffer );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(JSONRoundTrip)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            Arena arena = Arena::Create( 16 * 1'024 );
+            Allocator arena_alloc = ArenaAllocator::Create( &arena );
+
+            StringView json = R"({"a":[1,2.5e3,"x\"y",{"b":null,"c":[]}],"d":{"e":false},"f":-0.5})";
+
+            ChunkedBuffer buffer = {};
+            ChunkedBuffer::Create( &buffer, alloc, ChunkedBuffer::MIN_CHUNK_SIZE );
+
+            JSONNode root = {};
+            bool parsed = JSONParser::Parse( json, &root, arena_alloc );
+
+            JSONWriter writer = {};
+            JSONWriter::Create( &writer, &buffer );
+            JSONWriter::WriteNode( &writer, &root );
+
+            EVALUATE( parsed );
+            EVALUATE( Matches( &buffer, json, alloc ) );
+
+            // pretty output parses back to the same compact text
+            ChunkedBuffer::Reset( &buffer );
+            JSONWriter::Create( &writer, &buffer, true );
+            JSONWriter::WriteNode( &writer, &root );
+
+            StringBuffer pretty = {};
+            ChunkedBuffer::ToString( &buffer, &pretty, alloc );
+
+            JSONNode pretty_root = {};
+            bool pretty_parsed = JSONParser::Parse( pretty.view, &pretty_root, arena_alloc );
+
+            ChunkedBuffer::Reset( &buffer );
+            JSONWriter::Create( &writer, &buffer );
+            JSONWriter::WriteNode( &writer, &pretty_root );
+
+            EVALUATE( pretty_parsed );
+            EVALUATE( Matches( &buffer, json, alloc ) );
+
+            StringBuffer::Destroy( &pretty );
+            ChunkedBuffer::Destroy( &buffer );
+            Arena::Destroy( &arena );
+
+            TEST_END()
+        }
+
+        static void WriteLevel( XMLWriter* writer )
+        {
+            XMLWriter::BeginElement( writer, "level" );
+            XMLWriter::Attribute( writer, "name", "a < b & \"c\"" );
+            XMLWriter::IntegerAttribute( writer, "size", 3 );
+
+            XMLWriter::BeginElement( writer, "entity" );
+            XMLWriter::FloatAttribute( writer, "x", 1.5 );
+            XMLWriter::EndElement( writer );
+
+            XMLWriter::BeginElement( writer, "note" );
+            XMLWriter::Text( writer, "1 > 0" );
+            XMLWriter::EndElement( writer );
+
+            XMLWriter::EndElement( writer );
+        }
+
+        TEST_DECLARATION(XMLWriting)
+        {
+            CoreContext::DefaultContext();
+            Allocator alloc = HeapAllocator::Create();
+
+            ChunkedBuffer buffer = {};
+            ChunkedBuffer::Create( &buffer, alloc, ChunkedBuffer::MIN_CHUNK_SIZE );
+
+            XMLWriter writer = {};
+            XMLWriter::Create( &writer, &buffer, alloc );
+            WriteLevel( &writer );
+            XMLWriter::Destroy( &writer );
+
+            StringView compact = R"(<level name="a &lt; b &amp; &quot;c&quot;" size="3"><entity x="1.5"/><note>1 &gt; 0</note></level>)";
+
+            EVALUATE( Matches( &buffer, compact, alloc ) );
+
+            ChunkedBuffer::Reset( &buffer );
+            XMLWriter::Create( &writer, &buffer, alloc, true );
+            XMLWriter::Declaration( &writer );
+            WriteLevel( &writer );
+            XMLWriter::Destroy( &writer );
+
+            StringView pretty =
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<level name=\"a &lt; b &amp; &quot;c&quot;\" size=\"3\">\n"
+                "\t<entity x=\"1.5\"/>\n"
+                "\t<note>1 &gt; 0</note>\n"
+                "</level>";
+
+            EVALUATE( Matches( &buffer, pretty, alloc ) );
+
+            ChunkedBuffer::Destroy( &buffer );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(5 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , WriterTests::NumberFormatting);
+            DArray<TestCallback>::Add(&arr , WriterTests::ChunkedBufferReuse);
+            DArray<TestCallback>::Add(&arr , WriterTests::JSONWriting);
+            DArray<TestCallback>::Add(&arr , WriterTests::JSONRoundTrip);
+            DArray<TestCallback>::Add(&arr , WriterTests::XMLWriting);
+
+            return arr;
+        };
+    };
+}
@@ -3,11 +3,24 @@
 #include "DArrayTests.h"
 #include "QueueTests.h"
 #include "FreeListTests.h"
+#include "FreeListDefragmenterTests.h"
 #include "HMapTests.h"
 #include "StringTests.h"
 #include "MinHeapTests.h"
 #include "SlotArrayTests.h"
 #include "DeferTests.h"
+#include "PoolAllocatorTests.h"
+#include "ArenaAllocatorTests.h"
+#include "ScratchArenaTests.h"
+#include "AllocationProfilerTests.h"
+#include "JSONParserTests.h"
+#include "StreamReaderTests.h"
+#include "WriterTests.h"
+#include "BinarySerializerTests.h"
+#include "StringInternerTests.h"
+#include "MPSCQueueTests.h"
+#include "FrameProfilerTests.h"
+#include "BBenchTests.h"
 
 TEST_DECLARATION(Wrong)
 {
@@ -30,10 +43,23 @@ int main(int argc , char** argv)
     BTest::AppendAll(Tests::DArrayTests::GetAll());
     BTest::AppendAll(Tests::QueueTests::GetAll());
     BTest::AppendAll(Tests::FreeListTests::GetAll());
+    BTest::AppendAll(Tests::FreeListDefragmenterTests::GetAll());
     BTest::AppendAll(Tests::StringTests::GetAll());
     BTest::AppendAll(Tests::MinHeapTests::GetAll());
     BTest::AppendAll(Tests::DeferTests::GetAll());
     BTest::AppendAll(Tests::SlotArrayTests::GetAll());
+    BTest::AppendAll(Tests::PoolAllocatorTests::GetAll());
+    BTest::AppendAll(Tests::ArenaAllocatorTests::GetAll());
+    BTest::AppendAll(Tests::ScratchArenaTests::GetAll());
+    BTest::AppendAll(Tests::AllocationProfilerTests::GetAll());
+    BTest::AppendAll(Tests::JSONParserTests::GetAll());
+    BTest::AppendAll(Tests::StreamReaderTests::GetAll());
+    BTest::AppendAll(Tests::WriterTests::GetAll());
+    BTest::AppendAll(Tests::BinarySerializerTests::GetAll());
+    BTest::AppendAll(Tests::StringInternerTests::GetAll());
+    BTest::AppendAll(Tests::MPSCQueueTests::GetAll());
+    BTest::AppendAll(Tests::FrameProfilerTests::GetAll());
+    BTest::AppendAll(Tests::BBenchTests::GetAll());
 
     BTest::RunAll();
 }
\ No newline at end of file
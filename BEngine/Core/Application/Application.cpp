@@ -9,7 +9,8 @@
 #include "../Platform/Base/Platform.h"
 #include "../Renderer/Backend/BackendRenderer.h"
 #include "../Renderer/VulkanBackend/VulkanBackendRenderer.h"
-#include "../AtomicLock/AtomicLock.h"
+#include <Atomic/AtomicLock.h>
+#include <Profiler/FrameProfiler.h>
 
 bool Application::Run()
 {
@@ -47,15 +48,25 @@ bool Application::Run()
 
         RendererContext renderer_ctx = {};
         DArray<DrawMesh>::Create( 32 ,&renderer_ctx.mesh_draws , Global::alloc_toolbox.frame_allocator);
+        DArray<FreeList::Node*>::Create( 16 ,&renderer_ctx.mesh_handles , Global::alloc_toolbox.frame_allocator);
+        DArray<FreeList::Node*>::Create( 16 ,&renderer_ctx.descriptors_handles , Global::alloc_toolbox.frame_allocator);
 
         // update game
-        game_app.on_update( &game_app, delta );
+        {
+            PROFILE_SCOPE( "Application::Update" );
+            game_app.on_update( &game_app, delta );
+        }
 
-        game_app.on_render( &game_app, &renderer_ctx , delta );
+        {
+            PROFILE_SCOPE( "Application::Render" );
+            game_app.on_render( &game_app, &renderer_ctx , delta );
+        }
 
 
         // draw frame
         {
+            PROFILE_SCOPE( "Application::DrawFrame" );
+
             if ( !Global::backend_renderer.start_frame( &Global::backend_renderer, &renderer_ctx ) )
             {
                 goto post_frame;
@@ -78,7 +89,9 @@ bool Application::Run()
 
     post_frame:
         Global::platform.input.OnPostUpdate( delta );
-        Global::alloc_toolbox.frame_arena.offset = 0;
+        AllocationProfiler::EndFrame( &Global::alloc_toolbox.profiler );
+        FrameProfiler::EndFrame( &Global::frame_profiler );
+        Arena::Reset( &Global::alloc_toolbox.frame_arena );
     }
 
     return true;
@@ -12,7 +12,7 @@ void GlobalAssetManager::Destroy()
     *this = {};
 }
 
-bool GlobalAssetManager::GetByID(const char* id, AssetManager* out_manager) const
+bool GlobalAssetManager::GetByID(StringID id, AssetManager* out_manager) const
 {
     for(size_t i = 0; i < asset_managers.size ; ++i)
     {
@@ -29,4 +29,16 @@ bool GlobalAssetManager::GetByID(const char* id, AssetManager* out_manager) cons
     }
 
     return false;
+}
+
+bool GlobalAssetManager::GetByID(StringView id, AssetManager* out_manager) const
+{
+    StringID interned = StringInterner::Find(&Global::names, id);
+
+    if(interned == StringInterner::INVALID_ID)
+    {
+        return false;
+    }
+
+    return GetByID(interned, out_manager);
 }
\ No newline at end of file
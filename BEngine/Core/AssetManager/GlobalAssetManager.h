@@ -1,6 +1,7 @@
 #pragma once
 #include "../Defines/Defines.h"
 #include <String/StringBuffer.h>
+#include <String/StringInterner.h>
 #include <Typedefs/Typedefs.h>
 #include <Containers/ArrayView.h>
 #include <Containers/DArray.h>
@@ -15,7 +16,7 @@ struct BAPI AssetInfo
 
 struct BAPI AssetHandle
 {
-    const char* type_id;
+    StringID type_id;
     AssetInfo info;
     FileHandle file_handle;
     void* data;
@@ -24,7 +25,7 @@ struct BAPI AssetHandle
 struct BAPI AssetManager
 {
     StringView name;
-    const char* id;
+    StringID id;
     DArray<AssetHandle> handles;
     Func<bool, AssetManager*,ArrayView<char>> can_import;
     Func<bool, AssetManager*,ArrayView<char>, FileHandle, AssetHandle*> import;
@@ -37,7 +38,12 @@ struct BAPI GlobalAssetManager
 
     void Startup();
 
-    bool GetByID(const char* id, AssetManager* out_manager) const;
+    bool GetByID(StringID id, AssetManager* out_manager) const;
+
+    /// <summary>
+    /// Looks the name up in Global::names first , keep the StringID around rather than calling this every frame
+    /// </summary>
+    bool GetByID(StringView id, AssetManager* out_manager) const;
 
     void Destroy();
 };
\ No newline at end of file
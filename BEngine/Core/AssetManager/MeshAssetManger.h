@@ -16,7 +16,7 @@ struct BAPI MeshAssetManager
     {
         *out_manager = {};
         out_manager->name = MANAGER_NAME;
-        out_manager->id = ASSET_ID;
+        out_manager->id = StringInterner::Intern(&Global::names, ASSET_ID);
         out_manager->can_import = CanImportMesh;
         out_manager->import = ImportMesh;
         out_manager->free = FreeMesh;
@@ -54,7 +54,7 @@ private:
         *out_handle = {};
 
         // assign id
-        out_handle->type_id = ASSET_ID;
+        out_handle->type_id = in_manager->id;
 
         // fill info
         out_handle->info.size = asset_data.size;
@@ -16,7 +16,7 @@ struct BAPI TextureAssetManager
     {
         *out_manager = {};
         out_manager->name = MANAGER_NAME;
-        out_manager->id = ASSET_ID;
+        out_manager->id = StringInterner::Intern(&Global::names, ASSET_ID);
         out_manager->can_import = CanImportTexture;
         out_manager->import = ImportTexture;
         out_manager->free = FreeTexture;
@@ -56,7 +56,7 @@ private:
         Global::platform.memory.mem_copy(asset_data.data, copy, asset_data.size);
 
         *out_handle = {};
-        out_handle->type_id = ASSET_ID;
+        out_handle->type_id = in_manager->id;
         out_handle->file_handle;
         out_handle->data = copy;
         out_handle->info.asset_id = ids++;
@@ -1,9 +1,13 @@
 #pragma once
 
-#ifdef _ENGINE_EXPORT
-#define BAPI __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef _ENGINE_EXPORT
+    #define BAPI __declspec(dllexport)
+    #else
+    #define BAPI  __declspec(dllimport)
+    #endif
 #else
-#define BAPI  __declspec(dllimport)
+    #define BAPI __attribute__((visibility("default")))
 #endif
 
 
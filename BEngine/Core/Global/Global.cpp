@@ -16,4 +16,8 @@ GlobalAssetManager Global::asset_manager;
 
 FileWatchingContext Global::filewatch_ctx;
 
-JobSystem Global::job_system;
\ No newline at end of file
+JobSystem Global::job_system;
+
+StringInterner Global::names;
+
+FrameProfiler Global::frame_profiler;
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 #include <Allocators/Allocator.h>
+#include <Allocators/PoolAllocator.h>
+#include <Allocators/AllocationProfiler.h>
 #include "../Defines/Defines.h"
 #include "../Platform/Base/Platform.h"
 #include "../EventSystem/GameEventSystem.h"
@@ -8,7 +10,9 @@
 #include "../AssetManager/GlobalAssetManager.h"
 #include "../FileWatcher/FileWatcher.h"
 #include "../Thread/Thread.h"
-#include "../AtomicLock/AtomicLock.h"
+#include <Atomic/AtomicLock.h>
+#include <String/StringInterner.h>
+#include <Profiler/FrameProfiler.h>
 #include "../JobSystem/JobSystem.h"
 
 struct BAPI GlobalAssetManager;
@@ -41,14 +45,37 @@ struct BAPI Global
     static FileWatchingContext filewatch_ctx;
 
     static JobSystem job_system;
+
+    /// <summary>
+    /// Asset , shader and pass names , created right after the allocators so everything after can intern its names
+    /// </summary>
+    static StringInterner names;
+
+    /// <summary>
+    /// CPU zones of the frame (PROFILE_SCOPE) , the frame is closed in Application::Run , the trace and the stats are written at shutdown
+    /// </summary>
+    static FrameProfiler frame_profiler;
 };
 
 struct BAPI AllocationToolbox
 {
     Arena frame_arena;
+
+    /// <summary>
+    /// Backs "heap_allocator" , small allocations come from size-class slabs and the rest goes to the heap
+    /// </summary>
+    Pool heap_pool;
     Allocator heap_allocator;
     Allocator frame_allocator;
 
+    /// <summary>
+    /// <para>Sees everything going through "heap_allocator" and "frame_allocator" , records every allocation in debug and samples them in release</para>
+    /// <para>Call AllocationProfiler::Report to see where the allocations come from , the leaks are reported at shutdown</para>
+    /// </summary>
+    AllocationProfiler profiler;
+    ProfiledAllocator profiled_heap;
+    ProfiledAllocator profiled_frame;
+
     template <typename T>
     T *HeapAlloc(bool init = true)
     {
@@ -112,14 +139,11 @@ struct BAPI AllocationToolbox
 
     ArenaCheckpoint GetArenaCheckpoint()
     {
-        ArenaCheckpoint res = {};
-        res.arena = &Global::alloc_toolbox.frame_arena;
-        res.start_offset = Global::alloc_toolbox.frame_arena.offset;
-        return res;
+        return ArenaCheckpoint::Create(&Global::alloc_toolbox.frame_arena);
     }
 
     void ResetArenaOffset(ArenaCheckpoint *in_checkpoint)
     {
-        in_checkpoint->arena->offset = in_checkpoint->start_offset;
+        ArenaCheckpoint::Rewind(in_checkpoint);
     }
 };
@@ -1,73 +1,426 @@
 #include <Typedefs/Typedefs.h>
-#include <Containers/LinkedList.h>
 #include <Containers/DArray.h>
 #include <Containers/Queue.h>
 #include <Defer/Defer.h>
 #include "../Thread/Thread.h"
-#include "../AtomicLock/AtomicLock.h"
-#include "../Global/Global.h"
+#include <Atomic/AtomicLock.h>
+#include <Atomic/Atomic.h>
+#include <Allocators/ScratchArena.h>
 #include "JobSystem.h"
 
-DWORD ThreadRun(void* data)
+// number of failed attempts at finding a job before a worker goes to sleep
+#define JOB_SPIN_COUNT 256
+
+// a sleeping worker wakes up on its own after this delay , covers the rare missed wake-up
+#define JOB_SLEEP_TIMEOUT_MS 2
+
+#define JOB_INVALID_THREAD ((size_t) -1)
+
+// index of the queue owned by the current thread , JOB_INVALID_THREAD if the thread doesn't own one
+static thread_local size_t tls_job_thread_index = JOB_INVALID_THREAD;
+
+// state of the random generator used to pick the victim to steal from
+static thread_local uint32_t tls_random_state = 0x9E3779B9;
+
+static inline JobHandle MakeHandle(uint32_t slot_index, int32_t generation)
+{
+    JobHandle handle = {};
+    handle.id = ((size_t) (uint32_t) generation << 32) | slot_index;
+    return handle;
+}
+
+static inline uint32_t GetSlotIndex(JobHandle handle)
+{
+    return (uint32_t) (handle.id & 0xFFFFFFFF);
+}
+
+static inline int32_t GetGeneration(JobHandle handle)
+{
+    return (int32_t) (uint32_t) (handle.id >> 32);
+}
+
+static inline uint32_t NextRandom()
+{
+    // xorshift32
+    uint32_t x = tls_random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    tls_random_state = x;
+    return x;
+}
+
+static void Enqueue(JobSystem* in_js, uint32_t slot_index);
+
+static void WakeWorker(JobSystem* in_js)
+{
+    if (Atomic::Load(&in_js->sleeping_threads) > 0)
+    {
+        Semaphore::Signal(&in_js->wake_semaphore, 1);
+    }
+}
+
+static void Execute(JobSystem* in_js, uint32_t slot_index)
+{
+    JobSystem::JobSlot* slot = &in_js->job_slots[slot_index];
+
+    Atomic::Exchange(&slot->state, (int32_t) JobSystem::JobState::Running);
+
+    slot->job.execute_fnc_ptr(&slot->job);
+
+    slot->continuations_lock.Lock();
+    {
+        // NOTE : moving the generation forward is what marks the job as done
+        // the interlocked op also makes the job's writes visible to anyone observing the new generation
+        int32_t next_gen = slot->generation + 1;
+        next_gen += (int32_t) (next_gen == 0);
+        Atomic::Exchange(&slot->generation, next_gen);
+    }
+    slot->continuations_lock.Unlock();
+
+    // NOTE : nobody registers against the old generation anymore and the slot can't be reused before it's Free ,
+    // so the continuations are walked without the lock , a continuation may schedule against this handle again
+    for (size_t i = 0; i < slot->continuations.size; ++i)
+    {
+        uint32_t cont_index = slot->continuations.data[i];
+        JobSystem::JobSlot* cont = &in_js->job_slots[cont_index];
+
+        if (Atomic::Decrement(&cont->pending_dependencies) == 0)
+        {
+            Enqueue(in_js, cont_index);
+        }
+    }
+
+    DArray<uint32_t>::Clear(&slot->continuations);
+    Atomic::Exchange(&slot->state, (int32_t) JobSystem::JobState::Free);
+}
+
+static void Inject(JobSystem* in_js, uint32_t slot_index)
+{
+    in_js->injected_jobs_lock.Lock();
+    {
+        Queue<uint32_t>::Enqueue(&in_js->injected_jobs, slot_index);
+    }
+    in_js->injected_jobs_lock.Unlock();
+
+    WakeWorker(in_js);
+}
+
+static void Enqueue(JobSystem* in_js, uint32_t slot_index)
+{
+    size_t th_index = tls_job_thread_index;
+
+    if (th_index == JOB_INVALID_THREAD)
+    {
+        Inject(in_js, slot_index);
+        return;
+    }
+
+    JobSystem::JobThread* th = &in_js->job_threads.data[th_index];
+
+    // NOTE : if our own queue is full the job goes to the injected queue , running it right away
+    // would nest jobs on this stack without any limit
+    if (!WorkStealingQueue::Push(&th->queue, slot_index))
+    {
+        Inject(in_js, slot_index);
+        return;
+    }
+
+    WakeWorker(in_js);
+}
+
+static bool TryGetJob(JobSystem* in_js, uint32_t* out_slot_index)
+{
+    size_t th_index = tls_job_thread_index;
+
+    // own queue first , LIFO keeps the caches warm
+    if (th_index != JOB_INVALID_THREAD)
+    {
+        JobSystem::JobThread* th = &in_js->job_threads.data[th_index];
+
+        if (WorkStealingQueue::TryPop(&th->queue, out_slot_index))
+        {
+            return true;
+        }
+    }
+
+    // steal from the others , start at a random victim to spread the contention
+    const size_t queue_count = in_js->job_threads.size;
+    size_t victim = NextRandom() % queue_count;
+
+    for (size_t i = 0; i < queue_count; ++i)
+    {
+        size_t curr = (victim + i) % queue_count;
+
+        if (curr == th_index)
+        {
+            continue;
+        }
+
+        if (WorkStealingQueue::TrySteal(&in_js->job_threads.data[curr].queue, out_slot_index))
+        {
+            return true;
+        }
+    }
+
+    // jobs coming from the outside
+    if (in_js->injected_jobs.size == 0)
+    {
+        return false;
+    }
+
+    bool found = false;
+    in_js->injected_jobs_lock.Lock();
+    {
+        found = Queue<uint32_t>::TryDequeue(&in_js->injected_jobs, out_slot_index);
+    }
+    in_js->injected_jobs_lock.Unlock();
+
+    return found;
+}
+
+static bool TryRunOne(JobSystem* in_js)
+{
+    uint32_t slot_index = {};
+
+    if (!TryGetJob(in_js, &slot_index))
+    {
+        return false;
+    }
+
+    Execute(in_js, slot_index);
+    return true;
+}
+
+static uint32_t AcquireSlot(JobSystem* in_js)
+{
+    while (true)
+    {
+        for (size_t i = 0; i < in_js->job_capacity; ++i)
+        {
+            uint32_t index = (uint32_t) ((uint32_t) Atomic::Increment(&in_js->next_slot) % in_js->job_capacity);
+            JobSystem::JobSlot* slot = &in_js->job_slots[index];
+
+            int32_t prev = Atomic::CompareExchange(&slot->state, (int32_t) JobSystem::JobState::Pending, (int32_t) JobSystem::JobState::Free);
+
+            if (prev == (int32_t) JobSystem::JobState::Free)
+            {
+                return index;
+            }
+        }
+
+        // every slot is in flight , help until one frees up
+        if (!TryRunOne(in_js))
+        {
+            Atomic::Pause();
+        }
+    }
+}
+
+/// <summary>
+/// Returns false if the dependency is already done , in which case nothing was registered
+/// </summary>
+static bool RegisterContinuation(JobSystem* in_js, JobHandle dependency, uint32_t slot_index)
+{
+    JobSystem::JobSlot* dep = &in_js->job_slots[GetSlotIndex(dependency)];
+
+    bool registered = false;
+
+    dep->continuations_lock.Lock();
+    {
+        if (Atomic::Load(&dep->generation) == GetGeneration(dependency))
+        {
+            DArray<uint32_t>::Add(&dep->continuations, slot_index);
+            registered = true;
+        }
+    }
+    dep->continuations_lock.Unlock();
+
+    return registered;
+}
+
+static uint32_t ThreadRun(void* data)
 {
-    JobSystem::ThreadParams th = *((JobSystem::ThreadParams*) data);
+    JobSystem::JobThread* th = (JobSystem::JobThread*) data;
+    JobSystem* js = th->job_system;
 
-    char buffer[1024] = {0};
-    
-    Arena arena = {};
-    arena.data = &buffer;
-    arena.capacity = 1024;
-    arena.offset = 0;
+    tls_job_thread_index = th->index;
+    tls_random_state = (uint32_t) (th->index * 2654435761u) | 1;
 
-    Allocator alloc = ArenaAllocator::Create(&arena);
+    size_t idle_count = 0;
 
-    while(true)
+    while (Atomic::Load(&js->is_running))
     {
-        DEFER([&](){ Arena::Reset(&arena); });
+        if (TryRunOne(js))
+        {
+            idle_count = 0;
+            continue;
+        }
+
+        if (++idle_count < JOB_SPIN_COUNT)
+        {
+            Atomic::Pause();
+            continue;
+        }
+
+        Atomic::Increment(&js->sleeping_threads);
+        Semaphore::Wait(&js->wake_semaphore, JOB_SLEEP_TIMEOUT_MS);
+        Atomic::Decrement(&js->sleeping_threads);
 
-        StringBuffer str = StringUtils::Format(alloc , alloc, "Thread index [{}]" , th.job_thread_ptr->index);
-        Global::logger.Log(str.view);
-        Global::platform.sleep(1000);
+        idle_count = 0;
     }
 
+    tls_job_thread_index = JOB_INVALID_THREAD;
+
+    // the jobs may have formatted or logged on this thread
+    ScratchArena::ReleaseThread();
+
     return 0;
 }
 
-void JobSystem::Create(size_t thread_count , JobSystem* out_js)
+void JobSystem::Create(size_t thread_count , Allocator alloc , JobSystem* out_js)
 {
     *out_js = {};
+    out_js->alloc = alloc;
     out_js->thread_count = thread_count;
-    DArray<JobThread>::Create(thread_count , &out_js->job_threads , Global::alloc_toolbox.heap_allocator);
+    out_js->job_capacity = DEFAULT_JOB_CAPACITY;
+    out_js->is_running = 1;
 
-    for(size_t i = 0; i < out_js->thread_count; ++i)
+    // job slots
+    {
+        const size_t slots_size = sizeof(JobSlot) * out_js->job_capacity;
+        out_js->job_slots = (JobSlot*) ALLOC(out_js->alloc, slots_size);
+        CoreContext::mem_init(out_js->job_slots, slots_size);
+
+        for (size_t i = 0; i < out_js->job_capacity; ++i)
+        {
+            JobSlot* slot = &out_js->job_slots[i];
+            slot->generation = 1;
+            slot->state = (int32_t) JobState::Free;
+            DArray<uint32_t>::Create(4, &slot->continuations, alloc);
+        }
+    }
+
+    Queue<uint32_t>::Create(&out_js->injected_jobs, 64, alloc);
+    Semaphore::Create(0, thread_count, &out_js->wake_semaphore);
+
+    // NOTE : all the JobThreads need to be added before starting any OS thread
+    // since the threads hold pointers into the array and steal from each other
+    DArray<JobThread>::Create(thread_count + 1, &out_js->job_threads, alloc);
+
+    for (size_t i = 0; i < thread_count + 1; ++i)
     {
-        ThreadParams* params = Global::alloc_toolbox.HeapAlloc<ThreadParams>();
-        
         JobThread th = {};
         th.index = i;
-        Queue<Job>::Create(&th.pending_jobs , 20 , Global::alloc_toolbox.heap_allocator);
-        Thread::Create(ThreadRun , params , &th.thread);
-        
-        DArray<JobThread>::Add(&out_js->job_threads , th);
-        size_t idx = out_js->job_threads.size - 1;
+        th.job_system = out_js;
+        WorkStealingQueue::Create(&th.queue, DEFAULT_QUEUE_CAPACITY, alloc);
+
+        DArray<JobThread>::Add(&out_js->job_threads, th);
+    }
 
-        params->job_thread_ptr = &out_js->job_threads.data[idx];
+    // the calling thread owns queue 0
+    tls_job_thread_index = 0;
+
+    for (size_t i = 1; i < out_js->job_threads.size; ++i)
+    {
+        JobThread* th = &out_js->job_threads.data[i];
 
-        th.thread.Run(&th.thread);
+        Thread::Create(ThreadRun, th, &th->thread);
+        Thread::Run(&th->thread);
     }
 }
 
 void JobSystem::Destroy(JobSystem* inout_js)
 {
-    for(size_t i = 0; i < inout_js->job_threads.size; ++i)
+    Atomic::Exchange(&inout_js->is_running, 0);
+    Semaphore::Signal(&inout_js->wake_semaphore, inout_js->thread_count);
+
+    // NOTE : every worker has to be joined before any queue goes away , they steal from each other until they exit
+    for(size_t i = 1; i < inout_js->job_threads.size; ++i)
     {
         JobThread* curr_th = &inout_js->job_threads.data[i];
-        
-        Thread::Suspend(&curr_th->thread);
+
+        Thread::Join(&curr_th->thread);
         Thread::Destroy(&curr_th->thread);
-        Queue<Job>::Destroy(&curr_th->pending_jobs);
     }
 
+    for(size_t i = 0; i < inout_js->job_threads.size; ++i)
+    {
+        WorkStealingQueue::Destroy(&inout_js->job_threads.data[i].queue);
+    }
+
+    for (size_t i = 0; i < inout_js->job_capacity; ++i)
+    {
+        DArray<uint32_t>::Destroy(&inout_js->job_slots[i].continuations);
+    }
+
+    tls_job_thread_index = JOB_INVALID_THREAD;
+
+    FREE(inout_js->alloc, inout_js->job_slots);
+    Queue<uint32_t>::Destroy(&inout_js->injected_jobs);
+    Semaphore::Destroy(&inout_js->wake_semaphore);
     DArray<JobThread>::Destroy(&inout_js->job_threads);
     *inout_js = {};
-}
\ No newline at end of file
+}
+
+JobHandle JobSystem::Schedule(JobSystem* in_js, Job job, ArrayView<JobHandle> dependencies)
+{
+    assert(job.execute_fnc_ptr != nullptr);
+
+    uint32_t slot_index = AcquireSlot(in_js);
+    JobSlot* slot = &in_js->job_slots[slot_index];
+
+    JobHandle handle = MakeHandle(slot_index, slot->generation);
+
+    slot->job = job;
+    slot->job.handle = handle;
+
+    // NOTE : the extra 1 keeps the job from being queued while we're still registering its dependencies
+    slot->pending_dependencies = (int32_t) dependencies.size + 1;
+
+    for (size_t i = 0; i < dependencies.size; ++i)
+    {
+        if (!RegisterContinuation(in_js, dependencies.data[i], slot_index))
+        {
+            Atomic::Decrement(&slot->pending_dependencies);
+        }
+    }
+
+    if (Atomic::Decrement(&slot->pending_dependencies) == 0)
+    {
+        Enqueue(in_js, slot_index);
+    }
+
+    return handle;
+}
+
+JobHandle JobSystem::Schedule(JobSystem* in_js, Job job)
+{
+    ArrayView<JobHandle> no_deps = {};
+    return Schedule(in_js, job, no_deps);
+}
+
+bool JobSystem::IsDone(JobSystem* in_js, JobHandle handle)
+{
+    JobSlot* slot = &in_js->job_slots[GetSlotIndex(handle)];
+    return Atomic::Load(&slot->generation) != GetGeneration(handle);
+}
+
+void JobSystem::Wait(JobSystem* in_js, JobHandle handle)
+{
+    while (!IsDone(in_js, handle))
+    {
+        if (!TryRunOne(in_js))
+        {
+            Atomic::Pause();
+        }
+    }
+}
+
+void JobSystem::WaitAll(JobSystem* in_js, ArrayView<JobHandle> handles)
+{
+    for (size_t i = 0; i < handles.size; ++i)
+    {
+        Wait(in_js, handles.data[i]);
+    }
+}
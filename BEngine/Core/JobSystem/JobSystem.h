@@ -1,15 +1,23 @@
 #pragma once
-#include <Defines/Defines.h>
+#include "../Defines/Defines.h"
 #include <Typedefs/Typedefs.h>
-#include <Containers/LinkedList.h>
 #include <Containers/DArray.h>
 #include <Containers/Queue.h>
+#include <Containers/ArrayView.h>
 #include <Defer/Defer.h>
 #include "../Thread/Thread.h"
-#include "../AtomicLock/AtomicLock.h"
+#include <Atomic/AtomicLock.h>
+#include <Atomic/Atomic.h>
+#include "../Semaphore/Semaphore.h"
+#include "WorkStealingQueue.h"
 
 struct BAPI Job;
+struct BAPI JobSystem;
 
+/// <summary>
+/// <para>Identifies a scheduled job , the low 32 bits are the slot index and the high 32 bits the slot generation</para>
+/// <para>Once the job is done the slot's generation moves on , so an outdated handle always reads as "done"</para>
+/// </summary>
 struct BAPI JobHandle
 {
     size_t id;
@@ -18,29 +26,86 @@ struct BAPI JobHandle
 struct BAPI Job
 {
     JobHandle handle;
-    LinkedList<JobHandle> dependencies;
     void* data;
-    ActionParams<Job*> execute_fnc_ptr; 
+    ActionParams<Job*> execute_fnc_ptr;
 };
 
 struct BAPI JobSystem
 {
-    struct JobThread
-    {        
-        size_t index;
-        Thread thread;
-        Queue<Job> pending_jobs;
-        AtomicLock pending_jobs_lock;
+    static const size_t DEFAULT_JOB_CAPACITY = 4096;
+    static const size_t DEFAULT_QUEUE_CAPACITY = 4096;
+
+    enum class JobState : int32_t
+    {
+        Free,
+        Pending,
+        Running
     };
 
-    struct ThreadParams
+    struct JobSlot
     {
-        JobThread* job_thread_ptr;
+        Job job;
+        volatile int32_t generation;
+        volatile int32_t state;
+
+        /// <summary>
+        /// Number of dependencies that are not done yet , the job is queued once it reaches 0
+        /// </summary>
+        volatile int32_t pending_dependencies;
+
+        /// <summary>
+        /// Indicies of the jobs waiting on this one to be done
+        /// </summary>
+        DArray<uint32_t> continuations;
+        AtomicLock continuations_lock;
     };
 
+    struct JobThread
+    {
+        size_t index;
+        Thread thread;
+        WorkStealingQueue queue;
+        JobSystem* job_system;
+    };
+
+    /// <summary>
+    /// <para>Index 0 is the thread that called Create (usually the main thread) , it doesn't get an OS thread</para>
+    /// <para>It only participates in running jobs when it calls Wait</para>
+    /// </summary>
     DArray<JobThread> job_threads;
     size_t thread_count;
 
-    static void Create(size_t thread_count , JobSystem* out_js);
+    JobSlot* job_slots;
+    size_t job_capacity;
+    volatile int32_t next_slot;
+
+    /// <summary>
+    /// Jobs scheduled from threads that don't own a queue (file watcher , logger ,etc ...)
+    /// </summary>
+    Queue<uint32_t> injected_jobs;
+    AtomicLock injected_jobs_lock;
+
+    Semaphore wake_semaphore;
+    volatile int32_t sleeping_threads;
+    volatile int32_t is_running;
+
+    Allocator alloc;
+
+    static void Create(size_t thread_count , Allocator alloc , JobSystem* out_js);
     static void Destroy(JobSystem* inout_js);
-};
\ No newline at end of file
+
+    /// <summary>
+    /// <para>Schedule a job that will only start once all the jobs in "dependencies" are done</para>
+    /// <para>The returned handle can be passed to Wait or used as a dependency for other jobs</para>
+    /// </summary>
+    static JobHandle Schedule(JobSystem* in_js, Job job, ArrayView<JobHandle> dependencies);
+    static JobHandle Schedule(JobSystem* in_js, Job job);
+
+    static bool IsDone(JobSystem* in_js, JobHandle handle);
+
+    /// <summary>
+    /// Runs other jobs on the calling thread until the job referred to by "handle" is done
+    /// </summary>
+    static void Wait(JobSystem* in_js, JobHandle handle);
+    static void WaitAll(JobSystem* in_js, ArrayView<JobHandle> handles);
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <stdint.h>
+#include <assert.h>
+#include <Allocators/Allocator.h>
+#include <Atomic/Atomic.h>
+
+/// <summary>
+/// <para>Fixed capacity lock-free deque (Chase-Lev) of job indicies</para>
+/// <para>Only the owning thread is allowed to Push and Pop (LIFO end) , any other thread can Steal (FIFO end)</para>
+/// <para>NOTE : the capacity has to be a power of two so that wrapping the indicies is just a mask</para>
+/// </summary>
+struct WorkStealingQueue
+{
+    volatile int64_t top;
+    volatile int64_t bottom;
+    uint32_t* data;
+    size_t capacity;
+    size_t mask;
+    Allocator alloc;
+
+    static void Create(WorkStealingQueue* out_queue, size_t capacity, Allocator alloc)
+    {
+        assert(capacity != 0 && (capacity & (capacity - 1)) == 0);
+
+        *out_queue = {};
+        out_queue->alloc = alloc;
+        out_queue->capacity = capacity;
+        out_queue->mask = capacity - 1;
+        out_queue->data = (uint32_t*) ALLOC(out_queue->alloc, sizeof(uint32_t) * capacity);
+    }
+
+    static void Destroy(WorkStealingQueue* inout_queue)
+    {
+        FREE(inout_queue->alloc, inout_queue->data);
+        *inout_queue = {};
+    }
+
+    /// <summary>
+    /// Owner only , returns false if the queue is full
+    /// </summary>
+    static bool Push(WorkStealingQueue* in_queue, uint32_t item)
+    {
+        int64_t b = Atomic::Load(&in_queue->bottom);
+        int64_t t = Atomic::Load(&in_queue->top);
+
+        if ((b - t) >= (int64_t) in_queue->capacity)
+        {
+            return false;
+        }
+
+        in_queue->data[b & in_queue->mask] = item;
+
+        // publish the item before the new bottom becomes visible to the thieves
+        Atomic::Store(&in_queue->bottom, b + 1);
+
+        return true;
+    }
+
+    /// <summary>
+    /// Owner only , takes the most recently pushed item
+    /// </summary>
+    static bool TryPop(WorkStealingQueue* in_queue, uint32_t* out_item)
+    {
+        int64_t b = Atomic::Load(&in_queue->bottom) - 1;
+
+        // NOTE : the exchange acts as a full fence , the new bottom has to be visible before we read the top
+        Atomic::Exchange(&in_queue->bottom, b);
+
+        int64_t t = Atomic::Load(&in_queue->top);
+
+        // empty , restore the bottom
+        if (t > b)
+        {
+            Atomic::Store(&in_queue->bottom, t);
+            return false;
+        }
+
+        uint32_t item = in_queue->data[b & in_queue->mask];
+
+        // more than one item left , no thief can reach this one
+        if (t != b)
+        {
+            *out_item = item;
+            return true;
+        }
+
+        // last item , race the thieves for it
+        bool won = Atomic::CompareExchange(&in_queue->top, t + 1, t) == t;
+        Atomic::Store(&in_queue->bottom, t + 1);
+
+        if (!won)
+        {
+            return false;
+        }
+
+        *out_item = item;
+        return true;
+    }
+
+    /// <summary>
+    /// Any thread , takes the oldest item
+    /// </summary>
+    static bool TrySteal(WorkStealingQueue* in_queue, uint32_t* out_item)
+    {
+        int64_t t = Atomic::Load(&in_queue->top);
+        int64_t b = Atomic::Load(&in_queue->bottom);
+
+        if (t >= b)
+        {
+            return false;
+        }
+
+        uint32_t item = in_queue->data[t & in_queue->mask];
+
+        // another thief or the owner got to it first
+        if (Atomic::CompareExchange(&in_queue->top, t + 1, t) != t)
+        {
+            return false;
+        }
+
+        *out_item = item;
+        return true;
+    }
+};
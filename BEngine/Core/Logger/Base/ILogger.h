@@ -1,7 +1,23 @@
 #pragma once
+#include <stdint.h>
 #include <String/StringView.h>
 #include <Typedefs/Typedefs.h>
 
+enum class LogLevel : uint8_t
+{
+    Log,
+    Info,
+    Warning,
+    Error,
+    Fatal,
+    NewLine
+};
+
+/// <summary>
+/// <para>A log sink , the callbacks are only ever called from the Logger's thread</para>
+/// <para>"flush" is optional , it's called when the Logger has nothing left to write : "force" is false while running ,
+/// the sink only writes if its buffer has waited long enough , and true when shutting down</para>
+/// </summary>
 struct ILogger
 {
     void* user_data;
@@ -11,5 +27,6 @@ struct ILogger
     ActionParams<ILogger*, StringView> warning;
     ActionParams<ILogger*, StringView> error;
     ActionParams<ILogger*, StringView> fatal;
+    ActionParams<ILogger*, bool> flush;
 };
 
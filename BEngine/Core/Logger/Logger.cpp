@@ -2,86 +2,231 @@
 #include "../Global/Global.h"
 #include <String/StringUtils.h>
 
-bool Comparer( size_t a, size_t b )
-{
-    return a == b;
-};
+// a sleeping logging thread wakes up on its own after this delay , covers the rare missed wake-up
+static const uint32_t LOG_SLEEP_TIMEOUT_MS = 10;
 
-size_t Hasher( size_t a )
-{
-    return a;
-};
+static_assert( sizeof( MPSCQueue<LogRecord>::Cell ) == 256, "A log record should fill its cell exactly" );
 
 void Logger::Initialize()
 {
-    HMap<size_t, ILogger>::Create( &loggers, Global::alloc_toolbox.heap_allocator, 10, Hasher, Comparer );
+    HMap<size_t, ILogger>::Create( &loggers, Global::alloc_toolbox.heap_allocator, 10 );
+    MPSCQueue<LogRecord>::Create( &records, QUEUE_CAPACITY, Global::alloc_toolbox.heap_allocator );
+
+    // NOTE : the line is only used by the logging thread , it allocates from the heap directly and not through the main allocators
+    ChunkedBuffer::Create( &line, HeapAllocator::Create() );
+
+    Semaphore::Create( 0, 1, &wake_semaphore );
+    is_running = 1;
+
+    Thread::Create( Run, this, &logging_thread );
+    Thread::Run( &logging_thread );
 };
 
 void Logger::Destroy()
 {
+    Atomic::Store( &is_running, 0 );
+    Semaphore::Signal( &wake_semaphore, 1 );
+
+    // the thread empties the queue before returning
+    Thread::Join( &logging_thread );
+    Thread::Destroy( &logging_thread );
+
+    Semaphore::Destroy( &wake_semaphore );
+    ChunkedBuffer::Destroy( &line );
+    MPSCQueue<LogRecord>::Destroy( &records );
     HMap<size_t, ILogger>::Destroy( &loggers );
 };
 
-void Logger::NewLine( size_t repeat )
+void Logger::Flush()
+{
+    int64_t target = MPSCQueue<LogRecord>::ReservedCount( &records );
+
+    while ( MPSCQueue<LogRecord>::PoppedCount( &records ) < target )
+    {
+        Semaphore::Signal( &wake_semaphore, 1 );
+        Thread::YieldTimeSlice();
+    }
+}
+
+void Logger::PushText( LogLevel level, StringView text )
 {
-    ArenaCheckpoint c = Global::alloc_toolbox.GetArenaCheckpoint();
-    DEFER([&](){ Global::alloc_toolbox.ResetArenaOffset( &c ); });
+    int64_t ticket = 0;
+    LogRecord* record = Reserve( &ticket );
 
-    DArray<Pair<size_t, ILogger>> tmp;
-    DArray<Pair<size_t, ILogger>>::Create(loggers.count, &tmp, Global::alloc_toolbox.frame_allocator);
-    HMap<size_t, ILogger>::GetAll(&loggers, &tmp);
+    record->level = level;
+    record->size = (uint32_t) text.length;
 
-    for (size_t i = 0; i < tmp.size; ++i)
+    if ( text.length <= LogRecord::PAYLOAD_SIZE )
     {
-        ILogger logger = tmp.data[i].value;
-        logger.new_line(&logger, repeat);
+        record->kind = LogRecord::Kind::Text;
+        memcpy( record->payload, text.buffer, text.length );
     }
-};
+    else
+    {
+        // long outputs (shader compiler , reports) , the logging thread frees the copy
+        char* copy = (char*) CoreContext::malloc( text.length );
+        memcpy( copy, text.buffer, text.length );
+
+        record->kind = LogRecord::Kind::HeapText;
+        memcpy( record->payload, &copy, sizeof( char* ) );
+    }
+
+    Commit( ticket );
+}
+
+void Logger::NewLine( size_t repeat )
+{
+    int64_t ticket = 0;
+    LogRecord* record = Reserve( &ticket );
 
-#define LOG(callback)\
-{\
-    char temp_buffer[1024] = {0};\
-    Arena arena = {};\
-    arena.data = &temp_buffer;\
-    arena.offset = 0;\
-    arena.capacity = 1024;\
-    \
-    Allocator alloc = ArenaAllocator::Create( &arena );\
-    {\
-        DArray<Pair<size_t, ILogger>> tmp;\
-        DArray<Pair<size_t, ILogger>>::Create( loggers.count, &tmp, alloc );\
-        HMap<size_t, ILogger>::GetAll( &loggers, &tmp );\
-        for ( size_t i = 0; i < tmp.size; ++i )\
-        {\
-            ILogger logger = tmp.data[i].value;\
-            logger.callback( &logger, message );\
-        }\
-    }\
-}\
+    record->kind = LogRecord::Kind::Text;
+    record->level = LogLevel::NewLine;
+    record->size = (uint32_t) repeat;
+
+    Commit( ticket );
+};
 
 void Logger::Log( StringView message )
 {
-    LOG( log )
+    PushText( LogLevel::Log, message );
 };
 
 void Logger::Info( StringView message )
 {
-    LOG( info )
+    PushText( LogLevel::Info, message );
 };
 
 void Logger::Warning( StringView message )
 {
-    LOG( warning )
+    PushText( LogLevel::Warning, message );
 };
 
 void Logger::Error( StringView message )
 {
-    LOG( error )
+    PushText( LogLevel::Error, message );
 };
 
 void Logger::Fatal( StringView message )
 {
-    LOG( fatal )
+    PushText( LogLevel::Fatal, message );
+    Flush();
 };
 
-#undef LOG
\ No newline at end of file
+uint32_t Logger::Run( void* param )
+{
+    Logger* logger = (Logger*) param;
+
+    while ( true )
+    {
+        if ( Drain( logger ) != 0 )
+        {
+            continue;
+        }
+
+        if ( !Atomic::Load( &logger->is_running ) )
+        {
+            // whatever was pushed while stopping
+            Drain( logger );
+            FlushSinks( logger, true );
+            break;
+        }
+
+        FlushSinks( logger, false );
+
+        Atomic::Exchange( &logger->is_sleeping, 1 );
+
+        if ( MPSCQueue<LogRecord>::TryPeek( &logger->records ) == nullptr )
+        {
+            Semaphore::Wait( &logger->wake_semaphore, LOG_SLEEP_TIMEOUT_MS );
+        }
+
+        Atomic::Store( &logger->is_sleeping, 0 );
+    }
+
+    return 0;
+}
+
+size_t Logger::Drain( Logger* logger )
+{
+    size_t count = 0;
+    LogRecord* record = nullptr;
+
+    while ( (record = MPSCQueue<LogRecord>::TryPeek( &logger->records )) != nullptr )
+    {
+        StringView text = {};
+
+        switch ( record->kind )
+        {
+            case LogRecord::Kind::Deferred:
+            {
+                ChunkedBuffer::Reset( &logger->line );
+                record->format( record->payload, &logger->line );
+                text = ChunkedBuffer::Flatten( &logger->line );
+                break;
+            }
+            case LogRecord::Kind::Text:
+            {
+                text.buffer = (const char*) record->payload;
+                text.length = record->size;
+                break;
+            }
+            case LogRecord::Kind::HeapText:
+            {
+                memcpy( &text.buffer, record->payload, sizeof( char* ) );
+                text.length = record->size;
+                break;
+            }
+        }
+
+        Dispatch( logger, record->level, text, record->size );
+
+        if ( record->kind == LogRecord::Kind::HeapText )
+        {
+            CoreContext::free( (void*) text.buffer );
+        }
+
+        MPSCQueue<LogRecord>::Pop( &logger->records );
+        count++;
+    }
+
+    return count;
+}
+
+void Logger::Dispatch( Logger* logger, LogLevel level, StringView text, size_t repeat )
+{
+    logger->loggers_lock.Lock();
+
+    for ( size_t i = 0; i < logger->loggers.all_values.size; ++i )
+    {
+        ILogger* sink = &logger->loggers.all_values.data[i];
+
+        switch ( level )
+        {
+            case LogLevel::Log: sink->log( sink, text ); break;
+            case LogLevel::Info: sink->info( sink, text ); break;
+            case LogLevel::Warning: sink->warning( sink, text ); break;
+            case LogLevel::Error: sink->error( sink, text ); break;
+            case LogLevel::Fatal: sink->fatal( sink, text ); break;
+            case LogLevel::NewLine: sink->new_line( sink, repeat ); break;
+        }
+    }
+
+    logger->loggers_lock.Unlock();
+}
+
+void Logger::FlushSinks( Logger* logger, bool force )
+{
+    logger->loggers_lock.Lock();
+
+    for ( size_t i = 0; i < logger->loggers.all_values.size; ++i )
+    {
+        ILogger* sink = &logger->loggers.all_values.data[i];
+
+        if ( sink->flush )
+        {
+            sink->flush( sink, force );
+        }
+    }
+
+    logger->loggers_lock.Unlock();
+}
@@ -2,17 +2,74 @@
 #include <String/StringView.h>
 #include <String/StringBuffer.h>
 #include <String/StringUtils.h>
+#include <String/DeferredFormat.h>
 #include <Containers/HMap.h>
+#include <Containers/MPSCQueue.h>
+#include <Containers/ChunkedBuffer.h>
+#include <Atomic/AtomicLock.h>
+#include <Allocators/ScratchArena.h>
+#include <Defer/Defer.h>
 #include "../Defines/Defines.h"
+#include "../Thread/Thread.h"
+#include "../Semaphore/Semaphore.h"
 #include "Base/ILogger.h"
 
 struct Global;
-struct ArenaCheckpoint;
 
+/// <summary>
+/// <para>One message on its way to the logging thread , a cell of the queue is exactly 256 bytes</para>
+/// <para>Deferred : "payload" holds the raw arguments and "format" turns them into text (see DeferredFormat)</para>
+/// <para>Text : "payload" holds the text itself , HeapText : "payload" holds a pointer to a malloc'ed copy , for the texts that don't fit</para>
+/// </summary>
+struct LogRecord
+{
+    static constexpr size_t PAYLOAD_SIZE = 232;
+
+    enum class Kind : uint8_t
+    {
+        Deferred,
+        Text,
+        HeapText
+    };
+
+    DeferredFormatter format;
+    LogLevel level;
+    Kind kind;
+
+    /// <summary>
+    /// Bytes used in "payload" , the text length for HeapText and the repeat count for NewLine
+    /// </summary>
+    uint32_t size;
+
+    uint8_t payload[PAYLOAD_SIZE];
+};
+
+/// <summary>
+/// <para>Callers never format nor touch the sinks : they copy a LogRecord into a lock-free queue and return</para>
+/// <para>A logging thread formats the records and hands the text to every ILogger , so the sinks are only ever called from that thread</para>
+/// <para>When it runs out of records the thread calls the sinks' "flush" , which is where buffering sinks write on a timer</para>
+/// <para>The FORMAT overloads only copy their arguments (tens of nanoseconds) , the runtime template ones still format on the caller</para>
+/// <para>NOTE : when the queue is full the callers wait for room , nothing is dropped. Fatal waits until everything before it is out</para>
+/// </summary>
 class BAPI Logger
 {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 4'096;
+
 private:
     HMap<size_t, ILogger> loggers;
+    AtomicLock loggers_lock;
+
+    MPSCQueue<LogRecord> records;
+    Thread logging_thread;
+    Semaphore wake_semaphore;
+    volatile int32_t is_sleeping;
+    volatile int32_t is_running;
+
+    /// <summary>
+    /// Logging thread only , where the deferred records are formatted
+    /// </summary>
+    ChunkedBuffer line;
 
 public:
     void Initialize();
@@ -20,12 +77,16 @@ public:
 
     size_t Add( ILogger in_logger )
     {
+        loggers_lock.Lock();
+
         const size_t id = loggers.count;
 
         size_t out_index;
 
         HMap<size_t, ILogger>::TryAdd( &loggers, id, in_logger, &out_index );
 
+        loggers_lock.Unlock();
+
         return id;
     };
 
@@ -33,9 +94,18 @@ public:
     {
         ILogger removed = {};
 
-        return HMap<size_t, ILogger>::TryRemove( &loggers, id, &removed );
+        loggers_lock.Lock();
+        bool is_removed = HMap<size_t, ILogger>::TryRemove( &loggers, id, &removed );
+        loggers_lock.Unlock();
+
+        return is_removed;
     };
 
+    /// <summary>
+    /// Blocks until every record pushed before the call went through the sinks
+    /// </summary>
+    void Flush();
+
     void Log( StringView message );
 
     void Info( StringView message );
@@ -48,61 +118,129 @@ public:
 
     void NewLine( size_t repeat = 1 );
 
-#define LOG(callback)             \
+#define LOG(level)             \
 {                                 \
-    char temp_buffer[1024] = {0}; \
-    Arena arena = {};             \
-    arena.data = &temp_buffer;    \
-    arena.capacity = 1024;        \
-    arena.offset = 0;             \
-    Allocator temp_alloc = ArenaAllocator::Create(&arena);\
-    \
-    Allocator alloc = ArenaAllocator::Create( &CoreContext::core_arena );\
-    StringBuffer str = StringUtils::Format( alloc, temp_alloc, message, args... );\
-    ArenaCheckpoint c = Global::alloc_toolbox.GetArenaCheckpoint();\
-    {\
-        DArray<Pair<size_t, ILogger>> tmp;\
-        DArray<Pair<size_t, ILogger>>::Create( loggers.count, &tmp, Global::alloc_toolbox.frame_allocator );\
-        HMap<size_t, ILogger>::GetAll( &loggers, &tmp );\
-        for ( size_t i = 0; i < tmp.size; ++i )\
-        {\
-            ILogger logger = tmp.data[i].value;\
-            logger.callback( &logger, str.view );\
-        }\
-    }\
+    ScratchArena scratch = ScratchArena::Get();\
+    DEFER([&](){ ScratchArena::Release( &scratch ); });\
     \
-    Global::alloc_toolbox.ResetArenaOffset( &c );\
+    StringBuffer str = StringUtils::Format( scratch.alloc, message, args... );\
+    PushText( level, str.view );\
 }\
 
+    // the template is a runtime string , it's formatted here , prefer the FORMAT overloads below for literals
     template<typename ...Args>
     void  Log( StringView message, Args... args )
     {
-        LOG( log );
+        LOG( LogLevel::Log );
     };
 
     template<typename ...Args>
     void  Info( StringView message, Args... args )
     {
-        LOG( info );
+        LOG( LogLevel::Info );
     };
 
     template<typename ...Args>
     void  Warning( StringView message, Args... args )
     {
-        LOG( warning );
+        LOG( LogLevel::Warning );
     };
 
     template<typename ...Args>
     void  Error( StringView message, Args... args )
     {
-        LOG( error );
+        LOG( LogLevel::Error );
     };
 
     template<typename ...Args>
     void Fatal( StringView message, Args... args )
     {
-        LOG(fatal)
+        LOG( LogLevel::Fatal )
+        Flush();
     };
 
 #undef LOG
+
+    // logger.Info( FORMAT( "loaded {} in {} ms" ) , path , time ) , parsed when compiling , formatted on the logging thread
+    template<typename TSource, typename ...Args>
+    void Log( CompiledFormat<TSource> message, Args... args )
+    {
+        PushDeferred( LogLevel::Log, message, args... );
+    };
+
+    template<typename TSource, typename ...Args>
+    void Info( CompiledFormat<TSource> message, Args... args )
+    {
+        PushDeferred( LogLevel::Info, message, args... );
+    };
+
+    template<typename TSource, typename ...Args>
+    void Warning( CompiledFormat<TSource> message, Args... args )
+    {
+        PushDeferred( LogLevel::Warning, message, args... );
+    };
+
+    template<typename TSource, typename ...Args>
+    void Error( CompiledFormat<TSource> message, Args... args )
+    {
+        PushDeferred( LogLevel::Error, message, args... );
+    };
+
+    template<typename TSource, typename ...Args>
+    void Fatal( CompiledFormat<TSource> message, Args... args )
+    {
+        PushDeferred( LogLevel::Fatal, message, args... );
+        Flush();
+    };
+
+private:
+
+    template<typename TSource, typename ...Args>
+    void PushDeferred( LogLevel level, CompiledFormat<TSource> format, const Args&... args )
+    {
+        int64_t ticket = 0;
+        LogRecord* record = Reserve( &ticket );
+
+        record->kind = LogRecord::Kind::Deferred;
+        record->level = level;
+        record->format = DeferredFormat::FormatterOf( format, args... );
+        record->size = (uint32_t) DeferredFormat::Encode( record->payload, args... );
+
+        Commit( ticket );
+    }
+
+    void PushText( LogLevel level, StringView text );
+
+    /// <summary>
+    /// A free cell of the queue , waits for the logging thread to make room when it's full
+    /// </summary>
+    LogRecord* Reserve( int64_t* out_ticket )
+    {
+        LogRecord* record = MPSCQueue<LogRecord>::TryReserve( &records, out_ticket );
+
+        while ( record == nullptr )
+        {
+            Semaphore::Signal( &wake_semaphore, 1 );
+            Thread::YieldTimeSlice();
+
+            record = MPSCQueue<LogRecord>::TryReserve( &records, out_ticket );
+        }
+
+        return record;
+    }
+
+    void Commit( int64_t ticket )
+    {
+        MPSCQueue<LogRecord>::Publish( &records, ticket );
+
+        if ( Atomic::Load( &is_sleeping ) )
+        {
+            Semaphore::Signal( &wake_semaphore, 1 );
+        }
+    }
+
+    static uint32_t Run( void* param );
+    static size_t Drain( Logger* logger );
+    static void Dispatch( Logger* logger, LogLevel level, StringView text, size_t repeat );
+    static void FlushSinks( Logger* logger, bool force );
 };
@@ -0,0 +1,276 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <Allocators/Allocator.h>
+#include <String/StringView.h>
+#include <String/StringBuffer.h>
+#include <String/StringBuilder.h>
+#include <String/StringUtils.h>
+#include <Clock/Clock.h>
+#include "../Base/ILogger.h"
+
+/// <summary>
+/// <para>Writes the log to a file in large batches : lines are appended to a StringBuilder whose chunks are the batch size ,
+/// so a flush is one write per chunk</para>
+/// <para>A batch goes to the file when it's full , when a line at "flush_level" or above comes in ,
+/// or when it has waited "flush_interval_ms" (checked on every line and every time the Logger goes idle)</para>
+/// <para>When a batch would take the file past "max_file_size" the file is rotated : "path" becomes "path.1" , "path.1" becomes "path.2" ,
+/// and so on up to "max_rotated_files"</para>
+/// <para>When the file can't be opened again after a rotation the batch stays pending and the open is retried on the next flush ,
+/// a batch that fills up in the meantime is dropped (see "dropped_count")</para>
+/// <para>NOTE : it's only called from the Logger's thread , the game threads never wait on the disk</para>
+/// </summary>
+struct FileLogger
+{
+    struct Params
+    {
+        StringView path;
+        size_t batch_size = 64 * 1'024;
+        uint32_t flush_interval_ms = 250;
+        LogLevel flush_level = LogLevel::Error;
+
+        /// <summary>
+        /// 0 never rotates
+        /// </summary>
+        size_t max_file_size = 16 * 1'024 * 1'024;
+        uint32_t max_rotated_files = 3;
+    };
+
+    struct FileLoggerData
+    {
+        Params params;
+        StringBuffer path;
+        FILE* file;
+        size_t file_size;
+        StringBuilder pending;
+        uint64_t last_flush_ms;
+        Allocator alloc;
+
+        /// <summary>
+        /// Batches written , files rotated and batches lost while the file couldn't be opened , for the stats
+        /// </summary>
+        size_t write_count;
+        size_t rotation_count;
+        size_t dropped_count;
+    };
+
+    /// <summary>
+    /// Opens (truncates) "params.path" , false if the file can't be opened
+    /// </summary>
+    static bool Create(ILogger *out_logger, Params params, Allocator alloc)
+    {
+        *out_logger = {};
+
+        FileLoggerData *data = (FileLoggerData *)ALLOC(alloc, sizeof(FileLoggerData));
+        *data = {};
+        data->alloc = alloc;
+        data->params = params;
+        data->path = StringBuffer::Create(params.path, alloc);
+        data->last_flush_ms = Clock::NowMs();
+
+        StringBuilder::Create(&data->pending, alloc, params.batch_size);
+
+        if (!Open(data))
+        {
+            StringBuilder::Destroy(&data->pending);
+            StringBuffer::Destroy(&data->path);
+            FREE(alloc, data);
+
+            return false;
+        }
+
+        out_logger->user_data = data;
+        out_logger->log = Log;
+        out_logger->info = Info;
+        out_logger->warning = Warning;
+        out_logger->error = Error;
+        out_logger->fatal = Fatal;
+        out_logger->new_line = NewLine;
+        out_logger->flush = Flush;
+
+        return true;
+    }
+
+    /// <summary>
+    /// Writes what's pending and closes the file , remove the sink from the Logger first
+    /// </summary>
+    static bool Destroy(ILogger *in_logger)
+    {
+        FileLoggerData *data = (FileLoggerData *)in_logger->user_data;
+        Allocator alloc = data->alloc;
+
+        WriteBatch(data);
+
+        if (data->file != nullptr)
+        {
+            fclose(data->file);
+        }
+
+        StringBuilder::Destroy(&data->pending);
+        StringBuffer::Destroy(&data->path);
+        FREE(alloc, data);
+
+        *in_logger = {};
+
+        return true;
+    }
+
+    static void Flush(ILogger *in_logger, bool force)
+    {
+        FileLoggerData *data = (FileLoggerData *)in_logger->user_data;
+
+        if (force || Clock::NowMs() - data->last_flush_ms >= data->params.flush_interval_ms)
+        {
+            WriteBatch(data);
+        }
+    }
+
+private:
+    static void Append(ILogger *in_logger, LogLevel level, StringView tag, StringView message)
+    {
+        FileLoggerData *data = (FileLoggerData *)in_logger->user_data;
+
+        StringBuilder::Append(&data->pending, tag);
+        StringBuilder::Append(&data->pending, message);
+        StringBuilder::Append(&data->pending, '\n');
+
+        bool is_full = data->pending.size >= data->params.batch_size;
+        bool is_urgent = (uint8_t)level >= (uint8_t)data->params.flush_level;
+
+        if (is_full || is_urgent || Clock::NowMs() - data->last_flush_ms >= data->params.flush_interval_ms)
+        {
+            WriteBatch(data);
+        }
+    }
+
+    static void WriteBatch(FileLoggerData *data)
+    {
+        data->last_flush_ms = Clock::NowMs();
+
+        if (data->pending.size == 0)
+        {
+            return;
+        }
+
+        if (data->params.max_file_size != 0 && data->file_size != 0 && data->file_size + data->pending.size > data->params.max_file_size)
+        {
+            Rotate(data);
+        }
+
+        // the last rotation couldn't reopen the file , keep the batch for the next flush unless it's full
+        if (data->file == nullptr && !Open(data))
+        {
+            if (data->pending.size >= data->params.batch_size)
+            {
+                data->dropped_count++;
+                StringBuilder::Clear(&data->pending);
+            }
+
+            return;
+        }
+
+        // one fwrite per chunk , the stream itself is unbuffered
+        StringBuilder::WriteTo(&data->pending, data->file);
+        fflush(data->file);
+
+        data->file_size += data->pending.size;
+        data->write_count++;
+
+        StringBuilder::Clear(&data->pending);
+    }
+
+    static bool Open(FileLoggerData *data)
+    {
+        char path[512];
+        FormatPath(data, 0, path, sizeof(path));
+
+        data->file = fopen(path, "wb");
+        data->file_size = 0;
+
+        if (data->file == nullptr)
+        {
+            return false;
+        }
+
+        setvbuf(data->file, nullptr, _IONBF, 0);
+
+        return true;
+    }
+
+    /// <summary>
+    /// Closes the file , shifts the rotated ones and opens a new one , false with "data->file" left null when that last open fails
+    /// </summary>
+    static bool Rotate(FileLoggerData *data)
+    {
+        fclose(data->file);
+        data->file = nullptr;
+
+        char from[512];
+        char to[512];
+
+        // the oldest goes away , the others move up by one
+        FormatPath(data, data->params.max_rotated_files, to, sizeof(to));
+        remove(to);
+
+        for (uint32_t i = data->params.max_rotated_files; i > 0; --i)
+        {
+            FormatPath(data, i - 1, from, sizeof(from));
+            FormatPath(data, i, to, sizeof(to));
+            rename(from, to);
+        }
+
+        data->rotation_count++;
+
+        return Open(data);
+    }
+
+    /// <summary>
+    /// "path" for index 0 , "path.index" for the rotated files
+    /// </summary>
+    static void FormatPath(FileLoggerData *data, uint32_t index, char *out_path, size_t capacity)
+    {
+        if (index == 0)
+        {
+            snprintf(out_path, capacity, "%.*s", (int)data->path.length, data->path.buffer);
+        }
+        else
+        {
+            snprintf(out_path, capacity, "%.*s.%u", (int)data->path.length, data->path.buffer, index);
+        }
+    }
+
+    static void Log(ILogger *in_logger, StringView message)
+    {
+        Append(in_logger, LogLevel::Log, "[LOG] ", message);
+    }
+
+    static void Info(ILogger *in_logger, StringView message)
+    {
+        Append(in_logger, LogLevel::Info, "[INFO] ", message);
+    }
+
+    static void Warning(ILogger *in_logger, StringView message)
+    {
+        Append(in_logger, LogLevel::Warning, "[WARNING] ", message);
+    }
+
+    static void Error(ILogger *in_logger, StringView message)
+    {
+        Append(in_logger, LogLevel::Error, "[ERROR] ", message);
+    }
+
+    static void Fatal(ILogger *in_logger, StringView message)
+    {
+        Append(in_logger, LogLevel::Fatal, "[FATAL] ", message);
+    }
+
+    static void NewLine(ILogger *in_logger, size_t repeat)
+    {
+        FileLoggerData *data = (FileLoggerData *)in_logger->user_data;
+
+        for (size_t i = 0; i < repeat; ++i)
+        {
+            StringBuilder::Append(&data->pending, '\n');
+        }
+    }
+};
@@ -25,6 +25,9 @@ struct BAPI Filesystem
     Func<bool, const FileHandle*, size_t*> get_size;
     Func<bool, const FileHandle*, StringBuffer*> read_text;
     Func<bool, const FileHandle, void* , uint64_t*> read_all;
+
+    // reads up to "size" bytes from where the last read stopped , false once the end of the file is reached
+    Func<bool, const FileHandle, void* , uint64_t , uint64_t*> read_chunk;
     Func<bool, const FileHandle*, StringView> write_text;
     Func<bool, const FileHandle*, ArrayView<char>> write_bytes;
 
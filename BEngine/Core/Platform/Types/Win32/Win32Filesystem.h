@@ -1,5 +1,7 @@
 #include "../../Base/Filesystem.h"
 #include "../../../Global/Global.h"
+#include <Allocators/ScratchArena.h>
+#include <Defer/Defer.h>
 #include <sys/stat.h>
 #include <cstdio>
 #pragma warning(disable : 4996)
@@ -16,6 +18,7 @@ public:
         out_filesystem->write_text = WriteText;
         out_filesystem->write_bytes = WriteBytes;
         out_filesystem->read_all = ReadAll;
+        out_filesystem->read_chunk = ReadChunk;
         out_filesystem->get_size = Win32GetSize;
         out_filesystem->get_files = Win32GetFiles;
         out_filesystem->get_directories = Win32GetDirectories;
@@ -24,17 +27,11 @@ public:
 private:
     static void Win32GetDirectories(StringView path, DArray<StringBuffer> *inout_sub_files, Allocator alloc)
     {
-        char temp_buffer[1024] = {0};
+        ScratchArena scratch = ScratchArena::Get(alloc);
+        DEFER([&](){ ScratchArena::Release(&scratch); });
 
-        Arena temp_arena = {};
-        temp_arena.data = &temp_buffer;
-        temp_arena.capacity = 1024;
-        temp_arena.offset = 0;
-
-        Allocator temp_alloc = ArenaAllocator::Create(&temp_arena);
-
-        StringBuffer fmt = StringUtils::Format(Global::alloc_toolbox.frame_allocator, temp_alloc , "{}\\*", path);
-        char *str = StringView::ToCString(fmt.view, Global::alloc_toolbox.frame_allocator);
+        StringBuffer fmt = StringUtils::Format(scratch.alloc, "{}\\*", path);
+        char *str = StringView::ToCString(fmt.view, scratch.alloc);
 
         WIN32_FIND_DATA find_data;
         HANDLE file_h = FindFirstFile(str, &find_data); // FILES
@@ -62,17 +59,11 @@ private:
 
     static void Win32GetFiles(StringView path, DArray<StringBuffer> *inout_sub_files, Allocator alloc)
     {
-        char temp_buffer[1024] = {0};
-    
-        Arena arena = {};
-        arena.data = &temp_buffer;
-        arena.capacity = 1024;
-        arena.offset = 0;
-    
-        Allocator temp_alloc = ArenaAllocator::Create(&arena);
-
-        StringBuffer fmt = StringUtils::Format(Global::alloc_toolbox.frame_allocator, temp_alloc, "{}\\*", path);
-        char *str = StringView::ToCString(fmt.view, Global::alloc_toolbox.frame_allocator);
+        ScratchArena scratch = ScratchArena::Get(alloc);
+        DEFER([&](){ ScratchArena::Release(&scratch); });
+
+        StringBuffer fmt = StringUtils::Format(scratch.alloc, "{}\\*", path);
+        char *str = StringView::ToCString(fmt.view, scratch.alloc);
 
         WIN32_FIND_DATA find_data;
         HANDLE file_h = FindFirstFile(str, &find_data); // FILES
@@ -199,6 +190,18 @@ private:
         return *outReadBytes == fileSize;
     }
 
+    static bool ReadChunk(const FileHandle fileHandle, void *outBytes, uint64_t size, uint64_t *outReadBytes)
+    {
+        *outReadBytes = 0;
+
+        if (!fileHandle.handle || !fileHandle.is_valid || !outBytes)
+            return false;
+
+        *outReadBytes = fread(outBytes, 1, size, (FILE *)fileHandle.handle);
+
+        return *outReadBytes != 0;
+    }
+
     static bool WriteBytes(const FileHandle *file_handle, ArrayView<char> in_bytes)
     {
         if (!file_handle->handle || !file_handle->is_valid)
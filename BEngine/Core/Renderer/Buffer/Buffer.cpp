@@ -128,6 +128,23 @@ bool Buffer::Copy(VkCommandPool pool, Fence fence, VkQueue queue, Buffer* src, u
     return true;
 }
 
+bool Buffer::CopyRegions(VkCommandPool pool, VkQueue queue, Buffer* src, Buffer* dst, const VkBufferCopy* regions, uint32_t region_count )
+{
+    if ( region_count == 0 )
+    {
+        return true;
+    }
+
+    vkQueueWaitIdle( queue );
+
+    CommandBuffer cmd = {};
+    CommandBuffer::SingleUseAllocateBegin(pool, &cmd );
+
+    vkCmdCopyBuffer( cmd.handle, src->handle, dst->handle, region_count, regions );
+
+    return CommandBuffer::SingleUseEndSubmit(pool, &cmd, queue );
+}
+
 bool Buffer::Resize(uint32_t new_size, VkQueue queue, VkCommandPool pool, Buffer* in_buffer )
 {
     VulkanContext *context = (VulkanContext *)Global::backend_renderer.user_data;
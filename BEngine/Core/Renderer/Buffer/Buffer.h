@@ -46,6 +46,11 @@ struct BAPI Buffer
     /// <returns></returns>
     static bool Unlock (Buffer* in_buffer );
     static bool Copy (VkCommandPool pool, Fence fence, VkQueue queue, Buffer* src, uint32_t srcOffset, Buffer* dst, uint32_t dstOffset, uint32_t size );
+
+    /// <summary>
+    /// Same as Copy for a batch of ranges , recorded as a single vkCmdCopyBuffer , src and dst can be the same buffer as long as no two regions overlap. Returns false if the submit failed
+    /// </summary>
+    static bool CopyRegions (VkCommandPool pool, VkQueue queue, Buffer* src, Buffer* dst, const VkBufferCopy* regions, uint32_t region_count );
     static bool Resize (uint32_t newSize, VkQueue queue, VkCommandPool pool, Buffer* in_buffer );
     static bool Bind (uint32_t offset , Buffer* in_buffer );
 };
\ No newline at end of file
@@ -82,7 +82,7 @@ void CommandBuffer::SingleUseAllocateBegin (VkCommandPool pool, CommandBuffer* o
     out_command_buffer->Begin ( true, false, false );
 }
 
-void CommandBuffer::SingleUseEndSubmit (VkCommandPool pool, CommandBuffer* out_command_buffer , VkQueue queue )
+bool CommandBuffer::SingleUseEndSubmit (VkCommandPool pool, CommandBuffer* out_command_buffer , VkQueue queue )
 {
     VulkanContext *context = (VulkanContext *)Global::backend_renderer.user_data;
     
@@ -93,9 +93,11 @@ void CommandBuffer::SingleUseEndSubmit (VkCommandPool pool, CommandBuffer* out_c
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &out_command_buffer->handle;
  
-    vkQueueSubmit ( queue, 1, &submitInfo, nullptr );
+    VkResult res = vkQueueSubmit ( queue, 1, &submitInfo, nullptr );
 
     vkQueueWaitIdle ( queue );
 
     CommandBuffer::Free ( pool, out_command_buffer );
+
+    return res == VK_SUCCESS;
 }
\ No newline at end of file
@@ -24,5 +24,8 @@ struct BAPI CommandBuffer
     static void Allocate (VkCommandPool pool, bool isPrimary, CommandBuffer* out_command_buffer );
     static void Free (VkCommandPool pool, CommandBuffer* out_command_buffer );
     static void SingleUseAllocateBegin (VkCommandPool pool, CommandBuffer* out_command_buffer );
-    static void SingleUseEndSubmit (VkCommandPool pool, CommandBuffer* out_command_buffer, VkQueue queue );
+    /// <summary>
+    /// Returns false if the submit failed , the command buffer is freed either way
+    /// </summary>
+    static bool SingleUseEndSubmit (VkCommandPool pool, CommandBuffer* out_command_buffer, VkQueue queue );
 };
@@ -16,4 +16,11 @@ struct DrawMesh
 struct RendererContext
 {
     DArray<DrawMesh> mesh_draws;
+
+    /// <summary>
+    /// <para>Blocks of mesh_buffer / descriptors_buffer the renderer is allowed to move this frame to compact the buffers</para>
+    /// <para>The handles are patched in place once the frame is submitted , so they must point at the copies that live across frames (Mesh3D::verticies_block , not DrawMesh::instances_data)</para>
+    /// </summary>
+    DArray<FreeList::Node*> mesh_handles;
+    DArray<FreeList::Node*> descriptors_handles;
 };
\ No newline at end of file
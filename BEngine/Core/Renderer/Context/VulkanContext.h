@@ -2,6 +2,7 @@
 #include <vulkan/vulkan.h>
 #include <Maths/Vector2Int.h>
 #include <Containers/FreeList.h>
+#include <Containers/FreeListDefragmenter.h>
 #include <Maths/Rect.h>
 #include <Maths/Color.h>
 #include "LogicalDeviceInfo.h"
@@ -38,9 +39,11 @@ struct BAPI VulkanContext
     
 	Buffer mesh_buffer;
 	FreeList mesh_freelist;
+	FreeListDefragmenter mesh_defragmenter;
 
 	Buffer descriptors_buffer;
 	FreeList descriptors_freelist;
+	FreeListDefragmenter descriptors_defragmenter;
 	
     VkSampler default_sampler;
 
@@ -5,7 +5,7 @@
 void DescriptorManager::Create( VulkanContext* context, DescriptorManager* out_manager )
 {
     *out_manager = {};
-    HMap<DescriptorLayoutInfo, DescriptorPoolInfo>::Create( &out_manager->pools_map, Global::alloc_toolbox.heap_allocator, 10, ShaderUtils::DescriptorLayoutHash, ShaderUtils::DescriptorLayoutComparer );
+    FuncHMap<DescriptorLayoutInfo, DescriptorPoolInfo>::Create( &out_manager->pools_map, Global::alloc_toolbox.heap_allocator, 10, ShaderUtils::DescriptorLayoutHash, ShaderUtils::DescriptorLayoutComparer );
 }
 
 void DescriptorManager::Destroy( DescriptorManager* in_manager )
@@ -19,7 +19,7 @@ void DescriptorManager::Destroy( DescriptorManager* in_manager )
         vkDestroyDescriptorPool( context->logical_device_info.handle, pool.pool_handle, VK_NULL_HANDLE );
     }
 
-    HMap<DescriptorLayoutInfo, DescriptorPoolInfo>::Destroy( &in_manager->pools_map );
+    FuncHMap<DescriptorLayoutInfo, DescriptorPoolInfo>::Destroy( &in_manager->pools_map );
 
     *in_manager = {};
 }
@@ -29,7 +29,7 @@ bool DescriptorManager::Allocate( DescriptorLayoutInfo layout, DescriptorManager
 {
     DescriptorPoolInfo* pool_info = {};
 
-    if ( HMap<DescriptorLayoutInfo, DescriptorPoolInfo>::TryGet( &in_manager->pools_map, layout, &pool_info ) )
+    if ( FuncHMap<DescriptorLayoutInfo, DescriptorPoolInfo>::TryGet( &in_manager->pools_map, layout, &pool_info ) )
     {
         *out_descriptor = pool_info;
         return true;
@@ -73,7 +73,7 @@ bool DescriptorManager::Allocate( DescriptorLayoutInfo layout, DescriptorManager
             DArray<DescriptorBindingInfo>::Create( layout.bindings.data, &layout_copy.bindings, layout.bindings.size, Global::alloc_toolbox.heap_allocator );
 
             size_t insertion_index = {};
-            if ( !HMap<DescriptorLayoutInfo, DescriptorPoolInfo>::TryAdd( &in_manager->pools_map, layout_copy, pool_to_use, &insertion_index ) )
+            if ( !FuncHMap<DescriptorLayoutInfo, DescriptorPoolInfo>::TryAdd( &in_manager->pools_map, layout_copy, pool_to_use, &insertion_index ) )
             {
                 Global::logger.Log( "DescriptorLayout alreayd exists , Check the hashing or the data passed" );
             }
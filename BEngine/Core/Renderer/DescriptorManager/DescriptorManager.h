@@ -17,7 +17,7 @@ struct DescriptorManager
 {
     size_t init_sets_count;
     float resize_factor;
-    HMap<DescriptorLayoutInfo, DescriptorPoolInfo> pools_map;
+    FuncHMap<DescriptorLayoutInfo, DescriptorPoolInfo> pools_map;
 
     static void Create( VulkanContext* context, DescriptorManager* out_manager );
 
@@ -4,6 +4,7 @@
 #include <Containers/FreeList.h>
 #include <Containers/ArrayView.h>
 #include <Maths/Vector3.h>
+#include <Serialization/BinarySerializer.h>
 #include "../../Defines/Defines.h"
 #include "Vertex3D.h"
 
@@ -19,4 +20,14 @@ struct BAPI Mesh3D
     static void Destroy(Mesh3D *inout_mesh);
     static void AllocData(Mesh3D *inout_mesh, ArrayView<Vertex3D> verts, ArrayView<uint32_t> indicies);
     static void FreeData(Mesh3D *inout_mesh);
-};
\ No newline at end of file
+};
+
+/// <summary>
+/// Only the geometry is written , the FreeList blocks are gpu buffer state and are zero once loaded
+/// </summary>
+template<>
+struct BinaryDescriptor<Mesh3D>
+{
+    static constexpr uint32_t VERSION = 1;
+    static constexpr BinaryField FIELDS[] = { BINARY_FIELD( Mesh3D, vertices ), BINARY_FIELD( Mesh3D, indicies ) };
+};
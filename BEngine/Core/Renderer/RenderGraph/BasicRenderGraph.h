@@ -81,6 +81,11 @@ struct BasicRenderGraph
         screen.x = Global::platform.window.width;
         screen.y = Global::platform.window.height;
 
+        // the names are only hashed here , the graph resolves its targets by id
+        StringID pass_id = StringInterner::Intern(&Global::names, renderpass_id);
+        StringID color_id = StringInterner::Intern(&Global::names, color_attachment_id);
+        StringID depth_id = StringInterner::Intern(&Global::names, depth_attachment_id);
+
         Subpass ui_pass = {};
         bool created_pass = UISubpass::Create(ctx, &ui_pass);
         assert(created_pass);
@@ -92,16 +97,16 @@ struct BasicRenderGraph
             params->area = Rect{0, 0, (float)screen.x, (float)screen.y};
             params->stencil = 0;
             params->depth = 1;
-            params->color_id = color_attachment_id;
-            params->depth_id = depth_attachment_id;
+            params->color_id = color_id;
+            params->depth_id = depth_id;
         }
 
         RenderGraphBuilder graph_builder = RenderGraphBuilder::Create(Global::alloc_toolbox.frame_allocator);
 
         graph_builder
-            .AddRenderpass(renderpass_id, params , BasicRenderpass::Builder)
-            ->AddRenderTarget(color_attachment_id, 0, color_attachment_desc)
-            ->AddRenderTarget(depth_attachment_id, 1, depth_attachment_desc)
+            .AddRenderpass(pass_id, params , BasicRenderpass::Builder)
+            ->AddRenderTarget(color_id, 0, color_attachment_desc)
+            ->AddRenderTarget(depth_id, 1, depth_attachment_desc)
             ->AddSubpass(ui_pass)
             ->Done();
 
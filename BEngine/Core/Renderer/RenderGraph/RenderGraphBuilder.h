@@ -16,7 +16,7 @@ typedef Func<Renderpass , RenderGraphBuilder* , RenderGraph*,RenderpassNode> Ren
 
 struct RenderGraph
 {
-    HMap<StringView , Texture> all_textures;
+    HMap<StringID , Texture> all_textures;
     DArray<Renderpass> renderpasses; 
 };
 
@@ -26,7 +26,7 @@ struct RenderGraphBuilder
     Allocator alloc;
 
     static RenderGraphBuilder Create(Allocator alloc);
-    RenderpassNode* AddRenderpass(StringView id , void* params, RenderpassBuilder renderpass_builder);
+    RenderpassNode* AddRenderpass(StringID id , void* params, RenderpassBuilder renderpass_builder);
     void Build(RenderGraph* out_graph);
 };
 
@@ -45,10 +45,10 @@ struct RenderTargetInfo
 
 struct RenderpassNode
 {
-    StringView id;
+    StringID id;
     RenderpassBuilder builder;
     void* params;
-    HMap<StringView,RenderTargetInfo> render_targets;
+    HMap<StringID,RenderTargetInfo> render_targets;
     DArray<SubpassNode> subpasses;
     RenderGraphBuilder* parent;
 
@@ -63,13 +63,13 @@ struct RenderpassNode
         return this;
     }
 
-    RenderpassNode* AddRenderTarget(StringView id , size_t index , VkAttachmentDescription desc)
+    RenderpassNode* AddRenderTarget(StringID id , size_t index , VkAttachmentDescription desc)
     {
         RenderTargetInfo info = {};
         info.index = index;
         info.description = desc;
 
-        bool added = HMap<StringView,RenderTargetInfo>::TryAdd( &render_targets, id , info , nullptr);
+        bool added = HMap<StringID,RenderTargetInfo>::TryAdd( &render_targets, id , info , nullptr);
         assert(added);
 
         return this;
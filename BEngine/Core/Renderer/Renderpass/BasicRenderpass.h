@@ -15,8 +15,8 @@ struct BasicRenderpassParams
     Color clearColor;
     float depth;
     uint32_t stencil;
-    StringView color_id;
-    StringView depth_id;
+    StringID color_id;
+    StringID depth_id;
 };
 
 struct BasicRenderpass
@@ -38,7 +38,7 @@ struct BasicRenderpass
     {
         *out_renderpass = {};
 
-        out_renderpass->id = StringView::Create(BASIC_RENDERPASS_ID);
+        out_renderpass->id = StringInterner::Intern(&Global::names, BASIC_RENDERPASS_ID);
 
         BasicRenderpassParams *params = (BasicRenderpassParams *)node.params;
 
@@ -51,7 +51,7 @@ struct BasicRenderpass
         VkAttachmentReference colorReference = {};
         RenderTargetInfo *color_lookup = {};
         {
-            bool found = HMap<StringView, RenderTargetInfo>::TryGet(&node.render_targets, params->color_id, &color_lookup);
+            bool found = HMap<StringID, RenderTargetInfo>::TryGet(&node.render_targets, params->color_id, &color_lookup);
             assert(found);
             colorReference.attachment = color_lookup->index;
             colorReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
@@ -60,7 +60,7 @@ struct BasicRenderpass
         VkAttachmentReference depthReference = {};
         RenderTargetInfo *depth_lookup = {};
         {
-            bool found = HMap<StringView, RenderTargetInfo>::TryGet(&node.render_targets, params->depth_id, &depth_lookup);
+            bool found = HMap<StringID, RenderTargetInfo>::TryGet(&node.render_targets, params->depth_id, &depth_lookup);
             assert(found);
             depthReference.attachment = depth_lookup->index;
             depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
@@ -28,7 +28,7 @@ struct CommandBuffer;
 
 struct Renderpass
 {
-    StringView id;
+    StringID id;
     RenderGraph* graph;
     VkRenderPass handle;
     void* internal_data;
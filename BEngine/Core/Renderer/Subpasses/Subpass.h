@@ -1,6 +1,7 @@
 #pragma once
 #include <vulkan/vulkan.h>
 #include <String/StringView.h>
+#include <String/StringInterner.h>
 #include <Typedefs/Typedefs.h>
 #include "../CommandBuffer/CommandBuffer.h"
 #include "../Context/RendererContext.h"
@@ -9,7 +10,7 @@ struct RenderGraph;
 
 struct Subpass
 {
-    StringView id;
+    StringID id;
     size_t renderpass_index;
     RenderGraph* graph;
     VkSubpassBeginInfo handle;
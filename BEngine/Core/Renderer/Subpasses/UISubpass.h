@@ -1,6 +1,7 @@
 #pragma once
 #include <Containers/DArray.h>
 #include <Containers/HMap.h>
+#include <Profiler/FrameProfiler.h>
 #include "../../Global/Global.h"
 #include "../Subpasses/Subpass.h"
 #include "../CommandBuffer/CommandBuffer.h"
@@ -10,7 +11,7 @@
 struct UISubpassParams
 {
     bool sync_window_size;
-    HMap<ShaderBuilder , Shader> shader_lookup;
+    FuncHMap<ShaderBuilder , Shader> shader_lookup;
     Buffer camera_matrix_buffer;
 };
 
@@ -21,11 +22,11 @@ struct UISubpass
     static bool Create(VulkanContext *ctx, Subpass *out_subpass)
     {
         *out_subpass = {};
-        out_subpass->id = StringView::Create(BASIC_RENDERPASS_ID);
+        out_subpass->id = StringInterner::Intern(&Global::names, BASIC_RENDERPASS_ID);
 
         UISubpassParams *data = Global::alloc_toolbox.HeapAlloc<UISubpassParams>();
 
-        HMap<ShaderBuilder,Shader>::Create(&data->shader_lookup , Global::alloc_toolbox.heap_allocator , 10 , ShaderUtils::ShaderBuilderHash , ShaderUtils::ShaderBuilderCmp );
+        FuncHMap<ShaderBuilder,Shader>::Create(&data->shader_lookup , Global::alloc_toolbox.heap_allocator , 10 , ShaderUtils::ShaderBuilderHash , ShaderUtils::ShaderBuilderCmp );
 
         // camera buffer
         {
@@ -50,6 +51,8 @@ struct UISubpass
 
     static void Draw(Subpass *in_subpass, CommandBuffer *cmd, RendererContext *render_ctx)
     {
+        PROFILE_SCOPE("UISubpass::Draw");
+
         UISubpassParams *data = (UISubpassParams *)in_subpass->internal_data;
         BackendRenderer *in_backend = &Global::backend_renderer;
         VulkanContext *ctx = (VulkanContext *)Global::backend_renderer.user_data;
@@ -118,12 +121,12 @@ struct UISubpass
                 Shader* shader_ptr = {};
                 Shader shader = {};
                 
-                if(!HMap<ShaderBuilder,Shader>::TryGet(&data->shader_lookup ,  builder , &shader_ptr))
+                if(!FuncHMap<ShaderBuilder,Shader>::TryGet(&data->shader_lookup ,  builder , &shader_ptr))
                 {
                     bool build = curr.shader_builder->Build(ctx , renderpass , &shader);
                     assert(build);
 
-                    HMap<ShaderBuilder,Shader>::TryAdd(&data->shader_lookup , *curr.shader_builder , shader , nullptr);
+                    FuncHMap<ShaderBuilder,Shader>::TryAdd(&data->shader_lookup , *curr.shader_builder , shader , nullptr);
                 }
                 else
                 {
@@ -180,7 +183,7 @@ struct UISubpass
         {
             DArray<Pair<ShaderBuilder, Shader>> kv_vals = {};
             DArray<Pair<ShaderBuilder, Shader>>::Create(data->shader_lookup.count , &kv_vals , Global::alloc_toolbox.frame_allocator);
-            HMap<ShaderBuilder,Shader>::GetAll(&data->shader_lookup , &kv_vals);
+            FuncHMap<ShaderBuilder,Shader>::GetAll(&data->shader_lookup , &kv_vals);
 
             for(size_t i = 0; i < kv_vals.size ; ++i)
             {
@@ -188,7 +191,7 @@ struct UISubpass
                 Shader::Destroy(ctx , &curr.value);
             }
 
-            HMap<ShaderBuilder,Shader>::Destroy(&data->shader_lookup);
+            FuncHMap<ShaderBuilder,Shader>::Destroy(&data->shader_lookup);
         }
         Global::alloc_toolbox.ResetArenaOffset(&check);
 
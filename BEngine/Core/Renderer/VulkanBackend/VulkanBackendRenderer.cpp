@@ -8,6 +8,7 @@
 #include <Maths/Vector3.h>
 #include <String/StringView.h>
 #include <String/StringUtils.h>
+#include <Profiler/FrameProfiler.h>
 #include "../../Defines/Defines.h"
 #include "../../Global/Global.h"
 #include "../../Logger/Logger.h"
@@ -28,6 +29,10 @@
 #include <Maths/Vector2.h>
 #include "../Mesh/Vertex3D.h"
 
+// work allowed to the buffer compaction per buffer and per frame
+const size_t DEFRAG_MAX_MOVES = 16;
+const size_t DEFRAG_MAX_BYTES = 256 * 1024;
+
 struct PhysicalDeviceRequirements
 {
     bool graphics;
@@ -751,6 +756,7 @@ bool Startup(BackendRenderer *in_renderer, ApplicationStartup startup)
         const size_t alignement = ctx->physical_device_info.physicalDeviceProperties.limits.minUniformBufferOffsetAlignment;
         const uint32_t nodes_capacity = 512;
         FreeList::Create(&ctx->mesh_freelist, alignement, nodes_capacity, mesh_alloc_size, Global::alloc_toolbox.heap_allocator);
+        FreeListDefragmenter::Create(&ctx->mesh_defragmenter, DEFRAG_MAX_MOVES, Global::alloc_toolbox.heap_allocator);
         Global::logger.Info("Vertex buffer created");
     }
 
@@ -777,6 +783,7 @@ bool Startup(BackendRenderer *in_renderer, ApplicationStartup startup)
         const size_t alignement = ctx->physical_device_info.physicalDeviceProperties.limits.minUniformBufferOffsetAlignment;
         const uint32_t nodes_capacity = 512;
         FreeList::Create(&ctx->descriptors_freelist, alignement, nodes_capacity, desc_alloc_size, Global::alloc_toolbox.heap_allocator);
+        FreeListDefragmenter::Create(&ctx->descriptors_defragmenter, DEFRAG_MAX_MOVES, Global::alloc_toolbox.heap_allocator);
         Global::logger.Info("Descriptor buffer created");
     }
 
@@ -797,6 +804,8 @@ void Resize(BackendRenderer *in_backend, uint32_t width, uint32_t height)
 // current frame is still the same , it gets updated after "Present"
 bool StartFrame(BackendRenderer *in_backend, RendererContext *renderer_ctx)
 {
+    PROFILE_SCOPE("VulkanBackendRenderer::StartFrame");
+
     VulkanContext *ctx = (VulkanContext *)in_backend->user_data;
     LogicalDeviceInfo device = ctx->logical_device_info;
 
@@ -885,6 +894,8 @@ bool StartFrame(BackendRenderer *in_backend, RendererContext *renderer_ctx)
 
 bool DrawFrame(BackendRenderer *in_backend, RendererContext *renderer_ctx)
 {
+    PROFILE_SCOPE("VulkanBackendRenderer::DrawFrame");
+
     VulkanContext *ctx = (VulkanContext *)in_backend->user_data;
     uint32_t current_index = ctx->current_image_index;
     CommandBuffer cmd = ctx->swapchain_info.graphics_cmd_buffers_per_image.data[current_index];
@@ -909,9 +920,45 @@ bool DrawFrame(BackendRenderer *in_backend, RendererContext *renderer_ctx)
     return true;
 }
 
+/// <summary>
+/// <para>Compacts "buffer" a little : the defragmenter moves some of "handles" lower in "freelist" and patches them , then the moves are copied in one go</para>
+/// <para>NOTE : CopyRegions waits the queue , so the frames in flight that still read the old ranges are done before they get overwritten</para>
+/// <para>Returns false when the copy couldn't be submitted</para>
+/// </summary>
+bool Defragment(VulkanContext *ctx, FreeListDefragmenter *defragmenter, FreeList *freelist, Buffer *buffer, DArray<FreeList::Node *> *handles)
+{
+    FreeListDefragmenter::Options options = {};
+    options.max_bytes = DEFRAG_MAX_BYTES;
+    options.max_moves = DEFRAG_MAX_MOVES;
+
+    size_t move_count = FreeListDefragmenter::Step(defragmenter, freelist, {handles->data, handles->size}, options);
+
+    if (move_count == 0)
+    {
+        return true;
+    }
+
+    VkBufferCopy *regions = (VkBufferCopy *)ALLOC(Global::alloc_toolbox.frame_allocator, move_count * sizeof(VkBufferCopy));
+
+    for (size_t i = 0; i < move_count; ++i)
+    {
+        FreeListMove *move = &defragmenter->moves.data[i];
+        regions[i].srcOffset = move->src.start;
+        regions[i].dstOffset = move->dst.start;
+        regions[i].size = move->src.size;
+    }
+
+    VkCommandPool pool = ctx->physical_device_info.command_pools_info.graphicsCommandPool;
+    VkQueue queue = ctx->physical_device_info.queues_info.graphics_queue;
+
+    return Buffer::CopyRegions(pool, queue, buffer, buffer, regions, (uint32_t)move_count);
+}
+
 /// Once we reach this function , the image_index represents the current image that's we're working on to send to presentation
 bool EndFrame(BackendRenderer *in_backend, RendererContext *rendererContext)
 {
+    PROFILE_SCOPE("VulkanBackendRenderer::EndFrame");
+
     VulkanContext *ctx = (VulkanContext *)in_backend->user_data;
     CommandBuffer cmd = ctx->swapchain_info.graphics_cmd_buffers_per_image.data[ctx->current_image_index];
 
@@ -998,6 +1045,21 @@ bool EndFrame(BackendRenderer *in_backend, RendererContext *rendererContext)
     // increments and loop frame count
     ctx->current_frame = (ctx->current_frame + 1) % ctx->swapchain_info.images_count;
 
+    // the frame is submitted with the current ranges , the next one records with the patched handles
+    {
+        PROFILE_SCOPE("VulkanBackendRenderer::Defragment");
+
+        if (!Defragment(ctx, &ctx->mesh_defragmenter, &ctx->mesh_freelist, &ctx->mesh_buffer, &rendererContext->mesh_handles))
+        {
+            Global::logger.Error("Couldn't defragment mesh buffer");
+        }
+
+        if (!Defragment(ctx, &ctx->descriptors_defragmenter, &ctx->descriptors_freelist, &ctx->descriptors_buffer, &rendererContext->descriptors_handles))
+        {
+            Global::logger.Error("Couldn't defragment descriptors buffer");
+        }
+    }
+
     return true;
 }
 
@@ -1010,9 +1072,11 @@ bool Destroy(BackendRenderer *in_backend)
 
     Buffer::Destroy(&ctx->mesh_buffer);
     FreeList::Destroy(&ctx->mesh_freelist);
+    FreeListDefragmenter::Destroy(&ctx->mesh_defragmenter);
 
     Buffer::Destroy(&ctx->descriptors_buffer);
     FreeList::Destroy(&ctx->descriptors_freelist);
+    FreeListDefragmenter::Destroy(&ctx->descriptors_defragmenter);
 
     Buffer::Destroy(&ctx->staging_buffer);
     
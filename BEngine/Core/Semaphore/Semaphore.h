@@ -0,0 +1,90 @@
+#pragma once
+#include <stdint.h>
+#include <assert.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <semaphore.h>
+#include <time.h>
+#include <errno.h>
+#endif
+
+/// <summary>
+/// <para>Counting semaphore used to park threads that have nothing to do</para>
+/// <para>Signal adds to the count and wakes up waiting threads , Wait blocks until the count is positive or the timeout expires</para>
+/// </summary>
+struct Semaphore
+{
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    sem_t handle;
+    size_t max_count;
+#endif
+
+    static void Create(size_t initial_count, size_t max_count, Semaphore* out_semaphore)
+    {
+        *out_semaphore = {};
+#ifdef _WIN32
+        out_semaphore->handle = CreateSemaphore(nullptr, (LONG) initial_count, (LONG) max_count, nullptr);
+        assert(out_semaphore->handle != nullptr);
+#else
+        out_semaphore->max_count = max_count;
+        int res = sem_init(&out_semaphore->handle, 0, (unsigned int) initial_count);
+        assert(res == 0);
+        (void) res;
+#endif
+    }
+
+    static void Signal(Semaphore* in_semaphore, size_t count)
+    {
+#ifdef _WIN32
+        // NOTE : releasing past the max count fails without touching the count , which is fine for wake-ups
+        ReleaseSemaphore(in_semaphore->handle, (LONG) count, nullptr);
+#else
+        // mirror the Win32 behaviour and never go past the max count
+        int curr = 0;
+        sem_getvalue(&in_semaphore->handle, &curr);
+
+        for (size_t i = (size_t) (curr < 0 ? 0 : curr); i < in_semaphore->max_count && count != 0; ++i, --count)
+        {
+            sem_post(&in_semaphore->handle);
+        }
+#endif
+    }
+
+    /// <summary>
+    /// Returns true if the semaphore was acquired , false if the wait timed out
+    /// </summary>
+    static bool Wait(Semaphore* in_semaphore, uint32_t timeout_ms)
+    {
+#ifdef _WIN32
+        DWORD res = WaitForSingleObject(in_semaphore->handle, (DWORD) timeout_ms);
+        return res == WAIT_OBJECT_0;
+#else
+        timespec deadline = {};
+        clock_gettime(CLOCK_REALTIME, &deadline);
+
+        deadline.tv_nsec += (long) (timeout_ms % 1000) * 1'000'000;
+        deadline.tv_sec += (time_t) (timeout_ms / 1000) + (deadline.tv_nsec / 1'000'000'000);
+        deadline.tv_nsec %= 1'000'000'000;
+
+        int res = 0;
+
+        while ((res = sem_timedwait(&in_semaphore->handle, &deadline)) != 0 && errno == EINTR);
+
+        return res == 0;
+#endif
+    }
+
+    static void Destroy(Semaphore* inout_semaphore)
+    {
+#ifdef _WIN32
+        CloseHandle(inout_semaphore->handle);
+#else
+        sem_destroy(&inout_semaphore->handle);
+#endif
+        *inout_semaphore = {};
+    }
+};
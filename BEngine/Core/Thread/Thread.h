@@ -1,39 +1,130 @@
 #pragma once
-#include <windows.h>
 #include <stdint.h>
 #include <Typedefs/Typedefs.h>
 #include <assert.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/// <summary>
+/// <para>OS thread , the backend is picked at compile time (Win32 threads or pthreads)</para>
+/// <para>The thread doesn't start until Run is called</para>
+/// <para>NOTE : the Thread struct has to stay at the same address until the thread has started , the entry point reads the callback from it</para>
+/// </summary>
 struct Thread
 {
-    typedef Func<DWORD , void*> ThreadCallback;
-    
+    typedef Func<uint32_t , void*> ThreadCallback;
+
+#ifdef _WIN32
     DWORD thread_id;
-    HANDLE thread_handle; 
+    HANDLE thread_handle;
+#else
+    pthread_t thread_handle;
+    bool is_joinable;
+#endif
+
     void* callback_param;
-    Func<DWORD , void*> thread_callback;
+    ThreadCallback thread_callback;
 
     static void Create(ThreadCallback callback , void* callback_param, Thread* out_thread)
     {
-        DWORD creation_flag = CREATE_SUSPENDED;
+        *out_thread = {};
         out_thread->callback_param = callback_param;
         out_thread->thread_callback = callback;
-        out_thread->thread_handle = CreateThread(nullptr , 0 , callback ,  callback_param , creation_flag,  &out_thread->thread_id);
+
+#ifdef _WIN32
+        DWORD creation_flag = CREATE_SUSPENDED;
+        out_thread->thread_handle = CreateThread(nullptr , 0 , Win32EntryPoint ,  out_thread , creation_flag,  &out_thread->thread_id);
+#endif
     }
 
     static void Run(Thread* in_thread)
     {
-        assert(ResumeThread(in_thread->thread_handle) != -1);
+#ifdef _WIN32
+        DWORD res = ResumeThread(in_thread->thread_handle);
+        assert(res != (DWORD) -1);
+        (void) res;
+#else
+        int res = pthread_create(&in_thread->thread_handle, nullptr, PosixEntryPoint, in_thread);
+        assert(res == 0);
+        in_thread->is_joinable = res == 0;
+#endif
     }
 
+    /// <summary>
+    /// <para>Pauses the thread wherever it is</para>
+    /// <para>NOTE : pthreads can't suspend another thread , on POSIX this does nothing and the thread is expected to return on its own</para>
+    /// </summary>
     static void Suspend(Thread* in_thread)
     {
-        assert(SuspendThread(in_thread->thread_handle) != -1);
+#ifdef _WIN32
+        DWORD res = SuspendThread(in_thread->thread_handle);
+        assert(res != (DWORD) -1);
+        (void) res;
+#else
+        (void) in_thread;
+#endif
+    }
+
+    /// <summary>
+    /// Blocks the calling thread until the thread's callback returns
+    /// </summary>
+    static void Join(Thread* in_thread)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(in_thread->thread_handle, INFINITE);
+#else
+        if (in_thread->is_joinable)
+        {
+            pthread_join(in_thread->thread_handle, nullptr);
+            in_thread->is_joinable = false;
+        }
+#endif
+    }
+
+    /// <summary>
+    /// Gives the rest of the calling thread's time slice to another ready thread , for waits that can't make progress on their own
+    /// </summary>
+    static void YieldTimeSlice()
+    {
+#ifdef _WIN32
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
     }
 
     static void Destroy(Thread* inout_thread)
     {
+#ifdef _WIN32
         CloseHandle(inout_thread->thread_handle);
-        *inout_thread = {};    
+#else
+        if (inout_thread->is_joinable)
+        {
+            pthread_detach(inout_thread->thread_handle);
+        }
+#endif
+        *inout_thread = {};
+    }
+
+private:
+
+#ifdef _WIN32
+    static DWORD WINAPI Win32EntryPoint(LPVOID param)
+    {
+        Thread* th = (Thread*) param;
+        return (DWORD) th->thread_callback(th->callback_param);
+    }
+#else
+    static void* PosixEntryPoint(void* param)
+    {
+        Thread* th = (Thread*) param;
+        th->thread_callback(th->callback_param);
+        return nullptr;
     }
-};
\ No newline at end of file
+#endif
+};
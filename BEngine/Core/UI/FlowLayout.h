@@ -1,11 +1,15 @@
 #pragma once
 #include <Defer/Defer.h>
+#include <Profiler/FrameProfiler.h>
 #include "UILayout.h"
 
 struct FlowLayout
 {
     static void Flow(LayoutNode *in_node, LayoutState *in_state)
     {
+        // one zone per node , they nest like the layout tree in the trace
+        PROFILE_SCOPE("FlowLayout::Flow");
+
         FlowLayout::FlowWidth(in_node, in_state);
         FlowLayout::FlowHeight(in_node, in_state);
         FlowLayout::FlowX(in_node, in_state);
@@ -1,8 +1,11 @@
 #pragma once
 #include <Containers/DArray.h>
+#include <Allocators/ScratchArena.h>
+#include <Defer/Defer.h>
 #include <Maths/Rect.h>
 #include <Maths/Vector2.h>
 #include <Maths/Matrix4x4.h>
+#include <Maths/TransformBatch.h>
 #include <Core/Renderer/Context/RendererContext.h>
 #include <Core/Renderer/Context/VulkanContext.h>
 
@@ -80,44 +83,68 @@ struct RootLayoutNode
     Texture* texture;
     FreeList::Node instances_data;
 
-    void GetAllRectRecursive(LayoutNode* root_node , DArray<Matrix4x4>* inout_mats)
+    size_t CountRectRecursive(LayoutNode* root_node)
     {
-        Rect rect = root_node->resolved_rect;
+        size_t count = 1;
 
-        Matrix4x4 ui_rect_mat = Matrix4x4(
-            {rect.size.x, 0, 0, rect.pos.x},
-            {0, rect.size.y, 0, rect.pos.y},
-            {0, 0, 1, 0},
-            {0, 0, 0, 1});
+        for(size_t i = 0; i < root_node->sub_nodes.size ; ++i)
+        {
+            count += CountRectRecursive(&root_node->sub_nodes.data[i]);
+        }
 
-        DArray<Matrix4x4>::Add(inout_mats , ui_rect_mat);
+        return count;
+    }
+
+    void GetAllRectRecursive(LayoutNode* root_node , TransformBatch* inout_batch)
+    {
+        Rect rect = root_node->resolved_rect;
+        size_t index = inout_batch->count++;
+
+        inout_batch->pos_x[index] = rect.pos.x;
+        inout_batch->pos_y[index] = rect.pos.y;
+        inout_batch->size_x[index] = rect.size.x;
+        inout_batch->size_y[index] = rect.size.y;
 
         for(size_t i = 0; i < root_node->sub_nodes.size ; ++i)
         {
-            GetAllRectRecursive(&root_node->sub_nodes.data[i] , inout_mats);
+            GetAllRectRecursive(&root_node->sub_nodes.data[i] , inout_batch);
         }
     }
 
     DrawMesh GetDraw()
     {
         VulkanContext* ctx = (VulkanContext*)Global::backend_renderer.user_data;
-        DArray<Matrix4x4> rects_to_render = {};
-        DArray<Matrix4x4>::Create(100 , &rects_to_render , Global::alloc_toolbox.frame_allocator);
+
+        ScratchArena scratch = ScratchArena::Get();
+        DEFER([&](){ ScratchArena::Release(&scratch); });
+
+        const size_t rect_count = CountRectRecursive(&root);
+
+        TransformBatch rects_to_render = {};
+        rects_to_render.pos_x = (float*)ALLOC(scratch.alloc , sizeof(float) * rect_count);
+        rects_to_render.pos_y = (float*)ALLOC(scratch.alloc , sizeof(float) * rect_count);
+        rects_to_render.size_x = (float*)ALLOC(scratch.alloc , sizeof(float) * rect_count);
+        rects_to_render.size_y = (float*)ALLOC(scratch.alloc , sizeof(float) * rect_count);
 
         GetAllRectRecursive(&root , &rects_to_render);
 
-        const size_t size_for_rects = sizeof(Matrix4x4) * rects_to_render.size;
+        const size_t size_for_rects = sizeof(Matrix4x4) * rects_to_render.count;
 
         DrawMesh draw = {};
         draw.mesh = mesh;
         draw.shader_builder = shader_builder;
         draw.texture = texture;
         draw.instances_data = instances_data;
-        draw.instances_count = rects_to_render.size;
+        draw.instances_count = rects_to_render.count;
+
+        // matrices are written straight into the staging buffer
+        void* staging_data = nullptr;
+        Buffer::Lock(0, size_for_rects , 0 , &ctx->staging_buffer , &staging_data);
+        TransformBatch::WriteMatrices(&rects_to_render , staging_data);
+        Buffer::Unlock(&ctx->staging_buffer);
 
         VkCommandPool pool = ctx->physical_device_info.command_pools_info.graphicsCommandPool;
         VkQueue queue = ctx->physical_device_info.queues_info.graphics_queue;
-        Buffer::Load(instances_data.start, size_for_rects , rects_to_render.data, 0, &ctx->staging_buffer); 
         Buffer::Copy(pool , {} , queue , &ctx->staging_buffer , 0 , &ctx->descriptors_buffer , instances_data.start , size_for_rects);
         return draw;
     }
@@ -7,6 +7,8 @@
 #include <cstdint>
 #include <Context/CoreContext.h>
 #include <Allocators/Allocator.h>
+#include <Allocators/ScratchArena.h>
+#include <Defer/Defer.h>
 #include <String/StringBuffer.h>
 #include <String/StringView.h>
 #include <String/StringUtils.h>
@@ -19,6 +21,7 @@
 #include "Logger/Logger.h"
 #include "Platform/Base/Platform.h"
 #include "Logger/Types/ConsoleLogger.h"
+#include "Logger/Types/FileLogger.h"
 #include "Renderer/Backend/BackendRenderer.h"
 #include "Renderer/VulkanBackend/VulkanBackendRenderer.h"
 #include "AssetManager/GlobalAssetManager.h"
@@ -33,8 +36,8 @@
 #include "Platform/Types/Win32/Win32Platform.h"
 #endif
 
-// Start the game with 500MB of frame arena memory
-#define INITIAL_GAME_ARENA_CAPACITY 500 * 1'024'000
+// Start the game with 32MB of frame arena memory , the arena chains more blocks of the same size on spikes
+#define INITIAL_GAME_ARENA_CAPACITY 32 * 1'024'000
 #define INITIAL_LIB_ARENA_CAPACITY 30 * 1'024'000
 
 typedef GameApp (*GenerateGameProc)();
@@ -71,15 +74,33 @@ int main(int argc, char **argv)
 
     // main allocators
     {
-        Global::alloc_toolbox.heap_allocator = HeapAllocator::Create();
+        AllocationToolbox* toolbox = &Global::alloc_toolbox;
 
-        Global::alloc_toolbox.frame_arena = Arena::Create(INITIAL_GAME_ARENA_CAPACITY);
-        Global::alloc_toolbox.frame_allocator = ArenaAllocator::Create(&Global::alloc_toolbox.frame_arena);
+        Pool::Create(&toolbox->heap_pool);
+        Allocator pool_allocator = PoolAllocator::Create(&toolbox->heap_pool);
+
+#if _DEBUG
+        AllocationProfiler::Create(&toolbox->profiler, pool_allocator);
+#else
+        AllocationProfiler::Create(&toolbox->profiler, pool_allocator, AllocationProfiler::DEFAULT_SAMPLE_INTERVAL);
+#endif
+
+        toolbox->heap_allocator = ProfiledAllocator::Create(&toolbox->profiled_heap, pool_allocator, &toolbox->profiler);
+
+        // NOTE : the frame memory is released by rewinding the arena , so only its allocations are counted , not its lifetimes
+        toolbox->frame_arena = Arena::Create(INITIAL_GAME_ARENA_CAPACITY);
+        toolbox->frame_allocator = ProfiledAllocator::Create(&toolbox->profiled_frame, ArenaAllocator::Create(&toolbox->frame_arena), &toolbox->profiler, false);
+
+        StringInterner::Create(&Global::names, toolbox->heap_allocator);
+
+        FrameProfiler::Create(&Global::frame_profiler, toolbox->heap_allocator);
+        FrameProfiler::SetThreadName("Main");
     }
 
     // Global::platform.startup( &Global::platform );
 
     // init logger
+    ILogger fileLogger = {};
     {
         Global::logger.Initialize();
 
@@ -87,6 +108,18 @@ int main(int argc, char **argv)
         ILogger consoleLogger = {};
         ConsoleLogger::Create(&consoleLogger);
         Global::logger.Add(consoleLogger);
+
+        // file logger , next to the executable
+        ScratchArena scratch = ScratchArena::Get();
+        DEFER([&](){ ScratchArena::Release(&scratch); });
+
+        FileLogger::Params params = {};
+        params.path = StringUtils::Format(scratch.alloc, "{}\\BEngine.log", Global::app.application_startup.executable_folder).view;
+
+        if (FileLogger::Create(&fileLogger, params, Global::alloc_toolbox.heap_allocator))
+        {
+            Global::logger.Add(fileLogger);
+        }
     }
 
     // create renderer , only vulkan for now
@@ -96,7 +129,7 @@ int main(int argc, char **argv)
 
     // job system
     {
-        JobSystem::Create(8 , &Global::job_system);
+        JobSystem::Create(8 , Global::alloc_toolbox.heap_allocator , &Global::job_system);
     }
 
     // file watcher
@@ -119,7 +152,7 @@ int main(int argc, char **argv)
         Thread::ThreadCallback run = [](void *data)
         {
             Global::filewatch_ctx.file_watcher.Start();
-            return (DWORD) 0;
+            return (uint32_t) 0;
         };
 
         Thread::Create(run, nullptr, &Global::filewatch_ctx.watcher_thread);
@@ -172,17 +205,14 @@ int main(int argc, char **argv)
                     continue;
                 }
 
-                char temp_buffer[1024] = {0};
-                Arena arena = {};
-                arena.data = &temp_buffer;
-                arena.capacity = 1024;
-                arena.offset = 0;
-                Allocator temp_alloc = ArenaAllocator::Create(&arena);
+                ScratchArena scratch = ScratchArena::Get();
+                DEFER([&](){ ScratchArena::Release(&scratch); });
+                Allocator temp_alloc = scratch.alloc;
 
                 Global::logger.Log(curr);
 
-                StringBuffer full_path = StringUtils::Format(alloc, temp_alloc,"{}\\{}", shader_folder, curr);
-                StringBuffer complile_cmd = StringUtils::Format(alloc, temp_alloc, "{} {} -o {}.spv", glsl_path, full_path.view, full_path.view);
+                StringBuffer full_path = StringUtils::Format(temp_alloc, "{}\\{}", shader_folder, curr);
+                StringBuffer complile_cmd = StringUtils::Format(temp_alloc, "{} {} -o {}.spv", glsl_path, full_path.view, full_path.view);
 
                 StringBuffer output = {};
                 Command cmd = {};
@@ -242,8 +272,76 @@ cleanup:
     Global::backend_renderer.destroy(&Global::backend_renderer);
     Global::asset_manager.Destroy();
     Global::event_system.Destroy();
+
+    // the frame stats go to the log , the last frames to a trace next to the executable (chrome://tracing or ui.perfetto.dev)
+    {
+        FrameProfiler* profiler = &Global::frame_profiler;
+
+        StringBuilder report = {};
+        StringBuilder::Create(&report, Global::alloc_toolbox.heap_allocator);
+        FrameProfiler::Report(profiler, &report);
+        Global::logger.Info(StringBuilder::Flatten(&report));
+        StringBuilder::Destroy(&report);
+
+        ScratchArena scratch = ScratchArena::Get();
+        DEFER([&](){ ScratchArena::Release(&scratch); });
+
+        StringBuffer path = StringUtils::Format(scratch.alloc, "{}\\BEngine.trace.json", Global::app.application_startup.executable_folder);
+
+        ChunkedBuffer trace = {};
+        ChunkedBuffer::Create(&trace, Global::alloc_toolbox.heap_allocator);
+        FrameProfiler::ExportChromeTrace(profiler, &trace);
+
+        FILE* file = fopen(StringView::ToCString(path.view, scratch.alloc), "wb");
+
+        if (file != nullptr)
+        {
+            ChunkedBuffer::WriteTo(&trace, [](void* user_data, StringView str)
+            {
+                return fwrite(str.buffer, 1, str.length, (FILE*) user_data) == str.length;
+            }, file);
+
+            fclose(file);
+        }
+
+        ChunkedBuffer::Destroy(&trace);
+    }
+
     Global::logger.Destroy();
+
+    // the logging thread wrote everything out before stopping
+    if (fileLogger.user_data)
+    {
+        FileLogger::Destroy(&fileLogger);
+    }
+
     Global::platform.window.destroy();
+    StringInterner::Destroy(&Global::names);
+    FrameProfiler::Destroy(&Global::frame_profiler);
+
+    Arena::Destroy(&Global::alloc_toolbox.frame_arena);
+
+    // the job threads release their scratch arenas when they exit , the main thread does it here
+    ScratchArena::ReleaseThread();
+
+    // everything above gave its memory back , what's left is leaked
+    {
+        AllocationProfiler* profiler = &Global::alloc_toolbox.profiler;
+
+        StringBuilder report = {};
+        StringBuilder::Create(&report, profiler->alloc);
+
+        if (AllocationProfiler::ReportLeaks(profiler, &report) != 0)
+        {
+            StringBuilder::WriteTo(&report, stdout);
+        }
+
+        StringBuilder::Destroy(&report);
+        AllocationProfiler::Destroy(profiler);
+    }
+
+    // NOTE : has to be last , everything above still frees through the heap allocator
+    Pool::Destroy(&Global::alloc_toolbox.heap_pool);
 
     return 0;
 }
@@ -0,0 +1,122 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <Allocators/Allocator.h>
+#include <String/StringView.h>
+#include <Logger/Types/FileLogger.h>
+#include "ThreadBenchmarks.h"
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// What the sinks used to do , one unbuffered write per line. Returns false if "path" can't be opened
+    /// </summary>
+    static bool RunNaiveFileLogging(const char* path, StringView line, size_t count, double* out_lines_per_second)
+    {
+        FILE* file = fopen(path, "wb");
+
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        setvbuf(file, nullptr, _IONBF, 0);
+
+        uint64_t start = NowNs();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            fwrite(line.buffer, 1, line.length, file);
+            fwrite("\n", 1, 1, file);
+            fflush(file);
+        }
+
+        uint64_t end = NowNs();
+
+        fclose(file);
+        remove(path);
+
+        *out_lines_per_second = (double) count * 1'000'000'000.0 / (double) (end - start);
+        return true;
+    }
+
+    /// <summary>
+    /// The FileLogger called the way the logging thread calls it , "max_file_size" small enough for a few rotations. Returns false if "path" can't be opened
+    /// </summary>
+    static bool RunFileLogger(const char* path, StringView line, size_t count, size_t batch_size, Allocator alloc, double* out_lines_per_second, size_t* out_rotations)
+    {
+        FileLogger::Params params = {};
+        params.path = path;
+        params.batch_size = batch_size;
+        params.max_file_size = 8 * 1'024 * 1'024;
+        params.max_rotated_files = 2;
+
+        ILogger sink = {};
+
+        if (!FileLogger::Create(&sink, params, alloc))
+        {
+            return false;
+        }
+
+        uint64_t start = NowNs();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            sink.info(&sink, line);
+        }
+
+        sink.flush(&sink, true);
+
+        uint64_t end = NowNs();
+
+        *out_rotations = ((FileLogger::FileLoggerData*) sink.user_data)->rotation_count;
+
+        FileLogger::Destroy(&sink);
+
+        char rotated[512];
+
+        for (uint32_t i = 0; i <= params.max_rotated_files; ++i)
+        {
+            snprintf(rotated, sizeof(rotated), i == 0 ? "%s" : "%s.%u", path, i);
+            remove(rotated);
+        }
+
+        *out_lines_per_second = (double) count * 1'000'000'000.0 / (double) (end - start);
+        return true;
+    }
+
+    static void FileLogging(Allocator alloc)
+    {
+        const size_t count = 200'000;
+        const size_t batch_sizes[] = { 4 * 1'024, 64 * 1'024, 256 * 1'024 };
+        const char* path = "BEngineBenchmark.log";
+
+        StringView line = "[renderer] frame 4096 took 16.6 ms , 1024 draws , 12 passes";
+
+        printf("\n-- File logging (%zu lines of %zu bytes)\n", count, line.length + 1);
+        printf("%12s | %16s | %10s\n", "batch", "Klines/s", "rotations");
+
+        double lines_per_second = 0.0;
+
+        if (!RunNaiveFileLogging(path, line, count, &lines_per_second))
+        {
+            printf("Couldn't open %s , skipped\n", path);
+            return;
+        }
+
+        printf("%12s | %16.2f | %10s\n", "per line", lines_per_second / 1'000.0, "-");
+
+        for (size_t batch_size : batch_sizes)
+        {
+            size_t rotations = 0;
+
+            if (!RunFileLogger(path, line, count, batch_size, alloc, &lines_per_second, &rotations))
+            {
+                printf("%12zu | couldn't open %s , skipped\n", batch_size, path);
+                continue;
+            }
+
+            printf("%12zu | %16.2f | %10zu\n", batch_size, lines_per_second / 1'000.0, rotations);
+        }
+    }
+}
@@ -0,0 +1,241 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <Allocators/Allocator.h>
+#include <Containers/DArray.h>
+#include <Atomic/Atomic.h>
+#include <Atomic/AtomicLock.h>
+#include <Thread/Thread.h>
+#include <JobSystem/JobSystem.h>
+#include <Clock/Clock.h>
+
+namespace Benchmarks
+{
+    /// <summary>
+    /// Monotonic clock in nanoseconds
+    /// </summary>
+    static uint64_t NowNs()
+    {
+        return Clock::NowNs();
+    }
+
+    /// <summary>
+    /// The lock AtomicLock used to be , a CAS hammered in a loop , kept here as the baseline
+    /// </summary>
+    struct NaiveSpinLock
+    {
+        volatile int32_t is_locked;
+
+        void Lock()
+        {
+            while (Atomic::CompareExchange(&is_locked, 1, 0) != 0);
+        }
+
+        void Unlock()
+        {
+            Atomic::Exchange(&is_locked, 0);
+        }
+    };
+
+    template<typename TLock>
+    struct ContentionContext
+    {
+        TLock lock;
+        volatile int32_t ready_threads;
+        volatile int32_t go;
+        size_t iterations;
+        uint64_t counter;
+    };
+
+    template<typename TLock>
+    static uint32_t ContentionRun(void* param)
+    {
+        ContentionContext<TLock>* ctx = (ContentionContext<TLock>*) param;
+
+        // wait for everyone so that all the threads hit the lock at the same time
+        Atomic::Increment(&ctx->ready_threads);
+
+        while (Atomic::Load(&ctx->go) == 0)
+        {
+            Atomic::Pause();
+        }
+
+        for (size_t i = 0; i < ctx->iterations; ++i)
+        {
+            ctx->lock.Lock();
+            ctx->counter++;
+            ctx->lock.Unlock();
+        }
+
+        return 0;
+    }
+
+    /// <summary>
+    /// Every thread increments a shared counter under the lock , returns the average nanoseconds per lock/unlock pair
+    /// </summary>
+    template<typename TLock>
+    static double RunContention(size_t thread_count, size_t iterations_per_thread, Allocator alloc, bool* out_valid)
+    {
+        ContentionContext<TLock> ctx = {};
+        ctx.iterations = iterations_per_thread;
+
+        DArray<Thread> threads = {};
+        DArray<Thread>::Create(thread_count, &threads, alloc);
+        threads.size = thread_count;
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            Thread::Create(ContentionRun<TLock>, &ctx, &threads.data[i]);
+            Thread::Run(&threads.data[i]);
+        }
+
+        while (Atomic::Load(&ctx.ready_threads) != (int32_t) thread_count)
+        {
+            Atomic::Pause();
+        }
+
+        uint64_t start = NowNs();
+
+        Atomic::Store(&ctx.go, 1);
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            Thread::Join(&threads.data[i]);
+        }
+
+        uint64_t end = NowNs();
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            Thread::Destroy(&threads.data[i]);
+        }
+
+        DArray<Thread>::Destroy(&threads);
+
+        uint64_t total_ops = (uint64_t) thread_count * iterations_per_thread;
+        *out_valid = ctx.counter == total_ops;
+
+        return (double) (end - start) / (double) total_ops;
+    }
+
+    static void LockContention(Allocator alloc)
+    {
+        const size_t thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+        const size_t total_iterations = 1 << 22;
+
+        printf("\n-- Lock contention (%zu lock/unlock pairs split between the threads)\n", total_iterations);
+        printf("%8s | %16s | %16s | %16s | %16s\n", "threads", "naive ns/op", "naive Mops/s", "ttas ns/op", "ttas Mops/s");
+
+        for (size_t t : thread_counts)
+        {
+            size_t iterations = total_iterations / t;
+
+            bool naive_valid = false;
+            bool ttas_valid = false;
+
+            double naive_ns = RunContention<NaiveSpinLock>(t, iterations, alloc, &naive_valid);
+            double ttas_ns = RunContention<AtomicLock>(t, iterations, alloc, &ttas_valid);
+
+            printf("%8zu | %16.2f | %16.2f | %16.2f | %16.2f %s\n",
+                t,
+                naive_ns, 1'000.0 / naive_ns,
+                ttas_ns, 1'000.0 / ttas_ns,
+                (naive_valid && ttas_valid) ? "" : "(COUNTER MISMATCH)");
+        }
+    }
+
+    struct JobBenchmarkData
+    {
+        volatile int32_t* done_count;
+        uint32_t work;
+    };
+
+    static void JobBenchmarkExecute(Job* job)
+    {
+        JobBenchmarkData* data = (JobBenchmarkData*) job->data;
+
+        // a bit of busy work so that the jobs aren't pure scheduling overhead
+        volatile uint32_t acc = 0;
+
+        for (uint32_t i = 0; i < data->work; ++i)
+        {
+            acc = acc + i * 2654435761u;
+        }
+
+        Atomic::Increment(data->done_count);
+    }
+
+    /// <summary>
+    /// Schedules a batch of independent jobs from the main thread and waits on all of them , returns the jobs per second
+    /// </summary>
+    static double RunJobThroughput(size_t worker_count, size_t job_count, uint32_t work, Allocator alloc, bool* out_valid)
+    {
+        JobSystem js = {};
+        JobSystem::Create(worker_count, alloc, &js);
+
+        volatile int32_t done_count = 0;
+
+        JobBenchmarkData data = {};
+        data.done_count = &done_count;
+        data.work = work;
+
+        DArray<JobHandle> handles = {};
+        DArray<JobHandle>::Create(job_count, &handles, alloc);
+        handles.size = job_count;
+
+        uint64_t start = NowNs();
+
+        for (size_t i = 0; i < job_count; ++i)
+        {
+            Job job = {};
+            job.data = &data;
+            job.execute_fnc_ptr = JobBenchmarkExecute;
+
+            handles.data[i] = JobSystem::Schedule(&js, job);
+        }
+
+        ArrayView<JobHandle> view = {};
+        view.data = handles.data;
+        view.size = handles.size;
+
+        JobSystem::WaitAll(&js, view);
+
+        uint64_t end = NowNs();
+
+        *out_valid = Atomic::Load(&done_count) == (int32_t) job_count;
+
+        DArray<JobHandle>::Destroy(&handles);
+        JobSystem::Destroy(&js);
+
+        return (double) job_count * 1'000'000'000.0 / (double) (end - start);
+    }
+
+    static void JobThroughput(Allocator alloc)
+    {
+        const size_t worker_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+        const uint32_t work_sizes[] = { 0, 256, 4096 };
+        const size_t job_count = JobSystem::DEFAULT_JOB_CAPACITY / 2;
+        const size_t rounds = 16;
+
+        printf("\n-- JobSystem throughput (%zu jobs per round , %zu rounds)\n", job_count, rounds);
+        printf("%8s | %10s | %16s\n", "threads", "work", "Kjobs/s");
+
+        for (uint32_t work : work_sizes)
+        {
+            for (size_t t : worker_counts)
+            {
+                double total = 0;
+                bool valid = true;
+
+                for (size_t r = 0; r < rounds; ++r)
+                {
+                    bool round_valid = false;
+                    total += RunJobThroughput(t, job_count, work, alloc, &round_valid);
+                    valid &= round_valid;
+                }
+
+                printf("%8zu | %10u | %16.2f %s\n", t, work, total / (double) rounds / 1'000.0, valid ? "" : "(MISSING JOBS)");
+            }
+        }
+    }
+}
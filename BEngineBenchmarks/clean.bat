@@ -0,0 +1,3 @@
+CALL rmdir /s /q "CMakeGenerated"
+CALL rmdir /s /q "Build"
+CALL rmdir /s /q "lib"
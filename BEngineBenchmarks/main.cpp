@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <Context/CoreContext.h>
+#include <Allocators/Allocator.h>
+#include "ThreadBenchmarks.h"
+#include "LoggerBenchmarks.h"
+
+int main(int argc , char** argv)
+{
+    CoreContext::DefaultContext();
+
+    Allocator alloc = HeapAllocator::Create();
+
+    printf("BEngine benchmarks\n");
+
+    Benchmarks::LockContention(alloc);
+    Benchmarks::JobThroughput(alloc);
+    Benchmarks::FileLogging(alloc);
+
+    return 0;
+}
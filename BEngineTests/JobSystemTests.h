@@ -0,0 +1,367 @@
+#pragma once
+
+#include <Testing/BTest.h>
+#include <Allocators/Allocator.h>
+#include <Atomic/Atomic.h>
+#include <JobSystem/JobSystem.h>
+
+namespace Tests
+{
+    struct JobSystemTests
+    {
+        static const size_t WORKER_COUNT = 4;
+
+        /// <summary>
+        /// Every job writes its index at the next free spot of "order" , so "order" ends up in execution order
+        /// </summary>
+        struct OrderData
+        {
+            uint32_t index;
+            volatile int32_t* next;
+            uint32_t* order;
+        };
+
+        static void RecordOrder(Job* job)
+        {
+            OrderData* data = (OrderData*) job->data;
+
+            int32_t pos = Atomic::Increment(data->next) - 1;
+            data->order[pos] = data->index;
+        }
+
+        struct CountData
+        {
+            volatile int32_t* done_count;
+            int32_t seen_count;
+        };
+
+        static void CountDone(Job* job)
+        {
+            CountData* data = (CountData*) job->data;
+
+            // a bit of busy work so that the parents are still running when the child is scheduled
+            volatile uint32_t acc = 0;
+
+            for (uint32_t i = 0; i < 10'000; ++i)
+            {
+                acc = acc + i * 2654435761u;
+            }
+
+            Atomic::Increment(data->done_count);
+        }
+
+        static void ReadDone(Job* job)
+        {
+            CountData* data = (CountData*) job->data;
+            data->seen_count = Atomic::Load(data->done_count);
+        }
+
+        struct GateData
+        {
+            volatile int32_t* is_open;
+            volatile int32_t* parent_done;
+            int32_t seen_parent_done;
+        };
+
+        static void WaitGate(Job* job)
+        {
+            GateData* data = (GateData*) job->data;
+
+            while (Atomic::Load(data->is_open) == 0)
+            {
+                Atomic::Pause();
+            }
+
+            Atomic::Store(data->parent_done, 1);
+        }
+
+        static void OpenGate(Job* job)
+        {
+            GateData* data = (GateData*) job->data;
+            Atomic::Store(data->is_open, 1);
+        }
+
+        static void ReadParentDone(Job* job)
+        {
+            GateData* data = (GateData*) job->data;
+            data->seen_parent_done = Atomic::Load(data->parent_done);
+        }
+
+        /// <summary>
+        /// Every child schedules one more job against the parent it was waiting on
+        /// </summary>
+        struct RescheduleData
+        {
+            JobSystem* js;
+            JobHandle parent;
+            volatile int32_t* is_open;
+            volatile int32_t* next;
+            volatile int32_t* done_count;
+            JobHandle* scheduled;
+        };
+
+        static void WaitOpen(Job* job)
+        {
+            RescheduleData* data = (RescheduleData*) job->data;
+
+            while (Atomic::Load(data->is_open) == 0)
+            {
+                Atomic::Pause();
+            }
+        }
+
+        static void CountOnce(Job* job)
+        {
+            RescheduleData* data = (RescheduleData*) job->data;
+            Atomic::Increment(data->done_count);
+        }
+
+        static void ScheduleOnParent(Job* job)
+        {
+            RescheduleData* data = (RescheduleData*) job->data;
+
+            Job next = {};
+            next.data = data;
+            next.execute_fnc_ptr = CountOnce;
+
+            int32_t pos = Atomic::Increment(data->next) - 1;
+            data->scheduled[pos] = JobSystem::Schedule( data->js, next, { &data->parent, 1 } );
+
+            Atomic::Increment(data->done_count);
+        }
+
+        TEST_DECLARATION(DependencyChain)
+        {
+            CoreContext::DefaultContext();
+
+            const size_t job_count = 64;
+
+            Allocator allocator = HeapAllocator::Create();
+
+            JobSystem js = {};
+            JobSystem::Create( WORKER_COUNT, allocator, &js );
+
+            volatile int32_t next = 0;
+            uint32_t order[job_count] = {};
+            OrderData data[job_count] = {};
+
+            // every job depends on the one scheduled before it
+            JobHandle prev = {};
+
+            for ( size_t i = 0; i < job_count; ++i )
+            {
+                data[i].index = (uint32_t) i;
+                data[i].next = &next;
+                data[i].order = order;
+
+                Job job = {};
+                job.data = &data[i];
+                job.execute_fnc_ptr = RecordOrder;
+
+                ArrayView<JobHandle> deps = { &prev, (size_t) (i != 0) };
+                prev = JobSystem::Schedule( &js, job, deps );
+            }
+
+            JobSystem::Wait( &js, prev );
+
+            EVALUATE( JobSystem::IsDone( &js, prev ) );
+            EVALUATE( next == (int32_t) job_count );
+
+            bool in_order = true;
+
+            for ( size_t i = 0; i < job_count; ++i )
+            {
+                in_order &= order[i] == (uint32_t) i;
+            }
+
+            EVALUATE( in_order );
+
+            JobSystem::Destroy( &js );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(FanIn)
+        {
+            CoreContext::DefaultContext();
+
+            const size_t parent_count = 32;
+
+            Allocator allocator = HeapAllocator::Create();
+
+            JobSystem js = {};
+            JobSystem::Create( WORKER_COUNT, allocator, &js );
+
+            volatile int32_t done_count = 0;
+
+            CountData data = {};
+            data.done_count = &done_count;
+
+            JobHandle parents[parent_count] = {};
+
+            Job parent = {};
+            parent.data = &data;
+            parent.execute_fnc_ptr = CountDone;
+
+            // the first half is done before the child is scheduled , those dependencies are never registered
+            for ( size_t i = 0; i < parent_count / 2; ++i )
+            {
+                parents[i] = JobSystem::Schedule( &js, parent );
+            }
+
+            JobSystem::WaitAll( &js, { parents, parent_count / 2 } );
+
+            EVALUATE( done_count == (int32_t) parent_count / 2 );
+
+            for ( size_t i = parent_count / 2; i < parent_count; ++i )
+            {
+                parents[i] = JobSystem::Schedule( &js, parent );
+            }
+
+            Job child = {};
+            child.data = &data;
+            child.execute_fnc_ptr = ReadDone;
+
+            JobHandle child_handle = JobSystem::Schedule( &js, child, { parents, parent_count } );
+
+            JobSystem::WaitAll( &js, { &child_handle, 1 } );
+
+            // the child only ran once every parent was done
+            EVALUATE( data.seen_count == (int32_t) parent_count );
+            EVALUATE( done_count == (int32_t) parent_count );
+
+            bool all_done = true;
+
+            for ( size_t i = 0; i < parent_count; ++i )
+            {
+                all_done &= JobSystem::IsDone( &js, parents[i] );
+            }
+
+            EVALUATE( all_done );
+
+            JobSystem::Destroy( &js );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(WaitOnPendingDependencies)
+        {
+            CoreContext::DefaultContext();
+
+            Allocator allocator = HeapAllocator::Create();
+
+            JobSystem js = {};
+            JobSystem::Create( WORKER_COUNT, allocator, &js );
+
+            volatile int32_t is_open = 0;
+            volatile int32_t parent_done = 0;
+
+            GateData data = {};
+            data.is_open = &is_open;
+            data.parent_done = &parent_done;
+            data.seen_parent_done = -1;
+
+            Job parent = {};
+            parent.data = &data;
+            parent.execute_fnc_ptr = WaitGate;
+
+            JobHandle parent_handle = JobSystem::Schedule( &js, parent );
+
+            Job child = {};
+            child.data = &data;
+            child.execute_fnc_ptr = ReadParentDone;
+
+            JobHandle child_handle = JobSystem::Schedule( &js, child, { &parent_handle, 1 } );
+
+            // the parent can't finish until the gate opens , so the child can't have started
+            EVALUATE( !JobSystem::IsDone( &js, parent_handle ) );
+            EVALUATE( !JobSystem::IsDone( &js, child_handle ) );
+            EVALUATE( data.seen_parent_done == -1 );
+
+            // nobody opens the gate but this job , Wait has to run or let the workers run other jobs meanwhile
+            Job opener = {};
+            opener.data = &data;
+            opener.execute_fnc_ptr = OpenGate;
+
+            JobSystem::Schedule( &js, opener );
+            JobSystem::Wait( &js, child_handle );
+
+            EVALUATE( JobSystem::IsDone( &js, parent_handle ) );
+            EVALUATE( JobSystem::IsDone( &js, child_handle ) );
+            EVALUATE( data.seen_parent_done == 1 );
+
+            JobSystem::Destroy( &js );
+
+            TEST_END()
+        }
+
+        TEST_DECLARATION(ContinuationSchedulesOnParent)
+        {
+            CoreContext::DefaultContext();
+
+            const size_t child_count = 64;
+
+            Allocator allocator = HeapAllocator::Create();
+
+            JobSystem js = {};
+            JobSystem::Create( WORKER_COUNT, allocator, &js );
+
+            volatile int32_t is_open = 0;
+            volatile int32_t next = 0;
+            volatile int32_t done_count = 0;
+            JobHandle children[child_count] = {};
+            JobHandle scheduled[child_count] = {};
+
+            RescheduleData data = {};
+            data.js = &js;
+            data.is_open = &is_open;
+            data.next = &next;
+            data.done_count = &done_count;
+            data.scheduled = scheduled;
+
+            Job parent = {};
+            parent.data = &data;
+            parent.execute_fnc_ptr = WaitOpen;
+
+            data.parent = JobSystem::Schedule( &js, parent );
+
+            Job child = {};
+            child.data = &data;
+            child.execute_fnc_ptr = ScheduleOnParent;
+
+            // the children run as continuations of the parent and schedule against it while it's finishing
+            for ( size_t i = 0; i < child_count; ++i )
+            {
+                children[i] = JobSystem::Schedule( &js, child, { &data.parent, 1 } );
+            }
+
+            Atomic::Store( &is_open, 1 );
+
+            JobSystem::WaitAll( &js, { children, child_count } );
+
+            EVALUATE( next == (int32_t) child_count );
+
+            JobSystem::WaitAll( &js, { scheduled, child_count } );
+
+            EVALUATE( done_count == (int32_t) child_count * 2 );
+
+            JobSystem::Destroy( &js );
+
+            TEST_END()
+        }
+
+        static inline DArray<TestCallback> GetAll()
+        {
+            Allocator alloc = HeapAllocator::Create();
+            DArray<TestCallback> arr = {};
+            DArray<TestCallback>::Create(4 , &arr , alloc);
+
+            DArray<TestCallback>::Add(&arr , JobSystemTests::DependencyChain);
+            DArray<TestCallback>::Add(&arr , JobSystemTests::FanIn);
+            DArray<TestCallback>::Add(&arr , JobSystemTests::WaitOnPendingDependencies);
+            DArray<TestCallback>::Add(&arr , JobSystemTests::ContinuationSchedulesOnParent);
+
+            return arr;
+        }
+    };
+}
@@ -0,0 +1,11 @@
+#include <Testing/BTest.h>
+#include "JobSystemTests.h"
+
+int main(int argc , char** argv)
+{
+    BTest::Init();
+
+    BTest::AppendAll(Tests::JobSystemTests::GetAll());
+
+    BTest::RunAll();
+}
@@ -3,6 +3,7 @@
 #include "Quaternion.h"
 #include "Matrix3x3.h"
 #include "Maths.h"
+#include "SIMD.h"
 #include <memory>
 
 struct Vector4Ref
@@ -241,7 +242,10 @@ public:
         return res;
     }
 
-    static inline Matrix4x4 Inverse( Matrix4x4& source )
+    /// <summary>
+    /// Reference version of "Inverse" , cofactors over determinant
+    /// </summary>
+    static inline Matrix4x4 InverseScalar( Matrix4x4& source )
     {
         Matrix4x4 res = {};
 
@@ -251,7 +255,7 @@ public:
 
         Matrix4x4 cofactor = Cofactor( source );
 
-        Matrix4x4 transposedCofactor = Transpose( cofactor );
+        Matrix4x4 transposedCofactor = TransposeScalar( cofactor );
 
         res = transposedCofactor / det;
 
@@ -314,7 +318,7 @@ public:
         return res;
     }
 
-    static inline Matrix4x4 Transpose( Matrix4x4& source )
+    static inline Matrix4x4 TransposeScalar( Matrix4x4& source )
     {
         Matrix4x4 res = {};
 
@@ -329,6 +333,411 @@ public:
 
         return res;
     }
+
+    /// <summary>
+    /// Reference version of "Multiply" , the SIMD version is checked against it
+    /// </summary>
+    static inline Matrix4x4 MultiplyScalar( const Matrix4x4& lhs, const Matrix4x4& rhs )
+    {
+        Matrix4x4 res;
+        res.m00 = rhs.m00 * lhs.m00 + rhs.m01 * lhs.m10 + rhs.m02 * lhs.m20 + rhs.m03 * lhs.m30;
+        res.m01 = rhs.m00 * lhs.m01 + rhs.m01 * lhs.m11 + rhs.m02 * lhs.m21 + rhs.m03 * lhs.m31;
+        res.m02 = rhs.m00 * lhs.m02 + rhs.m01 * lhs.m12 + rhs.m02 * lhs.m22 + rhs.m03 * lhs.m32;
+        res.m03 = rhs.m00 * lhs.m03 + rhs.m01 * lhs.m13 + rhs.m02 * lhs.m23 + rhs.m03 * lhs.m33;
+
+        res.m10 = rhs.m10 * lhs.m00 + rhs.m11 * lhs.m10 + rhs.m12 * lhs.m20 + rhs.m13 * lhs.m30;
+        res.m11 = rhs.m10 * lhs.m01 + rhs.m11 * lhs.m11 + rhs.m12 * lhs.m21 + rhs.m13 * lhs.m31;
+        res.m12 = rhs.m10 * lhs.m02 + rhs.m11 * lhs.m12 + rhs.m12 * lhs.m22 + rhs.m13 * lhs.m32;
+        res.m13 = rhs.m10 * lhs.m03 + rhs.m11 * lhs.m13 + rhs.m12 * lhs.m23 + rhs.m13 * lhs.m33;
+
+        res.m20 = rhs.m20 * lhs.m00 + rhs.m21 * lhs.m10 + rhs.m22 * lhs.m20 + rhs.m23 * lhs.m30;
+        res.m21 = rhs.m20 * lhs.m01 + rhs.m21 * lhs.m11 + rhs.m22 * lhs.m21 + rhs.m23 * lhs.m31;
+        res.m22 = rhs.m20 * lhs.m02 + rhs.m21 * lhs.m12 + rhs.m22 * lhs.m22 + rhs.m23 * lhs.m32;
+        res.m23 = rhs.m20 * lhs.m03 + rhs.m21 * lhs.m13 + rhs.m22 * lhs.m23 + rhs.m23 * lhs.m33;
+
+        res.m30 = rhs.m30 * lhs.m00 + rhs.m31 * lhs.m10 + rhs.m32 * lhs.m20 + rhs.m33 * lhs.m30;
+        res.m31 = rhs.m30 * lhs.m01 + rhs.m31 * lhs.m11 + rhs.m32 * lhs.m21 + rhs.m33 * lhs.m31;
+        res.m32 = rhs.m30 * lhs.m02 + rhs.m31 * lhs.m12 + rhs.m32 * lhs.m22 + rhs.m33 * lhs.m32;
+        res.m33 = rhs.m30 * lhs.m03 + rhs.m31 * lhs.m13 + rhs.m32 * lhs.m23 + rhs.m33 * lhs.m33;
+
+        return res;
+    }
+
+    /// <summary>
+    /// Reference version of "TransformPoint" , w is taken as 1 and dropped
+    /// </summary>
+    static inline Vector3 TransformPointScalar( const Matrix4x4& mat, const Vector3& point )
+    {
+        Vector3 res = Vector3
+        (
+            (mat.rows[0].x * point.x) + (mat.rows[0].y * point.y) + (mat.rows[0].z * point.z) + (mat.rows[0].w),
+            (mat.rows[1].x * point.x) + (mat.rows[1].y * point.y) + (mat.rows[1].z * point.z) + (mat.rows[1].w),
+            (mat.rows[2].x * point.x) + (mat.rows[2].y * point.y) + (mat.rows[2].z * point.z) + (mat.rows[2].w)
+        );
+
+        return res;
+    }
+
+    /// <summary>
+    /// Reference version of "Transform"
+    /// </summary>
+    static inline Vector4 TransformScalar( const Matrix4x4& mat, const Vector4& vec )
+    {
+        Vector4 res = Vector4
+        (
+            (mat.rows[0].x * vec.x) + (mat.rows[0].y * vec.y) + (mat.rows[0].z * vec.z) + (mat.rows[0].w * vec.w),
+            (mat.rows[1].x * vec.x) + (mat.rows[1].y * vec.y) + (mat.rows[1].z * vec.z) + (mat.rows[1].w * vec.w),
+            (mat.rows[2].x * vec.x) + (mat.rows[2].y * vec.y) + (mat.rows[2].z * vec.z) + (mat.rows[2].w * vec.w),
+            (mat.rows[3].x * vec.x) + (mat.rows[3].y * vec.y) + (mat.rows[3].z * vec.z) + (mat.rows[3].w * vec.w)
+        );
+
+        return res;
+    }
+
+    // NOTE : the versions below use SSE2 when it's available (see SIMD.h) and fall back to the scalar ones otherwise ,
+    // loads and stores are unaligned so matrices don't need any particular alignment
+
+    static inline Matrix4x4 Transpose( const Matrix4x4& source )
+    {
+#if MATHS_SSE2
+        __m128 r0 = _mm_loadu_ps( source.rows[0].values );
+        __m128 r1 = _mm_loadu_ps( source.rows[1].values );
+        __m128 r2 = _mm_loadu_ps( source.rows[2].values );
+        __m128 r3 = _mm_loadu_ps( source.rows[3].values );
+
+        _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+        Matrix4x4 res;
+        _mm_storeu_ps( res.rows[0].values, r0 );
+        _mm_storeu_ps( res.rows[1].values, r1 );
+        _mm_storeu_ps( res.rows[2].values, r2 );
+        _mm_storeu_ps( res.rows[3].values, r3 );
+
+        return res;
+#else
+        Matrix4x4 copy = source;
+        return TransposeScalar( copy );
+#endif
+    }
+
+    /// <summary>
+    /// <para>Multiplies two matricies together , same as "lhs * rhs"</para>
+    /// <para>The resulting matrix would combine both matricies apply the rhs first , followed by the lhs</para>
+    /// </summary>
+    static inline Matrix4x4 Multiply( const Matrix4x4& lhs, const Matrix4x4& rhs )
+    {
+#if MATHS_SSE2
+        __m128 b0 = _mm_loadu_ps( rhs.rows[0].values );
+        __m128 b1 = _mm_loadu_ps( rhs.rows[1].values );
+        __m128 b2 = _mm_loadu_ps( rhs.rows[2].values );
+        __m128 b3 = _mm_loadu_ps( rhs.rows[3].values );
+
+        Matrix4x4 res;
+
+        for ( int i = 0; i < 4; ++i )
+        {
+            __m128 row = CombineRows( _mm_loadu_ps( lhs.rows[i].values ), b0, b1, b2, b3 );
+            _mm_storeu_ps( res.rows[i].values, row );
+        }
+
+        return res;
+#else
+        return MultiplyScalar( lhs, rhs );
+#endif
+    }
+
+    /// <summary>
+    /// <para>Inverts a matrix , a singular matrix gives infinities / NaNs just like the scalar version</para>
+    /// <para>SIMD version uses the 2x2 block decomposition , the results match "InverseScalar" within float precision</para>
+    /// </summary>
+    static inline Matrix4x4 Inverse( const Matrix4x4& source )
+    {
+#if MATHS_SSE2
+        __m128 r0 = _mm_loadu_ps( source.rows[0].values );
+        __m128 r1 = _mm_loadu_ps( source.rows[1].values );
+        __m128 r2 = _mm_loadu_ps( source.rows[2].values );
+        __m128 r3 = _mm_loadu_ps( source.rows[3].values );
+
+        // 2x2 sub matrices , each stored as ( x00 , x01 , x10 , x11 )
+        // | A B |
+        // | C D |
+        __m128 A = _mm_movelh_ps( r0, r1 );
+        __m128 B = _mm_movehl_ps( r1, r0 );
+        __m128 C = _mm_movelh_ps( r2, r3 );
+        __m128 D = _mm_movehl_ps( r3, r2 );
+
+        // ( |A| , |B| , |C| , |D| )
+        __m128 det_sub = _mm_sub_ps(
+            _mm_mul_ps( _mm_shuffle_ps( r0, r2, MATHS_SHUFFLE( 0, 2, 0, 2 ) ), _mm_shuffle_ps( r1, r3, MATHS_SHUFFLE( 1, 3, 1, 3 ) ) ),
+            _mm_mul_ps( _mm_shuffle_ps( r0, r2, MATHS_SHUFFLE( 1, 3, 1, 3 ) ), _mm_shuffle_ps( r1, r3, MATHS_SHUFFLE( 0, 2, 0, 2 ) ) )
+        );
+
+        __m128 det_a = MATHS_SWIZZLE( det_sub, 0, 0, 0, 0 );
+        __m128 det_b = MATHS_SWIZZLE( det_sub, 1, 1, 1, 1 );
+        __m128 det_c = MATHS_SWIZZLE( det_sub, 2, 2, 2, 2 );
+        __m128 det_d = MATHS_SWIZZLE( det_sub, 3, 3, 3, 3 );
+
+        // # is the adjugate
+        __m128 d_c = Mat2AdjMul( D, C );
+        __m128 a_b = Mat2AdjMul( A, B );
+
+        // X# = |D|A - B(D#C) , W# = |A|D - C(A#B)
+        __m128 x = _mm_sub_ps( _mm_mul_ps( det_d, A ), Mat2Mul( B, d_c ) );
+        __m128 w = _mm_sub_ps( _mm_mul_ps( det_a, D ), Mat2Mul( C, a_b ) );
+
+        // Y# = |B|C - D(A#B)# , Z# = |C|B - A(D#C)#
+        __m128 y = _mm_sub_ps( _mm_mul_ps( det_b, C ), Mat2MulAdj( D, a_b ) );
+        __m128 z = _mm_sub_ps( _mm_mul_ps( det_c, B ), Mat2MulAdj( A, d_c ) );
+
+        // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        __m128 trace = _mm_mul_ps( a_b, MATHS_SWIZZLE( d_c, 0, 2, 1, 3 ) );
+        trace = _mm_add_ps( trace, MATHS_SWIZZLE( trace, 2, 3, 0, 1 ) );
+        trace = _mm_add_ps( trace, MATHS_SWIZZLE( trace, 1, 0, 3, 2 ) );
+
+        __m128 det = _mm_add_ps( _mm_mul_ps( det_a, det_d ), _mm_mul_ps( det_b, det_c ) );
+        det = _mm_sub_ps( det, trace );
+
+        __m128 det_inverse = _mm_div_ps( _mm_setr_ps( 1.f, -1.f, -1.f, 1.f ), det );
+
+        x = _mm_mul_ps( x, det_inverse );
+        y = _mm_mul_ps( y, det_inverse );
+        z = _mm_mul_ps( z, det_inverse );
+        w = _mm_mul_ps( w, det_inverse );
+
+        // the shuffles apply the adjugate and put the blocks back in rows
+        Matrix4x4 res;
+        _mm_storeu_ps( res.rows[0].values, _mm_shuffle_ps( x, y, MATHS_SHUFFLE( 3, 1, 3, 1 ) ) );
+        _mm_storeu_ps( res.rows[1].values, _mm_shuffle_ps( x, y, MATHS_SHUFFLE( 2, 0, 2, 0 ) ) );
+        _mm_storeu_ps( res.rows[2].values, _mm_shuffle_ps( z, w, MATHS_SHUFFLE( 3, 1, 3, 1 ) ) );
+        _mm_storeu_ps( res.rows[3].values, _mm_shuffle_ps( z, w, MATHS_SHUFFLE( 2, 0, 2, 0 ) ) );
+
+        return res;
+#else
+        Matrix4x4 copy = source;
+        return InverseScalar( copy );
+#endif
+    }
+
+    /// <summary>
+    /// Transforms a point , w is taken as 1 and dropped , same as "mat * point"
+    /// </summary>
+    static inline Vector3 TransformPoint( const Matrix4x4& mat, const Vector3& point )
+    {
+#if MATHS_SSE2
+        __m128 c0, c1, c2, c3;
+        LoadColumns( mat, &c0, &c1, &c2, &c3 );
+
+        __m128 res = _mm_add_ps( _mm_mul_ps( c0, _mm_set1_ps( point.x ) ), c3 );
+        res = _mm_add_ps( res, _mm_mul_ps( c1, _mm_set1_ps( point.y ) ) );
+        res = _mm_add_ps( res, _mm_mul_ps( c2, _mm_set1_ps( point.z ) ) );
+
+        return StoreVector3( res );
+#else
+        return TransformPointScalar( mat, point );
+#endif
+    }
+
+    /// <summary>
+    /// Transforms a 4d vector , same as "mat * vec"
+    /// </summary>
+    static inline Vector4 Transform( const Matrix4x4& mat, const Vector4& vec )
+    {
+#if MATHS_SSE2
+        __m128 c0, c1, c2, c3;
+        LoadColumns( mat, &c0, &c1, &c2, &c3 );
+
+        Vector4 res;
+        _mm_storeu_ps( res.values, CombineRows( _mm_loadu_ps( vec.values ), c0, c1, c2, c3 ) );
+
+        return res;
+#else
+        return TransformScalar( mat, vec );
+#endif
+    }
+
+    /// <summary>
+    /// <para>Transforms "count" points with the same matrix into "out" , in and out can be the same array</para>
+    /// <para>The matrix is only transposed once for the whole batch</para>
+    /// </summary>
+    static inline void TransformPoints( const Matrix4x4& mat, const Vector3* in, Vector3* out, size_t count )
+    {
+#if MATHS_SSE2
+        __m128 c0, c1, c2, c3;
+        LoadColumns( mat, &c0, &c1, &c2, &c3 );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            __m128 res = _mm_add_ps( _mm_mul_ps( c0, _mm_set1_ps( in[i].x ) ), c3 );
+            res = _mm_add_ps( res, _mm_mul_ps( c1, _mm_set1_ps( in[i].y ) ) );
+            res = _mm_add_ps( res, _mm_mul_ps( c2, _mm_set1_ps( in[i].z ) ) );
+
+            out[i] = StoreVector3( res );
+        }
+#else
+        for ( size_t i = 0; i < count; ++i )
+        {
+            out[i] = TransformPointScalar( mat, in[i] );
+        }
+#endif
+    }
+
+    /// <summary>
+    /// <para>Transforms "count" 4d vectors with the same matrix into "out" , in and out can be the same array</para>
+    /// <para>With AVX two vectors go through per iteration</para>
+    /// </summary>
+    static inline void TransformVectors( const Matrix4x4& mat, const Vector4* in, Vector4* out, size_t count )
+    {
+#if MATHS_SSE2
+        __m128 c0, c1, c2, c3;
+        LoadColumns( mat, &c0, &c1, &c2, &c3 );
+
+        size_t i = 0;
+
+#if MATHS_AVX
+        __m256 c0x2 = _mm256_insertf128_ps( _mm256_castps128_ps256( c0 ), c0, 1 );
+        __m256 c1x2 = _mm256_insertf128_ps( _mm256_castps128_ps256( c1 ), c1, 1 );
+        __m256 c2x2 = _mm256_insertf128_ps( _mm256_castps128_ps256( c2 ), c2, 1 );
+        __m256 c3x2 = _mm256_insertf128_ps( _mm256_castps128_ps256( c3 ), c3, 1 );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            __m256 vec = _mm256_loadu_ps( in[i].values );
+
+            __m256 res = _mm256_mul_ps( _mm256_permute_ps( vec, 0x00 ), c0x2 );
+            res = _mm256_add_ps( res, _mm256_mul_ps( _mm256_permute_ps( vec, 0x55 ), c1x2 ) );
+            res = _mm256_add_ps( res, _mm256_mul_ps( _mm256_permute_ps( vec, 0xAA ), c2x2 ) );
+            res = _mm256_add_ps( res, _mm256_mul_ps( _mm256_permute_ps( vec, 0xFF ), c3x2 ) );
+
+            _mm256_storeu_ps( out[i].values, res );
+        }
+#endif
+
+        for ( ; i < count; ++i )
+        {
+            _mm_storeu_ps( out[i].values, CombineRows( _mm_loadu_ps( in[i].values ), c0, c1, c2, c3 ) );
+        }
+#else
+        for ( size_t i = 0; i < count; ++i )
+        {
+            out[i] = TransformScalar( mat, in[i] );
+        }
+#endif
+    }
+
+    /// <summary>
+    /// <para>Computes "lhs * rhs[i]" into "out[i]" for "count" matricies (ex : view projection times every model matrix)</para>
+    /// <para>rhs and out can be the same array , with AVX two rows go through per instruction</para>
+    /// </summary>
+    static inline void MultiplyBatch( const Matrix4x4& lhs, const Matrix4x4* rhs, Matrix4x4* out, size_t count )
+    {
+#if MATHS_AVX
+        __m256 w01 = _mm256_loadu_ps( lhs.rows[0].values );
+        __m256 w23 = _mm256_loadu_ps( lhs.rows[2].values );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            __m256 b0 = _mm256_broadcast_ps( (const __m128*) rhs[i].rows[0].values );
+            __m256 b1 = _mm256_broadcast_ps( (const __m128*) rhs[i].rows[1].values );
+            __m256 b2 = _mm256_broadcast_ps( (const __m128*) rhs[i].rows[2].values );
+            __m256 b3 = _mm256_broadcast_ps( (const __m128*) rhs[i].rows[3].values );
+
+            __m256 r01 = _mm256_mul_ps( _mm256_permute_ps( w01, 0x00 ), b0 );
+            r01 = _mm256_add_ps( r01, _mm256_mul_ps( _mm256_permute_ps( w01, 0x55 ), b1 ) );
+            r01 = _mm256_add_ps( r01, _mm256_mul_ps( _mm256_permute_ps( w01, 0xAA ), b2 ) );
+            r01 = _mm256_add_ps( r01, _mm256_mul_ps( _mm256_permute_ps( w01, 0xFF ), b3 ) );
+
+            __m256 r23 = _mm256_mul_ps( _mm256_permute_ps( w23, 0x00 ), b0 );
+            r23 = _mm256_add_ps( r23, _mm256_mul_ps( _mm256_permute_ps( w23, 0x55 ), b1 ) );
+            r23 = _mm256_add_ps( r23, _mm256_mul_ps( _mm256_permute_ps( w23, 0xAA ), b2 ) );
+            r23 = _mm256_add_ps( r23, _mm256_mul_ps( _mm256_permute_ps( w23, 0xFF ), b3 ) );
+
+            _mm256_storeu_ps( out[i].rows[0].values, r01 );
+            _mm256_storeu_ps( out[i].rows[2].values, r23 );
+        }
+#elif MATHS_SSE2
+        __m128 w0 = _mm_loadu_ps( lhs.rows[0].values );
+        __m128 w1 = _mm_loadu_ps( lhs.rows[1].values );
+        __m128 w2 = _mm_loadu_ps( lhs.rows[2].values );
+        __m128 w3 = _mm_loadu_ps( lhs.rows[3].values );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            __m128 b0 = _mm_loadu_ps( rhs[i].rows[0].values );
+            __m128 b1 = _mm_loadu_ps( rhs[i].rows[1].values );
+            __m128 b2 = _mm_loadu_ps( rhs[i].rows[2].values );
+            __m128 b3 = _mm_loadu_ps( rhs[i].rows[3].values );
+
+            _mm_storeu_ps( out[i].rows[0].values, CombineRows( w0, b0, b1, b2, b3 ) );
+            _mm_storeu_ps( out[i].rows[1].values, CombineRows( w1, b0, b1, b2, b3 ) );
+            _mm_storeu_ps( out[i].rows[2].values, CombineRows( w2, b0, b1, b2, b3 ) );
+            _mm_storeu_ps( out[i].rows[3].values, CombineRows( w3, b0, b1, b2, b3 ) );
+        }
+#else
+        for ( size_t i = 0; i < count; ++i )
+        {
+            out[i] = MultiplyScalar( lhs, rhs[i] );
+        }
+#endif
+    }
+
+private:
+
+#if MATHS_SSE2
+    /// <summary>
+    /// weights.x * r0 + weights.y * r1 + weights.z * r2 + weights.w * r3
+    /// </summary>
+    static inline __m128 CombineRows( __m128 weights, __m128 r0, __m128 r1, __m128 r2, __m128 r3 )
+    {
+        __m128 res = _mm_mul_ps( MATHS_SWIZZLE( weights, 0, 0, 0, 0 ), r0 );
+        res = _mm_add_ps( res, _mm_mul_ps( MATHS_SWIZZLE( weights, 1, 1, 1, 1 ), r1 ) );
+        res = _mm_add_ps( res, _mm_mul_ps( MATHS_SWIZZLE( weights, 2, 2, 2, 2 ), r2 ) );
+        res = _mm_add_ps( res, _mm_mul_ps( MATHS_SWIZZLE( weights, 3, 3, 3, 3 ), r3 ) );
+
+        return res;
+    }
+
+    static inline void LoadColumns( const Matrix4x4& mat, __m128* c0, __m128* c1, __m128* c2, __m128* c3 )
+    {
+        *c0 = _mm_loadu_ps( mat.rows[0].values );
+        *c1 = _mm_loadu_ps( mat.rows[1].values );
+        *c2 = _mm_loadu_ps( mat.rows[2].values );
+        *c3 = _mm_loadu_ps( mat.rows[3].values );
+
+        _MM_TRANSPOSE4_PS( *c0, *c1, *c2, *c3 );
+    }
+
+    static inline Vector3 StoreVector3( __m128 vec )
+    {
+        float values[4];
+        _mm_storeu_ps( values, vec );
+
+        return Vector3( values[0], values[1], values[2] );
+    }
+
+    // NOTE : 2x2 helpers for "Inverse" , a 2x2 matrix is stored as ( x00 , x01 , x10 , x11 )
+
+    // lhs * rhs
+    static inline __m128 Mat2Mul( __m128 lhs, __m128 rhs )
+    {
+        return _mm_add_ps( _mm_mul_ps( lhs, MATHS_SWIZZLE( rhs, 0, 3, 0, 3 ) ),
+                           _mm_mul_ps( MATHS_SWIZZLE( lhs, 1, 0, 3, 2 ), MATHS_SWIZZLE( rhs, 2, 1, 2, 1 ) ) );
+    }
+
+    // adjugate(lhs) * rhs
+    static inline __m128 Mat2AdjMul( __m128 lhs, __m128 rhs )
+    {
+        return _mm_sub_ps( _mm_mul_ps( MATHS_SWIZZLE( lhs, 3, 3, 0, 0 ), rhs ),
+                           _mm_mul_ps( MATHS_SWIZZLE( lhs, 1, 1, 2, 2 ), MATHS_SWIZZLE( rhs, 2, 3, 0, 1 ) ) );
+    }
+
+    // lhs * adjugate(rhs)
+    static inline __m128 Mat2MulAdj( __m128 lhs, __m128 rhs )
+    {
+        return _mm_sub_ps( _mm_mul_ps( lhs, MATHS_SWIZZLE( rhs, 3, 0, 3, 0 ) ),
+                           _mm_mul_ps( MATHS_SWIZZLE( lhs, 1, 0, 3, 2 ), MATHS_SWIZZLE( rhs, 2, 1, 2, 1 ) ) );
+    }
+#endif
+
 public:
 
     inline Matrix4x4 operator/( float& div )
@@ -345,14 +754,12 @@ public:
 
     inline friend Vector3 operator*( const Matrix4x4& lhs, const Vector3& rhs )
     {
-        Vector3 res = Vector3
-        (
-            (lhs.rows[0].x * rhs.x) + (lhs.rows[0].y * rhs.y) + (lhs.rows[0].z * rhs.z) + (lhs.rows[0].w),
-            (lhs.rows[1].x * rhs.x) + (lhs.rows[1].y * rhs.y) + (lhs.rows[1].z * rhs.z) + (lhs.rows[1].w),
-            (lhs.rows[2].x * rhs.x) + (lhs.rows[2].y * rhs.y) + (lhs.rows[2].z * rhs.z) + (lhs.rows[2].w)
-        );
+        return TransformPoint( lhs, rhs );
+    }
 
-        return res;
+    inline friend Vector4 operator*( const Matrix4x4& lhs, const Vector4& rhs )
+    {
+        return Transform( lhs, rhs );
     }
 
     inline Matrix4x4 operator*( float& mul )
@@ -379,29 +786,8 @@ public:
     /// <param name="lhs">Left hand side matrix</param>
     /// <param name="rhs">Right hand side matrix</param>
     /// <returns></returns>
-    inline friend Matrix4x4 operator*(Matrix4x4 lhs , Matrix4x4 rhs )
+    inline friend Matrix4x4 operator*(const Matrix4x4& lhs , const Matrix4x4& rhs )
     {
-        Matrix4x4 res;
-        res.m00 = rhs.m00 * lhs.m00 + rhs.m01 * lhs.m10 + rhs.m02 * lhs.m20 + rhs.m03 * lhs.m30;
-        res.m01 = rhs.m00 * lhs.m01 + rhs.m01 * lhs.m11 + rhs.m02 * lhs.m21 + rhs.m03 * lhs.m31;
-        res.m02 = rhs.m00 * lhs.m02 + rhs.m01 * lhs.m12 + rhs.m02 * lhs.m22 + rhs.m03 * lhs.m32;
-        res.m03 = rhs.m00 * lhs.m03 + rhs.m01 * lhs.m13 + rhs.m02 * lhs.m23 + rhs.m03 * lhs.m33;
-
-        res.m10 = rhs.m10 * lhs.m00 + rhs.m11 * lhs.m10 + rhs.m12 * lhs.m20 + rhs.m13 * lhs.m30;
-        res.m11 = rhs.m10 * lhs.m01 + rhs.m11 * lhs.m11 + rhs.m12 * lhs.m21 + rhs.m13 * lhs.m31;
-        res.m12 = rhs.m10 * lhs.m02 + rhs.m11 * lhs.m12 + rhs.m12 * lhs.m22 + rhs.m13 * lhs.m32;
-        res.m13 = rhs.m10 * lhs.m03 + rhs.m11 * lhs.m13 + rhs.m12 * lhs.m23 + rhs.m13 * lhs.m33;
-
-        res.m20 = rhs.m20 * lhs.m00 + rhs.m21 * lhs.m10 + rhs.m22 * lhs.m20 + rhs.m23 * lhs.m30;
-        res.m21 = rhs.m20 * lhs.m01 + rhs.m21 * lhs.m11 + rhs.m22 * lhs.m21 + rhs.m23 * lhs.m31;
-        res.m22 = rhs.m20 * lhs.m02 + rhs.m21 * lhs.m12 + rhs.m22 * lhs.m22 + rhs.m23 * lhs.m32;
-        res.m23 = rhs.m20 * lhs.m03 + rhs.m21 * lhs.m13 + rhs.m22 * lhs.m23 + rhs.m23 * lhs.m33;
-
-        res.m30 = rhs.m30 * lhs.m00 + rhs.m31 * lhs.m10 + rhs.m32 * lhs.m20 + rhs.m33 * lhs.m30;
-        res.m31 = rhs.m30 * lhs.m01 + rhs.m31 * lhs.m11 + rhs.m32 * lhs.m21 + rhs.m33 * lhs.m31;
-        res.m32 = rhs.m30 * lhs.m02 + rhs.m31 * lhs.m12 + rhs.m32 * lhs.m22 + rhs.m33 * lhs.m32;
-        res.m33 = rhs.m30 * lhs.m03 + rhs.m31 * lhs.m13 + rhs.m32 * lhs.m23 + rhs.m33 * lhs.m33;
-
-        return res;
+        return Multiply( lhs, rhs );
     }
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+/// <summary>
+/// <para>Instruction sets the maths kernels can use , picked at compile time</para>
+/// <para>SSE2 is always there on x64 , AVX only when the compiler targets it (/arch:AVX or -mavx)</para>
+/// <para>Define MATHS_NO_SIMD to force the scalar versions</para>
+/// </summary>
+
+#if !defined(MATHS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATHS_SSE2 1
+#include <emmintrin.h>
+#else
+#define MATHS_SSE2 0
+#endif
+
+#if MATHS_SSE2 && defined(__AVX__)
+#define MATHS_AVX 1
+#include <immintrin.h>
+#else
+#define MATHS_AVX 0
+#endif
+
+#if MATHS_SSE2
+
+// NOTE : same order as the memory , MATHS_SHUFFLE(0,1,2,3) keeps a vector as is
+#define MATHS_SHUFFLE(x, y, z, w) _MM_SHUFFLE(w, z, y, x)
+
+#define MATHS_SWIZZLE(vec, x, y, z, w) _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(vec), MATHS_SHUFFLE(x, y, z, w)))
+
+#endif
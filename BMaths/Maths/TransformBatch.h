@@ -0,0 +1,145 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "SIMD.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/// <summary>
+/// <para>Many 2D quads (ui rects , glyphs , sprites ...) stored as a structure of arrays , turned into instance matrices in one pass</para>
+/// <para>Each quad gets Translate(pos) * RotateZ(rotation) * Scale(size * scale) , without rotation and scale it's the usual rect matrix</para>
+/// <para>The arrays are owned by the caller , "rotations" (radians around z) and "scales" (uniform) are optional and can stay null</para>
+/// </summary>
+struct TransformBatch
+{
+    float* pos_x;
+    float* pos_y;
+    float* size_x;
+    float* size_y;
+    float* rotations;
+    float* scales;
+
+    // z translation shared by the whole batch
+    float depth;
+    size_t count;
+
+    /// <summary>
+    /// <para>Writes "count" matrices to "out" , one every "stride" bytes so they can sit inside bigger per instance structs</para>
+    /// <para>"out" doesn't need any alignment , it can be mapped gpu memory</para>
+    /// </summary>
+    static inline void WriteMatrices( const TransformBatch* batch, void* out, size_t stride = sizeof( Matrix4x4 ) )
+    {
+        uint8_t* dst = (uint8_t*) out;
+        size_t i = 0;
+
+#if MATHS_SSE2
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 row2 = _mm_setr_ps( 0, 0, 1, batch->depth );
+        const __m128 row3 = _mm_setr_ps( 0, 0, 0, 1 );
+
+        // 4 quads at a time , the first two rows are computed as columns then transposed into each matrix
+        for ( ; i + 4 <= batch->count; i += 4 )
+        {
+            __m128 sx = _mm_loadu_ps( batch->size_x + i );
+            __m128 sy = _mm_loadu_ps( batch->size_y + i );
+
+            if ( batch->scales != nullptr )
+            {
+                __m128 scale = _mm_loadu_ps( batch->scales + i );
+                sx = _mm_mul_ps( sx, scale );
+                sy = _mm_mul_ps( sy, scale );
+            }
+
+            __m128 m00 = sx;
+            __m128 m10 = zero;
+            __m128 m01 = zero;
+            __m128 m11 = sy;
+
+            if ( batch->rotations != nullptr )
+            {
+                float cos_values[4];
+                float sin_values[4];
+
+                for ( size_t j = 0; j < 4; ++j )
+                {
+                    cos_values[j] = cosf( batch->rotations[i + j] );
+                    sin_values[j] = sinf( batch->rotations[i + j] );
+                }
+
+                __m128 cos = _mm_loadu_ps( cos_values );
+                __m128 sin = _mm_loadu_ps( sin_values );
+
+                m00 = _mm_mul_ps( sx, cos );
+                m10 = _mm_xor_ps( _mm_mul_ps( sy, sin ), _mm_set1_ps( -0.0f ) );
+                m01 = _mm_mul_ps( sx, sin );
+                m11 = _mm_mul_ps( sy, cos );
+            }
+
+            __m128 row0_a = m00, row0_b = m10, row0_c = zero, row0_d = _mm_loadu_ps( batch->pos_x + i );
+            __m128 row1_a = m01, row1_b = m11, row1_c = zero, row1_d = _mm_loadu_ps( batch->pos_y + i );
+
+            _MM_TRANSPOSE4_PS( row0_a, row0_b, row0_c, row0_d );
+            _MM_TRANSPOSE4_PS( row1_a, row1_b, row1_c, row1_d );
+
+            const __m128 rows0[4] = { row0_a, row0_b, row0_c, row0_d };
+            const __m128 rows1[4] = { row1_a, row1_b, row1_c, row1_d };
+
+            for ( size_t j = 0; j < 4; ++j )
+            {
+                float* mat = (float*) (dst + ((i + j) * stride));
+
+                _mm_storeu_ps( mat, rows0[j] );
+                _mm_storeu_ps( mat + 4, rows1[j] );
+                _mm_storeu_ps( mat + 8, row2 );
+                _mm_storeu_ps( mat + 12, row3 );
+            }
+        }
+#endif
+
+        for ( ; i < batch->count; ++i )
+        {
+            Matrix4x4 mat = QuadMatrix( batch, i );
+            memcpy( dst + (i * stride), &mat, sizeof( Matrix4x4 ) );
+        }
+    }
+
+    /// <summary>
+    /// Matrix of a single quad , used for the remainder and as the reference of "WriteMatrices"
+    /// </summary>
+    static inline Matrix4x4 QuadMatrix( const TransformBatch* batch, size_t index )
+    {
+        float sx = batch->size_x[index];
+        float sy = batch->size_y[index];
+
+        if ( batch->scales != nullptr )
+        {
+            sx *= batch->scales[index];
+            sy *= batch->scales[index];
+        }
+
+        float m00 = sx;
+        float m10 = 0;
+        float m01 = 0;
+        float m11 = sy;
+
+        if ( batch->rotations != nullptr )
+        {
+            float cos = cosf( batch->rotations[index] );
+            float sin = sinf( batch->rotations[index] );
+
+            m00 = sx * cos;
+            m10 = -(sy * sin);
+            m01 = sx * sin;
+            m11 = sy * cos;
+        }
+
+        Matrix4x4 res = Matrix4x4(
+            { m00 , m10 , 0 , batch->pos_x[index] },
+            { m01 , m11 , 0 , batch->pos_y[index] },
+            { 0   , 0   , 1 , batch->depth },
+            { 0   , 0   , 0 , 1 }
+        );
+
+        return res;
+    }
+};
@@ -44,7 +44,7 @@ public:
 
     static inline float MagnitudeSqr ( Vector4& vec )
     {
-        float res = (vec.x * vec.x) + (vec.y * vec.y) + (vec.z * vec.y) + (vec.w * vec.w);
+        float res = (vec.x * vec.x) + (vec.y * vec.y) + (vec.z * vec.z) + (vec.w * vec.w);
 
         return res;
     }
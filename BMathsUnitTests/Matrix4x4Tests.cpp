@@ -64,6 +64,9 @@ namespace Tests
             return input;
         }
 
+        // NOTE : the SIMD kernels only have to match the scalar ones within float precision
+        static constexpr float SIMD_EPSILON = 0.0001f;
+
     public:
 
         TEST_METHOD ( PerpectiveMatrix )
@@ -187,5 +190,118 @@ namespace Tests
 
             Assert::AreEqual ( expected, result );
         }
+
+        TEST_METHOD ( MultiplyMatchesScalar )
+        {
+            Matrix4x4 lhs = GetFloatingInput ();
+            Matrix4x4 rhs = Matrix4x4::Rotate ( Quaternion::AxisRotation ( 30, Vector3::Up () ) ) * Matrix4x4::Translate ( Vector3 ( 1, 2, 3 ) );
+
+            Matrix4x4 result = Matrix4x4::Multiply ( lhs, rhs );
+            Matrix4x4 expected = Matrix4x4::MultiplyScalar ( lhs, rhs );
+
+            bool approxEq = Matrix4x4::ApproxEqual ( expected, result, SIMD_EPSILON );
+
+            Assert::IsTrue ( approxEq );
+        }
+
+        TEST_METHOD ( InverseMatchesScalar )
+        {
+            Matrix4x4 input = GetFloatingInput ();
+
+            Matrix4x4 result = Matrix4x4::Inverse ( input );
+            Matrix4x4 expected = Matrix4x4::InverseScalar ( input );
+
+            bool approxEq = Matrix4x4::ApproxEqual ( expected, result, SIMD_EPSILON );
+
+            Assert::IsTrue ( approxEq );
+        }
+
+        TEST_METHOD ( TransposeMatchesScalar )
+        {
+            Matrix4x4 input = GetFloatingInput ();
+
+            Matrix4x4 result = Matrix4x4::Transpose ( input );
+            Matrix4x4 expected = Matrix4x4::TransposeScalar ( input );
+
+            Assert::IsTrue ( result == expected );
+        }
+
+        TEST_METHOD ( TransformMatchesScalar )
+        {
+            Matrix4x4 mat = GetFloatingInput ();
+            Vector3 point = Vector3 ( 0.5f, -2, 3 );
+            Vector4 vec = Vector4 ( 0.5f, -2, 3, 0.25f );
+
+            Vector3 point_result = Matrix4x4::TransformPoint ( mat, point );
+            Vector3 point_expected = Matrix4x4::TransformPointScalar ( mat, point );
+
+            Vector4 vec_result = Matrix4x4::Transform ( mat, vec );
+            Vector4 vec_expected = Matrix4x4::TransformScalar ( mat, vec );
+
+            Assert::IsTrue ( Vector3::EqualsApprox ( point_expected, point_result ) );
+            Assert::IsTrue ( Vector4::ApproxEqual ( vec_expected, vec_result, SIMD_EPSILON ) );
+        }
+
+        TEST_METHOD ( BatchTransformsMatchScalar )
+        {
+            // odd count so the AVX path also goes through its remainder
+            constexpr size_t COUNT = 7;
+
+            Matrix4x4 mat = GetFloatingInput ();
+            Vector3 points[COUNT] = {};
+            Vector4 vecs[COUNT] = {};
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                points[i] = Vector3 ( (float) i, -(float) i * 0.5f, 1.5f );
+                vecs[i] = Vector4 ( (float) i, 2, -(float) i * 0.25f, 1 );
+            }
+
+            Vector3 points_result[COUNT] = {};
+            Vector4 vecs_result[COUNT] = {};
+
+            Matrix4x4::TransformPoints ( mat, points, points_result, COUNT );
+            Matrix4x4::TransformVectors ( mat, vecs, vecs_result, COUNT );
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                Vector3 point_expected = Matrix4x4::TransformPointScalar ( mat, points[i] );
+                Vector4 vec_expected = Matrix4x4::TransformScalar ( mat, vecs[i] );
+
+                Assert::IsTrue ( Vector3::EqualsApprox ( point_expected, points_result[i] ) );
+                Assert::IsTrue ( Vector4::ApproxEqual ( vec_expected, vecs_result[i], SIMD_EPSILON ) );
+            }
+
+            // in place
+            Matrix4x4::TransformVectors ( mat, vecs, vecs, COUNT );
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                Assert::IsTrue ( vecs[i] == vecs_result[i] );
+            }
+        }
+
+        TEST_METHOD ( MultiplyBatchMatchesScalar )
+        {
+            constexpr size_t COUNT = 5;
+
+            Matrix4x4 lhs = GetFloatingInput ();
+            Matrix4x4 rhs[COUNT] = {};
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                rhs[i] = Matrix4x4::Translate ( Vector3 ( (float) i, 1, -(float) i ) ) * Matrix4x4::Scale ( Vector3 ( 1, 2, (float) i ) );
+            }
+
+            Matrix4x4 result[COUNT] = {};
+            Matrix4x4::MultiplyBatch ( lhs, rhs, result, COUNT );
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                Matrix4x4 expected = Matrix4x4::MultiplyScalar ( lhs, rhs[i] );
+
+                Assert::IsTrue ( Matrix4x4::ApproxEqual ( expected, result[i], SIMD_EPSILON ) );
+            }
+        }
     };
 }
@@ -0,0 +1,127 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <Maths/Matrix4x4.h>
+#include <Maths/TransformBatch.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Tests
+{
+    TEST_CLASS ( TransformBatchTests )
+    {
+    private:
+
+        // odd count so the SIMD path also goes through its remainder
+        static constexpr size_t COUNT = 11;
+
+        float pos_x[COUNT];
+        float pos_y[COUNT];
+        float size_x[COUNT];
+        float size_y[COUNT];
+        float rotations[COUNT];
+        float scales[COUNT];
+
+        TransformBatch GetBatch ()
+        {
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                pos_x[i] = (float) i * 10;
+                pos_y[i] = 50 - (float) i;
+                size_x[i] = 8 + (float) i;
+                size_y[i] = 16;
+                rotations[i] = (float) i * 0.3f;
+                scales[i] = 1 + ((float) i * 0.5f);
+            }
+
+            TransformBatch batch = {};
+            batch.pos_x = pos_x;
+            batch.pos_y = pos_y;
+            batch.size_x = size_x;
+            batch.size_y = size_y;
+            batch.count = COUNT;
+
+            return batch;
+        }
+
+    public:
+
+        TEST_METHOD ( MatchesRectMatrix )
+        {
+            TransformBatch batch = GetBatch ();
+
+            Matrix4x4 result[COUNT] = {};
+            TransformBatch::WriteMatrices ( &batch, result );
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                Matrix4x4 expected = Matrix4x4(
+                    { size_x[i], 0, 0, pos_x[i] },
+                    { 0, size_y[i], 0, pos_y[i] },
+                    { 0, 0, 1, 0 },
+                    { 0, 0, 0, 1 } );
+
+                Assert::IsTrue ( result[i] == expected );
+            }
+        }
+
+        TEST_METHOD ( MatchesComposedMatrices )
+        {
+            TransformBatch batch = GetBatch ();
+            batch.rotations = rotations;
+            batch.scales = scales;
+            batch.depth = 2;
+
+            Matrix4x4 result[COUNT] = {};
+            TransformBatch::WriteMatrices ( &batch, result );
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                float cos = cosf ( rotations[i] );
+                float sin = sinf ( rotations[i] );
+
+                Matrix4x4 rotation = Matrix4x4(
+                    { cos, -sin, 0, 0 },
+                    { sin, cos, 0, 0 },
+                    { 0, 0, 1, 0 },
+                    { 0, 0, 0, 1 } );
+
+                Matrix4x4 translation = Matrix4x4::Translate ( Vector3 ( pos_x[i], pos_y[i], 2 ) );
+                Matrix4x4 scale = Matrix4x4::Scale ( Vector3 ( size_x[i] * scales[i], size_y[i] * scales[i], 1 ) );
+
+                Matrix4x4 expected = Matrix4x4::MultiplyScalar ( translation, Matrix4x4::MultiplyScalar ( rotation, scale ) );
+
+                Assert::IsTrue ( Matrix4x4::ApproxEqual ( expected, result[i], 0.0001f ) );
+            }
+        }
+
+        TEST_METHOD ( WritesWithStride )
+        {
+            struct Instance
+            {
+                Matrix4x4 mat;
+                float extra[3];
+            };
+
+            TransformBatch batch = GetBatch ();
+            batch.rotations = rotations;
+
+            Instance result[COUNT] = {};
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                result[i].extra[0] = (float) i;
+            }
+
+            TransformBatch::WriteMatrices ( &batch, result, sizeof ( Instance ) );
+
+            for ( size_t i = 0; i < COUNT; ++i )
+            {
+                Matrix4x4 expected = TransformBatch::QuadMatrix ( &batch, i );
+
+                Assert::IsTrue ( Matrix4x4::ApproxEqual ( expected, result[i].mat, 0.0001f ) );
+                Assert::IsTrue ( result[i].extra[0] == (float) i );
+            }
+        }
+    };
+}
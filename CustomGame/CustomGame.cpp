@@ -402,7 +402,7 @@ FontInfo CreateFont()
     return info;
 }
 
-DWORD Test(void *param)
+uint32_t Test(void *param)
 {
     // const static char* log_test = "Hi from test";
     while (true)
@@ -477,6 +477,12 @@ void OnRender(GameApp *game_app, RendererContext *render_ctx, float delta_time)
     // investigate
     DArray<DrawMesh>::Add(&render_ctx->mesh_draws, entry->ui_root.GetDraw());
     DArray<DrawMesh>::Add(&render_ctx->mesh_draws, entry->text.GetDraw());
+
+    // the renderer can move these to compact its buffers , it patches them after the frame
+    DArray<FreeList::Node *>::Add(&render_ctx->mesh_handles, &entry->plane_mesh.verticies_block);
+    DArray<FreeList::Node *>::Add(&render_ctx->mesh_handles, &entry->plane_mesh.indicies_block);
+    DArray<FreeList::Node *>::Add(&render_ctx->descriptors_handles, &entry->ui_root.instances_data);
+    DArray<FreeList::Node *>::Add(&render_ctx->descriptors_handles, &entry->text.instance_matricies);
 }
 
 void Destroy(GameApp *game_app)
@@ -27,8 +27,22 @@ DrawMesh TextUI::GetDraw()
     VulkanContext *ctx = (VulkanContext *)Global::backend_renderer.user_data;
     EntryPoint *entry = (EntryPoint *)Global::app.game_app.user_data;
 
-    DArray<TextCharData> char_data = {};
-    DArray<TextCharData>::Create(text.length, &char_data, Global::alloc_toolbox.frame_allocator);
+    ScratchArena scratch = ScratchArena::Get();
+    DEFER([&](){ ScratchArena::Release(&scratch); });
+
+    TransformBatch glyphs = {};
+    glyphs.pos_x = (float *)ALLOC(scratch.alloc, sizeof(float) * text.length);
+    glyphs.pos_y = (float *)ALLOC(scratch.alloc, sizeof(float) * text.length);
+    glyphs.size_x = (float *)ALLOC(scratch.alloc, sizeof(float) * text.length);
+    glyphs.size_y = (float *)ALLOC(scratch.alloc, sizeof(float) * text.length);
+    glyphs.count = text.length;
+
+    const size_t size_for_text = sizeof(TextCharData) * text.length;
+
+    // instance data is written straight into the staging buffer
+    void *staging_data = nullptr;
+    Buffer::Lock(0, size_for_text, 0, &ctx->staging_buffer, &staging_data);
+    TextCharData *char_data = (TextCharData *)staging_data;
 
     FontInfo font = entry->font_info;
 
@@ -42,11 +56,10 @@ DrawMesh TextUI::GetDraw()
         float starting_space = char_info.bearing_x;
         float ending_space = char_info.advance - starting_space - char_info.character_width;
 
-        Matrix4x4 char_mat = Matrix4x4(
-            {char_info.character_width, 0, 0, offset.x + starting_space},
-            {0, char_info.character_height , 0, offset.y + line_offset},
-            {0, 0, 1, 0},
-            {0, 0, 0, 1});
+        glyphs.pos_x[i] = offset.x + starting_space;
+        glyphs.pos_y[i] = offset.y + line_offset;
+        glyphs.size_x[i] = char_info.character_width;
+        glyphs.size_y[i] = char_info.character_height;
 
         if(c == ' ')
         {
@@ -56,14 +69,12 @@ DrawMesh TextUI::GetDraw()
         {
             offset.x += char_info.character_width + ending_space;
         }
-        TextCharData data = {};
-        data.uv_rect = char_info.uv_rect;
-        data.quad_matrix = char_mat;
 
-        DArray<TextCharData>::Add(&char_data, data);
+        char_data[i].uv_rect = char_info.uv_rect;
     }
 
-    const size_t size_for_text = sizeof(TextCharData) * text.length;
+    TransformBatch::WriteMatrices(&glyphs, &char_data->quad_matrix, sizeof(TextCharData));
+    Buffer::Unlock(&ctx->staging_buffer);
 
     DrawMesh draw = {};
     draw.instances_count = text.length;
@@ -74,7 +85,6 @@ DrawMesh TextUI::GetDraw()
 
     VkCommandPool pool = ctx->physical_device_info.command_pools_info.graphicsCommandPool;
     VkQueue queue = ctx->physical_device_info.queues_info.graphics_queue;
-    Buffer::Load(0, size_for_text, char_data.data, 0, &ctx->staging_buffer);
     Buffer::Copy(pool, {}, queue, &ctx->staging_buffer, 0, &ctx->descriptors_buffer, instance_matricies.start, size_for_text);
 
     return draw;